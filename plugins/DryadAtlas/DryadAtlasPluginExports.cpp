@@ -58,6 +58,9 @@ constexpr int kMaxPreviewWidth = 4096;
 constexpr int kMaxPreviewHeight = 2048;
 
 QByteArray g_errorBuffer;
+// Set only for the duration of APE_Plugin_InvokeStreaming on the invoking thread.
+thread_local const ApePluginAbiStreamHost* g_streamHost = nullptr;
+thread_local bool g_streamCancelled = false;
 
 struct Rgba {
     std::uint8_t r = 0;
@@ -155,6 +158,18 @@ static void clearError() {
     g_errorBuffer.clear();
 }
 
+// Returns false once the host has asked for the running call to stop.
+static bool reportStreamProgress(std::uint64_t completed, std::uint64_t total, const char* messageUtf8) {
+    if (!g_streamHost || g_streamCancelled) {
+        return !g_streamCancelled;
+    }
+    if (g_streamHost->reportProgress
+        && g_streamHost->reportProgress(g_streamHost->context, completed, total, messageUtf8) != 0) {
+        g_streamCancelled = true;
+    }
+    return !g_streamCancelled;
+}
+
 static char* allocateCString(const QByteArray& utf8) {
     char* result = static_cast<char*>(std::malloc(static_cast<std::size_t>(utf8.size()) + 1U));
     if (!result) {
@@ -754,7 +769,13 @@ static std::vector<GlyphBitmap> rasterizeTtfCodepoints(const std::uint8_t* data,
 
     std::vector<GlyphBitmap> glyphs;
     glyphs.reserve(codepoints.size());
+    std::uint64_t visited = 0;
     for (std::uint32_t cp : codepoints) {
+        if ((visited++ & 63u) == 0
+            && !reportStreamProgress(visited - 1, codepoints.size(), "Rasterizing glyphs")) {
+            glyphs.clear();
+            break;
+        }
         if (cp > 0xFFFFu) {
             continue;
         }
@@ -777,6 +798,10 @@ static std::vector<GlyphBitmap> rasterizeTtfCodepoints(const std::uint8_t* data,
     DeleteObject(font);
     DeleteDC(dc);
     RemoveFontMemResourceEx(fontResource);
+    if (g_streamCancelled) {
+        setError("Font generation was cancelled.");
+        return {};
+    }
     return glyphs;
 #endif
 }
@@ -1892,6 +1917,10 @@ APE_DRYAD_EXPORT int APE_DryadAtlas_GenerateFromTtf(
         const std::string logicalBase = "gfx/fonts/" + options.outputName + "/" + baseName;
         const std::string fntText = buildFntText(options, packedGlyphs, i, lineHeight, base);
         const std::vector<std::uint8_t> ddsBytes = ddsFutures[static_cast<std::size_t>(i)].get();
+        if (!reportStreamProgress(static_cast<std::uint64_t>(i) + 1, pages.size(), "Encoding atlas pages")) {
+            setError("Font generation was cancelled.");
+            return 0;
+        }
 
         QJsonObject fnt;
         fnt[QStringLiteral("path")] = QString::fromStdString(logicalBase + ".fnt");
@@ -2116,7 +2145,9 @@ int invokeDryadGenerateFromTtf(const ApePluginAbiRequest* request, ApePluginAbiR
             ttfBytes.size(),
             optionsJson.constData(),
             &jsonText) || !jsonText) {
-        setAbiError(response, APE_PLUGIN_ABI_STATUS_PLUGIN_ERROR, QString::fromUtf8(APE_DryadAtlas_GetLastError()));
+        setAbiError(response,
+                    g_streamCancelled ? APE_PLUGIN_ABI_STATUS_CANCELLED : APE_PLUGIN_ABI_STATUS_PLUGIN_ERROR,
+                    QString::fromUtf8(APE_DryadAtlas_GetLastError()));
         return 1;
     }
     const QByteArray payload(jsonText);
@@ -2238,3 +2269,25 @@ APE_PLUGIN_ABI_EXPORT int APE_Plugin_Invoke(const ApePluginAbiRequest* request,
     setAbiError(response, APE_PLUGIN_ABI_STATUS_UNSUPPORTED_OPERATION, QStringLiteral("Unsupported DryadAtlas operation."));
     return 1;
 }
+
+APE_PLUGIN_ABI_EXPORT int APE_Plugin_InvokeStreaming(const ApePluginAbiRequest* request,
+                                                     const ApePluginAbiStreamHost* host,
+                                                     ApePluginAbiResponse* response) {
+    struct StreamScope {
+        explicit StreamScope(const ApePluginAbiStreamHost* streamHost) {
+            g_streamHost = streamHost;
+            g_streamCancelled = streamHost && streamHost->isCancelled && streamHost->isCancelled(streamHost->context) != 0;
+        }
+        ~StreamScope() {
+            g_streamHost = nullptr;
+            g_streamCancelled = false;
+        }
+    } scope(host);
+
+    if (g_streamCancelled && response) {
+        clearAbiResponse(response);
+        setAbiError(response, APE_PLUGIN_ABI_STATUS_CANCELLED, QStringLiteral("DryadAtlas call was cancelled."));
+        return 1;
+    }
+    return APE_Plugin_Invoke(request, response);
+}
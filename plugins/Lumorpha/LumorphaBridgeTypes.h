@@ -57,6 +57,39 @@ enum LumorphaResizeFilter {
     APE_LUMORPHA_FILTER_LANCZOS3 = 6
 };
 
+// APE_Lumorpha_EncodeImage encodeFlags for DDS output: the low byte picks the block compression,
+// the next one the quality preset, and GENERATE_MIPS adds a mip chain down to 1x1.
+enum LumorphaEncodeFlags {
+    APE_LUMORPHA_DDS_UNCOMPRESSED = 0x0,
+    APE_LUMORPHA_DDS_BC1 = 0x1,
+    APE_LUMORPHA_DDS_BC3 = 0x2,
+    APE_LUMORPHA_DDS_BC7 = 0x3,
+    APE_LUMORPHA_DDS_COMPRESSION_MASK = 0xFF,
+    APE_LUMORPHA_DDS_QUALITY_BALANCED = 0x000,
+    APE_LUMORPHA_DDS_QUALITY_FAST = 0x100,
+    APE_LUMORPHA_DDS_QUALITY_BEST = 0x200,
+    APE_LUMORPHA_DDS_QUALITY_MASK = 0xFF00,
+    APE_LUMORPHA_DDS_GENERATE_MIPS = 0x10000
+};
+
+// lumorpha.runPipeline: where the source comes from and the steps applied to it
+enum LumorphaPipelineSource {
+    APE_LUMORPHA_PIPELINE_SOURCE_ENCODED = 0,
+    APE_LUMORPHA_PIPELINE_SOURCE_IMAGE = 1
+};
+
+enum LumorphaPipelineOp {
+    APE_LUMORPHA_PIPELINE_OP_CROP = 1,
+    APE_LUMORPHA_PIPELINE_OP_RESIZE = 2,
+    APE_LUMORPHA_PIPELINE_OP_FLIP = 3,
+    APE_LUMORPHA_PIPELINE_OP_PREMULTIPLY = 4
+};
+
+enum LumorphaPipelineFlip {
+    APE_LUMORPHA_FLIP_HORIZONTAL = 1,
+    APE_LUMORPHA_FLIP_VERTICAL = 2
+};
+
 typedef struct LumorphaImageView {
     uint32_t width;
     uint32_t height;
@@ -63,6 +63,20 @@ APE_LUMORPHA_EXPORT int APE_Lumorpha_CropResizeImage(
     LumorphaImageData* outImage
 );
 
+// targetSizes holds targetCount width/height pairs; outImages receives targetCount images,
+// each released with APE_Lumorpha_FreeImage. Either every target succeeds or none is returned.
+APE_LUMORPHA_EXPORT int APE_Lumorpha_CropResizeImageSizes(
+    const LumorphaImageView* image,
+    uint32_t x,
+    uint32_t y,
+    uint32_t width,
+    uint32_t height,
+    const uint32_t* targetSizes,
+    uint32_t targetCount,
+    uint32_t filter,
+    LumorphaImageData* outImages
+);
+
 APE_LUMORPHA_EXPORT void APE_Lumorpha_FreeImage(LumorphaImageData* image);
 APE_LUMORPHA_EXPORT void APE_Lumorpha_FreeBytes(unsigned char* bytes);
 
@@ -12,6 +12,8 @@
 
 #include "main/Codecs/ImageCodec.h"
 #include "main/Processing/ImageProcessor.h"
+#include "main/Render/ImagePipeline.h"
+#include "main/Render/TextureAtlas.h"
 
 #include <algorithm>
 #include <cstdlib>
@@ -26,6 +28,9 @@
 namespace {
 
 thread_local std::string g_lastError;
+// Set only for the duration of APE_Plugin_InvokeStreaming on the invoking thread.
+thread_local const ApePluginAbiStreamHost* g_streamHost = nullptr;
+thread_local bool g_streamCancelled = false;
 
 void clearError() {
     g_lastError.clear();
@@ -35,6 +40,18 @@ void setError(const std::string& message) {
     g_lastError = message;
 }
 
+// Returns false once the host has asked for the running call to stop.
+bool reportStreamProgress(std::uint64_t completed, std::uint64_t total, const char* messageUtf8) {
+    if (!g_streamHost || g_streamCancelled) {
+        return !g_streamCancelled;
+    }
+    if (g_streamHost->reportProgress
+        && g_streamHost->reportProgress(g_streamHost->context, completed, total, messageUtf8) != 0) {
+        g_streamCancelled = true;
+    }
+    return !g_streamCancelled;
+}
+
 Lumorpha::ImageFormat toImageFormat(std::uint32_t value) {
     switch (value) {
     case APE_LUMORPHA_FORMAT_PNG:
@@ -59,6 +76,44 @@ Lumorpha::ImageFormat toImageFormat(std::uint32_t value) {
     }
 }
 
+bool toTextureOptions(std::uint32_t encodeFlags, Lumorpha::TextureOptions* outOptions) {
+    switch (encodeFlags & APE_LUMORPHA_DDS_COMPRESSION_MASK) {
+    case APE_LUMORPHA_DDS_UNCOMPRESSED:
+        outOptions->compression = Lumorpha::TextureCompression::None;
+        break;
+    case APE_LUMORPHA_DDS_BC1:
+        outOptions->compression = Lumorpha::TextureCompression::Bc1;
+        break;
+    case APE_LUMORPHA_DDS_BC3:
+        outOptions->compression = Lumorpha::TextureCompression::Bc3;
+        break;
+    case APE_LUMORPHA_DDS_BC7:
+        outOptions->compression = Lumorpha::TextureCompression::Bc7;
+        break;
+    default:
+        return false;
+    }
+
+    switch (encodeFlags & APE_LUMORPHA_DDS_QUALITY_MASK) {
+    case APE_LUMORPHA_DDS_QUALITY_BALANCED:
+        outOptions->quality = Lumorpha::TextureQuality::Balanced;
+        break;
+    case APE_LUMORPHA_DDS_QUALITY_FAST:
+        outOptions->quality = Lumorpha::TextureQuality::Fast;
+        break;
+    case APE_LUMORPHA_DDS_QUALITY_BEST:
+        outOptions->quality = Lumorpha::TextureQuality::Best;
+        break;
+    default:
+        return false;
+    }
+
+    outOptions->generateMips = (encodeFlags & APE_LUMORPHA_DDS_GENERATE_MIPS) != 0;
+    return (encodeFlags & ~static_cast<std::uint32_t>(APE_LUMORPHA_DDS_COMPRESSION_MASK
+                                                      | APE_LUMORPHA_DDS_QUALITY_MASK
+                                                      | APE_LUMORPHA_DDS_GENERATE_MIPS)) == 0;
+}
+
 Lumorpha::ResizeFilter toResizeFilter(std::uint32_t value) {
     switch (value) {
     case APE_LUMORPHA_FILTER_NEAREST:
@@ -79,6 +134,38 @@ Lumorpha::ResizeFilter toResizeFilter(std::uint32_t value) {
     }
 }
 
+bool outputByteSize(int width, int height, std::uint32_t* outByteSize) {
+    const std::size_t pixelCount = Lumorpha::checkedPixelCount(width, height);
+    if (pixelCount == 0 || pixelCount > std::numeric_limits<std::uint32_t>::max() / 4U) {
+        setError("Image buffer is too large.");
+        return false;
+    }
+    *outByteSize = static_cast<std::uint32_t>(pixelCount * 4U);
+    return true;
+}
+
+// Mallocs outImage's pixels and returns them as a view for the result to be written into.
+Lumorpha::MutableImageView allocateOutputImage(int width, int height, LumorphaImageData* outImage) {
+    std::memset(outImage, 0, sizeof(*outImage));
+    std::uint32_t byteCount = 0;
+    if (!outputByteSize(width, height, &byteCount)) {
+        return {};
+    }
+    auto* pixels = static_cast<unsigned char*>(std::malloc(byteCount));
+    if (!pixels) {
+        setError("Failed to allocate output image.");
+        return {};
+    }
+
+    outImage->width = static_cast<std::uint32_t>(width);
+    outImage->height = static_cast<std::uint32_t>(height);
+    outImage->stride = static_cast<std::uint32_t>(width * 4);
+    outImage->pixelFormat = APE_LUMORPHA_PIXEL_RGBA8;
+    outImage->byteSize = byteCount;
+    outImage->pixels = pixels;
+    return {reinterpret_cast<Lumorpha::Rgba8*>(pixels), width, height, static_cast<std::size_t>(width)};
+}
+
 bool copyToOutputImage(const Lumorpha::ImageBuffer& image, LumorphaImageData* outImage) {
     if (!outImage) {
         setError("Output image pointer is null.");
@@ -91,77 +178,99 @@ bool copyToOutputImage(const Lumorpha::ImageBuffer& image, LumorphaImageData* ou
         return false;
     }
 
-    const std::size_t pixelCount = Lumorpha::checkedPixelCount(image.width, image.height);
-    if (pixelCount > std::numeric_limits<std::uint32_t>::max() / 4U) {
-        setError("Image buffer is too large.");
-        return false;
-    }
-
-    const std::size_t byteCount = pixelCount * 4U;
-    auto* pixels = static_cast<unsigned char*>(std::malloc(byteCount));
-    if (!pixels) {
-        setError("Failed to allocate output image.");
+    const Lumorpha::MutableImageView output = allocateOutputImage(image.width, image.height, outImage);
+    if (!output.pixels) {
         return false;
     }
-
-    for (std::size_t i = 0; i < pixelCount; ++i) {
-        const Lumorpha::Rgba8 pixel = image.pixels[i];
-        pixels[i * 4U + 0U] = pixel.r;
-        pixels[i * 4U + 1U] = pixel.g;
-        pixels[i * 4U + 2U] = pixel.b;
-        pixels[i * 4U + 3U] = pixel.a;
-    }
-
-    outImage->width = static_cast<std::uint32_t>(image.width);
-    outImage->height = static_cast<std::uint32_t>(image.height);
-    outImage->stride = static_cast<std::uint32_t>(image.width * 4);
-    outImage->pixelFormat = APE_LUMORPHA_PIXEL_RGBA8;
-    outImage->byteSize = static_cast<std::uint32_t>(byteCount);
-    outImage->pixels = pixels;
+    Lumorpha::copyPixels(image, output);
     return true;
 }
 
-Lumorpha::ImageBuffer imageFromView(const LumorphaImageView* view) {
+// Reads the caller's RGBA8 rows in place. Only a stride that is not a whole number of pixels
+// needs a packed copy, which goes into storage.
+bool resolveImageView(const LumorphaImageView* view, Lumorpha::ImageBuffer* storage, Lumorpha::ImageView* outView) {
     if (!view || !view->pixels) {
         setError("Image view is null.");
-        return {};
+        return false;
     }
     if (view->pixelFormat != APE_LUMORPHA_PIXEL_RGBA8) {
         setError("Only RGBA8 image views are supported.");
-        return {};
+        return false;
     }
     if (view->width == 0 || view->height == 0) {
         setError("Image view dimensions or stride are invalid.");
-        return {};
+        return false;
     }
     if (!Lumorpha::imageDimensionsAreSafe(static_cast<int>(view->width), static_cast<int>(view->height))) {
         setError("Image view dimensions are too large.");
-        return {};
+        return false;
     }
     if (view->stride < view->width * 4U) {
         setError("Image view dimensions or stride are invalid.");
-        return {};
+        return false;
     }
 
-    Lumorpha::ImageBuffer image;
-    image.width = static_cast<int>(view->width);
-    image.height = static_cast<int>(view->height);
-    image.pixels.resize(Lumorpha::checkedPixelCount(image.width, image.height));
+    const int width = static_cast<int>(view->width);
+    const int height = static_cast<int>(view->height);
+    if (view->stride % sizeof(Lumorpha::Rgba8) == 0) {
+        *outView = {reinterpret_cast<const Lumorpha::Rgba8*>(view->pixels), width, height, view->stride / sizeof(Lumorpha::Rgba8)};
+        return true;
+    }
+
+    *storage = Lumorpha::makeImage(width, height);
+    for (int y = 0; y < height; ++y) {
+        std::memcpy(storage->pixels.data() + static_cast<std::size_t>(y) * width,
+                    view->pixels + static_cast<std::size_t>(y) * view->stride,
+                    static_cast<std::size_t>(width) * sizeof(Lumorpha::Rgba8));
+    }
+    *outView = *storage;
+    return true;
+}
+
+// Shared by every crop/resize entry point: resamples the rectangle (the whole image when rect
+// is null) to each target and writes the result into the memory allocate(index, width, height)
+// returns, so the caller's output buffer is the only allocation a result needs. A size set
+// derives its targets from a shared pyramid, as cropResizeImageSizes does.
+template <typename AllocateFn>
+int cropResizeInto(const LumorphaImageView* image,
+                   const Lumorpha::CropRect* rect,
+                   const std::vector<Lumorpha::ResizeTarget>& targets,
+                   Lumorpha::ResizeFilter filter,
+                   bool sizeSet,
+                   const AllocateFn& allocate) {
+    Lumorpha::ImageBuffer storage;
+    Lumorpha::ImageView source;
+    if (!resolveImageView(image, &storage, &source)) {
+        return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
+    }
+    const Lumorpha::CropRect area = rect ? *rect : Lumorpha::CropRect{0, 0, source.width, source.height};
+    if (!Lumorpha::isValidCrop(source, area)) {
+        setError("Crop rectangle is invalid.");
+        return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
+    }
+    for (const Lumorpha::ResizeTarget& target : targets) {
+        if (!Lumorpha::imageDimensionsAreSafe(target.width, target.height)) {
+            setError("Target size is invalid.");
+            return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
+        }
+    }
 
-    for (int y = 0; y < image.height; ++y) {
-        const unsigned char* row = view->pixels + static_cast<std::size_t>(y) * view->stride;
-        for (int x = 0; x < image.width; ++x) {
-            const int offset = x * 4;
-            image.pixels[static_cast<std::size_t>(y * image.width + x)] = {
-                row[offset],
-                row[offset + 1],
-                row[offset + 2],
-                row[offset + 3]
-            };
+    std::vector<Lumorpha::MutableImageView> destinations(targets.size());
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+        destinations[i] = allocate(i, targets[i].width, targets[i].height);
+        if (!destinations[i].pixels) {
+            return APE_LUMORPHA_STATUS_INTERNAL_ERROR;
         }
     }
 
-    return image;
+    const bool written = sizeSet
+        ? Lumorpha::cropResizeImageSizesInto(source, area, destinations, filter)
+        : Lumorpha::resizeImageInto(Lumorpha::cropView(source, area), destinations.front(), filter);
+    if (!written) {
+        setError("Failed to resample image.");
+        return APE_LUMORPHA_STATUS_INTERNAL_ERROR;
+    }
+    return APE_LUMORPHA_STATUS_OK;
 }
 
 int statusFromImageError(bool unsupportedFormat) {
@@ -224,7 +333,6 @@ APE_LUMORPHA_EXPORT int APE_Lumorpha_EncodeImage(
     unsigned char** outBytes,
     std::uint32_t* outSize
 ) {
-    (void)encodeFlags;
     if (!outBytes || !outSize) {
         setError("Output byte buffer pointer is null.");
         return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
@@ -232,15 +340,22 @@ APE_LUMORPHA_EXPORT int APE_Lumorpha_EncodeImage(
     *outBytes = nullptr;
     *outSize = 0;
 
+    Lumorpha::TextureOptions textureOptions;
+    if (!toTextureOptions(encodeFlags, &textureOptions)) {
+        setError("Unknown encode flags.");
+        return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
+    }
+
     try {
-        const Lumorpha::ImageBuffer source = imageFromView(image);
-        if (!Lumorpha::isValidImage(source)) {
+        Lumorpha::ImageBuffer storage;
+        Lumorpha::ImageView source;
+        if (!resolveImageView(image, &storage, &source)) {
             return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
         }
 
         std::vector<std::uint8_t> encoded;
         std::string errorMessage;
-        if (!Lumorpha::encodeImage(source, toImageFormat(outputFormat), encoded, &errorMessage)) {
+        if (!Lumorpha::encodeImage(source, toImageFormat(outputFormat), textureOptions, encoded, &errorMessage)) {
             setError(errorMessage.empty() ? "Failed to encode image." : errorMessage);
             return statusFromImageError(!errorMessage.empty() && errorMessage.find("Unsupported") != std::string::npos);
         }
@@ -283,23 +398,25 @@ APE_LUMORPHA_EXPORT int APE_Lumorpha_ResizeImage(
         return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
     }
 
+    std::memset(outImage, 0, sizeof(*outImage));
+
     try {
-        const Lumorpha::ImageBuffer source = imageFromView(image);
-        if (!Lumorpha::isValidImage(source)) {
-            return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
-        }
-        const Lumorpha::ImageBuffer resized = Lumorpha::resizeImage(
-            source,
-            static_cast<int>(targetWidth),
-            static_cast<int>(targetHeight),
-            toResizeFilter(filter)
+        const int status = cropResizeInto(
+            image,
+            nullptr,
+            {{static_cast<int>(targetWidth), static_cast<int>(targetHeight)}},
+            toResizeFilter(filter),
+            false,
+            [outImage](std::size_t, int width, int height) { return allocateOutputImage(width, height, outImage); }
         );
-        if (!copyToOutputImage(resized, outImage)) {
-            return APE_LUMORPHA_STATUS_INTERNAL_ERROR;
+        if (status != APE_LUMORPHA_STATUS_OK) {
+            APE_Lumorpha_FreeImage(outImage);
+            return status;
         }
         clearError();
         return APE_LUMORPHA_STATUS_OK;
     } catch (...) {
+        APE_Lumorpha_FreeImage(outImage);
         setError("Unexpected resize failure.");
         return APE_LUMORPHA_STATUS_INTERNAL_ERROR;
     }
@@ -318,24 +435,32 @@ APE_LUMORPHA_EXPORT int APE_Lumorpha_CropImage(
         return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
     }
 
+    std::memset(outImage, 0, sizeof(*outImage));
+
     try {
-        const Lumorpha::ImageBuffer source = imageFromView(image);
-        if (!Lumorpha::isValidImage(source)) {
-            return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
-        }
         const Lumorpha::CropRect rect{
             static_cast<int>(x),
             static_cast<int>(y),
             static_cast<int>(width),
             static_cast<int>(height)
         };
-        const Lumorpha::ImageBuffer cropped = Lumorpha::cropImage(source, rect);
-        if (!copyToOutputImage(cropped, outImage)) {
-            return APE_LUMORPHA_STATUS_INTERNAL_ERROR;
+        // Resampling to the crop's own size copies the rows unchanged
+        const int status = cropResizeInto(
+            image,
+            &rect,
+            {{rect.width, rect.height}},
+            Lumorpha::ResizeFilter::Auto,
+            false,
+            [outImage](std::size_t, int outWidth, int outHeight) { return allocateOutputImage(outWidth, outHeight, outImage); }
+        );
+        if (status != APE_LUMORPHA_STATUS_OK) {
+            APE_Lumorpha_FreeImage(outImage);
+            return status;
         }
         clearError();
         return APE_LUMORPHA_STATUS_OK;
     } catch (...) {
+        APE_Lumorpha_FreeImage(outImage);
         setError("Unexpected crop failure.");
         return APE_LUMORPHA_STATUS_INTERNAL_ERROR;
     }
@@ -357,30 +482,91 @@ APE_LUMORPHA_EXPORT int APE_Lumorpha_CropResizeImage(
         return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
     }
 
+    std::memset(outImage, 0, sizeof(*outImage));
+
     try {
-        const Lumorpha::ImageBuffer source = imageFromView(image);
-        if (!Lumorpha::isValidImage(source)) {
-            return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
+        const Lumorpha::CropRect rect{
+            static_cast<int>(x),
+            static_cast<int>(y),
+            static_cast<int>(width),
+            static_cast<int>(height)
+        };
+        const int status = cropResizeInto(
+            image,
+            &rect,
+            {{static_cast<int>(targetWidth), static_cast<int>(targetHeight)}},
+            toResizeFilter(filter),
+            false,
+            [outImage](std::size_t, int outWidth, int outHeight) { return allocateOutputImage(outWidth, outHeight, outImage); }
+        );
+        if (status != APE_LUMORPHA_STATUS_OK) {
+            APE_Lumorpha_FreeImage(outImage);
+            return status;
         }
+        clearError();
+        return APE_LUMORPHA_STATUS_OK;
+    } catch (...) {
+        APE_Lumorpha_FreeImage(outImage);
+        setError("Unexpected crop-resize failure.");
+        return APE_LUMORPHA_STATUS_INTERNAL_ERROR;
+    }
+}
+
+APE_LUMORPHA_EXPORT int APE_Lumorpha_CropResizeImageSizes(
+    const LumorphaImageView* image,
+    std::uint32_t x,
+    std::uint32_t y,
+    std::uint32_t width,
+    std::uint32_t height,
+    const std::uint32_t* targetSizes,
+    std::uint32_t targetCount,
+    std::uint32_t filter,
+    LumorphaImageData* outImages
+) {
+    if (!outImages || !targetSizes || targetCount == 0 || width == 0 || height == 0) {
+        setError("Invalid crop-resize arguments.");
+        return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
+    }
+    std::memset(outImages, 0, sizeof(*outImages) * targetCount);
+
+    try {
+        std::vector<Lumorpha::ResizeTarget> targets(targetCount);
+        for (std::uint32_t i = 0; i < targetCount; ++i) {
+            if (targetSizes[i * 2U] == 0 || targetSizes[i * 2U + 1U] == 0) {
+                setError("Invalid crop-resize arguments.");
+                return APE_LUMORPHA_STATUS_INVALID_ARGUMENT;
+            }
+            targets[i] = {static_cast<int>(targetSizes[i * 2U]), static_cast<int>(targetSizes[i * 2U + 1U])};
+        }
+
         const Lumorpha::CropRect rect{
             static_cast<int>(x),
             static_cast<int>(y),
             static_cast<int>(width),
             static_cast<int>(height)
         };
-        const Lumorpha::ImageBuffer result = Lumorpha::cropResizeImage(
-            source,
-            rect,
-            static_cast<int>(targetWidth),
-            static_cast<int>(targetHeight),
-            toResizeFilter(filter)
+        const int status = cropResizeInto(
+            image,
+            &rect,
+            targets,
+            toResizeFilter(filter),
+            true,
+            [outImages](std::size_t index, int outWidth, int outHeight) {
+                return allocateOutputImage(outWidth, outHeight, &outImages[index]);
+            }
         );
-        if (!copyToOutputImage(result, outImage)) {
-            return APE_LUMORPHA_STATUS_INTERNAL_ERROR;
+        if (status != APE_LUMORPHA_STATUS_OK) {
+            for (std::uint32_t i = 0; i < targetCount; ++i) {
+                APE_Lumorpha_FreeImage(&outImages[i]);
+            }
+            return status;
         }
         clearError();
         return APE_LUMORPHA_STATUS_OK;
     } catch (...) {
+        for (std::uint32_t i = 0; i < targetCount; ++i) {
+            APE_Lumorpha_FreeImage(&outImages[i]);
+        }
         setError("Unexpected crop-resize failure.");
         return APE_LUMORPHA_STATUS_INTERNAL_ERROR;
     }
@@ -400,6 +586,13 @@ APE_LUMORPHA_EXPORT void APE_Lumorpha_FreeBytes(unsigned char* bytes) {
 
 namespace {
 
+// More sizes than any caller derives from one crop; bounds the allocation for a bad payload
+constexpr std::uint32_t kMaxResizeTargets = 64;
+// Likewise for the steps of one pipeline stage
+constexpr std::uint32_t kMaxPipelineOps = 32;
+// And for the sprites of one atlas; large mods ship a few thousand icons
+constexpr std::uint32_t kMaxAtlasSprites = 16384;
+
 void clearAbiResponse(ApePluginAbiResponse* response) {
     if (!response) {
         return;
@@ -452,6 +645,57 @@ bool setAbiPayload(ApePluginAbiResponse* response, const std::vector<std::uint8_
     return setAbiPayload(response, payload.data(), payload.size(), contentType);
 }
 
+struct OwnedPayload {
+    std::vector<std::uint8_t> bytes;
+};
+
+void releaseOwnedPayload(void* context) {
+    delete static_cast<OwnedPayload*>(context);
+}
+
+void releaseMallocPayload(void* context) {
+    std::free(context);
+}
+
+bool supportsOwnedPayload(const ApePluginAbiRequest* request) {
+    return request && request->abiVersion == APE_PLUGIN_ABI_VERSION_2;
+}
+
+void setAbiOwnedBuffer(ApePluginAbiResponse* response,
+                       const std::uint8_t* data,
+                       std::size_t size,
+                       ApePluginBufferRefFn release,
+                       void* releaseContext,
+                       std::uint32_t contentType) {
+    auto* extended = reinterpret_cast<ApePluginAbiResponseV2*>(response);
+    response->contentType = contentType;
+    response->payload = nullptr;
+    response->payloadSize = 0;
+    extended->ownedPayload.data = data;
+    extended->ownedPayload.size = static_cast<std::uint64_t>(size);
+    extended->ownedPayload.release = release;
+    extended->ownedPayload.releaseContext = releaseContext;
+}
+
+// Hands the vector to an ABI v2 host without copying; v1 hosts get the usual malloc'd copy.
+bool setAbiPayload(const ApePluginAbiRequest* request,
+                   ApePluginAbiResponse* response,
+                   std::vector<std::uint8_t>&& payload,
+                   std::uint32_t contentType) {
+    if (!response) {
+        return false;
+    }
+    if (!supportsOwnedPayload(request) || payload.empty()) {
+        return setAbiPayload(response, payload, contentType);
+    }
+    auto* owned = new (std::nothrow) OwnedPayload{std::move(payload)};
+    if (!owned) {
+        return false;
+    }
+    setAbiOwnedBuffer(response, owned->bytes.data(), owned->bytes.size(), &releaseOwnedPayload, owned, contentType);
+    return true;
+}
+
 void setAbiError(ApePluginAbiResponse* response, std::uint32_t status, const char* message) {
     if (!response) {
         return;
@@ -486,6 +730,7 @@ bool appendImageData(std::vector<std::uint8_t>* payload, const LumorphaImageData
     if (!payload || !image.pixels || image.byteSize == 0) {
         return false;
     }
+    payload->reserve(payload->size() + 5U * sizeof(std::uint32_t) + image.byteSize);
     appendU32(payload, image.width);
     appendU32(payload, image.height);
     appendU32(payload, image.stride);
@@ -515,13 +760,84 @@ bool readImageView(const std::uint8_t*& cursor, const std::uint8_t* end, Lumorph
     return true;
 }
 
-int finishLumorphaImageResponse(ApePluginAbiResponse* response, int status, LumorphaImageData* image) {
+// Reserves every record up front, so appendImageRecord never reallocates and the pixel views
+// it hands out stay valid while later records are added.
+void reserveImageRecords(std::vector<std::uint8_t>* payload,
+                         std::size_t prefixSize,
+                         const std::vector<Lumorpha::ResizeTarget>& targets) {
+    std::size_t size = payload->size() + prefixSize;
+    for (const Lumorpha::ResizeTarget& target : targets) {
+        if (Lumorpha::imageDimensionsAreSafe(target.width, target.height)) {
+            size += 5U * sizeof(std::uint32_t) + Lumorpha::checkedPixelCount(target.width, target.height) * 4U;
+        }
+    }
+    payload->reserve(size);
+}
+
+// Writes a record header in the appendImageData layout and returns the pixel area after it.
+Lumorpha::MutableImageView appendImageRecord(std::vector<std::uint8_t>* payload, int width, int height) {
+    std::uint32_t byteSize = 0;
+    if (!outputByteSize(width, height, &byteSize)) {
+        return {};
+    }
+    appendU32(payload, static_cast<std::uint32_t>(width));
+    appendU32(payload, static_cast<std::uint32_t>(height));
+    appendU32(payload, static_cast<std::uint32_t>(width * 4));
+    appendU32(payload, APE_LUMORPHA_PIXEL_RGBA8);
+    appendU32(payload, byteSize);
+    const std::size_t offset = payload->size();
+    payload->resize(offset + byteSize);
+    return {reinterpret_cast<Lumorpha::Rgba8*>(payload->data() + offset), width, height, static_cast<std::size_t>(width)};
+}
+
+// Resamples straight into the response payload, so the envelope the host receives is the only
+// buffer a result is written to. A size set's records follow a u32 target count.
+int respondWithImageRecords(const ApePluginAbiRequest* request,
+                            ApePluginAbiResponse* response,
+                            const LumorphaImageView& image,
+                            const Lumorpha::CropRect* rect,
+                            const std::vector<Lumorpha::ResizeTarget>& targets,
+                            std::uint32_t filter,
+                            bool sizeSet) {
+    std::vector<std::uint8_t> payload;
+    int status = APE_LUMORPHA_STATUS_INTERNAL_ERROR;
+    try {
+        reserveImageRecords(&payload, sizeSet ? sizeof(std::uint32_t) : 0U, targets);
+        if (sizeSet) {
+            appendU32(&payload, static_cast<std::uint32_t>(targets.size()));
+        }
+        status = cropResizeInto(&image, rect, targets, toResizeFilter(filter), sizeSet, [&payload](std::size_t, int width, int height) {
+            return appendImageRecord(&payload, width, height);
+        });
+    } catch (const std::bad_alloc&) {
+        setError("Failed to allocate Lumorpha response.");
+    } catch (...) {
+        setError("Unexpected Lumorpha failure.");
+    }
+    if (status != APE_LUMORPHA_STATUS_OK) {
+        setAbiError(response, abiStatusFromLumorphaStatus(status), APE_Lumorpha_GetLastError());
+        return 1;
+    }
+    if (!setAbiPayload(request, response, std::move(payload), APE_PLUGIN_ABI_CONTENT_BINARY_ENVELOPE)) {
+        setAbiError(response, APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR, "Failed to allocate Lumorpha response.");
+        return 1;
+    }
+    clearError();
+    response->status = APE_PLUGIN_ABI_STATUS_OK;
+    return 0;
+}
+
+int finishLumorphaImageResponse(const ApePluginAbiRequest* request,
+                                ApePluginAbiResponse* response,
+                                int status,
+                                LumorphaImageData* image) {
     if (status != APE_LUMORPHA_STATUS_OK) {
         setAbiError(response, abiStatusFromLumorphaStatus(status), APE_Lumorpha_GetLastError());
         return 1;
     }
     std::vector<std::uint8_t> payload;
-    if (!appendImageData(&payload, *image) || !setAbiPayload(response, payload, APE_PLUGIN_ABI_CONTENT_BINARY_ENVELOPE)) {
+    if (!appendImageData(&payload, *image)
+        || !setAbiPayload(request, response, std::move(payload), APE_PLUGIN_ABI_CONTENT_BINARY_ENVELOPE)) {
         APE_Lumorpha_FreeImage(image);
         setAbiError(response, APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR, "Failed to allocate Lumorpha response.");
         return 1;
@@ -542,7 +858,7 @@ int invokeLumorphaDecodeImage(const ApePluginAbiRequest* request, ApePluginAbiRe
 
     LumorphaImageData image{};
     const int status = APE_Lumorpha_DecodeImage(cursor, static_cast<std::uint32_t>(end - cursor), formatHint, &image);
-    return finishLumorphaImageResponse(response, status, &image);
+    return finishLumorphaImageResponse(request, response, status, &image);
 }
 
 int invokeLumorphaEncodeImage(const ApePluginAbiRequest* request, ApePluginAbiResponse* response) {
@@ -565,6 +881,12 @@ int invokeLumorphaEncodeImage(const ApePluginAbiRequest* request, ApePluginAbiRe
         setAbiError(response, abiStatusFromLumorphaStatus(status), APE_Lumorpha_GetLastError());
         return 1;
     }
+    if (supportsOwnedPayload(request) && bytes && size > 0) {
+        // The encoder already produced a malloc'd buffer; lend it to the host as is.
+        setAbiOwnedBuffer(response, bytes, size, &releaseMallocPayload, bytes, APE_PLUGIN_ABI_CONTENT_BINARY);
+        response->status = APE_PLUGIN_ABI_STATUS_OK;
+        return 0;
+    }
     if (!setAbiPayload(response, bytes, size, APE_PLUGIN_ABI_CONTENT_BINARY)) {
         APE_Lumorpha_FreeBytes(bytes);
         setAbiError(response, APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR, "Failed to allocate Lumorpha encoded response.");
@@ -590,9 +912,8 @@ int invokeLumorphaResizeImage(const ApePluginAbiRequest* request, ApePluginAbiRe
         return 1;
     }
 
-    LumorphaImageData resized{};
-    const int status = APE_Lumorpha_ResizeImage(&image, targetWidth, targetHeight, filter, &resized);
-    return finishLumorphaImageResponse(response, status, &resized);
+    const std::vector<Lumorpha::ResizeTarget> targets{{static_cast<int>(targetWidth), static_cast<int>(targetHeight)}};
+    return respondWithImageRecords(request, response, image, nullptr, targets, filter, false);
 }
 
 int invokeLumorphaCropImage(const ApePluginAbiRequest* request, ApePluginAbiResponse* response) {
@@ -612,9 +933,9 @@ int invokeLumorphaCropImage(const ApePluginAbiRequest* request, ApePluginAbiResp
         return 1;
     }
 
-    LumorphaImageData cropped{};
-    const int status = APE_Lumorpha_CropImage(&image, x, y, width, height, &cropped);
-    return finishLumorphaImageResponse(response, status, &cropped);
+    const Lumorpha::CropRect rect{static_cast<int>(x), static_cast<int>(y), static_cast<int>(width), static_cast<int>(height)};
+    const std::vector<Lumorpha::ResizeTarget> targets{{rect.width, rect.height}};
+    return respondWithImageRecords(request, response, image, &rect, targets, APE_LUMORPHA_FILTER_AUTO, false);
 }
 
 int invokeLumorphaCropResizeImage(const ApePluginAbiRequest* request, ApePluginAbiResponse* response) {
@@ -640,9 +961,341 @@ int invokeLumorphaCropResizeImage(const ApePluginAbiRequest* request, ApePluginA
         return 1;
     }
 
-    LumorphaImageData result{};
-    const int status = APE_Lumorpha_CropResizeImage(&image, x, y, width, height, targetWidth, targetHeight, filter, &result);
-    return finishLumorphaImageResponse(response, status, &result);
+    const Lumorpha::CropRect rect{static_cast<int>(x), static_cast<int>(y), static_cast<int>(width), static_cast<int>(height)};
+    const std::vector<Lumorpha::ResizeTarget> targets{{static_cast<int>(targetWidth), static_cast<int>(targetHeight)}};
+    return respondWithImageRecords(request, response, image, &rect, targets, filter, false);
+}
+
+int invokeLumorphaCropResizeImageSizes(const ApePluginAbiRequest* request, ApePluginAbiResponse* response) {
+    const std::uint8_t* cursor = request->payload.data;
+    const std::uint8_t* end = cursor ? cursor + request->payload.size : nullptr;
+    LumorphaImageView image{};
+    std::uint32_t x = 0;
+    std::uint32_t y = 0;
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    std::uint32_t filter = APE_LUMORPHA_FILTER_AUTO;
+    std::uint32_t targetCount = 0;
+    if (!readImageView(cursor, end, &image)
+        || !readU32(cursor, end, &x)
+        || !readU32(cursor, end, &y)
+        || !readU32(cursor, end, &width)
+        || !readU32(cursor, end, &height)
+        || !readU32(cursor, end, &filter)
+        || !readU32(cursor, end, &targetCount)
+        || targetCount == 0
+        || targetCount > kMaxResizeTargets) {
+        setAbiError(response, APE_PLUGIN_ABI_STATUS_INVALID_ARGUMENT, "Invalid Lumorpha crop-resize payload.");
+        return 1;
+    }
+    std::vector<Lumorpha::ResizeTarget> targets(targetCount);
+    for (Lumorpha::ResizeTarget& target : targets) {
+        std::uint32_t targetWidth = 0;
+        std::uint32_t targetHeight = 0;
+        if (!readU32(cursor, end, &targetWidth) || !readU32(cursor, end, &targetHeight)) {
+            setAbiError(response, APE_PLUGIN_ABI_STATUS_INVALID_ARGUMENT, "Invalid Lumorpha crop-resize payload.");
+            return 1;
+        }
+        target = {static_cast<int>(targetWidth), static_cast<int>(targetHeight)};
+    }
+
+    // u32 count followed by one image record per target, in request order
+    const Lumorpha::CropRect rect{static_cast<int>(x), static_cast<int>(y), static_cast<int>(width), static_cast<int>(height)};
+    return respondWithImageRecords(request, response, image, &rect, targets, filter, true);
+}
+
+// A request's source image: encoded file bytes or an image record.
+struct ImageSource {
+    const std::uint8_t* bytes = nullptr;
+    std::uint32_t size = 0;
+    std::uint32_t formatHint = APE_LUMORPHA_FORMAT_AUTO;
+    LumorphaImageView image{};
+};
+
+// u32 APE_LUMORPHA_PIPELINE_SOURCE_*, then u32 format hint, u32 size and the encoded bytes, or
+// an image record.
+bool readImageSource(const std::uint8_t*& cursor, const std::uint8_t* end, ImageSource* outSource) {
+    std::uint32_t sourceKind = 0;
+    if (!readU32(cursor, end, &sourceKind)) {
+        return false;
+    }
+    if (sourceKind == APE_LUMORPHA_PIPELINE_SOURCE_IMAGE) {
+        return readImageView(cursor, end, &outSource->image);
+    }
+    if (sourceKind != APE_LUMORPHA_PIPELINE_SOURCE_ENCODED
+        || !readU32(cursor, end, &outSource->formatHint)
+        || !readU32(cursor, end, &outSource->size)
+        || outSource->size == 0
+        || outSource->size > static_cast<std::size_t>(end - cursor)) {
+        return false;
+    }
+    outSource->bytes = cursor;
+    cursor += outSource->size;
+    return true;
+}
+
+// Decodes the source into storage, or borrows its pixels; returns the ABI status to fail with.
+std::uint32_t loadImageSource(const ImageSource& source,
+                              Lumorpha::ImageBuffer* storage,
+                              Lumorpha::ImageView* outView,
+                              std::string* errorMessage) {
+    if (source.bytes) {
+        *storage = Lumorpha::decodeImage(source.bytes, source.size, toImageFormat(source.formatHint), errorMessage);
+        if (!Lumorpha::isValidImage(*storage)) {
+            if (errorMessage->empty()) {
+                *errorMessage = "Failed to decode image.";
+            }
+            return APE_PLUGIN_ABI_STATUS_PLUGIN_ERROR;
+        }
+        *outView = *storage;
+        return APE_PLUGIN_ABI_STATUS_OK;
+    }
+    if (!resolveImageView(&source.image, storage, outView)) {
+        *errorMessage = APE_Lumorpha_GetLastError();
+        return APE_PLUGIN_ABI_STATUS_INVALID_ARGUMENT;
+    }
+    return APE_PLUGIN_ABI_STATUS_OK;
+}
+
+// u32 length and that many UTF-8 bytes
+bool readString(const std::uint8_t*& cursor, const std::uint8_t* end, std::string* outText) {
+    std::uint32_t length = 0;
+    if (!readU32(cursor, end, &length) || length > static_cast<std::size_t>(end - cursor)) {
+        return false;
+    }
+    outText->assign(reinterpret_cast<const char*>(cursor), length);
+    cursor += length;
+    return true;
+}
+
+void appendString(std::vector<std::uint8_t>* payload, const std::string& text) {
+    appendU32(payload, static_cast<std::uint32_t>(text.size()));
+    payload->insert(payload->end(), text.begin(), text.end());
+}
+
+// u32 count followed by that many ops, each a u32 APE_LUMORPHA_PIPELINE_OP_* and its arguments:
+// crop x, y, width, height; resize width, height, filter; flip flags; premultiply nothing.
+bool readPipelineOps(const std::uint8_t*& cursor, const std::uint8_t* end, std::vector<Lumorpha::PipelineOp>* outOps) {
+    std::uint32_t count = 0;
+    if (!readU32(cursor, end, &count) || count > kMaxPipelineOps) {
+        return false;
+    }
+    outOps->assign(count, {});
+    for (Lumorpha::PipelineOp& op : *outOps) {
+        std::uint32_t kind = 0;
+        if (!readU32(cursor, end, &kind)) {
+            return false;
+        }
+        std::uint32_t values[4] = {};
+        switch (kind) {
+        case APE_LUMORPHA_PIPELINE_OP_CROP:
+            if (!readU32(cursor, end, &values[0]) || !readU32(cursor, end, &values[1])
+                || !readU32(cursor, end, &values[2]) || !readU32(cursor, end, &values[3])) {
+                return false;
+            }
+            op.kind = Lumorpha::PipelineOpKind::Crop;
+            op.crop = {static_cast<int>(values[0]), static_cast<int>(values[1]), static_cast<int>(values[2]), static_cast<int>(values[3])};
+            break;
+        case APE_LUMORPHA_PIPELINE_OP_RESIZE:
+            if (!readU32(cursor, end, &values[0]) || !readU32(cursor, end, &values[1]) || !readU32(cursor, end, &values[2])) {
+                return false;
+            }
+            op.kind = Lumorpha::PipelineOpKind::Resize;
+            op.size = {static_cast<int>(values[0]), static_cast<int>(values[1])};
+            op.filter = toResizeFilter(values[2]);
+            break;
+        case APE_LUMORPHA_PIPELINE_OP_FLIP:
+            if (!readU32(cursor, end, &op.flipFlags)) {
+                return false;
+            }
+            op.kind = Lumorpha::PipelineOpKind::Flip;
+            break;
+        case APE_LUMORPHA_PIPELINE_OP_PREMULTIPLY:
+            op.kind = Lumorpha::PipelineOpKind::Premultiply;
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+// Source (see readImageSource), shared ops, then u32 output count and per output a u32 format and
+// its ops. Only the encoded outputs travel back: u32 count, then u32 size and bytes per output.
+int invokeLumorphaRunPipeline(const ApePluginAbiRequest* request, ApePluginAbiResponse* response) {
+    const std::uint8_t* cursor = request->payload.data;
+    const std::uint8_t* end = cursor ? cursor + request->payload.size : nullptr;
+    ImageSource source;
+    const bool validSource = readImageSource(cursor, end, &source);
+
+    std::vector<Lumorpha::PipelineOp> prefix;
+    std::uint32_t outputCount = 0;
+    if (!validSource
+        || !readPipelineOps(cursor, end, &prefix)
+        || !readU32(cursor, end, &outputCount)
+        || outputCount == 0
+        || outputCount > kMaxResizeTargets) {
+        setAbiError(response, APE_PLUGIN_ABI_STATUS_INVALID_ARGUMENT, "Invalid Lumorpha pipeline payload.");
+        return 1;
+    }
+    std::vector<Lumorpha::PipelineOutput> outputs(outputCount);
+    for (Lumorpha::PipelineOutput& output : outputs) {
+        std::uint32_t format = APE_LUMORPHA_FORMAT_PNG;
+        if (!readU32(cursor, end, &format) || !readPipelineOps(cursor, end, &output.ops)) {
+            setAbiError(response, APE_PLUGIN_ABI_STATUS_INVALID_ARGUMENT, "Invalid Lumorpha pipeline payload.");
+            return 1;
+        }
+        output.format = toImageFormat(format);
+    }
+
+    try {
+        std::string errorMessage;
+        Lumorpha::ImageBuffer storage;
+        Lumorpha::ImageView image;
+        const std::uint32_t sourceStatus = loadImageSource(source, &storage, &image, &errorMessage);
+        if (sourceStatus != APE_PLUGIN_ABI_STATUS_OK) {
+            setAbiError(response, sourceStatus, errorMessage.c_str());
+            return 1;
+        }
+
+        std::vector<std::vector<std::uint8_t>> encoded;
+        if (!Lumorpha::runImagePipeline(image, prefix, outputs, encoded, &errorMessage)) {
+            const bool unsupported = errorMessage.find("Unsupported") != std::string::npos;
+            setAbiError(response,
+                        unsupported ? APE_PLUGIN_ABI_STATUS_UNSUPPORTED_OPERATION : APE_PLUGIN_ABI_STATUS_PLUGIN_ERROR,
+                        errorMessage.empty() ? "Lumorpha pipeline failed." : errorMessage.c_str());
+            return 1;
+        }
+
+        std::size_t payloadSize = sizeof(std::uint32_t);
+        for (const std::vector<std::uint8_t>& bytes : encoded) {
+            if (bytes.size() > std::numeric_limits<std::uint32_t>::max()) {
+                setAbiError(response, APE_PLUGIN_ABI_STATUS_BUFFER_TOO_LARGE, "Encoded image is too large.");
+                return 1;
+            }
+            payloadSize += sizeof(std::uint32_t) + bytes.size();
+        }
+        std::vector<std::uint8_t> payload;
+        payload.reserve(payloadSize);
+        appendU32(&payload, outputCount);
+        for (const std::vector<std::uint8_t>& bytes : encoded) {
+            appendU32(&payload, static_cast<std::uint32_t>(bytes.size()));
+            payload.insert(payload.end(), bytes.begin(), bytes.end());
+        }
+        if (!setAbiPayload(request, response, std::move(payload), APE_PLUGIN_ABI_CONTENT_BINARY_ENVELOPE)) {
+            setAbiError(response, APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR, "Failed to allocate Lumorpha response.");
+            return 1;
+        }
+    } catch (const std::bad_alloc&) {
+        setAbiError(response, APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR, "Failed to allocate pipeline buffers.");
+        return 1;
+    } catch (...) {
+        setAbiError(response, APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR, "Unexpected pipeline failure.");
+        return 1;
+    }
+    response->status = APE_PLUGIN_ABI_STATUS_OK;
+    return 0;
+}
+
+// u32 max page size, u32 padding, u32 encodeFlags, the page path prefix as a string, then u32
+// sprite count and per sprite its name and source (see readImageSource). The response holds
+// u32 page count and per page u32 width, height and DDS size with its bytes; then per sprite
+// u32 page, x, y, width, height; then the .gfx text and the savings report JSON as strings.
+int invokeLumorphaBuildAtlas(const ApePluginAbiRequest* request, ApePluginAbiResponse* response) {
+    const std::uint8_t* cursor = request->payload.data;
+    const std::uint8_t* end = cursor ? cursor + request->payload.size : nullptr;
+    std::uint32_t maxPageSize = 0;
+    std::uint32_t padding = 0;
+    std::uint32_t encodeFlags = 0;
+    std::uint32_t spriteCount = 0;
+    Lumorpha::AtlasOptions options;
+    if (!readU32(cursor, end, &maxPageSize)
+        || !readU32(cursor, end, &padding)
+        || !readU32(cursor, end, &encodeFlags)
+        || !toTextureOptions(encodeFlags, &options.texture)
+        || !readString(cursor, end, &options.texturePathPrefix)
+        || !readU32(cursor, end, &spriteCount)
+        || spriteCount == 0
+        || spriteCount > kMaxAtlasSprites
+        || maxPageSize > static_cast<std::uint32_t>(std::numeric_limits<int>::max())
+        || padding > maxPageSize) {
+        setAbiError(response, APE_PLUGIN_ABI_STATUS_INVALID_ARGUMENT, "Invalid Lumorpha atlas payload.");
+        return 1;
+    }
+    options.maxPageSize = static_cast<int>(maxPageSize);
+    options.padding = static_cast<int>(padding);
+
+    try {
+        std::vector<Lumorpha::AtlasSprite> sprites(spriteCount);
+        std::vector<Lumorpha::ImageBuffer> storage(spriteCount);
+        std::string errorMessage;
+        for (std::uint32_t index = 0; index < spriteCount; ++index) {
+            ImageSource source;
+            if (!readString(cursor, end, &sprites[index].name) || !readImageSource(cursor, end, &source)) {
+                setAbiError(response, APE_PLUGIN_ABI_STATUS_INVALID_ARGUMENT, "Invalid Lumorpha atlas payload.");
+                return 1;
+            }
+            const std::uint32_t sourceStatus = loadImageSource(source, &storage[index], &sprites[index].image, &errorMessage);
+            if (sourceStatus != APE_PLUGIN_ABI_STATUS_OK) {
+                setAbiError(response, sourceStatus, errorMessage.c_str());
+                return 1;
+            }
+            sprites[index].sourceFileSize = source.size;
+        }
+
+        // BC7 pages take seconds each; one event per page keeps a tool host's call alive.
+        const auto pageProgress = [](std::size_t completedPages, std::size_t pageCount) {
+            return reportStreamProgress(completedPages, pageCount, "Encoding atlas pages");
+        };
+        Lumorpha::AtlasResult atlas;
+        if (!Lumorpha::buildTextureAtlas(sprites, options, atlas, &errorMessage, pageProgress)) {
+            setAbiError(response,
+                        g_streamCancelled ? APE_PLUGIN_ABI_STATUS_CANCELLED : APE_PLUGIN_ABI_STATUS_PLUGIN_ERROR,
+                        errorMessage.empty() ? "Failed to build atlas." : errorMessage.c_str());
+            return 1;
+        }
+
+        const std::string report = Lumorpha::atlasReportJson(atlas);
+        std::size_t payloadSize = sizeof(std::uint32_t) * (3U + 5U * sprites.size())
+            + atlas.spriteDefinitions.size() + report.size();
+        for (const std::vector<std::uint8_t>& page : atlas.pages) {
+            if (page.size() > std::numeric_limits<std::uint32_t>::max()) {
+                setAbiError(response, APE_PLUGIN_ABI_STATUS_BUFFER_TOO_LARGE, "Atlas page is too large.");
+                return 1;
+            }
+            payloadSize += sizeof(std::uint32_t) * 3U + page.size();
+        }
+        std::vector<std::uint8_t> payload;
+        payload.reserve(payloadSize);
+        appendU32(&payload, static_cast<std::uint32_t>(atlas.pages.size()));
+        for (std::size_t page = 0; page < atlas.pages.size(); ++page) {
+            appendU32(&payload, static_cast<std::uint32_t>(atlas.pageSizes[page].width));
+            appendU32(&payload, static_cast<std::uint32_t>(atlas.pageSizes[page].height));
+            appendU32(&payload, static_cast<std::uint32_t>(atlas.pages[page].size()));
+            payload.insert(payload.end(), atlas.pages[page].begin(), atlas.pages[page].end());
+        }
+        for (const Lumorpha::AtlasPlacement& placement : atlas.placements) {
+            appendU32(&payload, static_cast<std::uint32_t>(placement.page));
+            appendU32(&payload, static_cast<std::uint32_t>(placement.rect.x));
+            appendU32(&payload, static_cast<std::uint32_t>(placement.rect.y));
+            appendU32(&payload, static_cast<std::uint32_t>(placement.rect.width));
+            appendU32(&payload, static_cast<std::uint32_t>(placement.rect.height));
+        }
+        appendString(&payload, atlas.spriteDefinitions);
+        appendString(&payload, report);
+        if (!setAbiPayload(request, response, std::move(payload), APE_PLUGIN_ABI_CONTENT_BINARY_ENVELOPE)) {
+            setAbiError(response, APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR, "Failed to allocate Lumorpha response.");
+            return 1;
+        }
+    } catch (const std::bad_alloc&) {
+        setAbiError(response, APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR, "Failed to allocate atlas buffers.");
+        return 1;
+    } catch (...) {
+        setAbiError(response, APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR, "Unexpected atlas failure.");
+        return 1;
+    }
+    response->status = APE_PLUGIN_ABI_STATUS_OK;
+    return 0;
 }
 
 } // namespace
@@ -652,7 +1305,31 @@ APE_PLUGIN_ABI_EXPORT const char* APE_Plugin_GetName(void) {
 }
 
 APE_PLUGIN_ABI_EXPORT std::uint32_t APE_Plugin_GetAbiVersion(void) {
-    return APE_PLUGIN_ABI_VERSION;
+    return APE_PLUGIN_ABI_VERSION_2;
+}
+
+APE_PLUGIN_ABI_EXPORT std::uint32_t APE_Plugin_GetConcurrency(void) {
+    return APE_PLUGIN_ABI_CONCURRENCY_REENTRANT;
+}
+
+APE_PLUGIN_ABI_EXPORT int APE_Plugin_IsOperationCacheable(const char* operationUtf8) {
+    // Every operation is pure, but only resizes are worth keeping: they are what thumbnails and
+    // flag previews repeat, and their results are small. Decodes, encodes, pipelines and atlases
+    // return whole images or files that would only push everything else out of the cache.
+    if (!operationUtf8) {
+        return 0;
+    }
+    static const char* const kCacheableOperations[] = {
+        "lumorpha.resizeImage",
+        "lumorpha.cropResizeImage",
+        "lumorpha.cropResizeImageSizes"
+    };
+    for (const char* operation : kCacheableOperations) {
+        if (std::strcmp(operationUtf8, operation) == 0) {
+            return 1;
+        }
+    }
+    return 0;
 }
 
 APE_PLUGIN_ABI_EXPORT void APE_Plugin_FreeResponse(ApePluginAbiResponse* response) {
@@ -670,10 +1347,11 @@ APE_PLUGIN_ABI_EXPORT int APE_Plugin_Invoke(const ApePluginAbiRequest* request,
         setAbiError(response, APE_PLUGIN_ABI_STATUS_INVALID_ARGUMENT, "Invalid Lumorpha ABI request.");
         return 1;
     }
-    if (request->abiVersion != APE_PLUGIN_ABI_VERSION) {
+    if (request->abiVersion != APE_PLUGIN_ABI_VERSION && request->abiVersion != APE_PLUGIN_ABI_VERSION_2) {
         setAbiError(response, APE_PLUGIN_ABI_STATUS_UNSUPPORTED_ABI, "Unsupported Lumorpha ABI version.");
         return 1;
     }
+    response->abiVersion = request->abiVersion;
 
     const std::string operation(request->operationUtf8);
     if (operation == "lumorpha.decodeImage") {
@@ -691,7 +1369,38 @@ APE_PLUGIN_ABI_EXPORT int APE_Plugin_Invoke(const ApePluginAbiRequest* request,
     if (operation == "lumorpha.cropResizeImage") {
         return invokeLumorphaCropResizeImage(request, response);
     }
+    if (operation == "lumorpha.cropResizeImageSizes") {
+        return invokeLumorphaCropResizeImageSizes(request, response);
+    }
+    if (operation == "lumorpha.runPipeline") {
+        return invokeLumorphaRunPipeline(request, response);
+    }
+    if (operation == "lumorpha.buildAtlas") {
+        return invokeLumorphaBuildAtlas(request, response);
+    }
 
     setAbiError(response, APE_PLUGIN_ABI_STATUS_UNSUPPORTED_OPERATION, "Unsupported Lumorpha operation.");
     return 1;
 }
+
+APE_PLUGIN_ABI_EXPORT int APE_Plugin_InvokeStreaming(const ApePluginAbiRequest* request,
+                                                     const ApePluginAbiStreamHost* host,
+                                                     ApePluginAbiResponse* response) {
+    struct StreamScope {
+        explicit StreamScope(const ApePluginAbiStreamHost* streamHost) {
+            g_streamHost = streamHost;
+            g_streamCancelled = streamHost && streamHost->isCancelled && streamHost->isCancelled(streamHost->context) != 0;
+        }
+        ~StreamScope() {
+            g_streamHost = nullptr;
+            g_streamCancelled = false;
+        }
+    } scope(host);
+
+    if (g_streamCancelled && response) {
+        clearAbiResponse(response);
+        setAbiError(response, APE_PLUGIN_ABI_STATUS_CANCELLED, "Lumorpha call was cancelled.");
+        return 1;
+    }
+    return APE_Plugin_Invoke(request, response);
+}
@@ -0,0 +1,378 @@
+//-------------------------------------------------------------------------------------
+// BmpCodec.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "BmpCodec.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace Lumorpha {
+
+namespace {
+
+constexpr std::size_t kFileHeaderSize = 14;
+constexpr std::uint32_t kCoreHeaderSize = 12;
+constexpr std::uint32_t kInfoHeaderSize = 40;
+constexpr std::uint32_t kV4HeaderSize = 108;
+
+enum Compression : std::uint32_t {
+    CompressionRgb = 0,
+    CompressionRle8 = 1,
+    CompressionRle4 = 2,
+    CompressionBitFields = 3,
+    CompressionAlphaBitFields = 6
+};
+
+struct Channel {
+    std::uint32_t mask = 0;
+    int shift = 0;
+    std::uint32_t maximum = 0;
+
+    explicit Channel(std::uint32_t value = 0)
+        : mask(value) {
+        if (mask == 0) {
+            return;
+        }
+        while (((mask >> shift) & 1U) == 0) {
+            ++shift;
+        }
+        maximum = mask >> shift;
+    }
+
+    std::uint8_t extract(std::uint32_t pixel, std::uint8_t fallback) const {
+        if (mask == 0) {
+            return fallback;
+        }
+        const std::uint32_t value = (pixel & mask) >> shift;
+        return static_cast<std::uint8_t>((static_cast<std::uint64_t>(value) * 255U + maximum / 2) / maximum);
+    }
+};
+
+void setError(std::string* errorMessage, const char* message) {
+    if (errorMessage) {
+        *errorMessage = message;
+    }
+}
+
+std::uint16_t readLittleEndian16(const std::uint8_t* data) {
+    return static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+}
+
+std::uint32_t readLittleEndian32(const std::uint8_t* data) {
+    return std::uint32_t(data[0]) | (std::uint32_t(data[1]) << 8) | (std::uint32_t(data[2]) << 16) | (std::uint32_t(data[3]) << 24);
+}
+
+void appendLittleEndian16(std::vector<std::uint8_t>& output, std::uint16_t value) {
+    output.push_back(static_cast<std::uint8_t>(value));
+    output.push_back(static_cast<std::uint8_t>(value >> 8));
+}
+
+void appendLittleEndian32(std::vector<std::uint8_t>& output, std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        output.push_back(static_cast<std::uint8_t>(value >> shift));
+    }
+}
+
+// Expands RLE4/RLE8 into one palette index per pixel, bottom row first as stored.
+bool decodeRle(const std::uint8_t* data,
+               std::size_t size,
+               int width,
+               int height,
+               bool fourBit,
+               std::vector<std::uint8_t>& indices) {
+    indices.assign(static_cast<std::size_t>(width) * height, 0);
+    std::size_t position = 0;
+    int x = 0;
+    int y = 0;
+    auto put = [&](std::uint8_t index) {
+        if (x < width && y < height) {
+            indices[static_cast<std::size_t>(y) * width + x] = index;
+        }
+        ++x;
+    };
+
+    while (position + 1 < size && y < height) {
+        const int count = data[position];
+        const int value = data[position + 1];
+        position += 2;
+        if (count > 0) {
+            for (int i = 0; i < count; ++i) {
+                put(static_cast<std::uint8_t>(fourBit ? ((i & 1) ? value & 0x0F : value >> 4) : value));
+            }
+            continue;
+        }
+
+        if (value == 0) {
+            x = 0;
+            ++y;
+        } else if (value == 1) {
+            return true;
+        } else if (value == 2) {
+            if (position + 1 >= size) {
+                return false;
+            }
+            x += data[position];
+            y += data[position + 1];
+            position += 2;
+        } else {
+            const std::size_t literalBytes = fourBit ? (static_cast<std::size_t>(value) + 1) / 2 : static_cast<std::size_t>(value);
+            if (position + literalBytes > size) {
+                return false;
+            }
+            for (int i = 0; i < value; ++i) {
+                const std::uint8_t byte = data[position + (fourBit ? i / 2 : i)];
+                put(static_cast<std::uint8_t>(fourBit ? ((i & 1) ? byte & 0x0F : byte >> 4) : byte));
+            }
+            // Literal runs are padded to a 16-bit boundary
+            position += (literalBytes + 1) & ~std::size_t(1);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+ImageBuffer decodeBmp(const std::uint8_t* data, std::size_t size, std::string* errorMessage) {
+    if (!data || size < kFileHeaderSize + 4 || data[0] != 'B' || data[1] != 'M') {
+        setError(errorMessage, "BMP signature is missing.");
+        return {};
+    }
+
+    const std::uint32_t pixelOffset = readLittleEndian32(data + 10);
+    const std::uint32_t headerSize = readLittleEndian32(data + kFileHeaderSize);
+    if (headerSize < kCoreHeaderSize || headerSize > size - kFileHeaderSize
+        || (headerSize != kCoreHeaderSize && headerSize < kInfoHeaderSize)) {
+        setError(errorMessage, "BMP header is invalid.");
+        return {};
+    }
+
+    const std::uint8_t* header = data + kFileHeaderSize;
+    const bool core = headerSize == kCoreHeaderSize;
+    std::int64_t width = 0;
+    std::int64_t height = 0;
+    int bitsPerPixel = 0;
+    std::uint32_t compression = CompressionRgb;
+    std::uint32_t colorsUsed = 0;
+    if (core) {
+        width = readLittleEndian16(header + 4);
+        height = readLittleEndian16(header + 6);
+        bitsPerPixel = readLittleEndian16(header + 10);
+    } else {
+        width = static_cast<std::int32_t>(readLittleEndian32(header + 4));
+        height = static_cast<std::int32_t>(readLittleEndian32(header + 8));
+        bitsPerPixel = readLittleEndian16(header + 14);
+        compression = readLittleEndian32(header + 16);
+        colorsUsed = readLittleEndian32(header + 32);
+    }
+
+    const bool topDown = height < 0;
+    height = std::llabs(height);
+    if (width <= 0 || height <= 0 || width > std::numeric_limits<int>::max() || height > std::numeric_limits<int>::max()
+        || !imageDimensionsAreSafe(static_cast<int>(width), static_cast<int>(height))) {
+        setError(errorMessage, "Image dimensions are too large.");
+        return {};
+    }
+
+    const bool rle = compression == CompressionRle8 || compression == CompressionRle4;
+    const bool validDepth = (bitsPerPixel == 1 || bitsPerPixel == 4 || bitsPerPixel == 8 || bitsPerPixel == 16
+                             || bitsPerPixel == 24 || bitsPerPixel == 32);
+    const bool validCompression = compression == CompressionRgb
+        || (compression == CompressionRle8 && bitsPerPixel == 8)
+        || (compression == CompressionRle4 && bitsPerPixel == 4)
+        || ((compression == CompressionBitFields || compression == CompressionAlphaBitFields)
+            && (bitsPerPixel == 16 || bitsPerPixel == 32));
+    if (!validDepth || !validCompression || (rle && topDown)) {
+        setError(errorMessage, "BMP uses an unsupported pixel format.");
+        return {};
+    }
+
+    // Masks live inside V2+ headers, or directly after a plain info header
+    std::size_t tableOffset = kFileHeaderSize + headerSize;
+    Channel red;
+    Channel green;
+    Channel blue;
+    Channel alpha;
+    if (compression == CompressionBitFields || compression == CompressionAlphaBitFields) {
+        const std::size_t maskCount = compression == CompressionAlphaBitFields ? 4 : 3;
+        const std::uint8_t* masks = header + kInfoHeaderSize;
+        if (headerSize == kInfoHeaderSize) {
+            if (tableOffset + maskCount * 4 > size) {
+                setError(errorMessage, "BMP header is truncated.");
+                return {};
+            }
+            tableOffset += maskCount * 4;
+        } else if (headerSize < kInfoHeaderSize + maskCount * 4) {
+            setError(errorMessage, "BMP header is truncated.");
+            return {};
+        }
+        red = Channel(readLittleEndian32(masks));
+        green = Channel(readLittleEndian32(masks + 4));
+        blue = Channel(readLittleEndian32(masks + 8));
+        if (maskCount == 4 || headerSize >= kInfoHeaderSize + 16) {
+            alpha = Channel(readLittleEndian32(masks + 12));
+        }
+    } else if (bitsPerPixel == 16) {
+        red = Channel(0x7C00);
+        green = Channel(0x03E0);
+        blue = Channel(0x001F);
+    } else if (bitsPerPixel == 32) {
+        red = Channel(0x00FF0000);
+        green = Channel(0x0000FF00);
+        blue = Channel(0x000000FF);
+        alpha = Channel(0xFF000000);
+    }
+
+    Rgba8 palette[256];
+    for (Rgba8& entry : palette) {
+        entry = {0, 0, 0, 255};
+    }
+    if (bitsPerPixel <= 8) {
+        const std::size_t entrySize = core ? 3 : 4;
+        std::size_t entryCount = colorsUsed == 0 || colorsUsed > (1U << bitsPerPixel) ? (1U << bitsPerPixel) : colorsUsed;
+        if (tableOffset < size) {
+            entryCount = std::min(entryCount, (size - tableOffset) / entrySize);
+        } else {
+            entryCount = 0;
+        }
+        for (std::size_t i = 0; i < entryCount; ++i) {
+            const std::uint8_t* entry = data + tableOffset + i * entrySize;
+            palette[i] = {entry[2], entry[1], entry[0], 255};
+        }
+    }
+
+    if (pixelOffset >= size) {
+        setError(errorMessage, "BMP pixel data is missing.");
+        return {};
+    }
+    const std::uint8_t* pixels = data + pixelOffset;
+    const std::size_t available = size - pixelOffset;
+
+    ImageBuffer image;
+    image.width = static_cast<int>(width);
+    image.height = static_cast<int>(height);
+    image.pixels.resize(checkedPixelCount(image.width, image.height));
+
+    if (rle) {
+        std::vector<std::uint8_t> indices;
+        if (!decodeRle(pixels, available, image.width, image.height, compression == CompressionRle4, indices)) {
+            setError(errorMessage, "BMP RLE data is corrupt.");
+            return {};
+        }
+        for (int y = 0; y < image.height; ++y) {
+            const std::uint8_t* sourceRow = indices.data() + static_cast<std::size_t>(image.height - 1 - y) * image.width;
+            Rgba8* destination = image.pixels.data() + static_cast<std::size_t>(y) * image.width;
+            for (int x = 0; x < image.width; ++x) {
+                destination[x] = palette[sourceRow[x]];
+            }
+        }
+        return image;
+    }
+
+    const std::size_t stride = ((static_cast<std::size_t>(image.width) * bitsPerPixel + 31) / 32) * 4;
+    if (stride > available / static_cast<std::size_t>(image.height)) {
+        setError(errorMessage, "BMP pixel data is truncated.");
+        return {};
+    }
+
+    bool anyAlpha = false;
+    for (int y = 0; y < image.height; ++y) {
+        const std::uint8_t* sourceRow = pixels + static_cast<std::size_t>(topDown ? y : image.height - 1 - y) * stride;
+        Rgba8* destination = image.pixels.data() + static_cast<std::size_t>(y) * image.width;
+        for (int x = 0; x < image.width; ++x) {
+            Rgba8 pixel;
+            switch (bitsPerPixel) {
+            case 1:
+            case 4:
+            case 8: {
+                const int bitOffset = x * bitsPerPixel;
+                const int shift = 8 - bitsPerPixel - (bitOffset & 7);
+                pixel = palette[(sourceRow[bitOffset >> 3] >> shift) & ((1 << bitsPerPixel) - 1)];
+                break;
+            }
+            case 24: {
+                const std::uint8_t* source = sourceRow + x * 3;
+                pixel = {source[2], source[1], source[0], 255};
+                break;
+            }
+            default: {
+                const std::uint32_t value = bitsPerPixel == 16
+                    ? readLittleEndian16(sourceRow + x * 2)
+                    : readLittleEndian32(sourceRow + x * 4);
+                pixel = {red.extract(value, 0), green.extract(value, 0), blue.extract(value, 0), alpha.extract(value, 255)};
+                anyAlpha = anyAlpha || pixel.a != 0;
+                break;
+            }
+            }
+            destination[x] = pixel;
+        }
+    }
+
+    // Plain 32 bpp files usually leave the padding byte at zero; only honour it as alpha when
+    // something actually uses it
+    if (bitsPerPixel == 32 && alpha.mask != 0 && !anyAlpha) {
+        for (Rgba8& pixel : image.pixels) {
+            pixel.a = 255;
+        }
+    }
+    return image;
+}
+
+bool encodeBmp(const ImageView& image, std::vector<std::uint8_t>& output, std::string* errorMessage) {
+    output.clear();
+    if (!isValidView(image)) {
+        setError(errorMessage, "Image is invalid.");
+        return false;
+    }
+
+    const std::size_t pixelBytes = checkedPixelCount(image.width, image.height) * 4U;
+    const std::size_t fileSize = kFileHeaderSize + kV4HeaderSize + pixelBytes;
+    if (fileSize > std::numeric_limits<std::uint32_t>::max()) {
+        setError(errorMessage, "Image is too large for BMP.");
+        return false;
+    }
+    output.reserve(fileSize);
+
+    output.push_back('B');
+    output.push_back('M');
+    appendLittleEndian32(output, static_cast<std::uint32_t>(fileSize));
+    appendLittleEndian32(output, 0);
+    appendLittleEndian32(output, static_cast<std::uint32_t>(kFileHeaderSize + kV4HeaderSize));
+
+    appendLittleEndian32(output, kV4HeaderSize);
+    appendLittleEndian32(output, static_cast<std::uint32_t>(image.width));
+    appendLittleEndian32(output, static_cast<std::uint32_t>(image.height));
+    appendLittleEndian16(output, 1);
+    appendLittleEndian16(output, 32);
+    appendLittleEndian32(output, CompressionBitFields);
+    appendLittleEndian32(output, static_cast<std::uint32_t>(pixelBytes));
+    appendLittleEndian32(output, 2835);
+    appendLittleEndian32(output, 2835);
+    appendLittleEndian32(output, 0);
+    appendLittleEndian32(output, 0);
+    appendLittleEndian32(output, 0x00FF0000);
+    appendLittleEndian32(output, 0x0000FF00);
+    appendLittleEndian32(output, 0x000000FF);
+    appendLittleEndian32(output, 0xFF000000);
+    appendLittleEndian32(output, 0x73524742); // 'sRGB'
+    output.resize(kFileHeaderSize + kV4HeaderSize, 0);
+
+    for (int y = image.height - 1; y >= 0; --y) {
+        const Rgba8* row = image.row(y);
+        for (int x = 0; x < image.width; ++x) {
+            output.push_back(row[x].b);
+            output.push_back(row[x].g);
+            output.push_back(row[x].r);
+            output.push_back(row[x].a);
+        }
+    }
+    return true;
+}
+
+} // namespace Lumorpha
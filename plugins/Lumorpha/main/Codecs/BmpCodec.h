@@ -0,0 +1,29 @@
+//-------------------------------------------------------------------------------------
+// BmpCodec.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LUMORPHA_BMP_CODEC_H
+#define LUMORPHA_BMP_CODEC_H
+
+#include "../Core/ImageBuffer.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Lumorpha {
+
+// OS/2 core and Windows info through V5 headers; 1/4/8/16/24/32 bpp, bit fields and RLE4/RLE8.
+ImageBuffer decodeBmp(const std::uint8_t* data, std::size_t size, std::string* errorMessage);
+
+// Writes a 32 bpp bottom-up bitmap with a V4 header so the alpha channel survives.
+bool encodeBmp(const ImageView& image, std::vector<std::uint8_t>& output, std::string* errorMessage);
+
+} // namespace Lumorpha
+
+#endif // LUMORPHA_BMP_CODEC_H
@@ -11,6 +11,10 @@
 //-------------------------------------------------------------------------------------
 #include "ImageCodec.h"
 
+#include "BmpCodec.h"
+#include "JpegCodec.h"
+#include "PngCodec.h"
+
 #include "DirectXTex.h"
 
 #include <algorithm>
@@ -24,6 +28,12 @@
 #include <wincodec.h>
 #endif
 
+// PNG, JPEG and BMP go through WIC unless the build sets LUMORPHA_PORTABLE_CODECS (the CMake
+// option defaults on outside Windows); the built-in codecs never touch a ScratchImage.
+#if !defined(_WIN32) && !defined(LUMORPHA_PORTABLE_CODECS)
+#error "Lumorpha needs LUMORPHA_PORTABLE_CODECS on platforms without WIC."
+#endif
+
 namespace Lumorpha {
 
 namespace {
@@ -229,8 +239,8 @@ ImageBuffer imageBufferFromDirectXImage(const DirectX::Image& source, std::strin
     return result;
 }
 
-bool imageToDirectXBytes(const ImageBuffer& image, std::vector<std::uint8_t>& output) {
-    if (!isValidImage(image)) {
+bool imageToDirectXBytes(const ImageView& image, std::vector<std::uint8_t>& output) {
+    if (!isValidView(image)) {
         return false;
     }
 
@@ -240,12 +250,9 @@ bool imageToDirectXBytes(const ImageBuffer& image, std::vector<std::uint8_t>& ou
     }
 
     output.resize(pixelCount * 4U);
-    for (std::size_t i = 0; i < pixelCount; ++i) {
-        const Rgba8 pixel = image.pixels[i];
-        output[i * 4U + 0U] = pixel.r;
-        output[i * 4U + 1U] = pixel.g;
-        output[i * 4U + 2U] = pixel.b;
-        output[i * 4U + 3U] = pixel.a;
+    const std::size_t rowBytes = static_cast<std::size_t>(image.width) * sizeof(Rgba8);
+    for (int y = 0; y < image.height; ++y) {
+        std::memcpy(output.data() + static_cast<std::size_t>(y) * rowBytes, image.row(y), rowBytes);
     }
     return true;
 }
@@ -294,6 +301,19 @@ ImageBuffer decodeImage(const std::uint8_t* data, std::size_t size, ImageFormat
         return {};
     }
 
+#ifdef LUMORPHA_PORTABLE_CODECS
+    switch (hint == ImageFormat::Auto ? detectFormat(data, size) : hint) {
+    case ImageFormat::Png:
+        return decodePng(data, size, errorMessage);
+    case ImageFormat::Jpeg:
+        return decodeJpeg(data, size, errorMessage);
+    case ImageFormat::Bmp:
+        return decodeBmp(data, size, errorMessage);
+    default:
+        break;
+    }
+#endif
+
 #ifdef _WIN32
     if (!ensureComInitialized(errorMessage)) {
         return {};
@@ -320,9 +340,17 @@ ImageBuffer decodeImage(const std::uint8_t* data, std::size_t size, ImageFormat
     return imageBufferFromDirectXImage(*image, errorMessage);
 }
 
-bool encodeImage(const ImageBuffer& image, ImageFormat format, std::vector<std::uint8_t>& output, std::string* errorMessage) {
+bool encodeImage(const ImageView& image, ImageFormat format, std::vector<std::uint8_t>& output, std::string* errorMessage) {
+    return encodeImage(image, format, TextureOptions{}, output, errorMessage);
+}
+
+bool encodeImage(const ImageView& image,
+                 ImageFormat format,
+                 const TextureOptions& textureOptions,
+                 std::vector<std::uint8_t>& output,
+                 std::string* errorMessage) {
     output.clear();
-    if (!isValidImage(image)) {
+    if (!isValidView(image)) {
         if (errorMessage) {
             *errorMessage = "Image is invalid.";
         }
@@ -332,6 +360,19 @@ bool encodeImage(const ImageBuffer& image, ImageFormat format, std::vector<std::
         format = ImageFormat::Png;
     }
 
+    if (format == ImageFormat::Dds) {
+        return encodeDdsTexture(image, textureOptions, output, errorMessage);
+    }
+
+#ifdef LUMORPHA_PORTABLE_CODECS
+    if (format == ImageFormat::Png) {
+        return encodePng(image, output, errorMessage);
+    }
+    if (format == ImageFormat::Bmp) {
+        return encodeBmp(image, output, errorMessage);
+    }
+#endif
+
 #ifdef _WIN32
     if (!ensureComInitialized(errorMessage)) {
         return false;
@@ -361,9 +402,6 @@ bool encodeImage(const ImageBuffer& image, ImageFormat format, std::vector<std::
     case ImageFormat::Tga:
         hr = DirectX::SaveToTGAMemory(directImage, DirectX::TGA_FLAGS_NONE, blob);
         break;
-    case ImageFormat::Dds:
-        hr = DirectX::SaveToDDSMemory(directImage, DirectX::DDS_FLAGS_NONE, blob);
-        break;
 #ifdef _WIN32
     case ImageFormat::Png:
     case ImageFormat::Jpeg:
@@ -406,8 +444,14 @@ bool encodeImage(const ImageBuffer& image, ImageFormat format, std::vector<std::
 }
 
 const char* supportedFormatsJson() {
+#ifdef _WIN32
     return "{\"decode\":[\"png\",\"jpeg\",\"bmp\",\"tiff\",\"gif\",\"tga\",\"dds\",\"hdr\"],"
            "\"encode\":[\"png\",\"jpeg\",\"bmp\",\"tiff\",\"gif\",\"tga\",\"dds\"],"
+#else
+    return "{\"decode\":[\"png\",\"jpeg\",\"bmp\",\"tga\",\"dds\",\"hdr\"],"
+           "\"encode\":[\"png\",\"bmp\",\"tga\",\"dds\"],"
+#endif
+           "\"ddsCompression\":[\"none\",\"bc1\",\"bc3\",\"bc7\"],"
            "\"pixelFormat\":\"rgba8\","
            "\"resizeFilters\":[\"auto\",\"nearest\",\"linear\",\"cubic\",\"box\",\"triangle\",\"lanczos3\"]}";
 }
@@ -10,6 +10,7 @@
 #define LUMORPHA_IMAGE_CODEC_H
 
 #include "../Core/ImageBuffer.h"
+#include "TextureCodec.h"
 
 #include <cstdint>
 #include <cstddef>
@@ -31,7 +32,13 @@ enum class ImageFormat : std::uint32_t {
 };
 
 ImageBuffer decodeImage(const std::uint8_t* data, std::size_t size, ImageFormat hint, std::string* errorMessage);
-bool encodeImage(const ImageBuffer& image, ImageFormat format, std::vector<std::uint8_t>& output, std::string* errorMessage);
+bool encodeImage(const ImageView& image, ImageFormat format, std::vector<std::uint8_t>& output, std::string* errorMessage);
+// Texture options only apply to DDS output; every other format ignores them.
+bool encodeImage(const ImageView& image,
+                 ImageFormat format,
+                 const TextureOptions& textureOptions,
+                 std::vector<std::uint8_t>& output,
+                 std::string* errorMessage);
 const char* supportedFormatsJson();
 
 } // namespace Lumorpha
@@ -0,0 +1,942 @@
+//-------------------------------------------------------------------------------------
+// JpegCodec.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "JpegCodec.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace Lumorpha {
+
+namespace {
+
+constexpr int kFastBits = 9;
+constexpr int kMaxComponents = 3;
+
+// Zigzag position to natural position. The tail absorbs out-of-range indices from corrupt
+// streams the way libjpeg does.
+constexpr std::uint8_t kNaturalOrder[64 + 16] = {
+    0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+    63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63
+};
+
+// AAN scale factors: cos(k * pi / 16) * sqrt(2) for k > 0
+constexpr float kAanScale[8] = {
+    1.0f, 1.387039845f, 1.306562965f, 1.175875602f, 1.0f, 0.785694958f, 0.541196100f, 0.275899379f
+};
+
+void setError(std::string* errorMessage, const char* message) {
+    if (errorMessage) {
+        *errorMessage = message;
+    }
+}
+
+std::uint16_t readBigEndian16(const std::uint8_t* data) {
+    return static_cast<std::uint16_t>((data[0] << 8) | data[1]);
+}
+
+std::uint8_t clampSample(int value) {
+    return static_cast<std::uint8_t>(std::clamp(value, 0, 255));
+}
+
+// Entropy-coded segment reader: most significant bit first, with 0xFF00 unstuffed. At a marker
+// (or the end of the data) it feeds zeros and stays put so the caller can find the marker.
+class BitReader {
+public:
+    BitReader(const std::uint8_t* data, std::size_t size, std::size_t position)
+        : m_data(data), m_size(size), m_position(position) {
+    }
+
+    void refill() {
+        while (m_count <= 56) {
+            std::uint32_t byte = 0;
+            if (!m_atMarker && m_position < m_size) {
+                byte = m_data[m_position];
+                if (byte != 0xFF) {
+                    ++m_position;
+                } else if (m_position + 1 < m_size && m_data[m_position + 1] == 0x00) {
+                    m_position += 2;
+                } else {
+                    m_atMarker = true;
+                    byte = 0;
+                }
+            }
+            m_bits |= static_cast<std::uint64_t>(byte) << (56 - m_count);
+            m_count += 8;
+        }
+    }
+
+    std::uint32_t peek(int count) {
+        refill();
+        return static_cast<std::uint32_t>(m_bits >> (64 - count));
+    }
+
+    void consume(int count) {
+        m_bits <<= count;
+        m_count -= count;
+    }
+
+    std::uint32_t read(int count) {
+        if (count == 0) {
+            return 0;
+        }
+        const std::uint32_t value = peek(count);
+        consume(count);
+        return value;
+    }
+
+    // JPEG stores a magnitude category followed by that many bits; a leading zero bit means
+    // the value is negative.
+    int receiveExtend(int count) {
+        if (count == 0) {
+            return 0;
+        }
+        const int value = static_cast<int>(read(count));
+        return value < (1 << (count - 1)) ? value - (1 << count) + 1 : value;
+    }
+
+    // Drops buffered bits and steps over the next RSTn marker.
+    void restart() {
+        m_bits = 0;
+        m_count = 0;
+        m_atMarker = false;
+        while (m_position + 1 < m_size) {
+            if (m_data[m_position] == 0xFF && m_data[m_position + 1] >= 0xD0 && m_data[m_position + 1] <= 0xD7) {
+                m_position += 2;
+                return;
+            }
+            if (m_data[m_position] == 0xFF && m_data[m_position + 1] != 0x00 && m_data[m_position + 1] != 0xFF) {
+                return;
+            }
+            ++m_position;
+        }
+    }
+
+    std::size_t position() const {
+        return m_position;
+    }
+
+private:
+    const std::uint8_t* m_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_position = 0;
+    std::uint64_t m_bits = 0;
+    int m_count = 0;
+    bool m_atMarker = false;
+};
+
+struct HuffmanTable {
+    bool present = false;
+    std::array<std::uint16_t, 1 << kFastBits> fast{};
+    std::array<std::int32_t, 18> limit{};
+    std::array<std::int32_t, 17> offset{};
+    std::array<std::uint8_t, 256> values{};
+
+    bool build(const std::uint8_t* counts, const std::uint8_t* symbols, int total) {
+        fast.fill(0);
+        std::copy(symbols, symbols + total, values.begin());
+        std::int32_t code = 0;
+        int index = 0;
+        for (int length = 1; length <= 16; ++length) {
+            offset[static_cast<std::size_t>(length)] = index - code;
+            for (int i = 0; i < counts[length - 1]; ++i, ++index, ++code) {
+                if (code >= (1 << length)) {
+                    return false;
+                }
+                if (length <= kFastBits) {
+                    const int shift = kFastBits - length;
+                    const std::uint16_t entry = static_cast<std::uint16_t>((length << 8) | values[static_cast<std::size_t>(index)]);
+                    std::fill_n(fast.begin() + (code << shift), 1 << shift, entry);
+                }
+            }
+            limit[static_cast<std::size_t>(length)] = code;
+            code <<= 1;
+        }
+        present = true;
+        return true;
+    }
+
+    int decode(BitReader& reader) const {
+        const std::uint32_t bits = reader.peek(16);
+        const std::uint16_t entry = fast[bits >> (16 - kFastBits)];
+        if (entry != 0) {
+            reader.consume(entry >> 8);
+            return entry & 0xFF;
+        }
+        for (int length = kFastBits + 1; length <= 16; ++length) {
+            const auto code = static_cast<std::int32_t>(bits >> (16 - length));
+            if (code < limit[static_cast<std::size_t>(length)]) {
+                reader.consume(length);
+                return values[static_cast<std::size_t>(code + offset[static_cast<std::size_t>(length)])];
+            }
+        }
+        return -1;
+    }
+};
+
+struct Component {
+    int id = 0;
+    int horizontal = 1;
+    int vertical = 1;
+    int quantTable = 0;
+    int dcTable = 0;
+    int acTable = 0;
+    int width = 0;
+    int height = 0;
+    int blocksPerLine = 0;
+    int blocksPerColumn = 0;
+    int dcPredictor = 0;
+    std::vector<std::int16_t> coefficients;
+    std::vector<std::uint8_t> samples;
+};
+
+struct Decoder {
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+
+    // Quantisation tables in natural order, pre-multiplied by the AAN scale factors
+    std::array<std::array<float, 64>, 4> dequantTables{};
+    std::array<HuffmanTable, 4> dcTables;
+    std::array<HuffmanTable, 4> acTables;
+    std::array<Component, kMaxComponents> components;
+    int componentCount = 0;
+    int width = 0;
+    int height = 0;
+    int maxHorizontal = 1;
+    int maxVertical = 1;
+    int mcusPerLine = 0;
+    int mcusPerColumn = 0;
+    bool progressive = false;
+    bool frameSeen = false;
+    int restartInterval = 0;
+    int adobeTransform = -1;
+    int eobRun = 0;
+    std::string error;
+
+    bool readFrame(const std::uint8_t* segment, std::size_t length);
+    bool readScan(const std::uint8_t* segment, std::size_t length, std::size_t& position);
+    bool decodeBlockBaseline(BitReader& reader, Component& component, int blockRow, int blockColumn);
+    bool decodeBlockProgressive(BitReader& reader,
+                                Component& component,
+                                int blockRow,
+                                int blockColumn,
+                                int spectralStart,
+                                int spectralEnd,
+                                int approximationHigh,
+                                int approximationLow);
+    void idctBlock(Component& component, const std::int16_t* block, int blockRow, int blockColumn);
+    ImageBuffer output();
+};
+
+// Separable AAN float inverse DCT with dequantisation folded into the first pass, as in
+// libjpeg's jidctflt.c.
+void inverseDct(const std::int16_t* block, const float* multipliers, std::uint8_t* output, int stride) {
+    float workspace[64];
+    for (int column = 0; column < 8; ++column) {
+        const std::int16_t* in = block + column;
+        const float* quant = multipliers + column;
+        float* ws = workspace + column;
+        if (in[8] == 0 && in[16] == 0 && in[24] == 0 && in[32] == 0 && in[40] == 0 && in[48] == 0 && in[56] == 0) {
+            const float dc = in[0] * quant[0];
+            for (int row = 0; row < 8; ++row) {
+                ws[row * 8] = dc;
+            }
+            continue;
+        }
+
+        float tmp0 = in[0] * quant[0];
+        float tmp1 = in[16] * quant[16];
+        float tmp2 = in[32] * quant[32];
+        float tmp3 = in[48] * quant[48];
+        float tmp10 = tmp0 + tmp2;
+        float tmp11 = tmp0 - tmp2;
+        float tmp13 = tmp1 + tmp3;
+        float tmp12 = (tmp1 - tmp3) * 1.414213562f - tmp13;
+        tmp0 = tmp10 + tmp13;
+        tmp3 = tmp10 - tmp13;
+        tmp1 = tmp11 + tmp12;
+        tmp2 = tmp11 - tmp12;
+
+        float tmp4 = in[8] * quant[8];
+        float tmp5 = in[24] * quant[24];
+        float tmp6 = in[40] * quant[40];
+        float tmp7 = in[56] * quant[56];
+        const float z13 = tmp6 + tmp5;
+        const float z10 = tmp6 - tmp5;
+        const float z11 = tmp4 + tmp7;
+        const float z12 = tmp4 - tmp7;
+        tmp7 = z11 + z13;
+        tmp11 = (z11 - z13) * 1.414213562f;
+        const float z5 = (z10 + z12) * 1.847759065f;
+        tmp10 = z5 - z12 * 1.082392200f;
+        tmp12 = z5 - z10 * 2.613125930f;
+        tmp6 = tmp12 - tmp7;
+        tmp5 = tmp11 - tmp6;
+        tmp4 = tmp10 - tmp5;
+
+        ws[0] = tmp0 + tmp7;
+        ws[56] = tmp0 - tmp7;
+        ws[8] = tmp1 + tmp6;
+        ws[48] = tmp1 - tmp6;
+        ws[16] = tmp2 + tmp5;
+        ws[40] = tmp2 - tmp5;
+        ws[24] = tmp3 + tmp4;
+        ws[32] = tmp3 - tmp4;
+    }
+
+    for (int row = 0; row < 8; ++row) {
+        const float* ws = workspace + row * 8;
+        std::uint8_t* out = output + static_cast<std::ptrdiff_t>(row) * stride;
+
+        float tmp10 = ws[0] + ws[4];
+        float tmp11 = ws[0] - ws[4];
+        float tmp13 = ws[2] + ws[6];
+        float tmp12 = (ws[2] - ws[6]) * 1.414213562f - tmp13;
+        const float tmp0 = tmp10 + tmp13;
+        const float tmp3 = tmp10 - tmp13;
+        const float tmp1 = tmp11 + tmp12;
+        const float tmp2 = tmp11 - tmp12;
+
+        const float z13 = ws[5] + ws[3];
+        const float z10 = ws[5] - ws[3];
+        const float z11 = ws[1] + ws[7];
+        const float z12 = ws[1] - ws[7];
+        const float tmp7 = z11 + z13;
+        tmp11 = (z11 - z13) * 1.414213562f;
+        const float z5 = (z10 + z12) * 1.847759065f;
+        tmp10 = z5 - z12 * 1.082392200f;
+        tmp12 = z5 - z10 * 2.613125930f;
+        const float tmp6 = tmp12 - tmp7;
+        const float tmp5 = tmp11 - tmp6;
+        const float tmp4 = tmp10 - tmp5;
+
+        // The two 1-D passes leave a factor of 8; fold it out together with the level shift
+        auto store = [](float value) {
+            return clampSample(static_cast<int>(value * 0.125f + 128.5f));
+        };
+        out[0] = store(tmp0 + tmp7);
+        out[7] = store(tmp0 - tmp7);
+        out[1] = store(tmp1 + tmp6);
+        out[6] = store(tmp1 - tmp6);
+        out[2] = store(tmp2 + tmp5);
+        out[5] = store(tmp2 - tmp5);
+        out[3] = store(tmp3 + tmp4);
+        out[4] = store(tmp3 - tmp4);
+    }
+}
+
+bool Decoder::readFrame(const std::uint8_t* segment, std::size_t length) {
+    if (frameSeen) {
+        error = "JPEG has more than one frame.";
+        return false;
+    }
+    if (length < 6) {
+        error = "JPEG frame header is truncated.";
+        return false;
+    }
+    if (segment[0] != 8) {
+        error = "Only 8-bit JPEG samples are supported.";
+        return false;
+    }
+    height = readBigEndian16(segment + 1);
+    width = readBigEndian16(segment + 3);
+    componentCount = segment[5];
+    if (componentCount != 1 && componentCount != 3) {
+        error = "Only greyscale and three-component JPEG images are supported.";
+        return false;
+    }
+    if (length < 6 + static_cast<std::size_t>(componentCount) * 3) {
+        error = "JPEG frame header is truncated.";
+        return false;
+    }
+    if (height == 0 || !imageDimensionsAreSafe(width, height)) {
+        error = "Image dimensions are too large.";
+        return false;
+    }
+
+    for (int i = 0; i < componentCount; ++i) {
+        const std::uint8_t* entry = segment + 6 + i * 3;
+        Component& component = components[static_cast<std::size_t>(i)];
+        component.id = entry[0];
+        component.horizontal = entry[1] >> 4;
+        component.vertical = entry[1] & 0x0F;
+        component.quantTable = entry[2];
+        if (component.horizontal < 1 || component.horizontal > 4 || component.vertical < 1 || component.vertical > 4
+            || component.quantTable > 3) {
+            error = "JPEG frame header is invalid.";
+            return false;
+        }
+        maxHorizontal = std::max(maxHorizontal, component.horizontal);
+        maxVertical = std::max(maxVertical, component.vertical);
+    }
+
+    mcusPerLine = (width + 8 * maxHorizontal - 1) / (8 * maxHorizontal);
+    mcusPerColumn = (height + 8 * maxVertical - 1) / (8 * maxVertical);
+    for (int i = 0; i < componentCount; ++i) {
+        Component& component = components[static_cast<std::size_t>(i)];
+        component.width = (width * component.horizontal + maxHorizontal - 1) / maxHorizontal;
+        component.height = (height * component.vertical + maxVertical - 1) / maxVertical;
+        component.blocksPerLine = mcusPerLine * component.horizontal;
+        component.blocksPerColumn = mcusPerColumn * component.vertical;
+        const std::size_t blockCount = static_cast<std::size_t>(component.blocksPerLine) * component.blocksPerColumn;
+        component.samples.assign(blockCount * 64, 0);
+        if (progressive) {
+            component.coefficients.assign(blockCount * 64, 0);
+        }
+    }
+    frameSeen = true;
+    return true;
+}
+
+bool Decoder::decodeBlockBaseline(BitReader& reader, Component& component, int blockRow, int blockColumn) {
+    std::int16_t block[64] = {};
+    const int category = dcTables[static_cast<std::size_t>(component.dcTable)].decode(reader);
+    if (category < 0 || category > 11) {
+        return false;
+    }
+    component.dcPredictor += reader.receiveExtend(category);
+    block[0] = static_cast<std::int16_t>(component.dcPredictor);
+
+    const HuffmanTable& ac = acTables[static_cast<std::size_t>(component.acTable)];
+    for (int k = 1; k < 64; ++k) {
+        const int symbol = ac.decode(reader);
+        if (symbol < 0) {
+            return false;
+        }
+        const int run = symbol >> 4;
+        const int magnitude = symbol & 15;
+        if (magnitude == 0) {
+            if (run != 15) {
+                break;
+            }
+            k += 15;
+            continue;
+        }
+        k += run;
+        if (k > 63) {
+            return false;
+        }
+        block[kNaturalOrder[k]] = static_cast<std::int16_t>(reader.receiveExtend(magnitude));
+    }
+
+    idctBlock(component, block, blockRow, blockColumn);
+    return true;
+}
+
+bool Decoder::decodeBlockProgressive(BitReader& reader,
+                                     Component& component,
+                                     int blockRow,
+                                     int blockColumn,
+                                     int spectralStart,
+                                     int spectralEnd,
+                                     int approximationHigh,
+                                     int approximationLow) {
+    std::int16_t* block = component.coefficients.data()
+        + (static_cast<std::size_t>(blockRow) * component.blocksPerLine + blockColumn) * 64;
+
+    if (spectralStart == 0) {
+        if (approximationHigh == 0) {
+            const int category = dcTables[static_cast<std::size_t>(component.dcTable)].decode(reader);
+            if (category < 0 || category > 11) {
+                return false;
+            }
+            component.dcPredictor += reader.receiveExtend(category);
+            block[0] = static_cast<std::int16_t>(component.dcPredictor * (1 << approximationLow));
+        } else if (reader.read(1) != 0) {
+            block[0] = static_cast<std::int16_t>(block[0] | (1 << approximationLow));
+        }
+        return true;
+    }
+
+    const HuffmanTable& ac = acTables[static_cast<std::size_t>(component.acTable)];
+    if (approximationHigh == 0) {
+        if (eobRun > 0) {
+            --eobRun;
+            return true;
+        }
+        for (int k = spectralStart; k <= spectralEnd; ++k) {
+            const int symbol = ac.decode(reader);
+            if (symbol < 0) {
+                return false;
+            }
+            const int run = symbol >> 4;
+            const int magnitude = symbol & 15;
+            if (magnitude == 0) {
+                if (run != 15) {
+                    eobRun = (1 << run) - 1;
+                    if (run != 0) {
+                        eobRun += static_cast<int>(reader.read(run));
+                    }
+                    break;
+                }
+                k += 15;
+                continue;
+            }
+            k += run;
+            if (k > 63) {
+                return false;
+            }
+            block[kNaturalOrder[k]] = static_cast<std::int16_t>(reader.receiveExtend(magnitude) * (1 << approximationLow));
+        }
+        return true;
+    }
+
+    // Refinement: one new bit for every coefficient that is already non-zero, plus newly
+    // non-zero coefficients of magnitude one (libjpeg's decode_mcu_AC_refine)
+    const int positive = 1 << approximationLow;
+    const int negative = -1 * (1 << approximationLow);
+    auto refine = [&](std::int16_t& coefficient) {
+        if (reader.read(1) != 0 && (coefficient & positive) == 0) {
+            coefficient = static_cast<std::int16_t>(coefficient + (coefficient >= 0 ? positive : negative));
+        }
+    };
+
+    int k = spectralStart;
+    if (eobRun == 0) {
+        for (; k <= spectralEnd; ++k) {
+            const int symbol = ac.decode(reader);
+            if (symbol < 0) {
+                return false;
+            }
+            int run = symbol >> 4;
+            int value = 0;
+            if ((symbol & 15) != 0) {
+                value = reader.read(1) != 0 ? positive : negative;
+            } else if (run != 15) {
+                eobRun = 1 << run;
+                if (run != 0) {
+                    eobRun += static_cast<int>(reader.read(run));
+                }
+                break;
+            }
+
+            while (k <= spectralEnd) {
+                std::int16_t& coefficient = block[kNaturalOrder[k]];
+                if (coefficient != 0) {
+                    refine(coefficient);
+                } else if (--run < 0) {
+                    break;
+                }
+                ++k;
+            }
+            if (value != 0 && k <= spectralEnd) {
+                block[kNaturalOrder[k]] = static_cast<std::int16_t>(value);
+            }
+        }
+    }
+
+    if (eobRun > 0) {
+        for (; k <= spectralEnd; ++k) {
+            std::int16_t& coefficient = block[kNaturalOrder[k]];
+            if (coefficient != 0) {
+                refine(coefficient);
+            }
+        }
+        --eobRun;
+    }
+    return true;
+}
+
+void Decoder::idctBlock(Component& component, const std::int16_t* block, int blockRow, int blockColumn) {
+    const int stride = component.blocksPerLine * 8;
+    std::uint8_t* output = component.samples.data()
+        + static_cast<std::size_t>(blockRow) * 8 * stride + static_cast<std::size_t>(blockColumn) * 8;
+    inverseDct(block, dequantTables[static_cast<std::size_t>(component.quantTable)].data(), output, stride);
+}
+
+bool Decoder::readScan(const std::uint8_t* segment, std::size_t length, std::size_t& position) {
+    if (!frameSeen || length < 1) {
+        error = "JPEG scan appears before the frame header.";
+        return false;
+    }
+    const int scanCount = segment[0];
+    if (scanCount < 1 || scanCount > componentCount || length < 4 + static_cast<std::size_t>(scanCount) * 2) {
+        error = "JPEG scan header is invalid.";
+        return false;
+    }
+
+    std::array<Component*, kMaxComponents> scanComponents{};
+    for (int i = 0; i < scanCount; ++i) {
+        const int id = segment[1 + i * 2];
+        const int tables = segment[2 + i * 2];
+        Component* match = nullptr;
+        for (int c = 0; c < componentCount; ++c) {
+            if (components[static_cast<std::size_t>(c)].id == id) {
+                match = &components[static_cast<std::size_t>(c)];
+            }
+        }
+        if (!match || (tables >> 4) > 3 || (tables & 15) > 3) {
+            error = "JPEG scan header is invalid.";
+            return false;
+        }
+        match->dcTable = tables >> 4;
+        match->acTable = tables & 15;
+        match->dcPredictor = 0;
+        scanComponents[static_cast<std::size_t>(i)] = match;
+    }
+
+    const std::uint8_t* spectral = segment + 1 + scanCount * 2;
+    const int spectralStart = progressive ? spectral[0] : 0;
+    const int spectralEnd = progressive ? spectral[1] : 63;
+    const int approximationHigh = progressive ? spectral[2] >> 4 : 0;
+    const int approximationLow = progressive ? spectral[2] & 15 : 0;
+    if (progressive && (spectralEnd > 63 || spectralStart > spectralEnd || (spectralStart == 0 && spectralEnd != 0)
+                        || (spectralStart > 0 && scanCount != 1) || approximationLow > 13)) {
+        error = "JPEG progressive scan parameters are invalid.";
+        return false;
+    }
+    for (int i = 0; i < scanCount; ++i) {
+        const Component& component = *scanComponents[static_cast<std::size_t>(i)];
+        const bool needsDc = spectralStart == 0 && approximationHigh == 0;
+        const bool needsAc = spectralEnd > 0;
+        if ((needsDc && !dcTables[static_cast<std::size_t>(component.dcTable)].present)
+            || (needsAc && !acTables[static_cast<std::size_t>(component.acTable)].present)) {
+            error = "JPEG scan references a missing Huffman table.";
+            return false;
+        }
+    }
+
+    BitReader reader(data, size, position);
+    eobRun = 0;
+    auto decodeBlock = [&](Component& component, int blockRow, int blockColumn) {
+        return progressive
+            ? decodeBlockProgressive(reader, component, blockRow, blockColumn,
+                                     spectralStart, spectralEnd, approximationHigh, approximationLow)
+            : decodeBlockBaseline(reader, component, blockRow, blockColumn);
+    };
+
+    // A single-component scan walks that component's own blocks; several components go MCU
+    // by MCU
+    int unitsPerLine = mcusPerLine;
+    int unitsPerColumn = mcusPerColumn;
+    if (scanCount == 1) {
+        unitsPerLine = (scanComponents[0]->width + 7) / 8;
+        unitsPerColumn = (scanComponents[0]->height + 7) / 8;
+    }
+
+    int restartsLeft = restartInterval;
+    for (int unitY = 0; unitY < unitsPerColumn; ++unitY) {
+        for (int unitX = 0; unitX < unitsPerLine; ++unitX) {
+            if (restartInterval > 0) {
+                if (restartsLeft == 0) {
+                    reader.restart();
+                    restartsLeft = restartInterval;
+                    eobRun = 0;
+                    for (int i = 0; i < scanCount; ++i) {
+                        scanComponents[static_cast<std::size_t>(i)]->dcPredictor = 0;
+                    }
+                }
+                --restartsLeft;
+            }
+
+            bool ok = true;
+            if (scanCount == 1) {
+                ok = decodeBlock(*scanComponents[0], unitY, unitX);
+            } else {
+                for (int i = 0; i < scanCount && ok; ++i) {
+                    Component& component = *scanComponents[static_cast<std::size_t>(i)];
+                    for (int y = 0; y < component.vertical && ok; ++y) {
+                        for (int x = 0; x < component.horizontal && ok; ++x) {
+                            ok = decodeBlock(component, unitY * component.vertical + y, unitX * component.horizontal + x);
+                        }
+                    }
+                }
+            }
+            if (!ok) {
+                error = "JPEG entropy-coded data is corrupt.";
+                return false;
+            }
+        }
+    }
+
+    // Continue at the next marker other than a trailing restart
+    position = reader.position();
+    while (position + 1 < size) {
+        const std::uint8_t next = data[position + 1];
+        if (data[position] == 0xFF && next != 0x00 && next != 0xFF && (next < 0xD0 || next > 0xD7)) {
+            break;
+        }
+        ++position;
+    }
+    return true;
+}
+
+// Centre-aligned bilinear upsampling of a subsampled plane, the same triangle filter libjpeg's
+// fancy upsampling applies to 2:1 chroma.
+struct UpsampleTap {
+    int first = 0;
+    int second = 0;
+    int weight = 0;
+};
+
+std::vector<UpsampleTap> upsampleTaps(int outputSize, int sourceSize, int factor, int maxFactor) {
+    std::vector<UpsampleTap> taps(static_cast<std::size_t>(outputSize));
+    for (int i = 0; i < outputSize; ++i) {
+        const float position = (static_cast<float>(i) + 0.5f) * static_cast<float>(factor) / static_cast<float>(maxFactor) - 0.5f;
+        const int base = static_cast<int>(std::floor(position));
+        const float fraction = position - static_cast<float>(base);
+        UpsampleTap& tap = taps[static_cast<std::size_t>(i)];
+        tap.first = std::clamp(base, 0, sourceSize - 1);
+        tap.second = std::clamp(base + 1, 0, sourceSize - 1);
+        tap.weight = static_cast<int>(fraction * 256.0f + 0.5f);
+    }
+    return taps;
+}
+
+ImageBuffer Decoder::output() {
+    if (progressive) {
+        for (int c = 0; c < componentCount; ++c) {
+            Component& component = components[static_cast<std::size_t>(c)];
+            for (int row = 0; row < component.blocksPerColumn; ++row) {
+                for (int column = 0; column < component.blocksPerLine; ++column) {
+                    const std::int16_t* block = component.coefficients.data()
+                        + (static_cast<std::size_t>(row) * component.blocksPerLine + column) * 64;
+                    idctBlock(component, block, row, column);
+                }
+            }
+            component.coefficients.clear();
+            component.coefficients.shrink_to_fit();
+        }
+    }
+
+    // Bring every plane to full resolution, then colour-convert row by row
+    std::array<std::vector<std::uint8_t>, kMaxComponents> fullPlanes;
+    std::array<const std::uint8_t*, kMaxComponents> planes{};
+    std::array<int, kMaxComponents> strides{};
+    for (int c = 0; c < componentCount; ++c) {
+        Component& component = components[static_cast<std::size_t>(c)];
+        if (component.horizontal == maxHorizontal && component.vertical == maxVertical) {
+            planes[static_cast<std::size_t>(c)] = component.samples.data();
+            strides[static_cast<std::size_t>(c)] = component.blocksPerLine * 8;
+            continue;
+        }
+
+        const std::vector<UpsampleTap> columns = upsampleTaps(width, component.width, component.horizontal, maxHorizontal);
+        const std::vector<UpsampleTap> rows = upsampleTaps(height, component.height, component.vertical, maxVertical);
+        const int sourceStride = component.blocksPerLine * 8;
+        std::vector<std::uint8_t>& plane = fullPlanes[static_cast<std::size_t>(c)];
+        plane.resize(static_cast<std::size_t>(width) * height);
+        std::vector<int> blended(static_cast<std::size_t>(component.width));
+        for (int y = 0; y < height; ++y) {
+            const UpsampleTap& rowTap = rows[static_cast<std::size_t>(y)];
+            const std::uint8_t* top = component.samples.data() + static_cast<std::size_t>(rowTap.first) * sourceStride;
+            const std::uint8_t* bottom = component.samples.data() + static_cast<std::size_t>(rowTap.second) * sourceStride;
+            for (int x = 0; x < component.width; ++x) {
+                blended[static_cast<std::size_t>(x)] = top[x] * (256 - rowTap.weight) + bottom[x] * rowTap.weight;
+            }
+            std::uint8_t* out = plane.data() + static_cast<std::size_t>(y) * width;
+            for (int x = 0; x < width; ++x) {
+                const UpsampleTap& columnTap = columns[static_cast<std::size_t>(x)];
+                const int value = blended[static_cast<std::size_t>(columnTap.first)] * (256 - columnTap.weight)
+                    + blended[static_cast<std::size_t>(columnTap.second)] * columnTap.weight;
+                out[x] = static_cast<std::uint8_t>((value + 32768) >> 16);
+            }
+        }
+        component.samples.clear();
+        component.samples.shrink_to_fit();
+        planes[static_cast<std::size_t>(c)] = plane.data();
+        strides[static_cast<std::size_t>(c)] = width;
+    }
+
+    ImageBuffer image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(checkedPixelCount(width, height));
+
+    // Three components are YCbCr unless an Adobe marker or R/G/B ids say otherwise
+    const bool rgb = componentCount == 3
+        && (adobeTransform == 0
+            || (adobeTransform < 0 && components[0].id == 'R' && components[1].id == 'G' && components[2].id == 'B'));
+    for (int y = 0; y < height; ++y) {
+        Rgba8* out = image.pixels.data() + static_cast<std::size_t>(y) * width;
+        const std::uint8_t* first = planes[0] + static_cast<std::size_t>(y) * strides[0];
+        if (componentCount == 1) {
+            for (int x = 0; x < width; ++x) {
+                out[x] = {first[x], first[x], first[x], 255};
+            }
+            continue;
+        }
+
+        const std::uint8_t* second = planes[1] + static_cast<std::size_t>(y) * strides[1];
+        const std::uint8_t* third = planes[2] + static_cast<std::size_t>(y) * strides[2];
+        if (rgb) {
+            for (int x = 0; x < width; ++x) {
+                out[x] = {first[x], second[x], third[x], 255};
+            }
+            continue;
+        }
+
+        // JFIF YCbCr with libjpeg's 16-bit fixed-point coefficients
+        for (int x = 0; x < width; ++x) {
+            const int luma = first[x];
+            const int cb = second[x] - 128;
+            const int cr = third[x] - 128;
+            out[x] = {
+                clampSample(luma + ((91881 * cr + 32768) >> 16)),
+                clampSample(luma + ((-22554 * cb - 46802 * cr + 32768) >> 16)),
+                clampSample(luma + ((116130 * cb + 32768) >> 16)),
+                255
+            };
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+ImageBuffer decodeJpeg(const std::uint8_t* data, std::size_t size, std::string* errorMessage) {
+    if (!data || size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        setError(errorMessage, "JPEG signature is missing.");
+        return {};
+    }
+
+    Decoder decoder;
+    decoder.data = data;
+    decoder.size = size;
+    bool sawScan = false;
+    std::size_t position = 2;
+    while (position + 1 < size) {
+        if (data[position] != 0xFF) {
+            ++position;
+            continue;
+        }
+        const std::uint8_t marker = data[position + 1];
+        if (marker == 0xFF) {
+            ++position;
+            continue;
+        }
+        position += 2;
+        if (marker == 0xD9) {
+            break;
+        }
+        if (marker == 0x00 || marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+            continue;
+        }
+
+        if (position + 2 > size) {
+            break;
+        }
+        const std::size_t length = readBigEndian16(data + position);
+        if (length < 2 || position + length > size) {
+            setError(errorMessage, "JPEG segment is truncated.");
+            return {};
+        }
+        const std::uint8_t* segment = data + position + 2;
+        const std::size_t segmentLength = length - 2;
+        position += length;
+
+        bool ok = true;
+        switch (marker) {
+        case 0xC0:
+        case 0xC1:
+        case 0xC2:
+            decoder.progressive = marker == 0xC2;
+            ok = decoder.readFrame(segment, segmentLength);
+            break;
+        case 0xC3:
+        case 0xC5:
+        case 0xC6:
+        case 0xC7:
+        case 0xC9:
+        case 0xCA:
+        case 0xCB:
+        case 0xCD:
+        case 0xCE:
+        case 0xCF:
+            decoder.error = "Lossless, hierarchical and arithmetic-coded JPEG are not supported.";
+            ok = false;
+            break;
+        case 0xC4: {
+            std::size_t offset = 0;
+            while (ok && offset + 17 <= segmentLength) {
+                const int tableClass = segment[offset] >> 4;
+                const int tableIndex = segment[offset] & 15;
+                int total = 0;
+                for (int i = 0; i < 16; ++i) {
+                    total += segment[offset + 1 + i];
+                }
+                if (tableClass > 1 || tableIndex > 3 || total > 256 || offset + 17 + total > segmentLength) {
+                    ok = false;
+                    break;
+                }
+                HuffmanTable& table = tableClass == 0
+                    ? decoder.dcTables[static_cast<std::size_t>(tableIndex)]
+                    : decoder.acTables[static_cast<std::size_t>(tableIndex)];
+                ok = table.build(segment + offset + 1, segment + offset + 17, total);
+                offset += 17 + static_cast<std::size_t>(total);
+            }
+            if (!ok) {
+                decoder.error = "JPEG Huffman table is invalid.";
+            }
+            break;
+        }
+        case 0xDB: {
+            std::size_t offset = 0;
+            while (ok && offset < segmentLength) {
+                const int precision = segment[offset] >> 4;
+                const int tableIndex = segment[offset] & 15;
+                const std::size_t tableSize = precision == 0 ? 64 : 128;
+                if (precision > 1 || tableIndex > 3 || offset + 1 + tableSize > segmentLength) {
+                    ok = false;
+                    break;
+                }
+                auto& table = decoder.dequantTables[static_cast<std::size_t>(tableIndex)];
+                for (int i = 0; i < 64; ++i) {
+                    const std::uint8_t* value = segment + offset + 1 + (precision == 0 ? i : i * 2);
+                    const int natural = kNaturalOrder[i];
+                    table[static_cast<std::size_t>(natural)] = static_cast<float>(precision == 0 ? *value : readBigEndian16(value))
+                        * kAanScale[natural / 8] * kAanScale[natural % 8];
+                }
+                offset += 1 + tableSize;
+            }
+            if (!ok) {
+                decoder.error = "JPEG quantisation table is invalid.";
+            }
+            break;
+        }
+        case 0xDD:
+            ok = segmentLength >= 2;
+            if (ok) {
+                decoder.restartInterval = readBigEndian16(segment);
+            } else {
+                decoder.error = "JPEG restart interval is invalid.";
+            }
+            break;
+        case 0xEE:
+            if (segmentLength >= 12 && std::memcmp(segment, "Adobe", 5) == 0) {
+                decoder.adobeTransform = segment[11];
+            }
+            break;
+        case 0xDA:
+            ok = decoder.readScan(segment, segmentLength, position);
+            sawScan = ok;
+            break;
+        default:
+            break;
+        }
+
+        if (!ok) {
+            setError(errorMessage, decoder.error.c_str());
+            return {};
+        }
+    }
+
+    if (!decoder.frameSeen || !sawScan) {
+        setError(errorMessage, "JPEG stream contains no image data.");
+        return {};
+    }
+    return decoder.output();
+}
+
+} // namespace Lumorpha
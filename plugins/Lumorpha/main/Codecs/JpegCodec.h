@@ -0,0 +1,27 @@
+//-------------------------------------------------------------------------------------
+// JpegCodec.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LUMORPHA_JPEG_CODEC_H
+#define LUMORPHA_JPEG_CODEC_H
+
+#include "../Core/ImageBuffer.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace Lumorpha {
+
+// 8-bit baseline and progressive Huffman JPEG with one (grey) or three components, any chroma
+// subsampling and restart intervals. Baseline blocks go straight to the sample planes; only
+// progressive files keep coefficients until the last scan.
+ImageBuffer decodeJpeg(const std::uint8_t* data, std::size_t size, std::string* errorMessage);
+
+} // namespace Lumorpha
+
+#endif // LUMORPHA_JPEG_CODEC_H
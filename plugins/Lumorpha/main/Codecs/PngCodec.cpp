@@ -0,0 +1,526 @@
+//-------------------------------------------------------------------------------------
+// PngCodec.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "PngCodec.h"
+
+#include "ZlibStream.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace Lumorpha {
+
+namespace {
+
+constexpr std::uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+
+enum ColorType : int {
+    Gray = 0,
+    Rgb = 2,
+    Palette = 3,
+    GrayAlpha = 4,
+    RgbAlpha = 6
+};
+
+struct Adam7Pass {
+    int x;
+    int y;
+    int stepX;
+    int stepY;
+};
+
+constexpr Adam7Pass kAdam7Passes[7] = {
+    {0, 0, 8, 8}, {4, 0, 8, 8}, {0, 4, 4, 8}, {2, 0, 4, 4}, {0, 2, 2, 4}, {1, 0, 2, 2}, {0, 1, 1, 2}
+};
+
+struct PngHeader {
+    int width = 0;
+    int height = 0;
+    int bitDepth = 0;
+    int colorType = 0;
+    bool interlaced = false;
+};
+
+struct PngPalette {
+    Rgba8 entries[256];
+    int size = 0;
+    bool hasColorKey = false;
+    std::uint16_t keyRed = 0;
+    std::uint16_t keyGreen = 0;
+    std::uint16_t keyBlue = 0;
+};
+
+void setError(std::string* errorMessage, const char* message) {
+    if (errorMessage) {
+        *errorMessage = message;
+    }
+}
+
+std::uint32_t readBigEndian32(const std::uint8_t* data) {
+    return (std::uint32_t(data[0]) << 24) | (std::uint32_t(data[1]) << 16) | (std::uint32_t(data[2]) << 8) | data[3];
+}
+
+std::uint16_t readBigEndian16(const std::uint8_t* data) {
+    return static_cast<std::uint16_t>((data[0] << 8) | data[1]);
+}
+
+void appendBigEndian32(std::vector<std::uint8_t>& output, std::uint32_t value) {
+    output.push_back(static_cast<std::uint8_t>(value >> 24));
+    output.push_back(static_cast<std::uint8_t>(value >> 16));
+    output.push_back(static_cast<std::uint8_t>(value >> 8));
+    output.push_back(static_cast<std::uint8_t>(value));
+}
+
+int channelCount(int colorType) {
+    switch (colorType) {
+    case Gray:
+    case Palette:
+        return 1;
+    case GrayAlpha:
+        return 2;
+    case Rgb:
+        return 3;
+    case RgbAlpha:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+bool headerIsValid(const PngHeader& header) {
+    switch (header.colorType) {
+    case Gray:
+        return header.bitDepth == 1 || header.bitDepth == 2 || header.bitDepth == 4
+            || header.bitDepth == 8 || header.bitDepth == 16;
+    case Palette:
+        return header.bitDepth == 1 || header.bitDepth == 2 || header.bitDepth == 4 || header.bitDepth == 8;
+    case Rgb:
+    case GrayAlpha:
+    case RgbAlpha:
+        return header.bitDepth == 8 || header.bitDepth == 16;
+    default:
+        return false;
+    }
+}
+
+std::size_t rowBytes(const PngHeader& header, int width) {
+    const std::size_t bits = static_cast<std::size_t>(width) * channelCount(header.colorType) * header.bitDepth;
+    return (bits + 7) / 8;
+}
+
+int passExtent(int size, int start, int step) {
+    return size > start ? (size - start + step - 1) / step : 0;
+}
+
+std::size_t filteredSize(const PngHeader& header) {
+    if (!header.interlaced) {
+        return static_cast<std::size_t>(header.height) * (rowBytes(header, header.width) + 1);
+    }
+    std::size_t total = 0;
+    for (const Adam7Pass& pass : kAdam7Passes) {
+        const int passWidth = passExtent(header.width, pass.x, pass.stepX);
+        const int passHeight = passExtent(header.height, pass.y, pass.stepY);
+        if (passWidth > 0 && passHeight > 0) {
+            total += static_cast<std::size_t>(passHeight) * (rowBytes(header, passWidth) + 1);
+        }
+    }
+    return total;
+}
+
+std::uint8_t paeth(int left, int up, int upLeft) {
+    const int estimate = left + up - upLeft;
+    const int distanceLeft = std::abs(estimate - left);
+    const int distanceUp = std::abs(estimate - up);
+    const int distanceUpLeft = std::abs(estimate - upLeft);
+    if (distanceLeft <= distanceUp && distanceLeft <= distanceUpLeft) {
+        return static_cast<std::uint8_t>(left);
+    }
+    return static_cast<std::uint8_t>(distanceUp <= distanceUpLeft ? up : upLeft);
+}
+
+// previous is all zeros for the first row of a pass
+bool unfilterRow(int filter, std::uint8_t* row, const std::uint8_t* previous, std::size_t length, std::size_t bpp) {
+    switch (filter) {
+    case 0:
+        return true;
+    case 1:
+        for (std::size_t i = bpp; i < length; ++i) {
+            row[i] = static_cast<std::uint8_t>(row[i] + row[i - bpp]);
+        }
+        return true;
+    case 2:
+        for (std::size_t i = 0; i < length; ++i) {
+            row[i] = static_cast<std::uint8_t>(row[i] + previous[i]);
+        }
+        return true;
+    case 3:
+        for (std::size_t i = 0; i < bpp && i < length; ++i) {
+            row[i] = static_cast<std::uint8_t>(row[i] + (previous[i] >> 1));
+        }
+        for (std::size_t i = bpp; i < length; ++i) {
+            row[i] = static_cast<std::uint8_t>(row[i] + ((row[i - bpp] + previous[i]) >> 1));
+        }
+        return true;
+    case 4:
+        for (std::size_t i = 0; i < bpp && i < length; ++i) {
+            row[i] = static_cast<std::uint8_t>(row[i] + previous[i]);
+        }
+        for (std::size_t i = bpp; i < length; ++i) {
+            row[i] = static_cast<std::uint8_t>(row[i] + paeth(row[i - bpp], previous[i], previous[i - bpp]));
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+std::uint16_t sampleAt(const std::uint8_t* row, int index, int bitDepth) {
+    switch (bitDepth) {
+    case 16:
+        return readBigEndian16(row + index * 2);
+    case 8:
+        return row[index];
+    default: {
+        const int bitOffset = index * bitDepth;
+        const int shift = 8 - bitDepth - (bitOffset & 7);
+        return static_cast<std::uint16_t>((row[bitOffset >> 3] >> shift) & ((1 << bitDepth) - 1));
+    }
+    }
+}
+
+std::uint8_t scaleSample(std::uint16_t value, int bitDepth) {
+    switch (bitDepth) {
+    case 1:
+        return value ? 255 : 0;
+    case 2:
+        return static_cast<std::uint8_t>(value * 0x55);
+    case 4:
+        return static_cast<std::uint8_t>(value * 0x11);
+    case 16:
+        return static_cast<std::uint8_t>(value >> 8);
+    default:
+        return static_cast<std::uint8_t>(value);
+    }
+}
+
+// Expands one unfiltered row straight into the destination pixels, `step` apart.
+void expandRow(const PngHeader& header,
+               const PngPalette& palette,
+               const std::uint8_t* row,
+               int count,
+               Rgba8* destination,
+               int step) {
+    const int depth = header.bitDepth;
+    for (int x = 0; x < count; ++x, destination += step) {
+        Rgba8 pixel;
+        switch (header.colorType) {
+        case Gray: {
+            const std::uint16_t gray = sampleAt(row, x, depth);
+            const std::uint8_t value = scaleSample(gray, depth);
+            pixel = {value, value, value, palette.hasColorKey && gray == palette.keyRed ? std::uint8_t(0) : std::uint8_t(255)};
+            break;
+        }
+        case Rgb: {
+            const std::uint16_t red = sampleAt(row, x * 3, depth);
+            const std::uint16_t green = sampleAt(row, x * 3 + 1, depth);
+            const std::uint16_t blue = sampleAt(row, x * 3 + 2, depth);
+            const bool keyed = palette.hasColorKey
+                && red == palette.keyRed && green == palette.keyGreen && blue == palette.keyBlue;
+            pixel = {scaleSample(red, depth), scaleSample(green, depth), scaleSample(blue, depth),
+                     keyed ? std::uint8_t(0) : std::uint8_t(255)};
+            break;
+        }
+        case Palette: {
+            const std::uint16_t index = sampleAt(row, x, depth);
+            pixel = index < palette.size ? palette.entries[index] : Rgba8{0, 0, 0, 255};
+            break;
+        }
+        case GrayAlpha: {
+            const std::uint8_t value = scaleSample(sampleAt(row, x * 2, depth), depth);
+            pixel = {value, value, value, scaleSample(sampleAt(row, x * 2 + 1, depth), depth)};
+            break;
+        }
+        default:
+            pixel = {scaleSample(sampleAt(row, x * 4, depth), depth),
+                     scaleSample(sampleAt(row, x * 4 + 1, depth), depth),
+                     scaleSample(sampleAt(row, x * 4 + 2, depth), depth),
+                     scaleSample(sampleAt(row, x * 4 + 3, depth), depth)};
+            break;
+        }
+        *destination = pixel;
+    }
+}
+
+bool readPass(const PngHeader& header,
+              const PngPalette& palette,
+              std::uint8_t*& filtered,
+              const Adam7Pass& pass,
+              ImageBuffer& image) {
+    const int passWidth = passExtent(header.width, pass.x, pass.stepX);
+    const int passHeight = passExtent(header.height, pass.y, pass.stepY);
+    if (passWidth == 0 || passHeight == 0) {
+        return true;
+    }
+
+    const std::size_t length = rowBytes(header, passWidth);
+    const std::size_t bpp = std::max<std::size_t>(1, static_cast<std::size_t>(channelCount(header.colorType) * header.bitDepth) / 8);
+    const std::vector<std::uint8_t> zeroRow(length, 0);
+    const std::uint8_t* previous = zeroRow.data();
+    for (int passY = 0; passY < passHeight; ++passY) {
+        const int filter = filtered[0];
+        std::uint8_t* row = filtered + 1;
+        if (!unfilterRow(filter, row, previous, length, bpp)) {
+            return false;
+        }
+        const int y = pass.y + passY * pass.stepY;
+        Rgba8* destination = image.pixels.data() + static_cast<std::size_t>(y) * image.width + pass.x;
+        expandRow(header, palette, row, passWidth, destination, pass.stepX);
+        previous = row;
+        filtered += length + 1;
+    }
+    return true;
+}
+
+void appendChunk(std::vector<std::uint8_t>& output, const char* type, const std::uint8_t* data, std::size_t size) {
+    appendBigEndian32(output, static_cast<std::uint32_t>(size));
+    const std::size_t typeOffset = output.size();
+    output.insert(output.end(), type, type + 4);
+    if (size > 0) {
+        output.insert(output.end(), data, data + size);
+    }
+    appendBigEndian32(output, crc32(output.data() + typeOffset, size + 4));
+}
+
+std::uint32_t filterCost(const std::uint8_t* filtered, std::size_t length) {
+    std::uint32_t cost = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+        cost += static_cast<std::uint32_t>(std::abs(static_cast<int>(static_cast<std::int8_t>(filtered[i]))));
+    }
+    return cost;
+}
+
+} // namespace
+
+ImageBuffer decodePng(const std::uint8_t* data, std::size_t size, std::string* errorMessage) {
+    if (!data || size < sizeof(kSignature) || std::memcmp(data, kSignature, sizeof(kSignature)) != 0) {
+        setError(errorMessage, "PNG signature is missing.");
+        return {};
+    }
+
+    PngHeader header;
+    PngPalette palette;
+    std::vector<std::uint8_t> compressed;
+    bool hasHeader = false;
+    bool hasEnd = false;
+    std::size_t position = sizeof(kSignature);
+    while (!hasEnd) {
+        if (size - position < 12) {
+            setError(errorMessage, "PNG stream is truncated.");
+            return {};
+        }
+        const std::uint32_t length = readBigEndian32(data + position);
+        const std::uint8_t* type = data + position + 4;
+        const std::uint8_t* chunk = type + 4;
+        if (length > size - position - 12) {
+            setError(errorMessage, "PNG stream is truncated.");
+            return {};
+        }
+        if (crc32(type, length + 4) != readBigEndian32(chunk + length)) {
+            setError(errorMessage, "PNG chunk checksum does not match.");
+            return {};
+        }
+        position += static_cast<std::size_t>(length) + 12;
+
+        if (std::memcmp(type, "IHDR", 4) == 0) {
+            if (hasHeader || length != 13) {
+                setError(errorMessage, "PNG header is invalid.");
+                return {};
+            }
+            const std::uint32_t width = readBigEndian32(chunk);
+            const std::uint32_t height = readBigEndian32(chunk + 4);
+            header.bitDepth = chunk[8];
+            header.colorType = chunk[9];
+            header.interlaced = chunk[12] == 1;
+            if (width > static_cast<std::uint32_t>(std::numeric_limits<int>::max())
+                || height > static_cast<std::uint32_t>(std::numeric_limits<int>::max())) {
+                setError(errorMessage, "Image dimensions are too large.");
+                return {};
+            }
+            header.width = static_cast<int>(width);
+            header.height = static_cast<int>(height);
+            if (!headerIsValid(header) || chunk[10] != 0 || chunk[11] != 0 || chunk[12] > 1) {
+                setError(errorMessage, "PNG header is invalid.");
+                return {};
+            }
+            if (!imageDimensionsAreSafe(header.width, header.height)) {
+                setError(errorMessage, "Image dimensions are too large.");
+                return {};
+            }
+            hasHeader = true;
+        } else if (!hasHeader) {
+            setError(errorMessage, "PNG header is missing.");
+            return {};
+        } else if (std::memcmp(type, "PLTE", 4) == 0) {
+            if (length % 3 != 0 || length / 3 > 256) {
+                setError(errorMessage, "PNG palette is invalid.");
+                return {};
+            }
+            palette.size = static_cast<int>(length / 3);
+            for (int i = 0; i < palette.size; ++i) {
+                palette.entries[i] = {chunk[i * 3], chunk[i * 3 + 1], chunk[i * 3 + 2], 255};
+            }
+        } else if (std::memcmp(type, "tRNS", 4) == 0) {
+            if (header.colorType == Palette) {
+                for (std::uint32_t i = 0; i < length && i < 256; ++i) {
+                    palette.entries[i].a = chunk[i];
+                }
+            } else if (header.colorType == Gray && length >= 2) {
+                palette.hasColorKey = true;
+                palette.keyRed = readBigEndian16(chunk);
+            } else if (header.colorType == Rgb && length >= 6) {
+                palette.hasColorKey = true;
+                palette.keyRed = readBigEndian16(chunk);
+                palette.keyGreen = readBigEndian16(chunk + 2);
+                palette.keyBlue = readBigEndian16(chunk + 4);
+            }
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            compressed.insert(compressed.end(), chunk, chunk + length);
+        } else if (std::memcmp(type, "IEND", 4) == 0) {
+            hasEnd = true;
+        } else if ((type[0] & 0x20) == 0) {
+            setError(errorMessage, "PNG stream uses an unsupported critical chunk.");
+            return {};
+        }
+    }
+
+    if (header.colorType == Palette && palette.size == 0) {
+        setError(errorMessage, "PNG palette is missing.");
+        return {};
+    }
+
+    const std::size_t expectedSize = filteredSize(header);
+    std::vector<std::uint8_t> filtered;
+    if (!zlibInflate(compressed.data(), compressed.size(), expectedSize, filtered, errorMessage)) {
+        return {};
+    }
+    if (filtered.size() != expectedSize) {
+        setError(errorMessage, "PNG image data is truncated.");
+        return {};
+    }
+
+    ImageBuffer image;
+    image.width = header.width;
+    image.height = header.height;
+    image.pixels.resize(checkedPixelCount(image.width, image.height));
+
+    std::uint8_t* cursor = filtered.data();
+    bool ok = true;
+    if (header.interlaced) {
+        for (const Adam7Pass& pass : kAdam7Passes) {
+            ok = ok && readPass(header, palette, cursor, pass, image);
+        }
+    } else {
+        ok = readPass(header, palette, cursor, {0, 0, 1, 1}, image);
+    }
+    if (!ok) {
+        setError(errorMessage, "PNG row filter is invalid.");
+        return {};
+    }
+    return image;
+}
+
+bool encodePng(const ImageView& image, std::vector<std::uint8_t>& output, std::string* errorMessage) {
+    output.clear();
+    if (!isValidView(image)) {
+        setError(errorMessage, "Image is invalid.");
+        return false;
+    }
+
+    bool opaque = true;
+    for (int y = 0; y < image.height && opaque; ++y) {
+        opaque = std::all_of(image.row(y), image.row(y) + image.width, [](const Rgba8& pixel) {
+            return pixel.a == 255;
+        });
+    }
+    const std::size_t bpp = opaque ? 3 : 4;
+    const std::size_t length = static_cast<std::size_t>(image.width) * bpp;
+
+    // Each row gets whichever filter leaves the smallest sum of absolute differences, the
+    // heuristic libpng uses by default
+    std::vector<std::uint8_t> filtered;
+    filtered.reserve(static_cast<std::size_t>(image.height) * (length + 1));
+    std::vector<std::uint8_t> previous(length, 0);
+    std::vector<std::uint8_t> current(length);
+    std::vector<std::uint8_t> candidates[5];
+    for (auto& candidate : candidates) {
+        candidate.resize(length);
+    }
+
+    for (int y = 0; y < image.height; ++y) {
+        const Rgba8* pixels = image.row(y);
+        for (int x = 0; x < image.width; ++x) {
+            std::uint8_t* out = current.data() + static_cast<std::size_t>(x) * bpp;
+            out[0] = pixels[x].r;
+            out[1] = pixels[x].g;
+            out[2] = pixels[x].b;
+            if (!opaque) {
+                out[3] = pixels[x].a;
+            }
+        }
+
+        for (std::size_t i = 0; i < length; ++i) {
+            const int left = i >= bpp ? current[i - bpp] : 0;
+            const int up = previous[i];
+            const int upLeft = i >= bpp ? previous[i - bpp] : 0;
+            candidates[0][i] = current[i];
+            candidates[1][i] = static_cast<std::uint8_t>(current[i] - left);
+            candidates[2][i] = static_cast<std::uint8_t>(current[i] - up);
+            candidates[3][i] = static_cast<std::uint8_t>(current[i] - ((left + up) >> 1));
+            candidates[4][i] = static_cast<std::uint8_t>(current[i] - paeth(left, up, upLeft));
+        }
+
+        int bestFilter = 0;
+        std::uint32_t bestCost = std::numeric_limits<std::uint32_t>::max();
+        for (int filter = 0; filter < 5; ++filter) {
+            const std::uint32_t cost = filterCost(candidates[filter].data(), length);
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestFilter = filter;
+            }
+        }
+        filtered.push_back(static_cast<std::uint8_t>(bestFilter));
+        filtered.insert(filtered.end(), candidates[bestFilter].begin(), candidates[bestFilter].end());
+        previous.swap(current);
+    }
+
+    std::uint8_t headerData[13];
+    const auto width = static_cast<std::uint32_t>(image.width);
+    const auto height = static_cast<std::uint32_t>(image.height);
+    for (int i = 0; i < 4; ++i) {
+        headerData[i] = static_cast<std::uint8_t>(width >> (24 - i * 8));
+        headerData[4 + i] = static_cast<std::uint8_t>(height >> (24 - i * 8));
+    }
+    headerData[8] = 8;
+    headerData[9] = opaque ? Rgb : RgbAlpha;
+    headerData[10] = 0;
+    headerData[11] = 0;
+    headerData[12] = 0;
+
+    std::vector<std::uint8_t> compressed;
+    zlibDeflate(filtered.data(), filtered.size(), compressed);
+
+    output.insert(output.end(), kSignature, kSignature + sizeof(kSignature));
+    appendChunk(output, "IHDR", headerData, sizeof(headerData));
+    appendChunk(output, "IDAT", compressed.data(), compressed.size());
+    appendChunk(output, "IEND", nullptr, 0);
+    return true;
+}
+
+} // namespace Lumorpha
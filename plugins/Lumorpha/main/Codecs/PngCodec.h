@@ -0,0 +1,29 @@
+//-------------------------------------------------------------------------------------
+// PngCodec.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LUMORPHA_PNG_CODEC_H
+#define LUMORPHA_PNG_CODEC_H
+
+#include "../Core/ImageBuffer.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Lumorpha {
+
+// Every colour type, bit depth and interlace mode. 16-bit samples keep their high byte.
+ImageBuffer decodePng(const std::uint8_t* data, std::size_t size, std::string* errorMessage);
+
+// Writes 8-bit RGB when every pixel is opaque, RGBA otherwise.
+bool encodePng(const ImageView& image, std::vector<std::uint8_t>& output, std::string* errorMessage);
+
+} // namespace Lumorpha
+
+#endif // LUMORPHA_PNG_CODEC_H
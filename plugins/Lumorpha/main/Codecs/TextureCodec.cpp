@@ -0,0 +1,225 @@
+//-------------------------------------------------------------------------------------
+// TextureCodec.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// This file integrates Microsoft DirectXTex without modifying the original
+// DirectXTex source files or removing their original MIT license headers.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "TextureCodec.h"
+
+#include "../Core/WorkerPool.h"
+#include "../Processing/ImageProcessor.h"
+
+#include "DirectXTex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace Lumorpha {
+
+namespace {
+
+// Source bytes one band of block rows may cover, so a worker's rows stay in its own L2
+constexpr std::size_t kBandSourceBytes = 256U * 1024U;
+
+std::string hresultText(HRESULT hr, const char* action) {
+    std::ostringstream stream;
+    stream << action << " failed with HRESULT 0x"
+           << std::hex << std::uppercase << static_cast<unsigned long>(hr) << ".";
+    return stream.str();
+}
+
+void setError(std::string* errorMessage, const std::string& message) {
+    if (errorMessage) {
+        *errorMessage = message;
+    }
+}
+
+DXGI_FORMAT blockFormat(TextureCompression compression) {
+    switch (compression) {
+    case TextureCompression::Bc1:
+        return DXGI_FORMAT_BC1_UNORM;
+    case TextureCompression::Bc3:
+        return DXGI_FORMAT_BC3_UNORM;
+    case TextureCompression::Bc7:
+        return DXGI_FORMAT_BC7_UNORM;
+    case TextureCompression::None:
+    default:
+        return DXGI_FORMAT_R8G8B8A8_UNORM;
+    }
+}
+
+DirectX::TEX_COMPRESS_FLAGS compressFlags(const TextureOptions& options) {
+    if (options.compression == TextureCompression::Bc7) {
+        switch (options.quality) {
+        case TextureQuality::Fast:
+            return DirectX::TEX_COMPRESS_BC7_QUICK;
+        case TextureQuality::Best:
+            return DirectX::TEX_COMPRESS_BC7_USE_3SUBSETS;
+        case TextureQuality::Balanced:
+        default:
+            return DirectX::TEX_COMPRESS_DEFAULT;
+        }
+    }
+    // The BC1/BC3 encoder has a single speed; dithering is the only quality knob it offers
+    return options.quality == TextureQuality::Best ? DirectX::TEX_COMPRESS_DITHER : DirectX::TEX_COMPRESS_DEFAULT;
+}
+
+std::size_t mipLevelCount(int width, int height) {
+    std::size_t levels = 1;
+    for (int size = std::max(width, height); size > 1; size /= 2) {
+        ++levels;
+    }
+    return levels;
+}
+
+MutableImageView levelView(const DirectX::Image& level) {
+    return {reinterpret_cast<Rgba8*>(level.pixels),
+            static_cast<int>(level.width),
+            static_cast<int>(level.height),
+            level.rowPitch / sizeof(Rgba8)};
+}
+
+// Level 0 is the source; each further level is a box-filtered half of the one before it
+bool buildMipChain(const ImageView& image,
+                   std::size_t levelCount,
+                   DirectX::ScratchImage& chain,
+                   std::string* errorMessage) {
+    const HRESULT hr = chain.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM,
+                                          static_cast<std::size_t>(image.width),
+                                          static_cast<std::size_t>(image.height),
+                                          1,
+                                          levelCount);
+    if (FAILED(hr)) {
+        setError(errorMessage, hresultText(hr, "Texture allocation"));
+        return false;
+    }
+
+    copyPixels(image, levelView(*chain.GetImage(0, 0, 0)));
+    for (std::size_t level = 1; level < levelCount; ++level) {
+        const MutableImageView previous = levelView(*chain.GetImage(level - 1, 0, 0));
+        if (!resizeImageInto(previous, levelView(*chain.GetImage(level, 0, 0)), ResizeFilter::Box)) {
+            setError(errorMessage, "Failed to generate texture mip levels.");
+            return false;
+        }
+    }
+    return true;
+}
+
+// Compresses one level into destination, which already has the level's block layout. Bands of
+// whole block rows are handed out through the shared worker pool, so cores that draw flat bands pick
+// up more of them; each band is compressed on its own and its block rows copied into place.
+HRESULT compressLevel(const DirectX::Image& source,
+                      const DirectX::Image& destination,
+                      DirectX::TEX_COMPRESS_FLAGS flags) {
+    const std::size_t blockRows = (source.height + 3U) / 4U;
+    const std::size_t blockRowSourceBytes = std::max<std::size_t>(source.rowPitch * 4U, 1U);
+    const std::size_t bandBlockRows = std::max<std::size_t>(kBandSourceBytes / blockRowSourceBytes, 1U);
+    const std::size_t bandCount = (blockRows + bandBlockRows - 1U) / bandBlockRows;
+
+    std::atomic<HRESULT> failure{S_OK};
+    parallelFor(bandCount, workerCount(), [&](std::size_t band) {
+        if (FAILED(failure.load())) {
+            return;
+        }
+        const std::size_t firstBlockRow = band * bandBlockRows;
+        const std::size_t bandRows = std::min(bandBlockRows, blockRows - firstBlockRow);
+        const std::size_t firstRow = firstBlockRow * 4U;
+
+        DirectX::Image slice = source;
+        slice.height = std::min(bandRows * 4U, source.height - firstRow);
+        slice.slicePitch = source.rowPitch * slice.height;
+        slice.pixels = source.pixels + firstRow * source.rowPitch;
+
+        DirectX::ScratchImage compressed;
+        const HRESULT hr = DirectX::Compress(slice, destination.format, flags, DirectX::TEX_THRESHOLD_DEFAULT, compressed);
+        const DirectX::Image* blocks = SUCCEEDED(hr) ? compressed.GetImage(0, 0, 0) : nullptr;
+        if (!blocks || blocks->rowPitch != destination.rowPitch) {
+            HRESULT expected = S_OK;
+            failure.compare_exchange_strong(expected, FAILED(hr) ? hr : E_UNEXPECTED);
+            return;
+        }
+        std::memcpy(destination.pixels + firstBlockRow * destination.rowPitch,
+                    blocks->pixels,
+                    bandRows * destination.rowPitch);
+    });
+    return failure.load();
+}
+
+} // namespace
+
+std::uint64_t textureByteSize(int width, int height, const TextureOptions& options) {
+    if (width <= 0 || height <= 0) {
+        return 0;
+    }
+
+    const std::size_t levelCount = options.generateMips ? mipLevelCount(width, height) : 1U;
+    std::uint64_t total = 0;
+    for (std::size_t level = 0; level < levelCount; ++level) {
+        const std::uint64_t levelWidth = static_cast<std::uint64_t>(std::max(1, width >> level));
+        const std::uint64_t levelHeight = static_cast<std::uint64_t>(std::max(1, height >> level));
+        if (options.compression == TextureCompression::None) {
+            total += levelWidth * levelHeight * 4U;
+        } else {
+            const std::uint64_t blockBytes = options.compression == TextureCompression::Bc1 ? 8U : 16U;
+            total += ((levelWidth + 3U) / 4U) * ((levelHeight + 3U) / 4U) * blockBytes;
+        }
+    }
+    return total;
+}
+
+bool encodeDdsTexture(const ImageView& image,
+                      const TextureOptions& options,
+                      std::vector<std::uint8_t>& output,
+                      std::string* errorMessage) {
+    output.clear();
+    if (!isValidView(image)) {
+        setError(errorMessage, "Image is invalid.");
+        return false;
+    }
+
+    const std::size_t levelCount = options.generateMips ? mipLevelCount(image.width, image.height) : 1U;
+    DirectX::ScratchImage levels;
+    if (!buildMipChain(image, levelCount, levels, errorMessage)) {
+        return false;
+    }
+
+    const DirectX::ScratchImage* saved = &levels;
+    DirectX::ScratchImage compressed;
+    if (options.compression != TextureCompression::None) {
+        DirectX::TexMetadata metadata = levels.GetMetadata();
+        metadata.format = blockFormat(options.compression);
+        HRESULT hr = compressed.Initialize(metadata);
+        for (std::size_t level = 0; SUCCEEDED(hr) && level < levelCount; ++level) {
+            hr = compressLevel(*levels.GetImage(level, 0, 0), *compressed.GetImage(level, 0, 0), compressFlags(options));
+        }
+        if (FAILED(hr)) {
+            setError(errorMessage, hresultText(hr, "Texture compression"));
+            return false;
+        }
+        saved = &compressed;
+    }
+
+    DirectX::Blob blob;
+    const HRESULT hr = DirectX::SaveToDDSMemory(saved->GetImages(),
+                                                saved->GetImageCount(),
+                                                saved->GetMetadata(),
+                                                DirectX::DDS_FLAGS_NONE,
+                                                blob);
+    const std::uint8_t* begin = blob.GetConstBufferPointer();
+    if (FAILED(hr) || !begin || blob.GetBufferSize() == 0) {
+        setError(errorMessage, hresultText(hr, "Image encode"));
+        return false;
+    }
+    output.assign(begin, begin + blob.GetBufferSize());
+    return true;
+}
+
+} // namespace Lumorpha
@@ -0,0 +1,54 @@
+//-------------------------------------------------------------------------------------
+// TextureCodec.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LUMORPHA_TEXTURE_CODEC_H
+#define LUMORPHA_TEXTURE_CODEC_H
+
+#include "../Core/ImageBuffer.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Lumorpha {
+
+enum class TextureCompression : std::uint32_t {
+    None = 0,
+    Bc1 = 1,
+    Bc3 = 2,
+    Bc7 = 3
+};
+
+// Fast limits BC7 to mode 6; Best adds the three-subset BC7 modes and dithers BC1/BC3.
+enum class TextureQuality : std::uint32_t {
+    Balanced = 0,
+    Fast = 1,
+    Best = 2
+};
+
+struct TextureOptions {
+    TextureCompression compression = TextureCompression::None;
+    TextureQuality quality = TextureQuality::Balanced;
+    bool generateMips = false;
+};
+
+// Bytes the texture's surfaces take once uploaded, every mip level included; what it costs in
+// VRAM before any driver padding.
+std::uint64_t textureByteSize(int width, int height, const TextureOptions& options);
+
+// Writes a DDS file, optionally with a box-filtered mip chain down to 1x1. Block compression
+// runs over bands of block rows shared out between cores; every block is encoded on its own, so
+// the bytes match a single-threaded compress of the same level.
+bool encodeDdsTexture(const ImageView& image,
+                      const TextureOptions& options,
+                      std::vector<std::uint8_t>& output,
+                      std::string* errorMessage);
+
+} // namespace Lumorpha
+
+#endif // LUMORPHA_TEXTURE_CODEC_H
@@ -0,0 +1,562 @@
+//-------------------------------------------------------------------------------------
+// ZlibStream.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "ZlibStream.h"
+
+#include <algorithm>
+#include <array>
+
+namespace Lumorpha {
+
+namespace {
+
+constexpr int kFastBits = 10;
+constexpr int kMaxCodeLength = 15;
+constexpr std::size_t kWindowSize = 32768;
+constexpr int kMinMatch = 3;
+constexpr int kMaxMatch = 258;
+constexpr int kMaxChain = 64;
+constexpr int kHashBits = 15;
+
+constexpr std::uint16_t kLengthBase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+constexpr std::uint8_t kLengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+constexpr std::uint16_t kDistanceBase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+constexpr std::uint8_t kDistanceExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+constexpr std::uint8_t kCodeLengthOrder[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+void setError(std::string* errorMessage, const char* message) {
+    if (errorMessage) {
+        *errorMessage = message;
+    }
+}
+
+std::uint32_t adler32(const std::uint8_t* data, std::size_t size) {
+    constexpr std::uint32_t kModulus = 65521;
+    // 5552 is the longest run whose sums cannot overflow 32 bits before the modulo
+    constexpr std::size_t kBlock = 5552;
+    std::uint32_t a = 1;
+    std::uint32_t b = 0;
+    while (size > 0) {
+        const std::size_t block = std::min(size, kBlock);
+        for (std::size_t i = 0; i < block; ++i) {
+            a += data[i];
+            b += a;
+        }
+        a %= kModulus;
+        b %= kModulus;
+        data += block;
+        size -= block;
+    }
+    return (b << 16) | a;
+}
+
+std::uint32_t reverseBits(std::uint32_t value, int length) {
+    std::uint32_t result = 0;
+    for (int i = 0; i < length; ++i) {
+        result = (result << 1) | (value & 1U);
+        value >>= 1;
+    }
+    return result;
+}
+
+// Reads bits least significant first. Reading past the end yields zeros and is reported by
+// overrun(), so a truncated stream fails instead of reading out of bounds.
+class BitReader {
+public:
+    BitReader(const std::uint8_t* data, std::size_t size)
+        : m_data(data), m_size(size) {
+    }
+
+    void refill() {
+        while (m_count <= 56) {
+            const std::uint64_t byte = m_position < m_size ? m_data[m_position] : 0;
+            ++m_position;
+            m_bits |= byte << m_count;
+            m_count += 8;
+        }
+    }
+
+    std::uint32_t read(int count) {
+        if (count == 0) {
+            return 0;
+        }
+        refill();
+        const auto value = static_cast<std::uint32_t>(m_bits & ((std::uint64_t(1) << count) - 1));
+        consume(count);
+        return value;
+    }
+
+    std::uint64_t bits() const {
+        return m_bits;
+    }
+
+    void consume(int count) {
+        m_bits >>= count;
+        m_count -= count;
+    }
+
+    void alignToByte() {
+        consume(m_count & 7);
+    }
+
+    bool overrun() const {
+        return m_position > m_size && (m_position - m_size) * 8 > static_cast<std::size_t>(m_count);
+    }
+
+private:
+    const std::uint8_t* m_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_position = 0;
+    std::uint64_t m_bits = 0;
+    int m_count = 0;
+};
+
+// Canonical Huffman decoder: codes up to kFastBits long resolve with one table lookup, longer
+// ones walk the per-length counts.
+struct HuffmanTable {
+    std::array<std::uint16_t, 1 << kFastBits> fast{};
+    std::array<std::uint16_t, kMaxCodeLength + 1> counts{};
+    std::array<std::uint16_t, 288> symbols{};
+
+    bool build(const std::uint8_t* lengths, int count) {
+        fast.fill(0);
+        counts.fill(0);
+        for (int symbol = 0; symbol < count; ++symbol) {
+            ++counts[lengths[symbol]];
+        }
+        counts[0] = 0;
+
+        int left = 1;
+        for (int length = 1; length <= kMaxCodeLength; ++length) {
+            left = (left << 1) - counts[static_cast<std::size_t>(length)];
+            if (left < 0) {
+                return false;
+            }
+        }
+
+        std::array<std::uint16_t, kMaxCodeLength + 2> offsets{};
+        for (int length = 1; length <= kMaxCodeLength; ++length) {
+            offsets[static_cast<std::size_t>(length + 1)] =
+                static_cast<std::uint16_t>(offsets[static_cast<std::size_t>(length)] + counts[static_cast<std::size_t>(length)]);
+        }
+        std::array<std::uint32_t, kMaxCodeLength + 1> nextCode{};
+        std::uint32_t code = 0;
+        for (int length = 1; length <= kMaxCodeLength; ++length) {
+            nextCode[static_cast<std::size_t>(length)] = code;
+            code = (code + counts[static_cast<std::size_t>(length)]) << 1;
+        }
+
+        for (int symbol = 0; symbol < count; ++symbol) {
+            const int length = lengths[symbol];
+            if (length == 0) {
+                continue;
+            }
+            symbols[offsets[static_cast<std::size_t>(length)]++] = static_cast<std::uint16_t>(symbol);
+            const std::uint32_t symbolCode = nextCode[static_cast<std::size_t>(length)]++;
+            if (length <= kFastBits) {
+                const std::uint32_t reversed = reverseBits(symbolCode, length);
+                for (std::uint32_t index = reversed; index < fast.size(); index += 1U << length) {
+                    fast[index] = static_cast<std::uint16_t>((symbol << 4) | length);
+                }
+            }
+        }
+        return true;
+    }
+
+    int decode(BitReader& reader) const {
+        reader.refill();
+        const std::uint64_t bits = reader.bits();
+        const std::uint16_t entry = fast[static_cast<std::size_t>(bits & (fast.size() - 1))];
+        if (entry != 0) {
+            reader.consume(entry & 15);
+            return entry >> 4;
+        }
+
+        int code = 0;
+        int first = 0;
+        int index = 0;
+        for (int length = 1; length <= kMaxCodeLength; ++length) {
+            code |= static_cast<int>((bits >> (length - 1)) & 1U);
+            const int count = counts[static_cast<std::size_t>(length)];
+            if (code - first < count) {
+                reader.consume(length);
+                return symbols[static_cast<std::size_t>(index + code - first)];
+            }
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+};
+
+const HuffmanTable& fixedLiteralTable() {
+    static const HuffmanTable table = []() {
+        std::uint8_t lengths[288];
+        std::fill(lengths, lengths + 144, 8);
+        std::fill(lengths + 144, lengths + 256, 9);
+        std::fill(lengths + 256, lengths + 280, 7);
+        std::fill(lengths + 280, lengths + 288, 8);
+        HuffmanTable built;
+        built.build(lengths, 288);
+        return built;
+    }();
+    return table;
+}
+
+const HuffmanTable& fixedDistanceTable() {
+    static const HuffmanTable table = []() {
+        std::uint8_t lengths[30];
+        std::fill(lengths, lengths + 30, 5);
+        HuffmanTable built;
+        built.build(lengths, 30);
+        return built;
+    }();
+    return table;
+}
+
+bool readDynamicTables(BitReader& reader, HuffmanTable& literals, HuffmanTable& distances) {
+    const int literalCount = static_cast<int>(reader.read(5)) + 257;
+    const int distanceCount = static_cast<int>(reader.read(5)) + 1;
+    const int codeLengthCount = static_cast<int>(reader.read(4)) + 4;
+    if (literalCount > 286 || distanceCount > 30) {
+        return false;
+    }
+
+    std::uint8_t codeLengthLengths[19] = {};
+    for (int i = 0; i < codeLengthCount; ++i) {
+        codeLengthLengths[kCodeLengthOrder[i]] = static_cast<std::uint8_t>(reader.read(3));
+    }
+    HuffmanTable codeLengths;
+    if (!codeLengths.build(codeLengthLengths, 19)) {
+        return false;
+    }
+
+    std::uint8_t lengths[286 + 30] = {};
+    int index = 0;
+    while (index < literalCount + distanceCount) {
+        const int symbol = codeLengths.decode(reader);
+        if (symbol < 0 || reader.overrun()) {
+            return false;
+        }
+        if (symbol < 16) {
+            lengths[index++] = static_cast<std::uint8_t>(symbol);
+            continue;
+        }
+
+        int repeat = 0;
+        std::uint8_t value = 0;
+        if (symbol == 16) {
+            if (index == 0) {
+                return false;
+            }
+            value = lengths[index - 1];
+            repeat = 3 + static_cast<int>(reader.read(2));
+        } else if (symbol == 17) {
+            repeat = 3 + static_cast<int>(reader.read(3));
+        } else {
+            repeat = 11 + static_cast<int>(reader.read(7));
+        }
+        if (index + repeat > literalCount + distanceCount) {
+            return false;
+        }
+        std::fill(lengths + index, lengths + index + repeat, value);
+        index += repeat;
+    }
+
+    if (lengths[256] == 0) {
+        return false;
+    }
+    return literals.build(lengths, literalCount) && distances.build(lengths + literalCount, distanceCount);
+}
+
+bool inflateCodes(BitReader& reader,
+                  const HuffmanTable& literals,
+                  const HuffmanTable& distances,
+                  std::size_t start,
+                  std::size_t maxOutputSize,
+                  std::vector<std::uint8_t>& output) {
+    while (true) {
+        const int symbol = literals.decode(reader);
+        if (symbol < 0 || reader.overrun()) {
+            return false;
+        }
+        if (symbol < 256) {
+            if (output.size() - start >= maxOutputSize) {
+                return false;
+            }
+            output.push_back(static_cast<std::uint8_t>(symbol));
+            continue;
+        }
+        if (symbol == 256) {
+            return true;
+        }
+
+        const int lengthIndex = symbol - 257;
+        if (lengthIndex >= 29) {
+            return false;
+        }
+        const std::size_t length = kLengthBase[lengthIndex] + reader.read(kLengthExtra[lengthIndex]);
+        const int distanceIndex = distances.decode(reader);
+        if (distanceIndex < 0 || distanceIndex >= 30) {
+            return false;
+        }
+        const std::size_t distance = kDistanceBase[distanceIndex] + reader.read(kDistanceExtra[distanceIndex]);
+        if (distance > output.size() - start || output.size() - start + length > maxOutputSize) {
+            return false;
+        }
+
+        // Copies may overlap their own output, so go a byte at a time
+        std::size_t from = output.size() - distance;
+        for (std::size_t i = 0; i < length; ++i) {
+            output.push_back(output[from++]);
+        }
+    }
+}
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<std::uint8_t>& output)
+        : m_output(output) {
+    }
+
+    void write(std::uint32_t value, int count) {
+        m_bits |= static_cast<std::uint64_t>(value) << m_count;
+        m_count += count;
+        while (m_count >= 8) {
+            m_output.push_back(static_cast<std::uint8_t>(m_bits));
+            m_bits >>= 8;
+            m_count -= 8;
+        }
+    }
+
+    // Huffman codes are defined most significant bit first
+    void writeCode(std::uint32_t code, int length) {
+        write(reverseBits(code, length), length);
+    }
+
+    void flush() {
+        if (m_count > 0) {
+            m_output.push_back(static_cast<std::uint8_t>(m_bits));
+        }
+        m_bits = 0;
+        m_count = 0;
+    }
+
+private:
+    std::vector<std::uint8_t>& m_output;
+    std::uint64_t m_bits = 0;
+    int m_count = 0;
+};
+
+void writeFixedLiteral(BitWriter& writer, int symbol) {
+    if (symbol < 144) {
+        writer.writeCode(0x30U + static_cast<std::uint32_t>(symbol), 8);
+    } else if (symbol < 256) {
+        writer.writeCode(0x190U + static_cast<std::uint32_t>(symbol - 144), 9);
+    } else if (symbol < 280) {
+        writer.writeCode(static_cast<std::uint32_t>(symbol - 256), 7);
+    } else {
+        writer.writeCode(0xC0U + static_cast<std::uint32_t>(symbol - 280), 8);
+    }
+}
+
+void writeMatch(BitWriter& writer, int length, int distance) {
+    int lengthIndex = 28;
+    while (kLengthBase[lengthIndex] > length) {
+        --lengthIndex;
+    }
+    writeFixedLiteral(writer, 257 + lengthIndex);
+    writer.write(static_cast<std::uint32_t>(length - kLengthBase[lengthIndex]), kLengthExtra[lengthIndex]);
+
+    int distanceIndex = 29;
+    while (kDistanceBase[distanceIndex] > distance) {
+        --distanceIndex;
+    }
+    writer.writeCode(static_cast<std::uint32_t>(distanceIndex), 5);
+    writer.write(static_cast<std::uint32_t>(distance - kDistanceBase[distanceIndex]), kDistanceExtra[distanceIndex]);
+}
+
+std::uint32_t hashAt(const std::uint8_t* data) {
+    const std::uint32_t value = data[0] | (data[1] << 8) | (data[2] << 16);
+    return (value * 2654435761U) >> (32 - kHashBits);
+}
+
+} // namespace
+
+bool zlibInflate(const std::uint8_t* data,
+                 std::size_t size,
+                 std::size_t maxOutputSize,
+                 std::vector<std::uint8_t>& output,
+                 std::string* errorMessage) {
+    if (!data || size < 6) {
+        setError(errorMessage, "Compressed stream is truncated.");
+        return false;
+    }
+    const int method = data[0];
+    const int flags = data[1];
+    if ((method & 0x0F) != 8 || (method >> 4) > 7 || ((method << 8) | flags) % 31 != 0 || (flags & 0x20) != 0) {
+        setError(errorMessage, "Compressed stream has an invalid zlib header.");
+        return false;
+    }
+
+    const std::size_t start = output.size();
+    output.reserve(start + maxOutputSize);
+    BitReader reader(data + 2, size - 2);
+    bool finalBlock = false;
+    while (!finalBlock) {
+        finalBlock = reader.read(1) != 0;
+        const std::uint32_t type = reader.read(2);
+        bool ok = false;
+        if (type == 0) {
+            reader.alignToByte();
+            const std::uint32_t length = reader.read(16);
+            const std::uint32_t inverted = reader.read(16);
+            ok = (length ^ 0xFFFFU) == inverted && output.size() - start + length <= maxOutputSize;
+            for (std::uint32_t i = 0; ok && i < length; ++i) {
+                output.push_back(static_cast<std::uint8_t>(reader.read(8)));
+            }
+        } else if (type == 1) {
+            ok = inflateCodes(reader, fixedLiteralTable(), fixedDistanceTable(), start, maxOutputSize, output);
+        } else if (type == 2) {
+            HuffmanTable literals;
+            HuffmanTable distances;
+            ok = readDynamicTables(reader, literals, distances)
+                && inflateCodes(reader, literals, distances, start, maxOutputSize, output);
+        }
+        if (!ok || reader.overrun()) {
+            setError(errorMessage, "Compressed stream is corrupt.");
+            return false;
+        }
+    }
+
+    reader.alignToByte();
+    std::uint32_t checksum = 0;
+    for (int i = 0; i < 4; ++i) {
+        checksum = (checksum << 8) | reader.read(8);
+    }
+    if (reader.overrun() || checksum != adler32(output.data() + start, output.size() - start)) {
+        setError(errorMessage, "Compressed stream checksum does not match.");
+        return false;
+    }
+    return true;
+}
+
+void zlibDeflate(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& output) {
+    // CMF/FLG: deflate with a 32 KiB window, default level
+    output.push_back(0x78);
+    output.push_back(0x9C);
+
+    BitWriter writer(output);
+    writer.write(1, 1);
+    writer.write(1, 2);
+
+    std::vector<std::int32_t> head(std::size_t(1) << kHashBits, -1);
+    std::vector<std::int32_t> previous(kWindowSize, -1);
+    auto insert = [&](std::size_t position) {
+        const std::uint32_t hash = hashAt(data + position);
+        previous[position & (kWindowSize - 1)] = head[hash];
+        head[hash] = static_cast<std::int32_t>(position);
+    };
+
+    std::size_t position = 0;
+    while (position < size) {
+        int bestLength = 0;
+        std::size_t bestDistance = 0;
+        if (position + kMinMatch <= size) {
+            const std::size_t maxLength = std::min<std::size_t>(kMaxMatch, size - position);
+            std::int32_t candidate = head[hashAt(data + position)];
+            for (int chain = 0; candidate >= 0 && chain < kMaxChain; ++chain) {
+                const std::size_t distance = position - static_cast<std::size_t>(candidate);
+                if (distance > kWindowSize - 1) {
+                    break;
+                }
+                const std::uint8_t* left = data + candidate;
+                const std::uint8_t* right = data + position;
+                if (left[bestLength] == right[bestLength]) {
+                    std::size_t length = 0;
+                    while (length < maxLength && left[length] == right[length]) {
+                        ++length;
+                    }
+                    if (static_cast<int>(length) > bestLength) {
+                        bestLength = static_cast<int>(length);
+                        bestDistance = distance;
+                        if (length == maxLength) {
+                            break;
+                        }
+                    }
+                }
+                const std::int32_t next = previous[static_cast<std::size_t>(candidate) & (kWindowSize - 1)];
+                if (next >= candidate) {
+                    break;
+                }
+                candidate = next;
+            }
+        }
+
+        if (bestLength >= kMinMatch) {
+            writeMatch(writer, bestLength, static_cast<int>(bestDistance));
+            const std::size_t end = position + static_cast<std::size_t>(bestLength);
+            for (; position < end; ++position) {
+                if (position + kMinMatch <= size) {
+                    insert(position);
+                }
+            }
+        } else {
+            writeFixedLiteral(writer, data[position]);
+            if (position + kMinMatch <= size) {
+                insert(position);
+            }
+            ++position;
+        }
+    }
+    writeFixedLiteral(writer, 256);
+    writer.flush();
+
+    const std::uint32_t checksum = adler32(data, size);
+    output.push_back(static_cast<std::uint8_t>(checksum >> 24));
+    output.push_back(static_cast<std::uint8_t>(checksum >> 16));
+    output.push_back(static_cast<std::uint8_t>(checksum >> 8));
+    output.push_back(static_cast<std::uint8_t>(checksum));
+}
+
+std::uint32_t crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc) {
+    static const std::array<std::uint32_t, 256> table = []() {
+        std::array<std::uint32_t, 256> built{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1U) ? 0xEDB88320U ^ (value >> 1) : value >> 1;
+            }
+            built[i] = value;
+        }
+        return built;
+    }();
+
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFFU] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+} // namespace Lumorpha
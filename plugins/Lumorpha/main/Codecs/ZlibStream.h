@@ -0,0 +1,34 @@
+//-------------------------------------------------------------------------------------
+// ZlibStream.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LUMORPHA_ZLIB_STREAM_H
+#define LUMORPHA_ZLIB_STREAM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Lumorpha {
+
+// Inflates a zlib stream (RFC 1950/1951). Output is appended; the stream must not expand past
+// maxOutputSize, which also lets the caller reserve the exact size up front.
+bool zlibInflate(const std::uint8_t* data,
+                 std::size_t size,
+                 std::size_t maxOutputSize,
+                 std::vector<std::uint8_t>& output,
+                 std::string* errorMessage);
+
+// Compresses into a zlib stream using LZ77 with fixed Huffman codes.
+void zlibDeflate(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& output);
+
+std::uint32_t crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0);
+
+} // namespace Lumorpha
+
+#endif // LUMORPHA_ZLIB_STREAM_H
@@ -8,6 +8,7 @@
 //-------------------------------------------------------------------------------------
 #include "ImageBuffer.h"
 
+#include <algorithm>
 #include <limits>
 
 namespace Lumorpha {
@@ -47,4 +48,37 @@ bool isValidImage(const ImageBuffer& image) {
     return image.pixels.size() == checkedPixelCount(image.width, image.height);
 }
 
+bool isValidView(const ImageView& view) {
+    return view.pixels && imageDimensionsAreSafe(view.width, view.height)
+        && view.stride >= static_cast<std::size_t>(view.width);
+}
+
+ImageBuffer makeImage(int width, int height) {
+    if (!imageDimensionsAreSafe(width, height)) {
+        return {};
+    }
+    ImageBuffer image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(checkedPixelCount(width, height));
+    return image;
+}
+
+ImageBuffer copyImage(const ImageView& view) {
+    if (!isValidView(view)) {
+        return {};
+    }
+    ImageBuffer image = makeImage(view.width, view.height);
+    copyPixels(view, image);
+    return image;
+}
+
+void copyPixels(const ImageView& source, const MutableImageView& destination) {
+    const int width = std::min(source.width, destination.width);
+    const int height = std::min(source.height, destination.height);
+    for (int y = 0; y < height; ++y) {
+        std::copy_n(source.row(y), width, destination.row(y));
+    }
+}
+
 } // namespace Lumorpha
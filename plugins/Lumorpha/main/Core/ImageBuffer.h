@@ -22,16 +22,72 @@ struct Rgba8 {
     std::uint8_t a = 0;
 };
 
+// Same layout as the RGBA8 byte rows callers hand in, so their pixels can be viewed in place
+static_assert(sizeof(Rgba8) == 4 && alignof(Rgba8) == 1, "Rgba8 must be four packed bytes");
+
 struct ImageBuffer {
     int width = 0;
     int height = 0;
     std::vector<Rgba8> pixels;
 };
 
+// Non-owning window onto rows of pixels; stride counts pixels from one row to the next, so a
+// crop is the same pixels with a different origin and size.
+struct ImageView {
+    const Rgba8* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    std::size_t stride = 0;
+
+    ImageView() = default;
+    ImageView(const Rgba8* viewPixels, int viewWidth, int viewHeight, std::size_t viewStride)
+        : pixels(viewPixels), width(viewWidth), height(viewHeight), stride(viewStride) {
+    }
+    ImageView(const ImageBuffer& image)
+        : pixels(image.pixels.data()), width(image.width), height(image.height),
+          stride(static_cast<std::size_t>(image.width)) {
+    }
+
+    const Rgba8* row(int y) const {
+        return pixels + static_cast<std::size_t>(y) * stride;
+    }
+};
+
+// Writable counterpart, so results can be produced straight into memory the caller owns.
+struct MutableImageView {
+    Rgba8* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    std::size_t stride = 0;
+
+    MutableImageView() = default;
+    MutableImageView(Rgba8* viewPixels, int viewWidth, int viewHeight, std::size_t viewStride)
+        : pixels(viewPixels), width(viewWidth), height(viewHeight), stride(viewStride) {
+    }
+    MutableImageView(ImageBuffer& image)
+        : pixels(image.pixels.data()), width(image.width), height(image.height),
+          stride(static_cast<std::size_t>(image.width)) {
+    }
+
+    Rgba8* row(int y) const {
+        return pixels + static_cast<std::size_t>(y) * stride;
+    }
+
+    operator ImageView() const {
+        return {pixels, width, height, stride};
+    }
+};
+
 bool isValidImage(const ImageBuffer& image);
+bool isValidView(const ImageView& view);
 bool imageDimensionsAreSafe(int width, int height);
 std::size_t checkedPixelCount(int width, int height);
 
+// Allocates a tightly packed buffer of the given size; empty when the size is unsafe.
+ImageBuffer makeImage(int width, int height);
+ImageBuffer copyImage(const ImageView& view);
+void copyPixels(const ImageView& source, const MutableImageView& destination);
+
 } // namespace Lumorpha
 
 #endif // LUMORPHA_IMAGE_BUFFER_H
@@ -0,0 +1,111 @@
+//-------------------------------------------------------------------------------------
+// ScratchBuffer.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "ScratchBuffer.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Lumorpha {
+
+namespace {
+// A resize holds at most two intermediates and a size set a few pyramid levels more
+constexpr std::size_t kMaxPooledBuffers = 8;
+// Buffers larger than this (64 MiB) go back to the allocator instead of pinning memory
+constexpr std::size_t kMaxPooledPixels = std::size_t(1) << 24;
+
+std::vector<std::vector<Rgba8>>& threadPool() {
+    thread_local std::vector<std::vector<Rgba8>> pool;
+    return pool;
+}
+
+// Best fit: the smallest pooled buffer that already holds pixelCount, else the largest one.
+// Pooled buffers keep their size, so only the part a smaller buffer grows by is filled.
+std::vector<Rgba8> takeFromPool(std::size_t pixelCount) {
+    std::vector<std::vector<Rgba8>>& pool = threadPool();
+    if (pool.empty()) {
+        return {};
+    }
+    auto chosen = pool.end();
+    for (auto it = pool.begin(); it != pool.end(); ++it) {
+        const bool fits = it->size() >= pixelCount;
+        if (chosen == pool.end()) {
+            chosen = it;
+            continue;
+        }
+        const bool chosenFits = chosen->size() >= pixelCount;
+        if (fits && (!chosenFits || it->size() < chosen->size())) {
+            chosen = it;
+        } else if (!fits && !chosenFits && it->size() > chosen->size()) {
+            chosen = it;
+        }
+    }
+    std::vector<Rgba8> pixels = std::move(*chosen);
+    pool.erase(chosen);
+    return pixels;
+}
+} // namespace
+
+ScratchBuffer::ScratchBuffer(int width, int height) {
+    if (!imageDimensionsAreSafe(width, height)) {
+        return;
+    }
+    const std::size_t pixelCount = checkedPixelCount(width, height);
+    m_pixels = takeFromPool(pixelCount);
+    if (m_pixels.size() < pixelCount) {
+        m_pixels.resize(pixelCount);
+    }
+    m_width = width;
+    m_height = height;
+}
+
+ScratchBuffer::~ScratchBuffer() {
+    release();
+}
+
+ScratchBuffer::ScratchBuffer(ScratchBuffer&& other) noexcept
+    : m_pixels(std::move(other.m_pixels)),
+      m_width(std::exchange(other.m_width, 0)),
+      m_height(std::exchange(other.m_height, 0)) {
+}
+
+ScratchBuffer& ScratchBuffer::operator=(ScratchBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_pixels = std::move(other.m_pixels);
+        m_width = std::exchange(other.m_width, 0);
+        m_height = std::exchange(other.m_height, 0);
+    }
+    return *this;
+}
+
+void ScratchBuffer::release() {
+    m_width = 0;
+    m_height = 0;
+    if (m_pixels.capacity() == 0 || m_pixels.capacity() > kMaxPooledPixels) {
+        std::vector<Rgba8>().swap(m_pixels);
+        return;
+    }
+
+    std::vector<std::vector<Rgba8>>& pool = threadPool();
+    if (pool.size() >= kMaxPooledBuffers) {
+        // Keep the larger buffers; they are the expensive ones to fault in again
+        auto smallest = std::min_element(pool.begin(), pool.end(), [](const auto& left, const auto& right) {
+            return left.capacity() < right.capacity();
+        });
+        if (smallest->capacity() >= m_pixels.capacity()) {
+            std::vector<Rgba8>().swap(m_pixels);
+            return;
+        }
+        pool.erase(smallest);
+    }
+    pool.push_back(std::move(m_pixels));
+    m_pixels = {};
+}
+
+} // namespace Lumorpha
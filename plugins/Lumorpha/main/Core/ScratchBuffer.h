@@ -0,0 +1,46 @@
+//-------------------------------------------------------------------------------------
+// ScratchBuffer.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LUMORPHA_SCRATCH_BUFFER_H
+#define LUMORPHA_SCRATCH_BUFFER_H
+
+#include "ImageBuffer.h"
+
+#include <vector>
+
+namespace Lumorpha {
+
+// Intermediate pixel storage borrowed from a per-thread pool and handed back on destruction, so
+// repeated resizes on one thread reuse the same allocations. Pooled buffers keep their size and
+// only grow, so a reused buffer holds stale pixels rather than being cleared.
+class ScratchBuffer {
+public:
+    ScratchBuffer() = default;
+    ScratchBuffer(int width, int height);
+    ~ScratchBuffer();
+
+    ScratchBuffer(ScratchBuffer&& other) noexcept;
+    ScratchBuffer& operator=(ScratchBuffer&& other) noexcept;
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    bool isValid() const { return m_width > 0; }
+    MutableImageView view() { return {m_pixels.data(), m_width, m_height, static_cast<std::size_t>(m_width)}; }
+    ImageView view() const { return {m_pixels.data(), m_width, m_height, static_cast<std::size_t>(m_width)}; }
+
+private:
+    void release();
+
+    std::vector<Rgba8> m_pixels;
+    int m_width = 0;
+    int m_height = 0;
+};
+
+} // namespace Lumorpha
+
+#endif // LUMORPHA_SCRATCH_BUFFER_H
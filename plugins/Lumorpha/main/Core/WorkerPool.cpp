@@ -0,0 +1,135 @@
+//-------------------------------------------------------------------------------------
+// WorkerPool.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Lumorpha {
+
+namespace {
+
+struct Job {
+    const std::function<void(std::size_t)>* function = nullptr;
+    std::size_t count = 0;
+    std::atomic<std::size_t> nextIndex{0};
+    // Helpers still allowed to join, and helpers currently inside drain(); both under the pool mutex
+    std::size_t openSlots = 0;
+    std::size_t activeHelpers = 0;
+
+    void drain() {
+        for (std::size_t index = nextIndex++; index < count; index = nextIndex++) {
+            (*function)(index);
+        }
+    }
+};
+
+class Pool {
+public:
+    Pool() {
+        const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        m_threads.reserve(hardwareThreads - 1);
+        for (unsigned index = 1; index < hardwareThreads; ++index) {
+            m_threads.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    std::size_t helperCount() const { return m_threads.size(); }
+
+    void run(std::size_t count, std::size_t maxWorkers, const std::function<void(std::size_t)>& function) {
+        auto job = std::make_shared<Job>();
+        job->function = &function;
+        job->count = count;
+        bool shared = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            job->openSlots = std::min({maxWorkers - 1, count - 1, m_idle});
+            shared = job->openSlots > 0;
+            if (shared) {
+                m_jobs.push_back(job);
+            }
+        }
+        if (shared) {
+            m_wake.notify_all();
+        }
+
+        job->drain();
+
+        // Close the job so no helper joins late, then wait for the ones already inside it
+        std::unique_lock<std::mutex> lock(m_mutex);
+        job->openSlots = 0;
+        m_jobs.erase(std::remove(m_jobs.begin(), m_jobs.end(), job), m_jobs.end());
+        m_done.wait(lock, [&job]() { return job->activeHelpers == 0; });
+    }
+
+private:
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            ++m_idle;
+            m_wake.wait(lock, [this]() { return !m_jobs.empty(); });
+            --m_idle;
+
+            const std::shared_ptr<Job> job = m_jobs.front();
+            ++job->activeHelpers;
+            if (--job->openSlots == 0) {
+                m_jobs.pop_front();
+            }
+
+            lock.unlock();
+            job->drain();
+            lock.lock();
+
+            if (--job->activeHelpers == 0) {
+                m_done.notify_all();
+            }
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    std::deque<std::shared_ptr<Job>> m_jobs;
+    std::size_t m_idle = 0;
+    std::vector<std::thread> m_threads;
+};
+
+Pool& pool() {
+    // Never destroyed: joining threads while the plugin library unloads can deadlock on Windows,
+    // and the workers only ever sleep between jobs.
+    static Pool* instance = new Pool;
+    return *instance;
+}
+
+} // namespace
+
+void parallelFor(std::size_t count, std::size_t maxWorkers, const std::function<void(std::size_t)>& job) {
+    if (count == 0) {
+        return;
+    }
+    if (count == 1 || maxWorkers <= 1) {
+        for (std::size_t index = 0; index < count; ++index) {
+            job(index);
+        }
+        return;
+    }
+    pool().run(count, maxWorkers, job);
+}
+
+std::size_t workerCount() {
+    return pool().helperCount() + 1;
+}
+
+} // namespace Lumorpha
@@ -0,0 +1,29 @@
+//-------------------------------------------------------------------------------------
+// WorkerPool.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LUMORPHA_WORKER_POOL_H
+#define LUMORPHA_WORKER_POOL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace Lumorpha {
+
+// Calls job(index) for every index in [0, count), using at most maxWorkers threads including the
+// caller. Helpers come from one process-wide pool of hardware_concurrency() - 1 threads, and only
+// idle ones join in, so concurrent callers (e.g. several broker workers) share the cores instead
+// of each starting their own threads. The caller always works through the indices itself and
+// never waits for a helper that has not started, so nested calls cannot deadlock.
+void parallelFor(std::size_t count, std::size_t maxWorkers, const std::function<void(std::size_t)>& job);
+
+// Threads parallelFor can use at most, the caller included.
+std::size_t workerCount();
+
+} // namespace Lumorpha
+
+#endif // LUMORPHA_WORKER_POOL_H
@@ -0,0 +1,282 @@
+//-------------------------------------------------------------------------------------
+// AtlasPacker.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "AtlasPacker.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+
+namespace Lumorpha {
+
+namespace {
+
+// Largest 2D texture Direct3D 11 hardware is required to support
+constexpr int kMaxAtlasPageSize = 16384;
+constexpr int kBlockSize = 4;
+
+void setError(std::string* errorMessage, const char* message) {
+    if (errorMessage) {
+        *errorMessage = message;
+    }
+}
+
+bool isPowerOfTwo(int value) {
+    return value > 0 && (value & (value - 1)) == 0;
+}
+
+int nextPowerOfTwo(int value) {
+    int result = kBlockSize;
+    while (result < value) {
+        result *= 2;
+    }
+    return result;
+}
+
+int roundUpToBlock(int value) {
+    return (value + kBlockSize - 1) / kBlockSize * kBlockSize;
+}
+
+bool contains(const CropRect& outer, const CropRect& inner) {
+    return inner.x >= outer.x
+        && inner.y >= outer.y
+        && inner.x + inner.width <= outer.x + outer.width
+        && inner.y + inner.height <= outer.y + outer.height;
+}
+
+bool intersects(const CropRect& a, const CropRect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+class MaxRectsBin {
+public:
+    MaxRectsBin(int width, int height)
+        : m_freeRects{{0, 0, width, height}} {
+    }
+
+    bool insert(int width, int height, CropRect* outRect) {
+        const CropRect* best = nullptr;
+        int bestShortSide = std::numeric_limits<int>::max();
+        int bestLongSide = std::numeric_limits<int>::max();
+        for (const CropRect& freeRect : m_freeRects) {
+            if (freeRect.width < width || freeRect.height < height) {
+                continue;
+            }
+            const int leftoverX = freeRect.width - width;
+            const int leftoverY = freeRect.height - height;
+            const int shortSide = std::min(leftoverX, leftoverY);
+            const int longSide = std::max(leftoverX, leftoverY);
+            if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+                best = &freeRect;
+                bestShortSide = shortSide;
+                bestLongSide = longSide;
+            }
+        }
+        if (!best) {
+            return false;
+        }
+
+        const CropRect placed{best->x, best->y, width, height};
+        splitFreeRects(placed);
+        pruneFreeRects();
+        *outRect = placed;
+        return true;
+    }
+
+private:
+    // Replaces every free rectangle the placed one overlaps with the (overlapping) maximal
+    // rectangles left around it.
+    void splitFreeRects(const CropRect& placed) {
+        std::vector<CropRect> next;
+        next.reserve(m_freeRects.size() + 4U);
+        for (const CropRect& freeRect : m_freeRects) {
+            if (!intersects(freeRect, placed)) {
+                next.push_back(freeRect);
+                continue;
+            }
+            const int freeRight = freeRect.x + freeRect.width;
+            const int freeBottom = freeRect.y + freeRect.height;
+            const int placedRight = placed.x + placed.width;
+            const int placedBottom = placed.y + placed.height;
+            if (placed.x > freeRect.x) {
+                next.push_back({freeRect.x, freeRect.y, placed.x - freeRect.x, freeRect.height});
+            }
+            if (placedRight < freeRight) {
+                next.push_back({placedRight, freeRect.y, freeRight - placedRight, freeRect.height});
+            }
+            if (placed.y > freeRect.y) {
+                next.push_back({freeRect.x, freeRect.y, freeRect.width, placed.y - freeRect.y});
+            }
+            if (placedBottom < freeBottom) {
+                next.push_back({freeRect.x, placedBottom, freeRect.width, freeBottom - placedBottom});
+            }
+        }
+        m_freeRects = std::move(next);
+    }
+
+    void pruneFreeRects() {
+        for (std::size_t i = 0; i < m_freeRects.size(); ++i) {
+            for (std::size_t j = i + 1; j < m_freeRects.size();) {
+                if (contains(m_freeRects[i], m_freeRects[j])) {
+                    m_freeRects.erase(m_freeRects.begin() + static_cast<std::ptrdiff_t>(j));
+                } else if (contains(m_freeRects[j], m_freeRects[i])) {
+                    m_freeRects.erase(m_freeRects.begin() + static_cast<std::ptrdiff_t>(i));
+                    --i;
+                    break;
+                } else {
+                    ++j;
+                }
+            }
+        }
+    }
+
+    std::vector<CropRect> m_freeRects;
+};
+
+// Packs cells in order into one width x height page. placed is indexed like cells and left
+// empty for cells that did not fit, which go to leftover. Returns how many were placed.
+std::size_t fillPage(const std::vector<ResizeTarget>& cells,
+                     const std::vector<std::size_t>& order,
+                     int width,
+                     int height,
+                     bool stopAtFirstMiss,
+                     std::vector<CropRect>& placed,
+                     std::vector<std::size_t>& leftover) {
+    MaxRectsBin bin(width, height);
+    placed.assign(cells.size(), CropRect{});
+    leftover.clear();
+    std::size_t placedCount = 0;
+    for (std::size_t index : order) {
+        if (bin.insert(cells[index].width, cells[index].height, &placed[index])) {
+            ++placedCount;
+        } else if (stopAtFirstMiss) {
+            leftover.push_back(index);
+            return placedCount;
+        } else {
+            leftover.push_back(index);
+        }
+    }
+    return placedCount;
+}
+
+} // namespace
+
+bool packAtlas(const std::vector<ResizeTarget>& sizes,
+               int maxPageSize,
+               int padding,
+               std::vector<AtlasPlacement>& placements,
+               std::vector<AtlasPageSize>& pages,
+               std::string* errorMessage) {
+    placements.clear();
+    pages.clear();
+    if (!isPowerOfTwo(maxPageSize) || maxPageSize < kBlockSize || maxPageSize > kMaxAtlasPageSize) {
+        setError(errorMessage, "Atlas page size must be a power of two between 4 and 16384.");
+        return false;
+    }
+    if (padding < 0 || padding > maxPageSize) {
+        setError(errorMessage, "Atlas padding is out of range.");
+        return false;
+    }
+
+    std::vector<ResizeTarget> cells(sizes.size());
+    for (std::size_t index = 0; index < sizes.size(); ++index) {
+        const ResizeTarget& size = sizes[index];
+        if (size.width <= 0 || size.height <= 0
+            || size.width > maxPageSize - padding || size.height > maxPageSize - padding) {
+            setError(errorMessage, "Sprite does not fit on an atlas page.");
+            return false;
+        }
+        cells[index] = {roundUpToBlock(size.width + padding), roundUpToBlock(size.height + padding)};
+    }
+
+    std::vector<std::size_t> remaining(cells.size());
+    std::iota(remaining.begin(), remaining.end(), std::size_t{0});
+    std::stable_sort(remaining.begin(), remaining.end(), [&](std::size_t left, std::size_t right) {
+        const ResizeTarget& a = cells[left];
+        const ResizeTarget& b = cells[right];
+        const int sideA = std::max(a.width, a.height);
+        const int sideB = std::max(b.width, b.height);
+        if (sideA != sideB) {
+            return sideA > sideB;
+        }
+        return static_cast<std::int64_t>(a.width) * a.height > static_cast<std::int64_t>(b.width) * b.height;
+    });
+
+    placements.resize(sizes.size());
+    std::vector<CropRect> placed;
+    std::vector<std::size_t> leftover;
+    while (!remaining.empty()) {
+        std::int64_t remainingArea = 0;
+        int widestCell = 0;
+        int tallestCell = 0;
+        for (std::size_t index : remaining) {
+            remainingArea += static_cast<std::int64_t>(cells[index].width) * cells[index].height;
+            widestCell = std::max(widestCell, cells[index].width);
+            tallestCell = std::max(tallestCell, cells[index].height);
+        }
+
+        // Smallest page that takes everything that is left, trying squarer shapes first at
+        // equal area; falls back to filling a full-size page.
+        AtlasPageSize page;
+        if (remainingArea <= static_cast<std::int64_t>(maxPageSize) * maxPageSize) {
+            std::vector<AtlasPageSize> candidates;
+            for (int width = nextPowerOfTwo(widestCell); width <= maxPageSize; width *= 2) {
+                for (int height = nextPowerOfTwo(tallestCell); height <= maxPageSize; height *= 2) {
+                    if (static_cast<std::int64_t>(width) * height >= remainingArea) {
+                        candidates.push_back({width, height});
+                    }
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(), [](const AtlasPageSize& a, const AtlasPageSize& b) {
+                const std::int64_t areaA = static_cast<std::int64_t>(a.width) * a.height;
+                const std::int64_t areaB = static_cast<std::int64_t>(b.width) * b.height;
+                if (areaA != areaB) {
+                    return areaA < areaB;
+                }
+                return std::abs(a.width - a.height) < std::abs(b.width - b.height);
+            });
+            for (const AtlasPageSize& candidate : candidates) {
+                if (fillPage(cells, remaining, candidate.width, candidate.height, true, placed, leftover)
+                    == remaining.size()) {
+                    page = candidate;
+                    break;
+                }
+            }
+        }
+
+        if (page.width == 0) {
+            if (fillPage(cells, remaining, maxPageSize, maxPageSize, false, placed, leftover) == 0) {
+                setError(errorMessage, "Failed to pack sprites into an atlas page.");
+                return false;
+            }
+            int usedWidth = 0;
+            int usedHeight = 0;
+            for (std::size_t index : remaining) {
+                if (placed[index].width > 0) {
+                    usedWidth = std::max(usedWidth, placed[index].x + placed[index].width);
+                    usedHeight = std::max(usedHeight, placed[index].y + placed[index].height);
+                }
+            }
+            page = {nextPowerOfTwo(usedWidth), nextPowerOfTwo(usedHeight)};
+        }
+
+        const int pageIndex = static_cast<int>(pages.size());
+        for (std::size_t index : remaining) {
+            if (placed[index].width > 0) {
+                placements[index] = {pageIndex, {placed[index].x, placed[index].y, sizes[index].width, sizes[index].height}};
+            }
+        }
+        pages.push_back(page);
+        remaining.swap(leftover);
+    }
+    return true;
+}
+
+} // namespace Lumorpha
@@ -0,0 +1,43 @@
+//-------------------------------------------------------------------------------------
+// AtlasPacker.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LUMORPHA_ATLAS_PACKER_H
+#define LUMORPHA_ATLAS_PACKER_H
+
+#include "ImageProcessor.h"
+
+#include <string>
+#include <vector>
+
+namespace Lumorpha {
+
+struct AtlasPlacement {
+    int page = -1;
+    CropRect rect;
+};
+
+struct AtlasPageSize {
+    int width = 0;
+    int height = 0;
+};
+
+// MaxRects (best short side fit) over power-of-two pages no larger than maxPageSize. Sprites
+// are packed largest first; each page takes as many as fit, and the last page shrinks to the
+// smallest power-of-two size that still holds what is left. Every cell is padded and rounded up
+// to a multiple of 4, so sprites start on 4x4 block boundaries and never share a BC block.
+// placements are in sizes order; rects exclude the padding.
+bool packAtlas(const std::vector<ResizeTarget>& sizes,
+               int maxPageSize,
+               int padding,
+               std::vector<AtlasPlacement>& placements,
+               std::vector<AtlasPageSize>& pages,
+               std::string* errorMessage);
+
+} // namespace Lumorpha
+
+#endif // LUMORPHA_ATLAS_PACKER_H
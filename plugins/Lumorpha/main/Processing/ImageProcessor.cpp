@@ -8,53 +8,50 @@
 //-------------------------------------------------------------------------------------
 #include "ImageProcessor.h"
 
+#include "../Core/ScratchBuffer.h"
+#include "../Core/WorkerPool.h"
+
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LUMORPHA_RESAMPLE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LUMORPHA_RESAMPLE_SSE2 1
+#endif
 
 namespace Lumorpha {
 
 namespace {
 constexpr double kPi = 3.14159265358979323846264338327950288;
 
-Rgba8 transparentPixel() {
-    return {};
-}
+// Resampling weights are 2.14 fixed point; every output's weights sum to exactly kWeightOne.
+constexpr int kWeightBits = 14;
+constexpr int kWeightOne = 1 << kWeightBits;
+// Downscales by more than this first box-reduce to this multiple of the target, so the kernel
+// pass reads a few taps per pixel instead of dozens; the difference is at most a level or two.
+constexpr int kReducingGap = 3;
+// Below this many multiply-adds per pass, starting threads costs more than it saves
+constexpr std::size_t kParallelTapThreshold = std::size_t(1) << 22;
 
-Rgba8 pixelAtClamped(const ImageBuffer& image, int x, int y) {
-    if (!isValidImage(image)) {
-        return transparentPixel();
-    }
+Rgba8 pixelAtClamped(const ImageView& image, int x, int y) {
     x = std::clamp(x, 0, image.width - 1);
     y = std::clamp(y, 0, image.height - 1);
-    return image.pixels[static_cast<std::size_t>(y * image.width + x)];
-}
-
-std::uint8_t clampToByte(double value) {
-    return static_cast<std::uint8_t>(std::clamp(std::lround(value), 0L, 255L));
-}
-
-Rgba8 lerpPixel(const Rgba8& a, const Rgba8& b, double t) {
-    return {
-        clampToByte(static_cast<double>(a.r) + (static_cast<double>(b.r) - a.r) * t),
-        clampToByte(static_cast<double>(a.g) + (static_cast<double>(b.g) - a.g) * t),
-        clampToByte(static_cast<double>(a.b) + (static_cast<double>(b.b) - a.b) * t),
-        clampToByte(static_cast<double>(a.a) + (static_cast<double>(b.a) - a.a) * t)
-    };
+    return image.row(y)[x];
 }
 
-Rgba8 sampleNearest(const ImageBuffer& image, double x, double y) {
+Rgba8 sampleNearest(const ImageView& image, double x, double y) {
     return pixelAtClamped(image, static_cast<int>(std::floor(x + 0.5)), static_cast<int>(std::floor(y + 0.5)));
 }
 
-Rgba8 sampleLinear(const ImageBuffer& image, double x, double y) {
-    const int x0 = static_cast<int>(std::floor(x));
-    const int y0 = static_cast<int>(std::floor(y));
-    const double fx = x - static_cast<double>(x0);
-    const double fy = y - static_cast<double>(y0);
-
-    const Rgba8 top = lerpPixel(pixelAtClamped(image, x0, y0), pixelAtClamped(image, x0 + 1, y0), fx);
-    const Rgba8 bottom = lerpPixel(pixelAtClamped(image, x0, y0 + 1), pixelAtClamped(image, x0 + 1, y0 + 1), fx);
-    return lerpPixel(top, bottom, fy);
+double triangleWeight(double x) {
+    const double ax = std::abs(x);
+    return ax < 1.0 ? 1.0 - ax : 0.0;
 }
 
 double cubicWeight(double x) {
@@ -85,99 +82,244 @@ double lanczosWeight(double x) {
     return sinc(x) * sinc(x / a);
 }
 
-template <typename WeightFn>
-Rgba8 sampleKernel(const ImageBuffer& image, double x, double y, int radius, WeightFn weightFn) {
-    const int centerX = static_cast<int>(std::floor(x));
-    const int centerY = static_cast<int>(std::floor(y));
+// Weights of one resampling direction: output i reads counts[i] source pixels starting at
+// firsts[i], with its weights at weights[i * taps].
+struct ResampleAxis {
+    int taps = 0;
+    std::vector<int> firsts;
+    std::vector<int> counts;
+    std::vector<std::int16_t> weights;
+};
+
+// The kernel is widened by the scale factor when downscaling, so every source pixel
+// contributes instead of only the ones next to each sample point. Box weights are the exact
+// overlap of each source pixel with the output pixel's footprint.
+ResampleAxis buildResampleAxis(int sourceSize, int targetSize, ResizeFilter filter) {
+    const double scale = static_cast<double>(sourceSize) / static_cast<double>(targetSize);
+    const double filterScale = std::max(1.0, scale);
+    double support = 3.0;
+    double (*weightFn)(double) = lanczosWeight;
+    switch (filter) {
+    case ResizeFilter::Linear:
+    case ResizeFilter::Triangle:
+        support = 1.0;
+        weightFn = triangleWeight;
+        break;
+    case ResizeFilter::Cubic:
+        support = 2.0;
+        weightFn = cubicWeight;
+        break;
+    case ResizeFilter::Box:
+        support = 0.5 * scale / filterScale;
+        weightFn = nullptr;
+        break;
+    default:
+        break;
+    }
 
-    double totalWeight = 0.0;
-    double red = 0.0;
-    double green = 0.0;
-    double blue = 0.0;
-    double alpha = 0.0;
+    const double radius = support * filterScale;
+    ResampleAxis axis;
+    axis.taps = std::max(1, static_cast<int>(std::ceil(radius)) * 2 + 1);
+    axis.firsts.resize(static_cast<std::size_t>(targetSize));
+    axis.counts.resize(static_cast<std::size_t>(targetSize));
+    axis.weights.assign(static_cast<std::size_t>(targetSize) * static_cast<std::size_t>(axis.taps), 0);
+
+    std::vector<double> exact(static_cast<std::size_t>(axis.taps));
+    for (int target = 0; target < targetSize; ++target) {
+        const double center = (static_cast<double>(target) + 0.5) * scale;
+        const int first = std::max(0, static_cast<int>(std::floor(center - radius)));
+        const int last = std::min(sourceSize, static_cast<int>(std::ceil(center + radius)));
+        const int count = std::min(axis.taps, std::max(0, last - first));
+
+        double total = 0.0;
+        for (int tap = 0; tap < count; ++tap) {
+            const double source = static_cast<double>(first + tap);
+            double weight = 0.0;
+            if (weightFn) {
+                weight = weightFn((source + 0.5 - center) / filterScale);
+            } else {
+                weight = std::max(0.0, std::min(center + radius, source + 1.0) - std::max(center - radius, source));
+            }
+            exact[static_cast<std::size_t>(tap)] = weight;
+            total += weight;
+        }
 
-    for (int yy = centerY - radius + 1; yy <= centerY + radius; ++yy) {
-        const double wy = weightFn(y - static_cast<double>(yy));
-        if (wy == 0.0) {
+        std::int16_t* weights = axis.weights.data() + static_cast<std::size_t>(target) * axis.taps;
+        if (count == 0 || std::abs(total) < 1.0e-9) {
+            // Nothing in range carries weight; fall back to the nearest source pixel
+            axis.firsts[static_cast<std::size_t>(target)] = std::clamp(static_cast<int>(center), 0, sourceSize - 1);
+            axis.counts[static_cast<std::size_t>(target)] = 1;
+            weights[0] = static_cast<std::int16_t>(kWeightOne);
             continue;
         }
 
-        for (int xx = centerX - radius + 1; xx <= centerX + radius; ++xx) {
-            const double wx = weightFn(x - static_cast<double>(xx));
-            const double weight = wx * wy;
-            if (weight == 0.0) {
-                continue;
+        // Quantize, then give the rounding residue to the largest tap so flat areas stay exact
+        int sum = 0;
+        int largest = 0;
+        for (int tap = 0; tap < count; ++tap) {
+            weights[tap] = static_cast<std::int16_t>(std::lround(exact[static_cast<std::size_t>(tap)] / total * kWeightOne));
+            sum += weights[tap];
+            if (std::abs(weights[tap]) > std::abs(weights[largest])) {
+                largest = tap;
             }
-
-            const Rgba8 pixel = pixelAtClamped(image, xx, yy);
-            red += static_cast<double>(pixel.r) * weight;
-            green += static_cast<double>(pixel.g) * weight;
-            blue += static_cast<double>(pixel.b) * weight;
-            alpha += static_cast<double>(pixel.a) * weight;
-            totalWeight += weight;
         }
+        weights[largest] = static_cast<std::int16_t>(weights[largest] + (kWeightOne - sum));
+        axis.firsts[static_cast<std::size_t>(target)] = first;
+        axis.counts[static_cast<std::size_t>(target)] = count;
     }
+    return axis;
+}
 
-    if (std::abs(totalWeight) < 1.0e-7) {
-        return sampleLinear(image, x, y);
-    }
+std::uint32_t loadPixel(const Rgba8* pixel) {
+    std::uint32_t value = 0;
+    std::memcpy(&value, pixel, sizeof(value));
+    return value;
+}
 
-    return {
-        clampToByte(red / totalWeight),
-        clampToByte(green / totalWeight),
-        clampToByte(blue / totalWeight),
-        clampToByte(alpha / totalWeight)
+// Weighted sum of count pixels spaced step pixels apart, rounded and clamped back to RGBA8.
+Rgba8 convolvePixel(const Rgba8* source, std::ptrdiff_t step, const std::int16_t* weights, int count) {
+    Rgba8 result;
+#if defined(LUMORPHA_RESAMPLE_AVX2) || defined(LUMORPHA_RESAMPLE_SSE2)
+    // Two taps share one multiply-add: their pixels are interleaved channel by channel and
+    // paired with their two weights.
+    const __m128i zero = _mm_setzero_si128();
+    auto pairTaps = [&](int tap, int secondTap) {
+        const __m128i first = _mm_cvtsi32_si128(static_cast<int>(loadPixel(source + tap * step)));
+        const __m128i second = secondTap < count
+            ? _mm_cvtsi32_si128(static_cast<int>(loadPixel(source + secondTap * step)))
+            : zero;
+        return _mm_unpacklo_epi8(_mm_unpacklo_epi8(first, second), zero);
+    };
+    auto pairWeights = [&](int tap, int secondTap) {
+        const std::uint16_t low = static_cast<std::uint16_t>(weights[tap]);
+        const std::uint16_t high = secondTap < count ? static_cast<std::uint16_t>(weights[secondTap]) : 0;
+        return static_cast<int>((static_cast<std::uint32_t>(high) << 16) | low);
     };
-}
 
-Rgba8 sampleBox(const ImageBuffer& image, double left, double top, double right, double bottom) {
-    if (right <= left || bottom <= top) {
-        return transparentPixel();
+    __m128i sum = _mm_set1_epi32(kWeightOne / 2);
+    int tap = 0;
+#if defined(LUMORPHA_RESAMPLE_AVX2)
+    __m256i wideSum = _mm256_setzero_si256();
+    for (; tap + 3 < count; tap += 4) {
+        const __m256i pixels = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(pairTaps(tap, tap + 1)), pairTaps(tap + 2, tap + 3), 1);
+        const __m256i pairWeights4 = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_set1_epi32(pairWeights(tap, tap + 1))),
+            _mm_set1_epi32(pairWeights(tap + 2, tap + 3)), 1);
+        wideSum = _mm256_add_epi32(wideSum, _mm256_madd_epi16(pixels, pairWeights4));
+    }
+    sum = _mm_add_epi32(sum, _mm_add_epi32(_mm256_castsi256_si128(wideSum), _mm256_extracti128_si256(wideSum, 1)));
+#endif
+    for (; tap < count; tap += 2) {
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(pairTaps(tap, tap + 1), _mm_set1_epi32(pairWeights(tap, tap + 1))));
     }
+    const __m128i shifted = _mm_srai_epi32(sum, kWeightBits);
+    const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(shifted, shifted), zero);
+    const std::uint32_t value = static_cast<std::uint32_t>(_mm_cvtsi128_si32(packed));
+    result.r = static_cast<std::uint8_t>(value);
+    result.g = static_cast<std::uint8_t>(value >> 8);
+    result.b = static_cast<std::uint8_t>(value >> 16);
+    result.a = static_cast<std::uint8_t>(value >> 24);
+#else
+    int red = kWeightOne / 2;
+    int green = kWeightOne / 2;
+    int blue = kWeightOne / 2;
+    int alpha = kWeightOne / 2;
+    for (int tap = 0; tap < count; ++tap) {
+        const Rgba8& pixel = source[tap * step];
+        red += pixel.r * weights[tap];
+        green += pixel.g * weights[tap];
+        blue += pixel.b * weights[tap];
+        alpha += pixel.a * weights[tap];
+    }
+    result.r = static_cast<std::uint8_t>(std::clamp(red >> kWeightBits, 0, 255));
+    result.g = static_cast<std::uint8_t>(std::clamp(green >> kWeightBits, 0, 255));
+    result.b = static_cast<std::uint8_t>(std::clamp(blue >> kWeightBits, 0, 255));
+    result.a = static_cast<std::uint8_t>(std::clamp(alpha >> kWeightBits, 0, 255));
+#endif
+    return result;
+}
 
-    const int xStart = static_cast<int>(std::floor(left));
-    const int xEnd = static_cast<int>(std::ceil(right));
-    const int yStart = static_cast<int>(std::floor(top));
-    const int yEnd = static_cast<int>(std::ceil(bottom));
+// Calls rowFn(begin, end) over [0, rowCount), split across the shared worker pool when the pass is large
+template <typename RowFn>
+void forEachRowRange(int rowCount, std::size_t tapCount, const RowFn& rowFn) {
+    const int chunkCount = tapCount < kParallelTapThreshold
+        ? 1
+        : static_cast<int>(std::min<std::size_t>(
+              {workerCount(),
+               static_cast<std::size_t>(rowCount),
+               tapCount / (kParallelTapThreshold / 4)}));
+    if (chunkCount <= 1) {
+        rowFn(0, rowCount);
+        return;
+    }
 
-    double totalWeight = 0.0;
-    double red = 0.0;
-    double green = 0.0;
-    double blue = 0.0;
-    double alpha = 0.0;
+    parallelFor(static_cast<std::size_t>(chunkCount), static_cast<std::size_t>(chunkCount), [&](std::size_t chunk) {
+        const int index = static_cast<int>(chunk);
+        rowFn(rowCount * index / chunkCount, rowCount * (index + 1) / chunkCount);
+    });
+}
 
-    for (int y = yStart; y < yEnd; ++y) {
-        const double yOverlap = std::max(0.0, std::min(bottom, static_cast<double>(y + 1)) - std::max(top, static_cast<double>(y)));
-        if (yOverlap <= 0.0) {
-            continue;
+void resampleHorizontal(const ImageView& image, const MutableImageView& output, ResizeFilter filter) {
+    const ResampleAxis axis = buildResampleAxis(image.width, output.width, filter);
+    const std::size_t tapCount = static_cast<std::size_t>(output.width) * image.height * axis.taps;
+    forEachRowRange(image.height, tapCount, [&](int beginRow, int endRow) {
+        for (int y = beginRow; y < endRow; ++y) {
+            const Rgba8* sourceRow = image.row(y);
+            Rgba8* outputRow = output.row(y);
+            for (int x = 0; x < output.width; ++x) {
+                outputRow[x] = convolvePixel(
+                    sourceRow + axis.firsts[static_cast<std::size_t>(x)],
+                    1,
+                    axis.weights.data() + static_cast<std::size_t>(x) * axis.taps,
+                    axis.counts[static_cast<std::size_t>(x)]
+                );
+            }
         }
+    });
+}
 
-        for (int x = xStart; x < xEnd; ++x) {
-            const double xOverlap = std::max(0.0, std::min(right, static_cast<double>(x + 1)) - std::max(left, static_cast<double>(x)));
-            const double weight = xOverlap * yOverlap;
-            if (weight <= 0.0) {
-                continue;
+void resampleVertical(const ImageView& image, const MutableImageView& output, ResizeFilter filter) {
+    const ResampleAxis axis = buildResampleAxis(image.height, output.height, filter);
+    const std::size_t tapCount = static_cast<std::size_t>(image.width) * output.height * axis.taps;
+    const auto step = static_cast<std::ptrdiff_t>(image.stride);
+    forEachRowRange(output.height, tapCount, [&](int beginRow, int endRow) {
+        for (int y = beginRow; y < endRow; ++y) {
+            const Rgba8* sourceColumn = image.row(axis.firsts[static_cast<std::size_t>(y)]);
+            const std::int16_t* weights = axis.weights.data() + static_cast<std::size_t>(y) * axis.taps;
+            const int count = axis.counts[static_cast<std::size_t>(y)];
+            Rgba8* outputRow = output.row(y);
+            for (int x = 0; x < image.width; ++x) {
+                outputRow[x] = convolvePixel(sourceColumn + x, step, weights, count);
             }
-
-            const Rgba8 pixel = pixelAtClamped(image, x, y);
-            red += static_cast<double>(pixel.r) * weight;
-            green += static_cast<double>(pixel.g) * weight;
-            blue += static_cast<double>(pixel.b) * weight;
-            alpha += static_cast<double>(pixel.a) * weight;
-            totalWeight += weight;
         }
-    }
+    });
+}
 
-    if (totalWeight <= 0.0) {
-        return transparentPixel();
+// Averages 2x2 blocks into output; odd dimensions fall back to a fractional box filter.
+void halveImageInto(const ImageView& image, const MutableImageView& output) {
+    if (image.width != output.width * 2 || image.height != output.height * 2) {
+        resizeImageInto(image, output, ResizeFilter::Box);
+        return;
     }
 
-    return {
-        clampToByte(red / totalWeight),
-        clampToByte(green / totalWeight),
-        clampToByte(blue / totalWeight),
-        clampToByte(alpha / totalWeight)
-    };
+    for (int y = 0; y < output.height; ++y) {
+        const Rgba8* top = image.row(y * 2);
+        const Rgba8* bottom = image.row(y * 2 + 1);
+        Rgba8* out = output.row(y);
+        for (int x = 0; x < output.width; ++x) {
+            const Rgba8& p00 = top[x * 2];
+            const Rgba8& p10 = top[x * 2 + 1];
+            const Rgba8& p01 = bottom[x * 2];
+            const Rgba8& p11 = bottom[x * 2 + 1];
+            out[x] = {
+                static_cast<std::uint8_t>((p00.r + p10.r + p01.r + p11.r + 2) >> 2),
+                static_cast<std::uint8_t>((p00.g + p10.g + p01.g + p11.g + 2) >> 2),
+                static_cast<std::uint8_t>((p00.b + p10.b + p01.b + p11.b + 2) >> 2),
+                static_cast<std::uint8_t>((p00.a + p10.a + p01.a + p11.a + 2) >> 2)
+            };
+        }
+    }
 }
 
 ResizeFilter normalizeFilter(ResizeFilter filter, int sourceWidth, int sourceHeight, int targetWidth, int targetHeight) {
@@ -192,8 +334,8 @@ ResizeFilter normalizeFilter(ResizeFilter filter, int sourceWidth, int sourceHei
 
 } // namespace
 
-bool isValidCrop(const ImageBuffer& image, const CropRect& rect) {
-    if (!isValidImage(image)) {
+bool isValidCrop(const ImageView& image, const CropRect& rect) {
+    if (!isValidView(image)) {
         return false;
     }
     if (rect.x < 0 || rect.y < 0 || rect.width <= 0 || rect.height <= 0) {
@@ -205,87 +347,195 @@ bool isValidCrop(const ImageBuffer& image, const CropRect& rect) {
     return true;
 }
 
-ImageBuffer cropImage(const ImageBuffer& image, const CropRect& rect) {
+ImageView cropView(const ImageView& image, const CropRect& rect) {
     if (!isValidCrop(image, rect)) {
         return {};
     }
+    return {image.row(rect.y) + rect.x, rect.width, rect.height, image.stride};
+}
 
-    ImageBuffer result;
-    result.width = rect.width;
-    result.height = rect.height;
-    result.pixels.resize(checkedPixelCount(result.width, result.height));
-
-    for (int y = 0; y < result.height; ++y) {
-        const auto sourceOffset = static_cast<std::size_t>((rect.y + y) * image.width + rect.x);
-        const auto destOffset = static_cast<std::size_t>(y * result.width);
-        std::copy_n(
-            image.pixels.begin() + static_cast<std::ptrdiff_t>(sourceOffset),
-            result.width,
-            result.pixels.begin() + static_cast<std::ptrdiff_t>(destOffset)
-        );
-    }
-
-    return result;
+ImageBuffer cropImage(const ImageView& image, const CropRect& rect) {
+    return copyImage(cropView(image, rect));
 }
 
-ImageBuffer resizeImage(const ImageBuffer& image, int targetWidth, int targetHeight, ResizeFilter filter) {
-    if (!isValidImage(image) || !imageDimensionsAreSafe(targetWidth, targetHeight)) {
-        return {};
+bool resizeImageInto(const ImageView& image, const MutableImageView& destination, ResizeFilter filter) {
+    if (!isValidView(image) || !isValidView(destination)) {
+        return false;
     }
 
-    ImageBuffer result;
-    result.width = targetWidth;
-    result.height = targetHeight;
-    result.pixels.resize(checkedPixelCount(targetWidth, targetHeight));
+    const int targetWidth = destination.width;
+    const int targetHeight = destination.height;
+    if (image.width == targetWidth && image.height == targetHeight) {
+        copyPixels(image, destination);
+        return true;
+    }
 
     const ResizeFilter activeFilter = normalizeFilter(filter, image.width, image.height, targetWidth, targetHeight);
-    const double scaleX = static_cast<double>(image.width) / static_cast<double>(targetWidth);
-    const double scaleY = static_cast<double>(image.height) / static_cast<double>(targetHeight);
-
-    for (int y = 0; y < targetHeight; ++y) {
-        const double sourceY = (static_cast<double>(y) + 0.5) * scaleY - 0.5;
-        for (int x = 0; x < targetWidth; ++x) {
-            const double sourceX = (static_cast<double>(x) + 0.5) * scaleX - 0.5;
-            Rgba8 sampled;
-
-            switch (activeFilter) {
-            case ResizeFilter::Nearest:
-                sampled = sampleNearest(image, sourceX, sourceY);
-                break;
-            case ResizeFilter::Linear:
-            case ResizeFilter::Triangle:
-                sampled = sampleLinear(image, sourceX, sourceY);
-                break;
-            case ResizeFilter::Cubic:
-                sampled = sampleKernel(image, sourceX, sourceY, 2, cubicWeight);
-                break;
-            case ResizeFilter::Box:
-                sampled = sampleBox(image, x * scaleX, y * scaleY, (x + 1) * scaleX, (y + 1) * scaleY);
-                break;
-            case ResizeFilter::Lanczos3:
-            case ResizeFilter::Auto:
-            default:
-                sampled = sampleKernel(image, sourceX, sourceY, 3, lanczosWeight);
-                break;
+    if (activeFilter == ResizeFilter::Nearest) {
+        const double scaleX = static_cast<double>(image.width) / static_cast<double>(targetWidth);
+        const double scaleY = static_cast<double>(image.height) / static_cast<double>(targetHeight);
+        for (int y = 0; y < targetHeight; ++y) {
+            const double sourceY = (static_cast<double>(y) + 0.5) * scaleY - 0.5;
+            Rgba8* outputRow = destination.row(y);
+            for (int x = 0; x < targetWidth; ++x) {
+                const double sourceX = (static_cast<double>(x) + 0.5) * scaleX - 0.5;
+                outputRow[x] = sampleNearest(image, sourceX, sourceY);
             }
+        }
+        return true;
+    }
+
+    // Separable: resample rows, then columns, skipping a direction whose size is unchanged
+    struct Pass {
+        bool horizontal;
+        int size;
+        ResizeFilter filter;
+    };
+    Pass passes[4];
+    int passCount = 0;
+    int width = image.width;
+    int height = image.height;
+    if (activeFilter != ResizeFilter::Box) {
+        if (width > targetWidth * kReducingGap) {
+            width = targetWidth * kReducingGap;
+            passes[passCount++] = {true, width, ResizeFilter::Box};
+        }
+        if (height > targetHeight * kReducingGap) {
+            height = targetHeight * kReducingGap;
+            passes[passCount++] = {false, height, ResizeFilter::Box};
+        }
+    }
+    if (width != targetWidth) {
+        width = targetWidth;
+        passes[passCount++] = {true, width, activeFilter};
+    }
+    if (height != targetHeight) {
+        passes[passCount++] = {false, targetHeight, activeFilter};
+    }
+    if (passCount == 0) {
+        copyPixels(image, destination);
+        return true;
+    }
 
-            result.pixels[static_cast<std::size_t>(y * targetWidth + x)] = sampled;
+    // Intermediates alternate between two scratch buffers; the last pass lands in destination
+    ScratchBuffer scratch[2];
+    ImageView current = image;
+    for (int index = 0; index < passCount; ++index) {
+        const Pass& pass = passes[index];
+        MutableImageView output = destination;
+        if (index + 1 < passCount) {
+            ScratchBuffer& buffer = scratch[index % 2];
+            buffer = pass.horizontal ? ScratchBuffer(pass.size, current.height) : ScratchBuffer(current.width, pass.size);
+            if (!buffer.isValid()) {
+                return false;
+            }
+            output = buffer.view();
         }
+        if (pass.horizontal) {
+            resampleHorizontal(current, output, pass.filter);
+        } else {
+            resampleVertical(current, output, pass.filter);
+        }
+        current = output;
     }
+    return true;
+}
 
+ImageBuffer resizeImage(const ImageView& image, int targetWidth, int targetHeight, ResizeFilter filter) {
+    if (!isValidView(image)) {
+        return {};
+    }
+    ImageBuffer result = makeImage(targetWidth, targetHeight);
+    if (!isValidImage(result) || !resizeImageInto(image, result, filter)) {
+        return {};
+    }
     return result;
 }
 
-ImageBuffer cropResizeImage(const ImageBuffer& image,
+ImageBuffer cropResizeImage(const ImageView& image,
                             const CropRect& rect,
                             int targetWidth,
                             int targetHeight,
                             ResizeFilter filter) {
-    const ImageBuffer cropped = cropImage(image, rect);
-    if (!isValidImage(cropped)) {
+    const ImageView cropped = cropView(image, rect);
+    if (!isValidView(cropped)) {
         return {};
     }
     return resizeImage(cropped, targetWidth, targetHeight, filter);
 }
 
+bool cropResizeImageSizesInto(const ImageView& image,
+                              const CropRect& rect,
+                              const std::vector<MutableImageView>& destinations,
+                              ResizeFilter filter) {
+    const ImageView cropped = cropView(image, rect);
+    if (!isValidView(cropped)) {
+        return false;
+    }
+
+    // Level 0 is the crop itself, borrowed from the source; deeper levels are pooled scratch
+    std::vector<ScratchBuffer> pyramid;
+    auto levelView = [&](std::size_t level) {
+        return level == 0 ? cropped : ImageView(pyramid[level - 1].view());
+    };
+
+    for (const MutableImageView& destination : destinations) {
+        if (!isValidView(destination)) {
+            continue;
+        }
+
+        // Levels are only built as deep as the smallest target needs
+        std::size_t level = 0;
+        while (true) {
+            if (level < pyramid.size()) {
+                const ImageView next = levelView(level + 1);
+                if (next.width < destination.width || next.height < destination.height) {
+                    break;
+                }
+                ++level;
+                continue;
+            }
+            const ImageView last = levelView(level);
+            if (last.width / 2 < destination.width || last.height / 2 < destination.height) {
+                break;
+            }
+            ScratchBuffer halved(last.width / 2, last.height / 2);
+            if (!halved.isValid()) {
+                break;
+            }
+            halveImageInto(last, halved.view());
+            pyramid.push_back(std::move(halved));
+            ++level;
+        }
+
+        const ImageView source = levelView(level);
+        if (source.width == destination.width && source.height == destination.height) {
+            copyPixels(source, destination);
+        } else {
+            resizeImageInto(source, destination, filter);
+        }
+    }
+    return true;
+}
+
+std::vector<ImageBuffer> cropResizeImageSizes(const ImageView& image,
+                                              const CropRect& rect,
+                                              const std::vector<ResizeTarget>& targets,
+                                              ResizeFilter filter) {
+    std::vector<ImageBuffer> results(targets.size());
+    if (!isValidCrop(image, rect)) {
+        return results;
+    }
+
+    std::vector<MutableImageView> destinations(targets.size());
+    for (std::size_t index = 0; index < targets.size(); ++index) {
+        results[index] = makeImage(targets[index].width, targets[index].height);
+        if (isValidImage(results[index])) {
+            destinations[index] = results[index];
+        }
+    }
+    cropResizeImageSizesInto(image, rect, destinations, filter);
+    return results;
+}
+
 } // namespace Lumorpha
@@ -12,6 +12,7 @@
 #include "../Core/ImageBuffer.h"
 
 #include <cstdint>
+#include <vector>
 
 namespace Lumorpha {
 
@@ -25,6 +26,11 @@ enum class ResizeFilter : std::uint32_t {
     Lanczos3 = 6
 };
 
+struct ResizeTarget {
+    int width = 0;
+    int height = 0;
+};
+
 struct CropRect {
     int x = 0;
     int y = 0;
@@ -32,14 +38,32 @@ struct CropRect {
     int height = 0;
 };
 
-bool isValidCrop(const ImageBuffer& image, const CropRect& rect);
-ImageBuffer cropImage(const ImageBuffer& image, const CropRect& rect);
-ImageBuffer resizeImage(const ImageBuffer& image, int targetWidth, int targetHeight, ResizeFilter filter);
-ImageBuffer cropResizeImage(const ImageBuffer& image,
+// Sources are views, so an ImageBuffer, a crop of one or caller-owned pixels all work in place.
+bool isValidCrop(const ImageView& image, const CropRect& rect);
+// Borrows the rectangle from image without copying; empty when the crop is invalid.
+ImageView cropView(const ImageView& image, const CropRect& rect);
+ImageBuffer cropImage(const ImageView& image, const CropRect& rect);
+// Resamples image to destination's size and writes the result straight into it. Intermediate
+// passes run in pooled scratch buffers, so the destination is the only memory the caller sees.
+bool resizeImageInto(const ImageView& image, const MutableImageView& destination, ResizeFilter filter);
+ImageBuffer resizeImage(const ImageView& image, int targetWidth, int targetHeight, ResizeFilter filter);
+ImageBuffer cropResizeImage(const ImageView& image,
                             const CropRect& rect,
                             int targetWidth,
                             int targetHeight,
                             ResizeFilter filter);
+// Derives every target from an area-averaged pyramid of the crop, so each target is filtered
+// from a level less than twice its size. Destinations that are not valid views are skipped;
+// returns false when the crop itself is invalid.
+bool cropResizeImageSizesInto(const ImageView& image,
+                              const CropRect& rect,
+                              const std::vector<MutableImageView>& destinations,
+                              ResizeFilter filter);
+// Results are in target order; an invalid target yields an empty image.
+std::vector<ImageBuffer> cropResizeImageSizes(const ImageView& image,
+                                              const CropRect& rect,
+                                              const std::vector<ResizeTarget>& targets,
+                                              ResizeFilter filter);
 
 } // namespace Lumorpha
 
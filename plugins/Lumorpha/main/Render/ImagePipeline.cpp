@@ -0,0 +1,214 @@
+//-------------------------------------------------------------------------------------
+// ImagePipeline.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "ImagePipeline.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Lumorpha {
+
+namespace {
+
+void setError(std::string* errorMessage, const char* message) {
+    if (errorMessage) {
+        *errorMessage = message;
+    }
+}
+
+// The image between steps: borrows the source (or a crop of it) until a step has to write
+// pixels, and owns them from then on.
+struct WorkingImage {
+    ImageBuffer storage;
+    ImageView view;
+
+    bool ownsView() const {
+        return !storage.pixels.empty()
+            && view.pixels == storage.pixels.data()
+            && view.width == storage.width
+            && view.height == storage.height
+            && view.stride == static_cast<std::size_t>(storage.width);
+    }
+
+    MutableImageView writable() {
+        if (!ownsView()) {
+            ImageBuffer copy = copyImage(view);
+            replace(std::move(copy));
+        }
+        return storage;
+    }
+
+    void replace(ImageBuffer image) {
+        storage = std::move(image);
+        view = storage;
+    }
+};
+
+void flipImage(const MutableImageView& image, std::uint32_t flags) {
+    if (flags & FlipHorizontal) {
+        for (int y = 0; y < image.height; ++y) {
+            std::reverse(image.row(y), image.row(y) + image.width);
+        }
+    }
+    if (flags & FlipVertical) {
+        for (int top = 0, bottom = image.height - 1; top < bottom; ++top, --bottom) {
+            std::swap_ranges(image.row(top), image.row(top) + image.width, image.row(bottom));
+        }
+    }
+}
+
+std::uint8_t premultiplyChannel(std::uint8_t value, std::uint8_t alpha) {
+    const unsigned product = static_cast<unsigned>(value) * alpha + 128U;
+    return static_cast<std::uint8_t>((product + (product >> 8)) >> 8);
+}
+
+void premultiplyImage(const MutableImageView& image) {
+    for (int y = 0; y < image.height; ++y) {
+        Rgba8* row = image.row(y);
+        for (int x = 0; x < image.width; ++x) {
+            Rgba8& pixel = row[x];
+            if (pixel.a == 255) {
+                continue;
+            }
+            pixel.r = premultiplyChannel(pixel.r, pixel.a);
+            pixel.g = premultiplyChannel(pixel.g, pixel.a);
+            pixel.b = premultiplyChannel(pixel.b, pixel.a);
+        }
+    }
+}
+
+bool applyOp(WorkingImage& image, const PipelineOp& op, std::string* errorMessage) {
+    switch (op.kind) {
+    case PipelineOpKind::Crop:
+        if (!isValidCrop(image.view, op.crop)) {
+            setError(errorMessage, "Pipeline crop is outside the image.");
+            return false;
+        }
+        image.view = cropView(image.view, op.crop);
+        return true;
+    case PipelineOpKind::Resize: {
+        if (!imageDimensionsAreSafe(op.size.width, op.size.height)) {
+            setError(errorMessage, "Pipeline resize target is invalid.");
+            return false;
+        }
+        if (op.size.width == image.view.width && op.size.height == image.view.height) {
+            return true;
+        }
+        ImageBuffer resized = resizeImage(image.view, op.size.width, op.size.height, op.filter);
+        if (!isValidImage(resized)) {
+            setError(errorMessage, "Failed to resize image.");
+            return false;
+        }
+        image.replace(std::move(resized));
+        return true;
+    }
+    case PipelineOpKind::Flip:
+        flipImage(image.writable(), op.flipFlags);
+        return true;
+    case PipelineOpKind::Premultiply:
+        premultiplyImage(image.writable());
+        return true;
+    }
+    setError(errorMessage, "Unsupported pipeline operation.");
+    return false;
+}
+
+// Outputs that open with a resize and share its filter are resized together from one pyramid;
+// a lone resize stays a direct resample so a single output matches resizeImage exactly.
+bool resizeSharedTargets(const ImageView& shared,
+                         const std::vector<PipelineOutput>& outputs,
+                         std::vector<ImageBuffer>& firstResults,
+                         std::string* errorMessage) {
+    std::vector<bool> grouped(outputs.size(), false);
+    for (std::size_t first = 0; first < outputs.size(); ++first) {
+        const std::vector<PipelineOp>& firstOps = outputs[first].ops;
+        if (grouped[first] || firstOps.empty() || firstOps.front().kind != PipelineOpKind::Resize) {
+            continue;
+        }
+
+        std::vector<std::size_t> members;
+        for (std::size_t index = first; index < outputs.size(); ++index) {
+            const std::vector<PipelineOp>& ops = outputs[index].ops;
+            if (!grouped[index] && !ops.empty() && ops.front().kind == PipelineOpKind::Resize
+                && ops.front().filter == firstOps.front().filter) {
+                members.push_back(index);
+            }
+        }
+        if (members.size() < 2) {
+            continue;
+        }
+
+        std::vector<MutableImageView> destinations;
+        destinations.reserve(members.size());
+        for (std::size_t index : members) {
+            const ResizeTarget& size = outputs[index].ops.front().size;
+            firstResults[index] = makeImage(size.width, size.height);
+            if (!isValidImage(firstResults[index])) {
+                setError(errorMessage, "Pipeline resize target is invalid.");
+                return false;
+            }
+            destinations.push_back(firstResults[index]);
+            grouped[index] = true;
+        }
+        if (!cropResizeImageSizesInto(shared, {0, 0, shared.width, shared.height}, destinations, firstOps.front().filter)) {
+            setError(errorMessage, "Failed to resize image.");
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool runImagePipeline(const ImageView& source,
+                      const std::vector<PipelineOp>& prefix,
+                      const std::vector<PipelineOutput>& outputs,
+                      std::vector<std::vector<std::uint8_t>>& encoded,
+                      std::string* errorMessage) {
+    encoded.assign(outputs.size(), {});
+    if (!isValidView(source)) {
+        setError(errorMessage, "Image is invalid.");
+        return false;
+    }
+
+    WorkingImage shared;
+    shared.view = source;
+    for (const PipelineOp& op : prefix) {
+        if (!applyOp(shared, op, errorMessage)) {
+            return false;
+        }
+    }
+
+    std::vector<ImageBuffer> firstResults(outputs.size());
+    if (!resizeSharedTargets(shared.view, outputs, firstResults, errorMessage)) {
+        return false;
+    }
+
+    for (std::size_t index = 0; index < outputs.size(); ++index) {
+        const PipelineOutput& output = outputs[index];
+        WorkingImage branch;
+        std::size_t next = 0;
+        if (isValidImage(firstResults[index])) {
+            branch.replace(std::move(firstResults[index]));
+            next = 1;
+        } else {
+            branch.view = shared.view;
+        }
+        for (; next < output.ops.size(); ++next) {
+            if (!applyOp(branch, output.ops[next], errorMessage)) {
+                return false;
+            }
+        }
+        if (!encodeImage(branch.view, output.format, encoded[index], errorMessage)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Lumorpha
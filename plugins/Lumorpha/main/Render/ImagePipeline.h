@@ -0,0 +1,61 @@
+//-------------------------------------------------------------------------------------
+// ImagePipeline.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LUMORPHA_IMAGE_PIPELINE_H
+#define LUMORPHA_IMAGE_PIPELINE_H
+
+#include "../Codecs/ImageCodec.h"
+#include "../Core/ImageBuffer.h"
+#include "../Processing/ImageProcessor.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Lumorpha {
+
+enum class PipelineOpKind : std::uint32_t {
+    Crop = 1,
+    Resize = 2,
+    Flip = 3,
+    Premultiply = 4
+};
+
+enum PipelineFlipFlags : std::uint32_t {
+    FlipHorizontal = 1,
+    FlipVertical = 2
+};
+
+// Only the fields of the op's kind are read.
+struct PipelineOp {
+    PipelineOpKind kind = PipelineOpKind::Crop;
+    CropRect crop;
+    ResizeTarget size;
+    ResizeFilter filter = ResizeFilter::Auto;
+    std::uint32_t flipFlags = 0;
+};
+
+// One result: its own ops applied to the shared image, then encoded as format.
+struct PipelineOutput {
+    std::vector<PipelineOp> ops;
+    ImageFormat format = ImageFormat::Png;
+};
+
+// Applies prefix to source, then each output's ops to that shared result, and encodes every
+// output into encoded (one buffer per output, in order). Crops only narrow the view and pixels
+// are copied only when a step writes them. Outputs that start with a resize are derived
+// together from one area pyramid of the shared image, like cropResizeImageSizes.
+bool runImagePipeline(const ImageView& source,
+                      const std::vector<PipelineOp>& prefix,
+                      const std::vector<PipelineOutput>& outputs,
+                      std::vector<std::vector<std::uint8_t>>& encoded,
+                      std::string* errorMessage);
+
+} // namespace Lumorpha
+
+#endif // LUMORPHA_IMAGE_PIPELINE_H
@@ -12,13 +12,13 @@
 
 namespace Lumorpha {
 
-bool renderPng(const ImageBuffer& image,
+bool renderPng(const ImageView& image,
                int targetWidth,
                int targetHeight,
                ResizeFilter filter,
                std::vector<std::uint8_t>& output,
                std::string* errorMessage) {
-    if (!isValidImage(image)) {
+    if (!isValidView(image)) {
         if (errorMessage) {
             *errorMessage = "Image is invalid.";
         }
@@ -28,10 +28,11 @@ bool renderPng(const ImageBuffer& image,
     const bool shouldResize = targetWidth > 0
         && targetHeight > 0
         && (targetWidth != image.width || targetHeight != image.height);
-    const ImageBuffer rendered = shouldResize
-        ? resizeImage(image, targetWidth, targetHeight, filter)
-        : image;
+    if (!shouldResize) {
+        return encodeImage(image, ImageFormat::Png, output, errorMessage);
+    }
 
+    const ImageBuffer rendered = resizeImage(image, targetWidth, targetHeight, filter);
     return encodeImage(rendered, ImageFormat::Png, output, errorMessage);
 }
 
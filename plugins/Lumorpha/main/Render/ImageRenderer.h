@@ -18,7 +18,7 @@
 
 namespace Lumorpha {
 
-bool renderPng(const ImageBuffer& image,
+bool renderPng(const ImageView& image,
                int targetWidth,
                int targetHeight,
                ResizeFilter filter,
@@ -0,0 +1,162 @@
+//-------------------------------------------------------------------------------------
+// TextureAtlas.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "TextureAtlas.h"
+
+#include <sstream>
+
+namespace Lumorpha {
+
+namespace {
+
+// Magic and header of a DDS; BC7 also needs the DX10 extension
+constexpr std::uint64_t kDdsHeaderBytes = 128;
+constexpr std::uint64_t kDdsDx10HeaderBytes = 20;
+
+void setError(std::string* errorMessage, const char* message) {
+    if (errorMessage) {
+        *errorMessage = message;
+    }
+}
+
+// Names and paths go between quotes in the .gfx text
+bool isQuotableText(const std::string& text) {
+    for (char character : text) {
+        if (character == '"' || character == '\n' || character == '\r') {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string pagePath(const std::string& prefix, std::size_t page) {
+    return prefix + "_" + std::to_string(page) + ".dds";
+}
+
+std::string pageSpriteName(const std::string& prefix, std::size_t page) {
+    const std::size_t slash = prefix.find_last_of("/\\");
+    return "GFX_" + prefix.substr(slash == std::string::npos ? 0 : slash + 1) + "_" + std::to_string(page);
+}
+
+std::string spriteDefinitions(const std::vector<AtlasSprite>& sprites,
+                              const AtlasResult& result,
+                              const std::string& prefix) {
+    std::ostringstream text;
+    text << "# Atlas sheets for .gui layouts. Sprites are not addressable by name; use the rectangles below.\n"
+         << "spriteTypes = {\n";
+    for (std::size_t page = 0; page < result.pageSizes.size(); ++page) {
+        text << "\tspriteType = {\n"
+             << "\t\tname = \"" << pageSpriteName(prefix, page) << "\"\n"
+             << "\t\ttexturefile = \"" << pagePath(prefix, page) << "\"\n"
+             << "\t}\n";
+        for (std::size_t index = 0; index < sprites.size(); ++index) {
+            const AtlasPlacement& placement = result.placements[index];
+            if (placement.page != static_cast<int>(page)) {
+                continue;
+            }
+            text << "\t# " << sprites[index].name << ": x = " << placement.rect.x << " y = " << placement.rect.y
+                 << " width = " << placement.rect.width << " height = " << placement.rect.height << "\n";
+        }
+    }
+    text << "}\n";
+    return text.str();
+}
+
+} // namespace
+
+bool buildTextureAtlas(const std::vector<AtlasSprite>& sprites,
+                       const AtlasOptions& options,
+                       AtlasResult& result,
+                       std::string* errorMessage,
+                       const AtlasProgress& progress) {
+    result = {};
+    if (sprites.empty()) {
+        setError(errorMessage, "Atlas has no sprites.");
+        return false;
+    }
+    if (options.texturePathPrefix.empty() || !isQuotableText(options.texturePathPrefix)) {
+        setError(errorMessage, "Atlas texture path is invalid.");
+        return false;
+    }
+
+    std::vector<ResizeTarget> sizes;
+    sizes.reserve(sprites.size());
+    for (const AtlasSprite& sprite : sprites) {
+        if (!isValidView(sprite.image)) {
+            setError(errorMessage, "Atlas sprite image is invalid.");
+            return false;
+        }
+        if (sprite.name.empty() || !isQuotableText(sprite.name)) {
+            setError(errorMessage, "Atlas sprite name is invalid.");
+            return false;
+        }
+        sizes.push_back({sprite.image.width, sprite.image.height});
+    }
+    if (!packAtlas(sizes, options.maxPageSize, options.padding, result.placements, result.pageSizes, errorMessage)) {
+        return false;
+    }
+
+    // Pages are built one at a time so only one uncompressed sheet is alive; the encoder
+    // already spreads each page's blocks over every core.
+    result.pages.resize(result.pageSizes.size());
+    for (std::size_t page = 0; page < result.pageSizes.size(); ++page) {
+        ImageBuffer sheet = makeImage(result.pageSizes[page].width, result.pageSizes[page].height);
+        if (!isValidImage(sheet)) {
+            setError(errorMessage, "Atlas page is too large.");
+            return false;
+        }
+        for (std::size_t index = 0; index < sprites.size(); ++index) {
+            const AtlasPlacement& placement = result.placements[index];
+            if (placement.page != static_cast<int>(page)) {
+                continue;
+            }
+            const MutableImageView sheetView(sheet);
+            copyPixels(sprites[index].image,
+                       {sheetView.row(placement.rect.y) + placement.rect.x,
+                        placement.rect.width,
+                        placement.rect.height,
+                        sheetView.stride});
+        }
+        if (!encodeDdsTexture(sheet, options.texture, result.pages[page], errorMessage)) {
+            return false;
+        }
+        result.report.atlasVramBytes += textureByteSize(sheet.width, sheet.height, options.texture);
+        result.report.atlasDiskBytes += result.pages[page].size();
+        if (progress && !progress(page + 1, result.pageSizes.size())) {
+            setError(errorMessage, "Atlas build was cancelled.");
+            return false;
+        }
+    }
+
+    const std::uint64_t headerBytes = kDdsHeaderBytes
+        + (options.texture.compression == TextureCompression::Bc7 ? kDdsDx10HeaderBytes : 0);
+    for (const AtlasSprite& sprite : sprites) {
+        const std::uint64_t textureBytes = textureByteSize(sprite.image.width, sprite.image.height, options.texture);
+        result.report.sourceVramBytes += textureBytes;
+        result.report.sourceDiskBytes += sprite.sourceFileSize > 0 ? sprite.sourceFileSize : textureBytes + headerBytes;
+    }
+    result.spriteDefinitions = spriteDefinitions(sprites, result, options.texturePathPrefix);
+    return true;
+}
+
+std::string atlasReportJson(const AtlasResult& result) {
+    const AtlasReport& report = result.report;
+    std::ostringstream json;
+    json << "{\"sprites\":" << result.placements.size()
+         << ",\"pages\":" << result.pages.size()
+         << ",\"sourceVramBytes\":" << report.sourceVramBytes
+         << ",\"atlasVramBytes\":" << report.atlasVramBytes
+         << ",\"vramSavedBytes\":" << static_cast<std::int64_t>(report.sourceVramBytes) - static_cast<std::int64_t>(report.atlasVramBytes)
+         << ",\"sourceDiskBytes\":" << report.sourceDiskBytes
+         << ",\"atlasDiskBytes\":" << report.atlasDiskBytes
+         << ",\"diskSavedBytes\":" << static_cast<std::int64_t>(report.sourceDiskBytes) - static_cast<std::int64_t>(report.atlasDiskBytes)
+         << "}";
+    return json.str();
+}
+
+} // namespace Lumorpha
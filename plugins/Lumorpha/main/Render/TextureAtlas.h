@@ -0,0 +1,77 @@
+//-------------------------------------------------------------------------------------
+// TextureAtlas.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LUMORPHA_TEXTURE_ATLAS_H
+#define LUMORPHA_TEXTURE_ATLAS_H
+
+#include "../Codecs/TextureCodec.h"
+#include "../Core/ImageBuffer.h"
+#include "../Processing/AtlasPacker.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Lumorpha {
+
+struct AtlasSprite {
+    // spriteType name, e.g. GFX_goal_generic_attack
+    std::string name;
+    ImageView image;
+    // Size of the file the sprite ships as today; 0 estimates an uncompressed 32 bpp DDS
+    std::uint64_t sourceFileSize = 0;
+};
+
+struct AtlasOptions {
+    int maxPageSize = 2048;
+    int padding = 4;
+    TextureOptions texture{TextureCompression::Bc7, TextureQuality::Balanced, true};
+    // Game path of the pages without extension; page N is written as <prefix>_<N>.dds
+    std::string texturePathPrefix = "gfx/interface/atlas";
+};
+
+// Sources are costed as standalone textures encoded with the same TextureOptions as the pages, so
+// the savings are what atlasing itself buys (fewer, fuller textures), not compression.
+struct AtlasReport {
+    std::uint64_t sourceVramBytes = 0;
+    std::uint64_t atlasVramBytes = 0;
+    std::uint64_t sourceDiskBytes = 0;
+    std::uint64_t atlasDiskBytes = 0;
+};
+
+struct AtlasResult {
+    std::vector<AtlasPlacement> placements;
+    std::vector<AtlasPageSize> pageSizes;
+    // One DDS file per page
+    std::vector<std::vector<std::uint8_t>> pages;
+    // .gfx text declaring one spriteType per page, for .gui layouts that address the sheet
+    std::string spriteDefinitions;
+    AtlasReport report;
+};
+
+// Called after each page is encoded; returning false stops the build.
+using AtlasProgress = std::function<bool(std::size_t completedPages, std::size_t pageCount)>;
+
+// GUI-sheet tooling: packs sprites onto power-of-two pages (see packAtlas), then builds and
+// encodes each page with options.texture. A spriteType can only point at a whole texture, so
+// the game cannot resolve individual sprites out of a page; the definitions declare one
+// spriteType per page and list each sprite's rectangle in comments, and placements carry the
+// same rectangles for tools that lay out .gui elements over the sheet. This does not replace
+// the per-icon spriteTypes that goals and ideas reference.
+bool buildTextureAtlas(const std::vector<AtlasSprite>& sprites,
+                       const AtlasOptions& options,
+                       AtlasResult& result,
+                       std::string* errorMessage,
+                       const AtlasProgress& progress = AtlasProgress());
+
+std::string atlasReportJson(const AtlasResult& result);
+
+} // namespace Lumorpha
+
+#endif // LUMORPHA_TEXTURE_ATLAS_H
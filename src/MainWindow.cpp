@@ -28,6 +28,7 @@
 #include "HttpClient.h"
 #include "ToolRuntimeContext.h"
 #include "ToolScriptedHostController.h"
+#include "ToolThumbnailCache.h"
 #include "ToolUiContainer.h"
 #include "WindowAviRecorder.h"
 #include <QStandardPaths>
@@ -725,105 +726,6 @@ QIcon iconFromBase64Png(const QString& base64Data) {
     return QIcon(pixmap);
 }
 
-QImage tgaImageFromData(const QByteArray& data) {
-    if (data.size() < 18) {
-        return {};
-    }
-
-    const auto* bytes = reinterpret_cast<const uchar*>(data.constData());
-    const int idLength = bytes[0];
-    const int colorMapType = bytes[1];
-    const int imageType = bytes[2];
-    const int width = bytes[12] | (bytes[13] << 8);
-    const int height = bytes[14] | (bytes[15] << 8);
-    const int bpp = bytes[16];
-    const int descriptor = bytes[17];
-
-    if (colorMapType != 0 || (imageType != 2 && imageType != 10)) {
-        return QImage::fromData(data);
-    }
-    if ((bpp != 24 && bpp != 32) || width <= 0 || height <= 0) {
-        return {};
-    }
-
-    const int bytesPerPixel = bpp / 8;
-    const int pixelDataOffset = 18 + idLength;
-    if (pixelDataOffset < 0 || pixelDataOffset >= data.size()) {
-        return {};
-    }
-
-    QImage image(width, height, QImage::Format_RGBA8888);
-    const uchar* pixelData = bytes + pixelDataOffset;
-    const int pixelCount = width * height;
-    const int maxDataSize = data.size() - pixelDataOffset;
-
-    auto writePixel = [&](int currentPixel, uchar blue, uchar green, uchar red, uchar alpha) {
-        const int x = currentPixel % width;
-        const int sourceY = currentPixel / width;
-        const int destY = (descriptor & 0x20) ? sourceY : (height - 1 - sourceY);
-        uchar* line = image.scanLine(destY);
-        const int offset = x * 4;
-        line[offset] = red;
-        line[offset + 1] = green;
-        line[offset + 2] = blue;
-        line[offset + 3] = alpha;
-    };
-
-    if (imageType == 2) {
-        for (int currentPixel = 0; currentPixel < pixelCount; ++currentPixel) {
-            const int srcIndex = currentPixel * bytesPerPixel;
-            if (srcIndex + bytesPerPixel > maxDataSize) {
-                break;
-            }
-            writePixel(
-                currentPixel,
-                pixelData[srcIndex],
-                pixelData[srcIndex + 1],
-                pixelData[srcIndex + 2],
-                bytesPerPixel == 4 ? pixelData[srcIndex + 3] : 255
-            );
-        }
-        return image;
-    }
-
-    int currentPixel = 0;
-    int dataIndex = 0;
-    while (currentPixel < pixelCount && dataIndex < maxDataSize) {
-        const uchar header = pixelData[dataIndex++];
-        const int count = (header & 0x7F) + 1;
-
-        if ((header & 0x80) != 0) {
-            if (dataIndex + bytesPerPixel > maxDataSize) {
-                break;
-            }
-            const uchar blue = pixelData[dataIndex];
-            const uchar green = pixelData[dataIndex + 1];
-            const uchar red = pixelData[dataIndex + 2];
-            const uchar alpha = bytesPerPixel == 4 ? pixelData[dataIndex + 3] : 255;
-            dataIndex += bytesPerPixel;
-            for (int i = 0; i < count && currentPixel < pixelCount; ++i, ++currentPixel) {
-                writePixel(currentPixel, blue, green, red, alpha);
-            }
-        } else {
-            for (int i = 0; i < count && currentPixel < pixelCount; ++i, ++currentPixel) {
-                if (dataIndex + bytesPerPixel > maxDataSize) {
-                    break;
-                }
-                writePixel(
-                    currentPixel,
-                    pixelData[dataIndex],
-                    pixelData[dataIndex + 1],
-                    pixelData[dataIndex + 2],
-                    bytesPerPixel == 4 ? pixelData[dataIndex + 3] : 255
-                );
-                dataIndex += bytesPerPixel;
-            }
-        }
-    }
-
-    return image;
-}
-
 bool truthyVariant(const QVariantMap& values, const QString& key, bool fallback = false) {
     if (!values.contains(key)) {
         return fallback;
@@ -2695,17 +2597,20 @@ void MainWindow::syncV2RightSidebarContent() {
                 if (cachedIcon != m_rightSidebarEffectiveIconCache.constEnd()) {
                     rowIcon = cachedIcon.value();
                 } else {
-                    const ToolRuntimeContext::FileReadResult readResult =
-                        ToolRuntimeContext::instance().readEffectiveFile(effectiveIconPath);
-                    if (readResult.success) {
-                        const QImage image = tgaImageFromData(readResult.content);
-                        if (!image.isNull()) {
-                            rowIcon = QIcon(QPixmap::fromImage(image));
-                            if (m_rightSidebarEffectiveIconCache.size() > 512) {
-                                m_rightSidebarEffectiveIconCache.clear();
-                            }
-                            m_rightSidebarEffectiveIconCache.insert(cacheKey, rowIcon);
+                    const QSize iconSize(
+                        row.state.value(QStringLiteral("iconWidth")).toInt(),
+                        row.state.value(QStringLiteral("iconHeight")).toInt()
+                    );
+                    const QImage image = ToolThumbnailCache::instance().thumbnail(
+                        effectiveIconPath,
+                        iconSize.isEmpty() ? QSize() : iconSize
+                    );
+                    if (!image.isNull()) {
+                        rowIcon = QIcon(QPixmap::fromImage(image));
+                        if (m_rightSidebarEffectiveIconCache.size() > 512) {
+                            m_rightSidebarEffectiveIconCache.clear();
                         }
+                        m_rightSidebarEffectiveIconCache.insert(cacheKey, rowIcon);
                     }
                 }
             }
@@ -3369,12 +3274,26 @@ void MainWindow::onToolSelected(const QString &toolId) {
                 brokerRequest.payload = request.payload;
                 brokerRequest.flags = request.flags;
                 brokerRequest.authorizedDependencies = invokerTool->dependencies();
+                brokerRequest.sessionId = invokerTool->id();
+                if (request.progressHandler) {
+                    const ToolRuntimeContext::PluginProgressHandler progressHandler = request.progressHandler;
+                    brokerRequest.streamHandler = [progressHandler](const PluginAbiBroker::StreamEvent& event) {
+                        ToolRuntimeContext::PluginProgressEvent progress;
+                        progress.completed = event.completed;
+                        progress.total = event.total;
+                        progress.message = event.message;
+                        progress.chunkContentType = static_cast<ToolRuntimeContext::PluginPayloadContentType>(static_cast<quint32>(event.chunkContentType));
+                        progress.chunk = event.chunk;
+                        return progressHandler(progress);
+                    };
+                }
 
                 const PluginAbiBroker::Response brokerResponse = PluginAbiBroker::instance().invoke(brokerRequest);
                 ToolRuntimeContext::PluginInvokeResponse response;
                 response.success = brokerResponse.success;
                 response.contentType = static_cast<ToolRuntimeContext::PluginPayloadContentType>(static_cast<quint32>(brokerResponse.contentType));
                 response.payload = brokerResponse.payload;
+                response.payloadOwner = brokerResponse.payloadOwner;
                 response.errorMessage = brokerResponse.errorMessage;
                 response.status = brokerResponse.status;
                 response.flags = brokerResponse.flags;
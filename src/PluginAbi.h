@@ -26,6 +26,14 @@
 #endif
 
 #define APE_PLUGIN_ABI_VERSION 1u
+#define APE_PLUGIN_ABI_VERSION_2 2u
+
+// Reserved operation executed by the host broker on behalf of any plugin. The payload
+// (content type BINARY_ENVELOPE, little-endian) is: u32 itemCount, then per item
+// u32 operationLength, operation UTF-8, u32 contentType, u32 flags, u64 payloadSize, payload.
+// The response lists per item: u32 status, u32 contentType, u32 flags, u64 payloadSize,
+// payload, u32 errorLength, error UTF-8.
+#define APE_PLUGIN_ABI_BATCH_OPERATION "ape.batch"
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,9 +55,17 @@ typedef enum ApePluginAbiStatus {
     APE_PLUGIN_ABI_STATUS_PLUGIN_UNAVAILABLE = 5,
     APE_PLUGIN_ABI_STATUS_PLUGIN_ERROR = 6,
     APE_PLUGIN_ABI_STATUS_BUFFER_TOO_LARGE = 7,
-    APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR = 8
+    APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR = 8,
+    APE_PLUGIN_ABI_STATUS_BUSY = 9,
+    APE_PLUGIN_ABI_STATUS_CANCELLED = 10
 } ApePluginAbiStatus;
 
+typedef enum ApePluginAbiConcurrency {
+    APE_PLUGIN_ABI_CONCURRENCY_SINGLE_THREADED = 0,
+    APE_PLUGIN_ABI_CONCURRENCY_REENTRANT = 1,
+    APE_PLUGIN_ABI_CONCURRENCY_THREAD_SAFE_PER_SESSION = 2
+} ApePluginAbiConcurrency;
+
 typedef struct ApePluginAbiBuffer {
     const uint8_t* data;
     uint64_t size;
@@ -74,10 +90,54 @@ typedef struct ApePluginAbiResponse {
     char* errorUtf8;
 } ApePluginAbiResponse;
 
+typedef void (*ApePluginBufferRefFn)(void* context);
+
+// Buffer owned by one side of the ABI and borrowed by the other until release(releaseContext) is called.
+typedef struct ApePluginAbiOwnedBuffer {
+    const uint8_t* data;
+    uint64_t size;
+    ApePluginBufferRefFn release;
+    void* releaseContext;
+} ApePluginAbiOwnedBuffer;
+
+// ABI v2 extends both structs in place; request->abiVersion tells the plugin which layout it received.
+typedef struct ApePluginAbiRequestV2 {
+    ApePluginAbiRequest base;
+    // Keeps base.payload alive past the call; every retain must be paired with one releasePayload.
+    ApePluginBufferRefFn retainPayload;
+    ApePluginBufferRefFn releasePayload;
+    void* payloadContext;
+} ApePluginAbiRequestV2;
+
+typedef struct ApePluginAbiResponseV2 {
+    ApePluginAbiResponse base;
+    // Used instead of base.payload when set; the host releases it once the bytes are no longer needed,
+    // which may be after APE_Plugin_FreeResponse has returned.
+    ApePluginAbiOwnedBuffer ownedPayload;
+} ApePluginAbiResponseV2;
+
+// Host callbacks for long-running operations. They may only be called from the invoking thread
+// while the call is in progress, and each returns non-zero once the host wants the call cancelled.
+typedef struct ApePluginAbiStreamHost {
+    void* context;
+    int (*emitChunk)(void* context, uint32_t contentType, const uint8_t* data, uint64_t size);
+    int (*reportProgress)(void* context, uint64_t completed, uint64_t total, const char* messageUtf8);
+    int (*isCancelled)(void* context);
+} ApePluginAbiStreamHost;
+
 typedef int (*ApePluginInvokeFn)(const ApePluginAbiRequest*, ApePluginAbiResponse*);
+// Optional export "APE_Plugin_InvokeStreaming"; the final response is still delivered as usual and a
+// cancelled call should finish with APE_PLUGIN_ABI_STATUS_CANCELLED.
+typedef int (*ApePluginInvokeStreamingFn)(const ApePluginAbiRequest*, const ApePluginAbiStreamHost*, ApePluginAbiResponse*);
 typedef void (*ApePluginFreeResponseFn)(ApePluginAbiResponse*);
 typedef const char* (*ApePluginGetNameFn)(void);
 typedef uint32_t (*ApePluginGetAbiVersionFn)(void);
+// Optional export "APE_Plugin_GetConcurrency"; plugins without it are treated as single-threaded
+// unless their descriptor declares otherwise.
+typedef uint32_t (*ApePluginGetConcurrencyFn)(void);
+// Optional export "APE_Plugin_IsOperationCacheable"; non-zero means the operation's result depends
+// only on its content type, flags and payload, so the host may reuse it. Overrides the descriptor.
+typedef int (*ApePluginIsOperationCacheableFn)(const char* operationUtf8);
 
 #ifdef __cplusplus
 }
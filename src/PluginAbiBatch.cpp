@@ -0,0 +1,205 @@
+//-------------------------------------------------------------------------------------
+// PluginAbiBatch.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "PluginAbiBatch.h"
+
+namespace {
+
+constexpr quint32 kMaxBatchItems = 65536;
+
+void appendU32(QByteArray* out, quint32 value) {
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) {
+        bytes[i] = static_cast<char>((value >> (i * 8)) & 0xFFu);
+    }
+    out->append(bytes, 4);
+}
+
+void appendU64(QByteArray* out, quint64 value) {
+    appendU32(out, static_cast<quint32>(value & 0xFFFFFFFFu));
+    appendU32(out, static_cast<quint32>(value >> 32));
+}
+
+void appendBytes(QByteArray* out, const QByteArray& bytes) {
+    appendU64(out, static_cast<quint64>(bytes.size()));
+    out->append(bytes);
+}
+
+void appendString(QByteArray* out, const QString& value) {
+    const QByteArray utf8 = value.toUtf8();
+    appendU32(out, static_cast<quint32>(utf8.size()));
+    out->append(utf8);
+}
+
+class Reader {
+public:
+    explicit Reader(const QByteArray& data)
+        : m_data(data) {}
+
+    bool readU32(quint32* outValue) {
+        if (m_data.size() - m_offset < 4) {
+            return false;
+        }
+        const auto* bytes = reinterpret_cast<const uchar*>(m_data.constData() + m_offset);
+        *outValue = static_cast<quint32>(bytes[0])
+            | (static_cast<quint32>(bytes[1]) << 8)
+            | (static_cast<quint32>(bytes[2]) << 16)
+            | (static_cast<quint32>(bytes[3]) << 24);
+        m_offset += 4;
+        return true;
+    }
+
+    bool readBytes(QByteArray* outBytes) {
+        quint32 low = 0;
+        quint32 high = 0;
+        if (!readU32(&low) || !readU32(&high) || high != 0) {
+            return false;
+        }
+        return readRaw(low, outBytes);
+    }
+
+    bool readString(QString* outValue) {
+        quint32 size = 0;
+        QByteArray utf8;
+        if (!readU32(&size) || !readRaw(size, &utf8)) {
+            return false;
+        }
+        *outValue = QString::fromUtf8(utf8);
+        return true;
+    }
+
+    bool atEnd() const { return m_offset == m_data.size(); }
+
+private:
+    bool readRaw(quint32 size, QByteArray* outBytes) {
+        if (static_cast<qint64>(size) > static_cast<qint64>(m_data.size() - m_offset)) {
+            return false;
+        }
+        // mid() copies each part. The copies are what make the parts safe to keep: decoded
+        // responses outlive their buffer, and a v2 plugin may retain an item's request payload
+        // after the batch call has returned.
+        *outBytes = m_data.mid(m_offset, static_cast<qsizetype>(size));
+        m_offset += static_cast<qsizetype>(size);
+        return true;
+    }
+
+    const QByteArray& m_data;
+    qsizetype m_offset = 0;
+};
+
+void setError(QString* errorMessage, const QString& message) {
+    if (errorMessage) {
+        *errorMessage = message;
+    }
+}
+
+} // namespace
+
+namespace PluginAbiBatch {
+
+bool isBatchOperation(const QString& operation) {
+    return operation == QLatin1String(APE_PLUGIN_ABI_BATCH_OPERATION);
+}
+
+QByteArray encodeRequest(const QList<Item>& items) {
+    QByteArray out;
+    appendU32(&out, static_cast<quint32>(items.size()));
+    for (const Item& item : items) {
+        appendString(&out, item.operation);
+        appendU32(&out, item.contentType);
+        appendU32(&out, item.flags);
+        appendBytes(&out, item.payload);
+    }
+    return out;
+}
+
+bool decodeRequest(const QByteArray& payload, QList<Item>* outItems, QString* errorMessage) {
+    if (!outItems) {
+        return false;
+    }
+    outItems->clear();
+
+    Reader reader(payload);
+    quint32 count = 0;
+    if (!reader.readU32(&count) || count > kMaxBatchItems) {
+        setError(errorMessage, QStringLiteral("Invalid batch request header."));
+        return false;
+    }
+
+    outItems->reserve(static_cast<qsizetype>(count));
+    for (quint32 i = 0; i < count; ++i) {
+        Item item;
+        if (!reader.readString(&item.operation)
+            || !reader.readU32(&item.contentType)
+            || !reader.readU32(&item.flags)
+            || !reader.readBytes(&item.payload)) {
+            setError(errorMessage, QStringLiteral("Invalid batch request item %1.").arg(i));
+            outItems->clear();
+            return false;
+        }
+        outItems->append(item);
+    }
+
+    if (!reader.atEnd()) {
+        setError(errorMessage, QStringLiteral("Batch request has trailing data."));
+        outItems->clear();
+        return false;
+    }
+    return true;
+}
+
+QByteArray encodeResponse(const QList<ItemResult>& results) {
+    QByteArray out;
+    appendU32(&out, static_cast<quint32>(results.size()));
+    for (const ItemResult& result : results) {
+        appendU32(&out, result.status);
+        appendU32(&out, result.contentType);
+        appendU32(&out, result.flags);
+        appendBytes(&out, result.payload);
+        appendString(&out, result.errorMessage);
+    }
+    return out;
+}
+
+bool decodeResponse(const QByteArray& payload, QList<ItemResult>* outResults, QString* errorMessage) {
+    if (!outResults) {
+        return false;
+    }
+    outResults->clear();
+
+    Reader reader(payload);
+    quint32 count = 0;
+    if (!reader.readU32(&count) || count > kMaxBatchItems) {
+        setError(errorMessage, QStringLiteral("Invalid batch response header."));
+        return false;
+    }
+
+    outResults->reserve(static_cast<qsizetype>(count));
+    for (quint32 i = 0; i < count; ++i) {
+        ItemResult result;
+        if (!reader.readU32(&result.status)
+            || !reader.readU32(&result.contentType)
+            || !reader.readU32(&result.flags)
+            || !reader.readBytes(&result.payload)
+            || !reader.readString(&result.errorMessage)) {
+            setError(errorMessage, QStringLiteral("Invalid batch response item %1.").arg(i));
+            outResults->clear();
+            return false;
+        }
+        outResults->append(result);
+    }
+
+    if (!reader.atEnd()) {
+        setError(errorMessage, QStringLiteral("Batch response has trailing data."));
+        outResults->clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace PluginAbiBatch
@@ -0,0 +1,46 @@
+//-------------------------------------------------------------------------------------
+// PluginAbiBatch.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef PLUGINABIBATCH_H
+#define PLUGINABIBATCH_H
+
+#include "PluginAbi.h"
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+// Codec for the APE_PLUGIN_ABI_BATCH_OPERATION envelope shared by the broker and tool runtimes.
+namespace PluginAbiBatch {
+
+struct Item {
+    QString operation;
+    quint32 contentType = APE_PLUGIN_ABI_CONTENT_NONE;
+    quint32 flags = 0;
+    QByteArray payload;
+};
+
+struct ItemResult {
+    quint32 status = APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR;
+    quint32 contentType = APE_PLUGIN_ABI_CONTENT_NONE;
+    quint32 flags = 0;
+    QByteArray payload;
+    QString errorMessage;
+};
+
+bool isBatchOperation(const QString& operation);
+
+QByteArray encodeRequest(const QList<Item>& items);
+bool decodeRequest(const QByteArray& payload, QList<Item>* outItems, QString* errorMessage = nullptr);
+
+QByteArray encodeResponse(const QList<ItemResult>& results);
+bool decodeResponse(const QByteArray& payload, QList<ItemResult>* outResults, QString* errorMessage = nullptr);
+
+} // namespace PluginAbiBatch
+
+#endif // PLUGINABIBATCH_H
@@ -9,19 +9,79 @@
 #include "PluginAbiBroker.h"
 
 #include "Logger.h"
+#include "PluginAbiBatch.h"
 #include "PluginManager.h"
 
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QMutexLocker>
 #include <QReadLocker>
 #include <QRegularExpression>
+#include <QSemaphore>
+#include <QStandardPaths>
+#include <QThread>
 #include <QWriteLocker>
 #include <QtAlgorithms>
+#include <algorithm>
 #include <limits>
 
+namespace {
+// Calls allowed to wait behind the running ones before the broker answers BUSY.
+constexpr int kPluginQueueDepth = 16;
+constexpr qint64 kResultCacheSpillCapacity = 256LL * 1024 * 1024;
+// Larger results are not kept in memory, where a few of them would evict every small entry. They
+// are only cached when slow enough to be written straight to the spill directory.
+constexpr qint64 kMaxResidentPayloadBytes = 1024 * 1024;
+
+// Reference handed to v2 plugins so they can hold on to a request payload without copying it.
+struct RequestPayloadRef {
+    QByteArray payload;
+    QAtomicInt refs = 1;
+};
+
+void retainRequestPayload(void* context) {
+    static_cast<RequestPayloadRef*>(context)->refs.ref();
+}
+
+void releaseRequestPayload(void* context) {
+    auto* ref = static_cast<RequestPayloadRef*>(context);
+    if (!ref->refs.deref()) {
+        delete ref;
+    }
+}
+}
+
+PluginAbiBroker::PluginAbiBroker() {
+    m_workerPool.setMaxThreadCount(std::max(2, QThread::idealThreadCount()));
+    m_resultCache.setSpillDirectory(
+        QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/APE-HOI4-Tool-Studio/plugin_cache",
+        kResultCacheSpillCapacity);
+    m_resultCache.setMaxResidentEntryBytes(kMaxResidentPayloadBytes);
+}
+
 PluginAbiBroker& PluginAbiBroker::instance() {
     static PluginAbiBroker broker;
     return broker;
 }
 
+PluginAbiBroker::Concurrency PluginAbiBroker::parseConcurrency(const QString& value, bool* ok) {
+    const QString normalized = value.trimmed().toLower();
+    if (ok) {
+        *ok = true;
+    }
+    if (normalized == QStringLiteral("reentrant")) {
+        return Concurrency::Reentrant;
+    }
+    if (normalized == QStringLiteral("thread_safe_per_session")) {
+        return Concurrency::ThreadSafePerSession;
+    }
+    if (normalized != QStringLiteral("single_threaded") && ok) {
+        *ok = false;
+    }
+    return Concurrency::SingleThreaded;
+}
+
 PluginAbiBroker::ContentType PluginAbiBroker::toContentType(quint32 value) {
     switch (value) {
     case APE_PLUGIN_ABI_CONTENT_JSON_UTF8:
@@ -72,6 +132,7 @@ PluginAbiBroker::LoadedPlugin* PluginAbiBroker::loadPluginLocked(const QString&
     loaded->freeResponse = reinterpret_cast<ApePluginFreeResponseFn>(loaded->library.resolve("APE_Plugin_FreeResponse"));
     loaded->getName = reinterpret_cast<ApePluginGetNameFn>(loaded->library.resolve("APE_Plugin_GetName"));
     loaded->getAbiVersion = reinterpret_cast<ApePluginGetAbiVersionFn>(loaded->library.resolve("APE_Plugin_GetAbiVersion"));
+    loaded->invokeStreaming = reinterpret_cast<ApePluginInvokeStreamingFn>(loaded->library.resolve("APE_Plugin_InvokeStreaming"));
 
     if (!loaded->invoke || !loaded->freeResponse || !loaded->getName || !loaded->getAbiVersion) {
         delete loaded;
@@ -81,7 +142,8 @@ PluginAbiBroker::LoadedPlugin* PluginAbiBroker::loadPluginLocked(const QString&
         return nullptr;
     }
 
-    if (loaded->getAbiVersion() != APE_PLUGIN_ABI_VERSION) {
+    loaded->abiVersion = loaded->getAbiVersion();
+    if (loaded->abiVersion != APE_PLUGIN_ABI_VERSION && loaded->abiVersion != APE_PLUGIN_ABI_VERSION_2) {
         delete loaded;
         if (errorMessage) {
             *errorMessage = QStringLiteral("Plugin ABI version is unsupported.");
@@ -98,26 +160,62 @@ PluginAbiBroker::LoadedPlugin* PluginAbiBroker::loadPluginLocked(const QString&
         return nullptr;
     }
 
+    // The plugin's own answer wins over the descriptor, since it describes the binary actually loaded.
+    bool descriptorConcurrencyValid = false;
+    loaded->concurrency = parseConcurrency(info.concurrency, &descriptorConcurrencyValid);
+    if (!info.concurrency.isEmpty() && !descriptorConcurrencyValid) {
+        Logger::instance().logWarning("PluginAbiBroker",
+                                      QStringLiteral("Unknown concurrency \"%1\" declared by plugin %2; using single_threaded.")
+                                          .arg(info.concurrency, pluginName));
+    }
+    const auto getConcurrency = reinterpret_cast<ApePluginGetConcurrencyFn>(loaded->library.resolve("APE_Plugin_GetConcurrency"));
+    if (getConcurrency) {
+        switch (getConcurrency()) {
+        case APE_PLUGIN_ABI_CONCURRENCY_REENTRANT:
+            loaded->concurrency = Concurrency::Reentrant;
+            break;
+        case APE_PLUGIN_ABI_CONCURRENCY_THREAD_SAFE_PER_SESSION:
+            loaded->concurrency = Concurrency::ThreadSafePerSession;
+            break;
+        default:
+            loaded->concurrency = Concurrency::SingleThreaded;
+            break;
+        }
+    }
+    loaded->maxInFlight = loaded->concurrency == Concurrency::SingleThreaded
+        ? 1
+        : m_workerPool.maxThreadCount();
+    loaded->statistics.concurrency = loaded->concurrency;
+
+    loaded->isOperationCacheable =
+        reinterpret_cast<ApePluginIsOperationCacheableFn>(loaded->library.resolve("APE_Plugin_IsOperationCacheable"));
+    for (const QString& operation : info.cacheableOperations) {
+        loaded->cacheableOperations.insert(operation);
+    }
+    const QFileInfo libraryInfo(info.libraryPath);
+    loaded->cacheFingerprint = QStringLiteral("%1|%2|%3|%4").arg(
+        pluginName,
+        info.version,
+        QString::number(libraryInfo.size()),
+        QString::number(libraryInfo.lastModified().toMSecsSinceEpoch()));
+
     m_plugins.insert(pluginName, loaded);
     return loaded;
 }
 
-PluginAbiBroker::Response PluginAbiBroker::invoke(const Request& request) {
-    Response result;
-    result.contentType = request.contentType;
-
+PluginAbiBroker::LoadedPlugin* PluginAbiBroker::resolvePlugin(const Request& request, Response* failure) {
     const QString pluginName = request.pluginName.trimmed();
     const QString operation = request.operation.trimmed();
     if (pluginName.isEmpty() || operation.isEmpty()) {
-        result.status = APE_PLUGIN_ABI_STATUS_INVALID_ARGUMENT;
-        result.errorMessage = QStringLiteral("Plugin name or operation is empty.");
-        return result;
+        failure->status = APE_PLUGIN_ABI_STATUS_INVALID_ARGUMENT;
+        failure->errorMessage = QStringLiteral("Plugin name or operation is empty.");
+        return nullptr;
     }
 
     if (!request.authorizedDependencies.contains(pluginName, Qt::CaseSensitive)) {
-        result.status = APE_PLUGIN_ABI_STATUS_UNAUTHORIZED;
-        result.errorMessage = QStringLiteral("Plugin operation is not authorized.");
-        return result;
+        failure->status = APE_PLUGIN_ABI_STATUS_UNAUTHORIZED;
+        failure->errorMessage = QStringLiteral("Plugin operation is not authorized.");
+        return nullptr;
     }
 
     LoadedPlugin* plugin = nullptr;
@@ -130,38 +228,312 @@ PluginAbiBroker::Response PluginAbiBroker::invoke(const Request& request) {
         QString loadError;
         plugin = loadPluginLocked(pluginName, &loadError);
         if (!plugin) {
-            result.status = APE_PLUGIN_ABI_STATUS_PLUGIN_UNAVAILABLE;
-            result.errorMessage = sanitizePluginError(loadError);
-            return result;
+            failure->status = APE_PLUGIN_ABI_STATUS_PLUGIN_UNAVAILABLE;
+            failure->errorMessage = sanitizePluginError(loadError);
+            return nullptr;
+        }
+    }
+    return plugin;
+}
+
+bool PluginAbiBroker::tryAcquireCallSlot(LoadedPlugin* plugin, Response* failure) {
+    const int inFlight = plugin->inFlight.fetchAndAddOrdered(1) + 1;
+    if (inFlight > plugin->maxInFlight + kPluginQueueDepth) {
+        plugin->inFlight.fetchAndAddOrdered(-1);
+        {
+            QMutexLocker locker(&plugin->statisticsMutex);
+            ++plugin->statistics.rejectedCalls;
+        }
+        failure->status = APE_PLUGIN_ABI_STATUS_BUSY;
+        failure->errorMessage = QStringLiteral("Plugin is busy; too many pending calls.");
+        return false;
+    }
+
+    QMutexLocker locker(&plugin->statisticsMutex);
+    plugin->statistics.peakInFlight = std::max(plugin->statistics.peakInFlight, inFlight);
+    return true;
+}
+
+QMutex* PluginAbiBroker::callMutexFor(LoadedPlugin* plugin, const QString& sessionId) {
+    switch (plugin->concurrency) {
+    case Concurrency::Reentrant:
+        return nullptr;
+    case Concurrency::ThreadSafePerSession:
+        {
+            QMutexLocker locker(&plugin->sessionMutex);
+            QMutex*& mutex = plugin->sessionCallMutexes[sessionId];
+            if (!mutex) {
+                mutex = new QMutex;
+            }
+            return mutex;
+        }
+    case Concurrency::SingleThreaded:
+    default:
+        return &plugin->callMutex;
+    }
+}
+
+PluginAbiBroker::Response PluginAbiBroker::invoke(const Request& request) {
+    Response failure;
+    failure.contentType = request.contentType;
+
+    LoadedPlugin* plugin = resolvePlugin(request, &failure);
+    if (!plugin || !tryAcquireCallSlot(plugin, &failure)) {
+        return failure;
+    }
+    return callPlugin(plugin, request);
+}
+
+void PluginAbiBroker::invokeAsync(const Request& request, ResponseCallback callback) {
+    Response failure;
+    failure.contentType = request.contentType;
+
+    LoadedPlugin* plugin = resolvePlugin(request, &failure);
+    if (!plugin || !tryAcquireCallSlot(plugin, &failure)) {
+        if (callback) {
+            callback(failure);
+        }
+        return;
+    }
+
+    auto task = [this, plugin, request, callback]() {
+        const Response response = callPlugin(plugin, request);
+        if (callback) {
+            callback(response);
+        }
+    };
+    if (plugin->concurrency == Concurrency::Reentrant) {
+        m_workerPool.start(std::move(task));
+        return;
+    }
+    startInLane(plugin, laneKeyFor(plugin, request.sessionId), std::move(task));
+}
+
+QString PluginAbiBroker::laneKeyFor(const LoadedPlugin* plugin, const QString& sessionId) {
+    return plugin->concurrency == Concurrency::ThreadSafePerSession ? sessionId : QString();
+}
+
+void PluginAbiBroker::startInLane(LoadedPlugin* plugin, const QString& laneKey, std::function<void()> task) {
+    {
+        QMutexLocker locker(&plugin->laneMutex);
+        const auto lane = plugin->lanes.find(laneKey);
+        if (lane != plugin->lanes.end()) {
+            lane->pending.push_back(std::move(task));
+            return;
+        }
+        plugin->lanes.insert(laneKey, CallLane{});
+    }
+    runLane(plugin, laneKey, std::move(task));
+}
+
+void PluginAbiBroker::runLane(LoadedPlugin* plugin, const QString& laneKey, std::function<void()> task) {
+    // Only the lane's head call holds a pool thread; the next one is submitted when it returns, so
+    // a burst of calls to a serialized plugin never parks threads other plugins could use.
+    m_workerPool.start([this, plugin, laneKey, task]() {
+        task();
+        std::function<void()> next;
+        {
+            QMutexLocker locker(&plugin->laneMutex);
+            const auto lane = plugin->lanes.find(laneKey);
+            if (lane->pending.empty()) {
+                plugin->lanes.erase(lane);
+                return;
+            }
+            next = std::move(lane->pending.front());
+            lane->pending.pop_front();
         }
+        runLane(plugin, laneKey, std::move(next));
+    });
+}
+
+PluginAbiBroker::Statistics PluginAbiBroker::statistics(const QString& pluginName) const {
+    QReadLocker reader(&m_lock);
+    const LoadedPlugin* plugin = m_plugins.value(pluginName.trimmed(), nullptr);
+    if (!plugin) {
+        return Statistics{};
     }
 
-    const QByteArray pluginNameUtf8 = pluginName.toUtf8();
-    const QByteArray operationUtf8 = operation.toUtf8();
+    QMutexLocker locker(&plugin->statisticsMutex);
+    Statistics result = plugin->statistics;
+    result.inFlight = plugin->inFlight.loadRelaxed();
+    return result;
+}
 
-    ApePluginAbiRequest abiRequest;
-    abiRequest.abiVersion = APE_PLUGIN_ABI_VERSION;
+PluginResultCache::Statistics PluginAbiBroker::resultCacheStatistics() const {
+    return m_resultCache.statistics();
+}
+
+bool PluginAbiBroker::isCacheable(const LoadedPlugin* plugin, const Request& request) {
+    const QString operation = request.operation.trimmed();
+    if (plugin->isOperationCacheable) {
+        return plugin->isOperationCacheable(operation.toUtf8().constData()) != 0;
+    }
+    return plugin->cacheableOperations.contains(operation);
+}
+
+PluginAbiBroker::Response PluginAbiBroker::executeCachedCall(LoadedPlugin* plugin, const Request& request) {
+    if (!isCacheable(plugin, request)) {
+        return executeCall(plugin, request);
+    }
+
+    const QByteArray key = PluginResultCache::makeKey(plugin->cacheFingerprint,
+                                                      request.operation.trimmed(),
+                                                      static_cast<quint32>(request.contentType),
+                                                      request.flags,
+                                                      request.payload);
+    PluginResultCache::Entry cached;
+    if (m_resultCache.lookup(key, &cached)) {
+        {
+            QMutexLocker locker(&plugin->statisticsMutex);
+            ++plugin->statistics.cacheHits;
+        }
+        Response result;
+        result.success = true;
+        result.status = APE_PLUGIN_ABI_STATUS_OK;
+        result.contentType = toContentType(cached.contentType);
+        result.flags = cached.flags;
+        result.payload = cached.payload;
+        return result;
+    }
+    {
+        QMutexLocker locker(&plugin->statisticsMutex);
+        ++plugin->statistics.cacheMisses;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    Response result = executeCall(plugin, request);
+    const qint64 costMicroseconds = timer.nsecsElapsed() / 1000;
+    if (result.success && m_resultCache.accepts(result.payload.size(), costMicroseconds)) {
+        PluginResultCache::Entry entry;
+        entry.contentType = static_cast<quint32>(result.contentType);
+        entry.flags = result.flags;
+        // A v2 payload borrows plugin memory, so the cache keeps its own copy.
+        entry.payload = result.payloadOwner
+            ? QByteArray(result.payload.constData(), result.payload.size())
+            : result.payload;
+        m_resultCache.insert(key, entry, costMicroseconds);
+    }
+    return result;
+}
+
+bool PluginAbiBroker::isCancelled(const Request& request) {
+    return request.cancelToken && request.cancelToken->loadRelaxed() != 0;
+}
+
+int PluginAbiBroker::streamEmitChunk(void* context, uint32_t contentType, const uint8_t* data, uint64_t size) {
+    auto* stream = static_cast<StreamContext*>(context);
+    if (!stream->cancelled && stream->request->streamHandler && data && size > 0
+        && size <= static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        StreamEvent event;
+        event.chunkContentType = toContentType(contentType);
+        event.chunk = QByteArray(reinterpret_cast<const char*>(data), static_cast<int>(size));
+        stream->cancelled = !stream->request->streamHandler(event);
+    }
+    return streamIsCancelled(context);
+}
+
+int PluginAbiBroker::streamReportProgress(void* context, uint64_t completed, uint64_t total, const char* messageUtf8) {
+    auto* stream = static_cast<StreamContext*>(context);
+    if (!stream->cancelled && stream->request->streamHandler) {
+        StreamEvent event;
+        event.completed = completed;
+        event.total = total;
+        event.message = messageUtf8 ? QString::fromUtf8(messageUtf8) : QString();
+        stream->cancelled = !stream->request->streamHandler(event);
+    }
+    return streamIsCancelled(context);
+}
+
+int PluginAbiBroker::streamIsCancelled(void* context) {
+    auto* stream = static_cast<StreamContext*>(context);
+    stream->cancelled = stream->cancelled || isCancelled(*stream->request);
+    return stream->cancelled ? 1 : 0;
+}
+
+PluginAbiBroker::Response PluginAbiBroker::executeCall(LoadedPlugin* plugin, const Request& request) {
+    Response result;
+    result.contentType = request.contentType;
+    if (isCancelled(request)) {
+        result.status = APE_PLUGIN_ABI_STATUS_CANCELLED;
+        result.errorMessage = QStringLiteral("Plugin operation was cancelled.");
+        return result;
+    }
+
+    const QByteArray pluginNameUtf8 = plugin->name.toUtf8();
+    const QByteArray operationUtf8 = request.operation.trimmed().toUtf8();
+
+    const bool useV2 = plugin->abiVersion == APE_PLUGIN_ABI_VERSION_2;
+    auto* payloadRef = useV2 ? new RequestPayloadRef{request.payload} : nullptr;
+
+    ApePluginAbiRequestV2 abiRequestV2;
+    ApePluginAbiRequest& abiRequest = abiRequestV2.base;
+    abiRequest.abiVersion = plugin->abiVersion;
     abiRequest.pluginNameUtf8 = pluginNameUtf8.constData();
     abiRequest.operationUtf8 = operationUtf8.constData();
     abiRequest.contentType = static_cast<quint32>(request.contentType);
     abiRequest.flags = request.flags;
     abiRequest.payload.data = reinterpret_cast<const uint8_t*>(request.payload.constData());
     abiRequest.payload.size = static_cast<uint64_t>(request.payload.size());
+    abiRequestV2.retainPayload = useV2 ? &retainRequestPayload : nullptr;
+    abiRequestV2.releasePayload = useV2 ? &releaseRequestPayload : nullptr;
+    abiRequestV2.payloadContext = payloadRef;
 
-    ApePluginAbiResponse abiResponse;
-    abiResponse.abiVersion = APE_PLUGIN_ABI_VERSION;
+    ApePluginAbiResponseV2 abiResponseV2;
+    ApePluginAbiResponse& abiResponse = abiResponseV2.base;
+    abiResponse.abiVersion = plugin->abiVersion;
     abiResponse.status = APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR;
     abiResponse.contentType = APE_PLUGIN_ABI_CONTENT_NONE;
     abiResponse.flags = 0;
     abiResponse.payload = nullptr;
     abiResponse.payloadSize = 0;
     abiResponse.errorUtf8 = nullptr;
+    abiResponseV2.ownedPayload = ApePluginAbiOwnedBuffer{nullptr, 0, nullptr, nullptr};
 
-    const int invokeResult = plugin->invoke(&abiRequest, &abiResponse);
+    // Async calls are already serialized by their lane; the mutex orders them against synchronous
+    // invoke() callers, which wait on their own threads.
+    QMutex* callMutex = callMutexFor(plugin, request.sessionId);
+    if (callMutex) {
+        callMutex->lock();
+    }
+    // The call may have been cancelled while it waited for the plugin.
+    if (isCancelled(request)) {
+        if (callMutex) {
+            callMutex->unlock();
+        }
+        if (payloadRef) {
+            releaseRequestPayload(payloadRef);
+        }
+        result.status = APE_PLUGIN_ABI_STATUS_CANCELLED;
+        result.errorMessage = QStringLiteral("Plugin operation was cancelled.");
+        return result;
+    }
+    StreamContext streamContext;
+    streamContext.request = &request;
+    const ApePluginAbiStreamHost streamHost{&streamContext, &streamEmitChunk, &streamReportProgress, &streamIsCancelled};
+    const bool streaming = plugin->invokeStreaming && (request.streamHandler || request.cancelToken);
+    const int invokeResult = streaming
+        ? plugin->invokeStreaming(&abiRequest, &streamHost, &abiResponse)
+        : plugin->invoke(&abiRequest, &abiResponse);
+    if (payloadRef) {
+        releaseRequestPayload(payloadRef);
+    }
     result.status = abiResponse.status;
     result.contentType = toContentType(abiResponse.contentType);
     result.flags = abiResponse.flags;
-    if (abiResponse.payload && abiResponse.payloadSize > 0) {
+
+    const ApePluginAbiOwnedBuffer owned = useV2 ? abiResponseV2.ownedPayload : ApePluginAbiOwnedBuffer{nullptr, 0, nullptr, nullptr};
+    if (owned.release) {
+        // Adopt the plugin's buffer: the payload is a view and the owner hands it back on destruction.
+        result.payloadOwner = std::shared_ptr<void>(owned.releaseContext, owned.release);
+        if (owned.size > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+            result.payloadOwner.reset();
+            result.status = APE_PLUGIN_ABI_STATUS_BUFFER_TOO_LARGE;
+            result.errorMessage = QStringLiteral("Plugin response is too large.");
+        } else if (owned.data && owned.size > 0) {
+            result.payload = QByteArray::fromRawData(reinterpret_cast<const char*>(owned.data), static_cast<int>(owned.size));
+        }
+    } else if (abiResponse.payload && abiResponse.payloadSize > 0) {
         if (abiResponse.payloadSize <= static_cast<uint64_t>(std::numeric_limits<int>::max())) {
             result.payload = QByteArray(reinterpret_cast<const char*>(abiResponse.payload), static_cast<int>(abiResponse.payloadSize));
         } else {
@@ -172,17 +544,136 @@ PluginAbiBroker::Response PluginAbiBroker::invoke(const Request& request) {
     if (abiResponse.errorUtf8) {
         result.errorMessage = sanitizePluginError(QString::fromUtf8(abiResponse.errorUtf8));
     }
-    result.success = invokeResult == 0 && abiResponse.status == APE_PLUGIN_ABI_STATUS_OK;
+    result.success = invokeResult == 0 && result.status == APE_PLUGIN_ABI_STATUS_OK;
     if (!result.success && result.errorMessage.isEmpty()) {
         result.errorMessage = QStringLiteral("Plugin operation failed.");
     }
 
     plugin->freeResponse(&abiResponse);
+    if (callMutex) {
+        callMutex->unlock();
+    }
+    return result;
+}
+
+PluginAbiBroker::Response PluginAbiBroker::executeBatch(LoadedPlugin* plugin, const Request& request) {
+    Response result;
+    result.contentType = ContentType::BinaryEnvelope;
+
+    QList<PluginAbiBatch::Item> items;
+    QString decodeError;
+    if (request.contentType != ContentType::BinaryEnvelope
+        || !PluginAbiBatch::decodeRequest(request.payload, &items, &decodeError)) {
+        result.status = APE_PLUGIN_ABI_STATUS_INVALID_ARGUMENT;
+        result.errorMessage = decodeError.isEmpty() ? QStringLiteral("Invalid batch request.") : decodeError;
+        return result;
+    }
+
+    QList<PluginAbiBatch::ItemResult> itemResults(items.size());
+    PluginAbiBatch::ItemResult* const itemResultData = itemResults.data();
+    // Set when the caller's stream handler asks to stop; items not started yet are skipped.
+    QAtomicInt stopRequested(0);
+    QMutex progressMutex;
+    quint64 completedItems = 0;
+    auto runItem = [&](qsizetype index) {
+        const PluginAbiBatch::Item& item = items.at(index);
+        PluginAbiBatch::ItemResult& itemResult = itemResultData[index];
+        if (stopRequested.loadRelaxed() != 0 || isCancelled(request)) {
+            itemResult.status = APE_PLUGIN_ABI_STATUS_CANCELLED;
+            itemResult.errorMessage = QStringLiteral("Plugin operation was cancelled.");
+            return;
+        }
+        if (item.operation.trimmed().isEmpty() || PluginAbiBatch::isBatchOperation(item.operation.trimmed())) {
+            itemResult.status = APE_PLUGIN_ABI_STATUS_INVALID_ARGUMENT;
+            itemResult.errorMessage = QStringLiteral("Invalid batch item operation.");
+            return;
+        }
+
+        Request itemRequest;
+        itemRequest.pluginName = request.pluginName;
+        itemRequest.operation = item.operation;
+        itemRequest.contentType = toContentType(item.contentType);
+        itemRequest.payload = item.payload;
+        itemRequest.flags = item.flags;
+        itemRequest.sessionId = request.sessionId;
+        itemRequest.cancelToken = request.cancelToken;
+
+        const Response itemResponse = executeCachedCall(plugin, itemRequest);
+        itemResult.status = itemResponse.status;
+        itemResult.contentType = static_cast<quint32>(itemResponse.contentType);
+        itemResult.flags = itemResponse.flags;
+        itemResult.payload = itemResponse.payload;
+        itemResult.payload.detach();
+        itemResult.errorMessage = itemResponse.success ? QString() : itemResponse.errorMessage;
+    };
+
+    QAtomicInteger<qsizetype> nextIndex(0);
+    auto drain = [&]() {
+        for (qsizetype index = nextIndex.fetchAndAddRelaxed(1); index < items.size(); index = nextIndex.fetchAndAddRelaxed(1)) {
+            runItem(index);
+            if (request.streamHandler) {
+                // One event per finished item keeps a long batch from looking stalled to the tool host.
+                QMutexLocker locker(&progressMutex);
+                StreamEvent event;
+                event.completed = ++completedItems;
+                event.total = static_cast<quint64>(items.size());
+                if (!request.streamHandler(event)) {
+                    stopRequested.storeRelaxed(1);
+                }
+            }
+        }
+    };
+
+    // Only a reentrant plugin can run items side by side; serialized ones would just queue on the
+    // call mutex. Helpers borrow idle broker pool threads with tryStart, so concurrent batches never
+    // exceed the pool, and the caller thread always drains too so a batch finishes even when the
+    // pool is fully busy.
+    if (plugin->concurrency == Concurrency::Reentrant) {
+        const int helperCount = static_cast<int>(std::min<qsizetype>(items.size(), plugin->maxInFlight)) - 1;
+        QSemaphore helpersDone;
+        int startedHelpers = 0;
+        for (int i = 0; i < helperCount; ++i) {
+            if (!m_workerPool.tryStart([&drain, &helpersDone]() {
+                    drain();
+                    helpersDone.release();
+                })) {
+                break;
+            }
+            ++startedHelpers;
+        }
+        drain();
+        helpersDone.acquire(startedHelpers);
+    } else {
+        drain();
+    }
+
+    result.payload = PluginAbiBatch::encodeResponse(itemResults);
+    result.status = APE_PLUGIN_ABI_STATUS_OK;
+    result.success = true;
+    return result;
+}
+
+PluginAbiBroker::Response PluginAbiBroker::callPlugin(LoadedPlugin* plugin, const Request& request) {
+    QElapsedTimer timer;
+    timer.start();
+
+    const Response result = PluginAbiBatch::isBatchOperation(request.operation.trimmed())
+        ? executeBatch(plugin, request)
+        : executeCachedCall(plugin, request);
+
+    plugin->inFlight.fetchAndAddOrdered(-1);
+    {
+        QMutexLocker locker(&plugin->statisticsMutex);
+        ++plugin->statistics.completedCalls;
+        plugin->statistics.totalCallMicroseconds += static_cast<quint64>(timer.nsecsElapsed() / 1000);
+    }
     return result;
 }
 
 void PluginAbiBroker::clearCache() {
+    m_workerPool.waitForDone();
     QWriteLocker writer(&m_lock);
     qDeleteAll(m_plugins);
     m_plugins.clear();
+    m_resultCache.clearMemory();
 }
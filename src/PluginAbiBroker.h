@@ -10,14 +10,22 @@
 #define PLUGINABIBROKER_H
 
 #include "PluginAbi.h"
+#include "PluginResultCache.h"
 
+#include <QAtomicInt>
 #include <QByteArray>
 #include <QHash>
 #include <QLibrary>
 #include <QMutex>
 #include <QReadWriteLock>
+#include <QSet>
 #include <QString>
 #include <QStringList>
+#include <QThreadPool>
+
+#include <deque>
+#include <functional>
+#include <memory>
 
 class PluginAbiBroker {
 public:
@@ -28,6 +36,24 @@ public:
         BinaryEnvelope = APE_PLUGIN_ABI_CONTENT_BINARY_ENVELOPE
     };
 
+    enum class Concurrency : quint32 {
+        SingleThreaded = APE_PLUGIN_ABI_CONCURRENCY_SINGLE_THREADED,
+        Reentrant = APE_PLUGIN_ABI_CONCURRENCY_REENTRANT,
+        ThreadSafePerSession = APE_PLUGIN_ABI_CONCURRENCY_THREAD_SAFE_PER_SESSION
+    };
+
+    struct StreamEvent {
+        quint64 completed = 0;
+        quint64 total = 0;
+        QString message;
+        // Partial result emitted by the plugin; empty for pure progress events.
+        ContentType chunkContentType = ContentType::None;
+        QByteArray chunk;
+    };
+
+    // Returning false asks the plugin to cancel the call.
+    using StreamHandler = std::function<bool(const StreamEvent&)>;
+
     struct Request {
         QString pluginName;
         QString operation;
@@ -35,23 +61,63 @@ public:
         QByteArray payload;
         quint32 flags = 0;
         QStringList authorizedDependencies;
+        // Calls sharing a session id are serialized for thread-safe-per-session plugins.
+        QString sessionId;
+        // Progress and chunk events are delivered on the thread running the call, or for batches on
+        // whichever thread finished the item, one event at a time. Plugins without
+        // APE_Plugin_InvokeStreaming only produce the final response.
+        StreamHandler streamHandler;
+        // Setting the token to non-zero from any thread cancels the call.
+        std::shared_ptr<QAtomicInt> cancelToken;
     };
 
     struct Response {
         bool success = false;
         quint32 status = APE_PLUGIN_ABI_STATUS_INTERNAL_ERROR;
         ContentType contentType = ContentType::None;
+        // For ABI v2 plugins this is a raw view into plugin memory kept alive by payloadOwner;
+        // keep both together, or detach() the payload before dropping the owner.
         QByteArray payload;
+        std::shared_ptr<void> payloadOwner;
         QString errorMessage;
         quint32 flags = 0;
     };
 
+    struct Statistics {
+        Concurrency concurrency = Concurrency::SingleThreaded;
+        quint64 completedCalls = 0;
+        quint64 rejectedCalls = 0;
+        quint64 totalCallMicroseconds = 0;
+        int inFlight = 0;
+        int peakInFlight = 0;
+        quint64 cacheHits = 0;
+        quint64 cacheMisses = 0;
+    };
+
+    using ResponseCallback = std::function<void(const Response&)>;
+
     static PluginAbiBroker& instance();
 
+    // Operation APE_PLUGIN_ABI_BATCH_OPERATION is expanded here into its sub-operations, so every
+    // plugin supports batching; items of a reentrant plugin run in parallel on idle broker pool
+    // threads. The stream handler gets one progress event per finished item.
     Response invoke(const Request& request);
+    // Runs the call on the broker worker pool and delivers the response on that worker thread.
+    // Calls to a single-threaded plugin, or to one session of a per-session plugin, wait in a
+    // queue of their own and only take a pool thread once the previous call has finished.
+    void invokeAsync(const Request& request, ResponseCallback callback);
+    Statistics statistics(const QString& pluginName) const;
+    // Shared by all plugins; operations opt in through the descriptor's cacheable_operations key
+    // or the APE_Plugin_IsOperationCacheable export. Results over 1 MiB are never kept in memory;
+    // they are cached only when slow enough to be written straight to disk.
+    PluginResultCache::Statistics resultCacheStatistics() const;
     void clearCache();
 
 private:
+    struct CallLane {
+        std::deque<std::function<void()>> pending;
+    };
+
     struct LoadedPlugin {
         QString name;
         QLibrary library;
@@ -59,17 +125,58 @@ private:
         ApePluginFreeResponseFn freeResponse = nullptr;
         ApePluginGetNameFn getName = nullptr;
         ApePluginGetAbiVersionFn getAbiVersion = nullptr;
+        ApePluginInvokeStreamingFn invokeStreaming = nullptr;
+        ApePluginIsOperationCacheableFn isOperationCacheable = nullptr;
+        QSet<QString> cacheableOperations;
+        QString cacheFingerprint;
+        quint32 abiVersion = APE_PLUGIN_ABI_VERSION;
+        Concurrency concurrency = Concurrency::SingleThreaded;
         QMutex callMutex;
+        QMutex sessionMutex;
+        QHash<QString, QMutex*> sessionCallMutexes;
+        // Pending async calls per serialization key (see laneKeyFor); a lane exists while one of
+        // its calls is running.
+        QMutex laneMutex;
+        QHash<QString, CallLane> lanes;
+        QAtomicInt inFlight;
+        int maxInFlight = 1;
+        mutable QMutex statisticsMutex;
+        Statistics statistics;
+
+        ~LoadedPlugin() { qDeleteAll(sessionCallMutexes); }
     };
 
-    PluginAbiBroker() = default;
+    PluginAbiBroker();
 
     LoadedPlugin* loadPluginLocked(const QString& pluginName, QString* errorMessage);
+    LoadedPlugin* resolvePlugin(const Request& request, Response* failure);
+    bool tryAcquireCallSlot(LoadedPlugin* plugin, Response* failure);
+    Response callPlugin(LoadedPlugin* plugin, const Request& request);
+    Response executeCachedCall(LoadedPlugin* plugin, const Request& request);
+    Response executeCall(LoadedPlugin* plugin, const Request& request);
+    Response executeBatch(LoadedPlugin* plugin, const Request& request);
+    QMutex* callMutexFor(LoadedPlugin* plugin, const QString& sessionId);
+    static QString laneKeyFor(const LoadedPlugin* plugin, const QString& sessionId);
+    void startInLane(LoadedPlugin* plugin, const QString& laneKey, std::function<void()> task);
+    void runLane(LoadedPlugin* plugin, const QString& laneKey, std::function<void()> task);
+    static bool isCacheable(const LoadedPlugin* plugin, const Request& request);
+    struct StreamContext {
+        const Request* request = nullptr;
+        bool cancelled = false;
+    };
+
+    static int streamEmitChunk(void* context, uint32_t contentType, const uint8_t* data, uint64_t size);
+    static int streamReportProgress(void* context, uint64_t completed, uint64_t total, const char* messageUtf8);
+    static int streamIsCancelled(void* context);
+    static bool isCancelled(const Request& request);
+    static Concurrency parseConcurrency(const QString& value, bool* ok);
     static QString sanitizePluginError(const QString& message);
     static ContentType toContentType(quint32 value);
 
-    QReadWriteLock m_lock;
+    mutable QReadWriteLock m_lock;
     QHash<QString, LoadedPlugin*> m_plugins;
+    QThreadPool m_workerPool;
+    mutable PluginResultCache m_resultCache;
 };
 
 #endif // PLUGINABIBROKER_H
@@ -48,6 +48,8 @@ bool parseDescriptorFile(const QString& filePath, PluginInfo& outInfo, QString*
     QString version;
     QString supportedVersion;
     QString author;
+    QString concurrency;
+    QStringList cacheableOperations;
 
     const QStringList lines = QString::fromUtf8(file.readAll()).split('\n');
     file.close();
@@ -71,6 +73,12 @@ bool parseDescriptorFile(const QString& filePath, PluginInfo& outInfo, QString*
             supportedVersion = value;
         } else if (key == "author") {
             author = value;
+        } else if (key == "concurrency") {
+            concurrency = value.toLower();
+        } else if (key == "cacheable_operations") {
+            for (const QString& operation : value.split(',', Qt::SkipEmptyParts)) {
+                cacheableOperations.append(operation.trimmed());
+            }
         }
     }
 
@@ -97,6 +105,8 @@ bool parseDescriptorFile(const QString& filePath, PluginInfo& outInfo, QString*
     outInfo.version = version;
     outInfo.compatibleVersion = supportedVersion;
     outInfo.author = author;
+    outInfo.concurrency = concurrency;
+    outInfo.cacheableOperations = cacheableOperations;
     outInfo.directoryPath = directoryPath;
     outInfo.descriptorPath = descriptorInfo.absoluteFilePath();
     outInfo.licensePath = QFile::exists(licensePath) ? licensePath : QString();
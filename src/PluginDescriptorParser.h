@@ -22,6 +22,8 @@ struct PluginInfo {
     QString libraryPath;
     QString descriptorPath;
     QString licensePath;
+    QString concurrency;
+    QStringList cacheableOperations;
     bool official = false;
 
     bool isValid() const {
@@ -0,0 +1,297 @@
+//-------------------------------------------------------------------------------------
+// PluginResultCache.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "PluginResultCache.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+constexpr qint64 kDefaultMemoryCapacity = 64LL * 1024 * 1024;
+// Only results that took at least this long to compute are worth a disk round trip.
+constexpr qint64 kSpillMinimumMicroseconds = 200 * 1000;
+constexpr char kSpillMagic[4] = {'A', 'P', 'R', 'C'};
+constexpr quint32 kSpillFormatVersion = 1;
+constexpr int kSpillHeaderSize = 16;
+
+qint64 entryCost(const QByteArray& key, const PluginResultCache::Entry& entry) {
+    return static_cast<qint64>(key.size()) + static_cast<qint64>(entry.payload.size());
+}
+
+void appendU32(QByteArray* out, quint32 value) {
+    const quint32 little = qToLittleEndian(value);
+    out->append(reinterpret_cast<const char*>(&little), 4);
+}
+}
+
+PluginResultCache::PluginResultCache()
+    : m_memoryCapacity(kDefaultMemoryCapacity)
+    , m_maxResidentEntryBytes(std::numeric_limits<qint64>::max()) {
+}
+
+QByteArray PluginResultCache::makeKey(const QString& pluginFingerprint,
+                                      const QString& operation,
+                                      quint32 contentType,
+                                      quint32 flags,
+                                      const QByteArray& payload) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(pluginFingerprint.toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(operation.toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    QByteArray header;
+    appendU32(&header, contentType);
+    appendU32(&header, flags);
+    hash.addData(header);
+    hash.addData(payload);
+    return hash.result();
+}
+
+bool PluginResultCache::lookup(const QByteArray& key, Entry* outEntry) {
+    QString spillPath;
+    {
+        QMutexLocker locker(&m_mutex);
+        const auto it = m_index.constFind(key);
+        if (it != m_index.constEnd()) {
+            m_lru.splice(m_lru.begin(), m_lru, it.value());
+            if (outEntry) {
+                *outEntry = it.value()->entry;
+            }
+            ++m_statistics.hits;
+            return true;
+        }
+
+        if (!m_spillDirectory.isEmpty()) {
+            loadDiskIndexLocked();
+            if (m_diskEntries.contains(key)) {
+                spillPath = spillPathFor(key);
+            }
+        }
+        if (spillPath.isEmpty()) {
+            ++m_statistics.misses;
+            return false;
+        }
+    }
+
+    Entry entry;
+    const bool loaded = readSpill(spillPath, &entry);
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!loaded) {
+            ++m_statistics.misses;
+            return false;
+        }
+        ++m_statistics.hits;
+        ++m_statistics.diskHits;
+    }
+
+    // The spill file stays where it is, so the promoted entry never needs to be written again.
+    insert(key, entry, 0);
+    if (outEntry) {
+        *outEntry = entry;
+    }
+    return true;
+}
+
+void PluginResultCache::insert(const QByteArray& key, const Entry& entry, qint64 costMicroseconds) {
+    QList<Node> spilled;
+    {
+        QMutexLocker locker(&m_mutex);
+        const qint64 cost = entryCost(key, entry);
+        if (cost > residentEntryLimitLocked()) {
+            // Too large to keep resident; expensive results still go straight to disk.
+            if (spillsDirectlyLocked(costMicroseconds) && !m_diskEntries.contains(key)) {
+                spilled.append(Node{key, entry, costMicroseconds});
+            }
+        } else {
+            const auto existing = m_index.find(key);
+            if (existing != m_index.end()) {
+                m_memoryBytes -= entryCost(key, existing.value()->entry);
+                m_lru.erase(existing.value());
+                m_index.erase(existing);
+            }
+            m_lru.push_front(Node{key, entry, costMicroseconds});
+            m_index.insert(key, m_lru.begin());
+            m_memoryBytes += cost;
+            evictLocked(&spilled);
+        }
+    }
+    writeSpills(spilled);
+}
+
+bool PluginResultCache::accepts(qint64 payloadBytes, qint64 costMicroseconds) const {
+    QMutexLocker locker(&m_mutex);
+    return payloadBytes <= residentEntryLimitLocked() || spillsDirectlyLocked(costMicroseconds);
+}
+
+qint64 PluginResultCache::residentEntryLimitLocked() const {
+    return std::min(m_memoryCapacity / 4, m_maxResidentEntryBytes);
+}
+
+bool PluginResultCache::spillsDirectlyLocked(qint64 costMicroseconds) const {
+    return !m_spillDirectory.isEmpty() && costMicroseconds >= kSpillMinimumMicroseconds;
+}
+
+void PluginResultCache::evictLocked(QList<Node>* spilled) {
+    while (m_memoryBytes > m_memoryCapacity && !m_lru.empty()) {
+        Node& victim = m_lru.back();
+        m_memoryBytes -= entryCost(victim.key, victim.entry);
+        m_index.remove(victim.key);
+        ++m_statistics.evictions;
+        if (!m_spillDirectory.isEmpty()
+            && victim.costMicroseconds >= kSpillMinimumMicroseconds
+            && !m_diskEntries.contains(victim.key)) {
+            spilled->append(std::move(victim));
+        }
+        m_lru.pop_back();
+    }
+}
+
+void PluginResultCache::setMemoryCapacity(qint64 bytes) {
+    QList<Node> spilled;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_memoryCapacity = std::max<qint64>(0, bytes);
+        evictLocked(&spilled);
+    }
+    writeSpills(spilled);
+}
+
+void PluginResultCache::setMaxResidentEntryBytes(qint64 bytes) {
+    QMutexLocker locker(&m_mutex);
+    m_maxResidentEntryBytes = std::max<qint64>(0, bytes);
+}
+
+void PluginResultCache::setSpillDirectory(const QString& directoryPath, qint64 capacityBytes) {
+    QMutexLocker locker(&m_mutex);
+    m_spillDirectory = directoryPath;
+    m_diskCapacity = std::max<qint64>(0, capacityBytes);
+    m_diskIndexLoaded = false;
+    m_diskEntries.clear();
+    m_diskOrder.clear();
+    m_diskBytes = 0;
+}
+
+void PluginResultCache::clearMemory() {
+    QMutexLocker locker(&m_mutex);
+    m_lru.clear();
+    m_index.clear();
+    m_memoryBytes = 0;
+}
+
+PluginResultCache::Statistics PluginResultCache::statistics() const {
+    QMutexLocker locker(&m_mutex);
+    Statistics result = m_statistics;
+    result.entryCount = static_cast<int>(m_index.size());
+    result.memoryBytes = m_memoryBytes;
+    result.memoryCapacityBytes = m_memoryCapacity;
+    result.diskBytes = m_diskBytes;
+    result.diskCapacityBytes = m_spillDirectory.isEmpty() ? 0 : m_diskCapacity;
+    return result;
+}
+
+void PluginResultCache::loadDiskIndexLocked() {
+    if (m_diskIndexLoaded) {
+        return;
+    }
+    m_diskIndexLoaded = true;
+
+    QDir directory(m_spillDirectory);
+    const QFileInfoList files = directory.entryInfoList({QStringLiteral("*.bin")}, QDir::Files, QDir::Time | QDir::Reversed);
+    for (const QFileInfo& file : files) {
+        const QByteArray key = QByteArray::fromHex(file.completeBaseName().toLatin1());
+        if (key.size() != 32) {
+            continue;
+        }
+        m_diskEntries.insert(key, file.size());
+        m_diskOrder.push_back(key);
+        m_diskBytes += file.size();
+    }
+}
+
+QString PluginResultCache::spillPathFor(const QByteArray& key) const {
+    return m_spillDirectory + QLatin1Char('/') + QString::fromLatin1(key.toHex()) + QStringLiteral(".bin");
+}
+
+bool PluginResultCache::readSpill(const QString& path, Entry* outEntry) const {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray bytes = file.readAll();
+    if (bytes.size() < kSpillHeaderSize || !bytes.startsWith(QByteArray(kSpillMagic, 4))) {
+        return false;
+    }
+    const auto* header = reinterpret_cast<const uchar*>(bytes.constData());
+    if (qFromLittleEndian<quint32>(header + 4) != kSpillFormatVersion) {
+        return false;
+    }
+    outEntry->contentType = qFromLittleEndian<quint32>(header + 8);
+    outEntry->flags = qFromLittleEndian<quint32>(header + 12);
+    outEntry->payload = bytes.mid(kSpillHeaderSize);
+    return true;
+}
+
+void PluginResultCache::writeSpills(const QList<Node>& spilled) {
+    if (spilled.isEmpty()) {
+        return;
+    }
+
+    QString directoryPath;
+    {
+        QMutexLocker locker(&m_mutex);
+        directoryPath = m_spillDirectory;
+    }
+    if (directoryPath.isEmpty() || !QDir().mkpath(directoryPath)) {
+        return;
+    }
+
+    for (const Node& node : spilled) {
+        const QString path = directoryPath + QLatin1Char('/') + QString::fromLatin1(node.key.toHex()) + QStringLiteral(".bin");
+        QByteArray header(kSpillMagic, 4);
+        appendU32(&header, kSpillFormatVersion);
+        appendU32(&header, node.entry.contentType);
+        appendU32(&header, node.entry.flags);
+
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)
+            || file.write(header) != header.size()
+            || file.write(node.entry.payload) != node.entry.payload.size()
+            || !file.commit()) {
+            continue;
+        }
+
+        const qint64 size = static_cast<qint64>(header.size()) + node.entry.payload.size();
+        QMutexLocker locker(&m_mutex);
+        if (m_spillDirectory != directoryPath) {
+            continue;
+        }
+        loadDiskIndexLocked();
+        if (!m_diskEntries.contains(node.key)) {
+            m_diskEntries.insert(node.key, size);
+            m_diskOrder.push_back(node.key);
+            m_diskBytes += size;
+        }
+        ++m_statistics.spills;
+
+        while (m_diskBytes > m_diskCapacity && !m_diskOrder.empty()) {
+            const QByteArray oldest = m_diskOrder.front();
+            m_diskOrder.pop_front();
+            m_diskBytes -= m_diskEntries.take(oldest);
+            QFile::remove(spillPathFor(oldest));
+        }
+    }
+}
@@ -0,0 +1,101 @@
+//-------------------------------------------------------------------------------------
+// PluginResultCache.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef PLUGINRESULTCACHE_H
+#define PLUGINRESULTCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <list>
+
+// Size-bounded LRU of successful results of pure plugin operations. Expensive entries are written
+// to a spill directory on eviction and promoted back into memory when requested again.
+class PluginResultCache {
+public:
+    struct Entry {
+        quint32 contentType = 0;
+        quint32 flags = 0;
+        QByteArray payload;
+    };
+
+    struct Statistics {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 diskHits = 0;
+        quint64 evictions = 0;
+        quint64 spills = 0;
+        int entryCount = 0;
+        qint64 memoryBytes = 0;
+        qint64 memoryCapacityBytes = 0;
+        qint64 diskBytes = 0;
+        qint64 diskCapacityBytes = 0;
+    };
+
+    PluginResultCache();
+
+    // pluginFingerprint should change whenever the plugin binary does, so spilled results of an
+    // older build are never returned.
+    static QByteArray makeKey(const QString& pluginFingerprint,
+                              const QString& operation,
+                              quint32 contentType,
+                              quint32 flags,
+                              const QByteArray& payload);
+
+    bool lookup(const QByteArray& key, Entry* outEntry);
+    void insert(const QByteArray& key, const Entry& entry, qint64 costMicroseconds);
+    // Whether insert() would keep a result of this size and cost, so callers can skip copying
+    // one that would be dropped.
+    bool accepts(qint64 payloadBytes, qint64 costMicroseconds) const;
+
+    void setMemoryCapacity(qint64 bytes);
+    // Larger entries are never held in memory; expensive ones still go straight to the spill
+    // directory. The limit never exceeds a quarter of the memory capacity.
+    void setMaxResidentEntryBytes(qint64 bytes);
+    // An empty directory disables spilling.
+    void setSpillDirectory(const QString& directoryPath, qint64 capacityBytes);
+    void clearMemory();
+    Statistics statistics() const;
+
+private:
+    struct Node {
+        QByteArray key;
+        Entry entry;
+        qint64 costMicroseconds = 0;
+    };
+
+    using NodeList = std::list<Node>;
+
+    void evictLocked(QList<Node>* spilled);
+    qint64 residentEntryLimitLocked() const;
+    bool spillsDirectlyLocked(qint64 costMicroseconds) const;
+    void loadDiskIndexLocked();
+    QString spillPathFor(const QByteArray& key) const;
+    bool readSpill(const QString& path, Entry* outEntry) const;
+    void writeSpills(const QList<Node>& spilled);
+
+    mutable QMutex m_mutex;
+    NodeList m_lru;
+    QHash<QByteArray, NodeList::iterator> m_index;
+    qint64 m_memoryBytes = 0;
+    qint64 m_memoryCapacity = 0;
+    qint64 m_maxResidentEntryBytes = 0;
+
+    QString m_spillDirectory;
+    qint64 m_diskCapacity = 0;
+    bool m_diskIndexLoaded = false;
+    QHash<QByteArray, qint64> m_diskEntries;
+    std::list<QByteArray> m_diskOrder;
+    qint64 m_diskBytes = 0;
+
+    Statistics m_statistics;
+};
+
+#endif // PLUGINRESULTCACHE_H
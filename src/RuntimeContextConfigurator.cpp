@@ -377,6 +377,42 @@ void configureToolRuntimeContext() {
         return ToolRuntimeContext::FileReadResult{true, file.readAll(), QString()};
     });
 
+    context.setBinaryFileRangeReader([](ToolRuntimeContext::FileRoot root,
+                                        const QString& relativePath,
+                                        qint64 offset,
+                                        qint64 maxBytes) {
+        QString absolutePath;
+        QString displayRelativePath;
+        QString errorMessage;
+        if (!resolveAuthorizedAbsolutePath(root, relativePath, &absolutePath, &displayRelativePath, &errorMessage)) {
+            return ToolRuntimeContext::FileRangeReadResult{false, QByteArray(), -1, errorMessage};
+        }
+
+        QFile file(absolutePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return ToolRuntimeContext::FileRangeReadResult{
+                false,
+                QByteArray(),
+                -1,
+                QString("Failed to open file for reading: %1").arg(displayRelativePath)
+            };
+        }
+
+        const qint64 fileSize = file.size();
+        if (offset >= fileSize) {
+            return ToolRuntimeContext::FileRangeReadResult{true, QByteArray(), fileSize, QString()};
+        }
+        if (!file.seek(offset)) {
+            return ToolRuntimeContext::FileRangeReadResult{
+                false,
+                QByteArray(),
+                fileSize,
+                QString("Failed to seek in file: %1").arg(displayRelativePath)
+            };
+        }
+        return ToolRuntimeContext::FileRangeReadResult{true, file.read(maxBytes), fileSize, QString()};
+    });
+
     context.setTextFileReader([](ToolRuntimeContext::FileRoot root, const QString& relativePath) {
         const ToolRuntimeContext::FileReadResult binaryResult =
             ToolRuntimeContext::instance().readFile(root, relativePath);
@@ -0,0 +1,330 @@
+//-------------------------------------------------------------------------------------
+// TgaCodec.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "TgaCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define TGACODEC_SSSE3 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TGACODEC_SSE2 1
+#endif
+
+namespace TgaCodec {
+
+namespace {
+
+constexpr std::size_t kHeaderSize = 18;
+constexpr int kTypeTrueColor = 2;
+constexpr int kTypeTrueColorRle = 10;
+constexpr std::uint8_t kDescriptorTopDown = 0x20;
+// One packet covers at most this many pixels
+constexpr int kMaxPacketPixels = 128;
+
+// Exchanges bytes 0 and 2 of every pixel: BGRA <-> RGBA
+void swapRedBlue(const std::uint8_t* source, std::uint8_t* destination, std::size_t count) {
+    std::size_t index = 0;
+#ifdef TGACODEC_SSE2
+    const __m128i keepMask = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+    const __m128i lowMask = _mm_set1_epi32(0x000000FF);
+    for (; index + 4 <= count; index += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index * 4));
+        const __m128i swapped = _mm_or_si128(
+            _mm_and_si128(pixels, keepMask),
+            _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pixels, 16), lowMask),
+                         _mm_slli_epi32(_mm_and_si128(pixels, lowMask), 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index * 4), swapped);
+    }
+#endif
+    for (; index < count; ++index) {
+        const std::uint8_t* pixel = source + index * 4;
+        std::uint8_t* output = destination + index * 4;
+        const std::uint8_t blue = pixel[0];
+        output[0] = pixel[2];
+        output[1] = pixel[1];
+        output[2] = blue;
+        output[3] = pixel[3];
+    }
+}
+
+// BGR -> BGRA or RGBA with opaque alpha
+void expandBgr(const std::uint8_t* source, std::uint8_t* destination, std::size_t count, PixelOrder order) {
+    std::size_t index = 0;
+#ifdef TGACODEC_SSSE3
+    // Four pixels per step read 16 bytes, so stop while at least six pixels remain
+    const __m128i shuffle = order == PixelOrder::Bgra
+        ? _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1)
+        : _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    for (; index + 6 <= count; index += 4) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index * 4),
+                         _mm_or_si128(_mm_shuffle_epi8(bytes, shuffle), alpha));
+    }
+#endif
+    const int redIndex = order == PixelOrder::Bgra ? 2 : 0;
+    for (; index < count; ++index) {
+        const std::uint8_t* pixel = source + index * 3;
+        std::uint8_t* output = destination + index * 4;
+        output[redIndex] = pixel[2];
+        output[1] = pixel[1];
+        output[2 - redIndex] = pixel[0];
+        output[3] = 255;
+    }
+}
+
+// File pixels (BGR or BGRA) to the caller's 4-byte pixels
+void readPixels(const std::uint8_t* source,
+                int bytesPerPixel,
+                PixelOrder order,
+                std::uint8_t* destination,
+                std::size_t count) {
+    if (bytesPerPixel == 3) {
+        expandBgr(source, destination, count, order);
+    } else if (order == PixelOrder::Bgra) {
+        std::memcpy(destination, source, count * 4);
+    } else {
+        swapRedBlue(source, destination, count);
+    }
+}
+
+// Repeats the 4-byte pixel count times by doubling copies of what is already written
+void fillPixels(std::uint8_t* destination, const std::uint8_t* pixel, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    std::memcpy(destination, pixel, 4);
+    const std::size_t total = count * 4;
+    for (std::size_t filled = 4; filled < total;) {
+        const std::size_t chunk = std::min(filled, total - filled);
+        std::memcpy(destination + filled, destination, chunk);
+        filled += chunk;
+    }
+}
+
+// Walks the image in file order and maps every file row onto its destination row
+class RowCursor {
+public:
+    RowCursor(const Header& header, std::uint8_t* destination, std::size_t stride)
+        : m_header(header), m_destination(destination), m_stride(stride),
+          m_total(static_cast<std::size_t>(header.width) * static_cast<std::size_t>(header.height)) {
+    }
+
+    bool done() const { return m_index >= m_total; }
+    std::size_t remaining() const { return m_total - m_index; }
+
+    // Pixels left in the current row, and where the next one goes
+    std::size_t rowRemaining() const { return static_cast<std::size_t>(m_header.width) - m_x; }
+    std::uint8_t* target() const {
+        const std::size_t fileRow = m_index / static_cast<std::size_t>(m_header.width);
+        const std::size_t row = m_header.topDown ? fileRow : static_cast<std::size_t>(m_header.height) - 1 - fileRow;
+        return m_destination + row * m_stride + m_x * 4;
+    }
+
+    void advance(std::size_t count) {
+        m_index += count;
+        m_x += count;
+        if (m_x == static_cast<std::size_t>(m_header.width)) {
+            m_x = 0;
+        }
+    }
+
+    // Calls write(target, count) for count pixels split at row ends
+    template <typename WriteFn>
+    void write(std::size_t count, const WriteFn& write) {
+        count = std::min(count, remaining());
+        while (count > 0) {
+            const std::size_t segment = std::min(count, rowRemaining());
+            write(target(), segment);
+            advance(segment);
+            count -= segment;
+        }
+    }
+
+private:
+    const Header& m_header;
+    std::uint8_t* m_destination;
+    std::size_t m_stride;
+    std::size_t m_total;
+    std::size_t m_index = 0;
+    std::size_t m_x = 0;
+};
+
+void decodeRle(const std::uint8_t* pixelData, std::size_t available, PixelOrder order, int bytesPerPixel, RowCursor& cursor) {
+    const std::size_t pixelBytes = static_cast<std::size_t>(bytesPerPixel);
+    std::size_t offset = 0;
+    while (!cursor.done() && offset < available) {
+        const std::uint8_t packet = pixelData[offset++];
+        const std::size_t count = static_cast<std::size_t>(packet & 0x7F) + 1;
+        if (packet & 0x80) {
+            if (available - offset < pixelBytes) {
+                return;
+            }
+            std::uint8_t pixel[4];
+            readPixels(pixelData + offset, bytesPerPixel, order, pixel, 1);
+            offset += pixelBytes;
+            cursor.write(count, [&](std::uint8_t* target, std::size_t segment) {
+                fillPixels(target, pixel, segment);
+            });
+        } else {
+            const std::size_t present = std::min(count, (available - offset) / pixelBytes);
+            cursor.write(present, [&](std::uint8_t* target, std::size_t segment) {
+                readPixels(pixelData + offset, bytesPerPixel, order, target, segment);
+                offset += segment * pixelBytes;
+            });
+            if (present < count) {
+                return;
+            }
+        }
+    }
+}
+
+void appendRlePackets(const std::uint32_t* pixels, int width, std::vector<std::uint8_t>& output) {
+    int x = 0;
+    while (x < width) {
+        int run = 1;
+        while (x + run < width && run < kMaxPacketPixels && pixels[x + run] == pixels[x]) {
+            ++run;
+        }
+        if (run >= 2) {
+            output.push_back(static_cast<std::uint8_t>(0x80 | (run - 1)));
+            const auto* bytes = reinterpret_cast<const std::uint8_t*>(pixels + x);
+            output.insert(output.end(), bytes, bytes + 4);
+            x += run;
+            continue;
+        }
+
+        // Raw packet up to where the next run of two or more starts
+        int count = 1;
+        while (x + count < width
+               && count < kMaxPacketPixels
+               && !(x + count + 1 < width && pixels[x + count] == pixels[x + count + 1])) {
+            ++count;
+        }
+        output.push_back(static_cast<std::uint8_t>(count - 1));
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(pixels + x);
+        output.insert(output.end(), bytes, bytes + static_cast<std::size_t>(count) * 4);
+        x += count;
+    }
+}
+
+} // namespace
+
+bool readHeader(const std::uint8_t* data, std::size_t size, Header* outHeader) {
+    if (!data || !outHeader || size < kHeaderSize) {
+        return false;
+    }
+
+    const int idLength = data[0];
+    const int colorMapType = data[1];
+    const int imageType = data[2];
+    const int width = data[12] | (data[13] << 8);
+    const int height = data[14] | (data[15] << 8);
+    const int bpp = data[16];
+    if (colorMapType != 0 || (imageType != kTypeTrueColor && imageType != kTypeTrueColorRle)) {
+        return false;
+    }
+    if ((bpp != 24 && bpp != 32) || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    const std::size_t pixelOffset = kHeaderSize + static_cast<std::size_t>(idLength);
+    if (pixelOffset >= size) {
+        return false;
+    }
+    const std::size_t bytesPerPixel = static_cast<std::size_t>(bpp / 8);
+    const std::size_t pixelCount = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    const std::size_t maxPackets = (size - pixelOffset) / (1 + bytesPerPixel) + 1;
+    if (pixelCount / kMaxPacketPixels > maxPackets) {
+        return false;
+    }
+
+    outHeader->width = width;
+    outHeader->height = height;
+    outHeader->bytesPerPixel = static_cast<int>(bytesPerPixel);
+    outHeader->rle = imageType == kTypeTrueColorRle;
+    outHeader->topDown = (data[17] & kDescriptorTopDown) != 0;
+    outHeader->pixelOffset = pixelOffset;
+    return true;
+}
+
+void decodePixels(const std::uint8_t* data,
+                  std::size_t size,
+                  const Header& header,
+                  PixelOrder order,
+                  std::uint8_t* destination,
+                  std::size_t stride) {
+    if (!data || !destination || header.width <= 0 || header.height <= 0 || header.pixelOffset >= size) {
+        return;
+    }
+
+    const std::uint8_t* pixelData = data + header.pixelOffset;
+    const std::size_t available = size - header.pixelOffset;
+    RowCursor cursor(header, destination, stride);
+    if (header.rle) {
+        decodeRle(pixelData, available, order, header.bytesPerPixel, cursor);
+    } else {
+        const std::size_t pixelBytes = static_cast<std::size_t>(header.bytesPerPixel);
+        std::size_t offset = 0;
+        cursor.write(available / pixelBytes, [&](std::uint8_t* target, std::size_t segment) {
+            readPixels(pixelData + offset, header.bytesPerPixel, order, target, segment);
+            offset += segment * pixelBytes;
+        });
+    }
+    cursor.write(cursor.remaining(), [](std::uint8_t* target, std::size_t segment) {
+        std::memset(target, 0, segment * 4);
+    });
+}
+
+std::vector<std::uint8_t> encode32(const std::uint8_t* pixels,
+                                   int width,
+                                   int height,
+                                   std::size_t stride,
+                                   PixelOrder order,
+                                   bool rle) {
+    if (!pixels || width <= 0 || height <= 0 || width > 0xFFFF || height > 0xFFFF) {
+        return {};
+    }
+
+    const std::size_t rowBytes = static_cast<std::size_t>(width) * 4;
+    std::vector<std::uint8_t> output(kHeaderSize);
+    output[2] = static_cast<std::uint8_t>(rle ? kTypeTrueColorRle : kTypeTrueColor);
+    output[12] = static_cast<std::uint8_t>(width & 0xFF);
+    output[13] = static_cast<std::uint8_t>((width >> 8) & 0xFF);
+    output[14] = static_cast<std::uint8_t>(height & 0xFF);
+    output[15] = static_cast<std::uint8_t>((height >> 8) & 0xFF);
+    output[16] = 32;
+    output[17] = 0;
+
+    if (!rle) {
+        output.resize(kHeaderSize + rowBytes * static_cast<std::size_t>(height));
+        std::uint8_t* target = output.data() + kHeaderSize;
+        for (int y = height - 1; y >= 0; --y, target += rowBytes) {
+            readPixels(pixels + static_cast<std::size_t>(y) * stride, 4, order, target, static_cast<std::size_t>(width));
+        }
+        return output;
+    }
+
+    // Worst case is one raw packet header per 128 pixels on top of the pixels themselves
+    const std::size_t packetsPerRow = (static_cast<std::size_t>(width) + kMaxPacketPixels - 1) / kMaxPacketPixels;
+    output.reserve(kHeaderSize + (rowBytes + packetsPerRow) * static_cast<std::size_t>(height));
+    std::vector<std::uint32_t> row(static_cast<std::size_t>(width));
+    for (int y = height - 1; y >= 0; --y) {
+        readPixels(pixels + static_cast<std::size_t>(y) * stride, 4, order,
+                   reinterpret_cast<std::uint8_t*>(row.data()), static_cast<std::size_t>(width));
+        appendRlePackets(row.data(), width, output);
+    }
+    return output;
+}
+
+} // namespace TgaCodec
@@ -0,0 +1,60 @@
+//-------------------------------------------------------------------------------------
+// TgaCodec.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef TGACODEC_H
+#define TGACODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Truecolour TGA shared by the thumbnail cache and the tools. Pixels on the caller's side are
+// rows of 4 bytes each; conversion to and from the file works on whole rows at a time.
+namespace TgaCodec {
+
+// Byte order of the caller's pixels. Bgra matches the file, so those rows are plain copies.
+enum class PixelOrder {
+    Bgra,
+    Rgba
+};
+
+struct Header {
+    int width = 0;
+    int height = 0;
+    int bytesPerPixel = 0;
+    bool rle = false;
+    bool topDown = false;
+    std::size_t pixelOffset = 0;
+};
+
+// Accepts uncompressed (type 2) and RLE (type 10) truecolour at 24 or 32 bpp without a colour
+// map. Rejects anything else, and headers whose size the payload could not cover even if
+// every byte were maximal RLE runs, so a bad header never drives a huge allocation.
+bool readHeader(const std::uint8_t* data, std::size_t size, Header* outHeader);
+
+// Writes header.height rows of header.width pixels, top row first, stride bytes apart. Pixels a
+// truncated file does not reach are left transparent black.
+void decodePixels(const std::uint8_t* data,
+                  std::size_t size,
+                  const Header& header,
+                  PixelOrder order,
+                  std::uint8_t* destination,
+                  std::size_t stride);
+
+// 32 bpp bottom-up file from top-down rows. With rle the file is type 10, and no packet
+// crosses a row so every reader can take it.
+std::vector<std::uint8_t> encode32(const std::uint8_t* pixels,
+                                   int width,
+                                   int height,
+                                   std::size_t stride,
+                                   PixelOrder order,
+                                   bool rle);
+
+} // namespace TgaCodec
+
+#endif // TGACODEC_H
@@ -8,61 +8,462 @@
 //-------------------------------------------------------------------------------------
 #include "ToolGuiModelAdapter.h"
 
+#include <QHash>
+#include <QSet>
+#include <QVariantList>
+
+#include <algorithm>
+
+namespace {
+constexpr int kRowRoleRole = Qt::UserRole + 1;
+constexpr int kCellRoleRole = Qt::UserRole + 2;
+constexpr int kSelectedRole = Qt::UserRole + 3;
+constexpr int kRowDataRole = Qt::UserRole + 4;
+
+// Beyond this many out-of-order rows (a re-sort, typically) one reset is cheaper than
+// per-row move signals.
+constexpr int kMaxRowMoves = 512;
+
+QList<int> changedRoles(const ToolGuiListRow& before, const ToolGuiListRow& after) {
+    bool valueChanged = before.cells.size() != after.cells.size();
+    bool cellRoleChanged = valueChanged;
+    for (int column = 0; !valueChanged && column < after.cells.size(); ++column) {
+        valueChanged = before.cells[column].value != after.cells[column].value;
+    }
+    for (int column = 0; !cellRoleChanged && column < after.cells.size(); ++column) {
+        cellRoleChanged = before.cells[column].role != after.cells[column].role;
+    }
+
+    QList<int> roles;
+    if (valueChanged) {
+        roles << Qt::DisplayRole << Qt::EditRole;
+    }
+    if (before.id != after.id) {
+        roles << Qt::UserRole;
+    }
+    if (before.role != after.role) {
+        roles << kRowRoleRole;
+    }
+    if (cellRoleChanged) {
+        roles << kCellRoleRole;
+    }
+    if (!roles.isEmpty() || before.rowId != after.rowId
+        || before.values != after.values || before.state != after.state) {
+        roles << kRowDataRole;
+    }
+    return roles;
+}
+
+QList<int> allRoles() {
+    return {Qt::DisplayRole, Qt::EditRole, Qt::UserRole, kRowRoleRole, kCellRoleRole, kSelectedRole, kRowDataRole};
+}
+
+// Marks the entries of a longest increasing subsequence of positions; those rows keep their
+// place while every other row is moved.
+QVector<bool> longestIncreasingRun(const QVector<int>& positions) {
+    QVector<int> tailIndices;
+    QVector<int> previous(positions.size(), -1);
+    for (int i = 0; i < positions.size(); ++i) {
+        const auto slot = std::lower_bound(
+            tailIndices.begin(), tailIndices.end(), positions[i],
+            [&positions](int index, int value) { return positions[index] < value; }
+        );
+        if (slot != tailIndices.begin()) {
+            previous[i] = *(slot - 1);
+        }
+        if (slot == tailIndices.end()) {
+            tailIndices.append(i);
+        } else {
+            *slot = i;
+        }
+    }
+
+    QVector<bool> stable(positions.size(), false);
+    for (int i = tailIndices.isEmpty() ? -1 : tailIndices.last(); i >= 0; i = previous[i]) {
+        stable[i] = true;
+    }
+    return stable;
+}
+}
+
 ToolGuiModelAdapter::ToolGuiModelAdapter(QObject* parent)
     : QAbstractTableModel(parent)
 {
 }
 
 void ToolGuiModelAdapter::setModel(const ToolGuiCollectionModel& model) {
+    if (m_windowed || !columnsCompatible(model.columns) || !applyRowStructure(model.rows)) {
+        resetModel(model, false, 0, 0);
+        return;
+    }
+
+    const bool headersChanged = headersDiffer(model.columns);
+    const QVector<ToolGuiListRow> previousRows = m_model.rows;
+    m_model = model;
+    emitRowDataChanges(previousRows);
+    setSelection(model.selection);
+    if (headersChanged) {
+        emit headerDataChanged(Qt::Horizontal, 0, columnCount() - 1);
+    }
+}
+
+void ToolGuiModelAdapter::setWindowedModel(const ToolGuiCollectionModel& model, int first, int total) {
+    first = std::max(0, first);
+    total = std::max(0, total);
+    if (!m_windowed || !columnsCompatible(model.columns)) {
+        resetModel(model, true, first, total);
+        return;
+    }
+
+    // The view has no data past the old count, so a count change is an append or a trim at the
+    // end; the window comparison below refreshes any rows whose contents shifted.
+    if (total > m_total) {
+        beginInsertRows(QModelIndex(), m_total, total - 1);
+        m_total = total;
+        endInsertRows();
+    } else if (total < m_total) {
+        beginRemoveRows(QModelIndex(), total, m_total - 1);
+        m_total = total;
+        endRemoveRows();
+    }
+
+    const bool headersChanged = headersDiffer(model.columns);
+    const QVector<ToolGuiListRow> previousRows = m_model.rows;
+    const int previousFirst = m_windowFirst;
+    const QStringList previousSelection = m_selectedIds;
+    m_model = model;
+    m_windowFirst = first;
+    m_selectedIds = model.selection;
+
+    // Window rows carry no stable position across windows, so they are compared by view row.
+    const int lastColumn = columnCount() - 1;
+    const int begin = std::min(previousFirst, first);
+    const int end = std::min(
+        m_total,
+        std::max(previousFirst + static_cast<int>(previousRows.size()),
+                 first + static_cast<int>(m_model.rows.size()))
+    );
+    int runStart = -1;
+    QList<int> runRoles;
+    const auto flush = [this, &runStart, lastColumn](int runLast, const QList<int>& roles) {
+        if (runStart >= 0) {
+            emit dataChanged(index(runStart, 0), index(runLast, lastColumn), roles);
+            runStart = -1;
+        }
+    };
+    for (int row = begin; lastColumn >= 0 && row < end; ++row) {
+        const int previousIndex = row - previousFirst;
+        const ToolGuiListRow* before = previousIndex >= 0 && previousIndex < previousRows.size()
+            ? &previousRows.at(previousIndex)
+            : nullptr;
+        const ToolGuiListRow* after = storedRow(row);
+
+        QList<int> roles;
+        if (before && after) {
+            roles = changedRoles(*before, *after);
+            if (previousSelection.contains(before->id) != m_selectedIds.contains(after->id)) {
+                roles << kSelectedRole;
+                if (!roles.contains(kRowDataRole)) {
+                    roles << kRowDataRole;
+                }
+            }
+        } else if (before || after) {
+            roles = allRoles();
+        }
+
+        if (runStart >= 0 && roles != runRoles) {
+            flush(row - 1, runRoles);
+        }
+        if (!roles.isEmpty() && runStart < 0) {
+            runStart = row;
+            runRoles = roles;
+        }
+    }
+    flush(end - 1, runRoles);
+
+    if (previousSelection != m_selectedIds) {
+        emit selectionChanged(m_selectedIds);
+    }
+    if (headersChanged) {
+        emit headerDataChanged(Qt::Horizontal, 0, columnCount() - 1);
+    }
+}
+
+void ToolGuiModelAdapter::resetModel(const ToolGuiCollectionModel& model, bool windowed, int first, int total) {
+    const bool selectionDidChange = m_selectedIds != model.selection;
     beginResetModel();
     m_model = model;
+    m_selectedIds = model.selection;
+    m_windowed = windowed;
+    m_windowFirst = first;
+    m_total = total;
     endResetModel();
+    if (selectionDidChange) {
+        emit selectionChanged(m_selectedIds);
+    }
+}
+
+bool ToolGuiModelAdapter::headersDiffer(const QVector<ToolGuiListColumn>& columns) const {
+    for (int column = 0; column < columns.size() && column < m_model.columns.size(); ++column) {
+        const ToolGuiListColumn& before = m_model.columns[column];
+        const ToolGuiListColumn& after = columns[column];
+        if (before.text != after.text || before.width != after.width
+            || before.stretch != after.stretch || before.hidden != after.hidden) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const ToolGuiListRow* ToolGuiModelAdapter::storedRow(int row) const {
+    const int storedIndex = row - m_windowFirst;
+    if (row < 0 || row >= rowCount() || storedIndex < 0 || storedIndex >= m_model.rows.size()) {
+        return nullptr;
+    }
+    return &m_model.rows.at(storedIndex);
+}
+
+bool ToolGuiModelAdapter::columnsCompatible(const QVector<ToolGuiListColumn>& columns) const {
+    if (columns.size() != m_model.columns.size()) {
+        return false;
+    }
+    for (int column = 0; column < columns.size(); ++column) {
+        if (columns[column].key != m_model.columns[column].key) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ToolGuiModelAdapter::applyRowStructure(const QVector<ToolGuiListRow>& newRows) {
+    QVector<ToolGuiListRow>& rows = m_model.rows;
+
+    QHash<QString, int> newIndex;
+    newIndex.reserve(newRows.size());
+    for (int i = 0; i < newRows.size(); ++i) {
+        const QString& id = newRows[i].id;
+        if (id.isEmpty() || newIndex.contains(id)) {
+            return false;
+        }
+        newIndex.insert(id, i);
+    }
+
+    QSet<QString> oldIds;
+    oldIds.reserve(rows.size());
+    QVector<int> survivorPositions;
+    for (const ToolGuiListRow& row : rows) {
+        if (row.id.isEmpty() || oldIds.contains(row.id)) {
+            return false;
+        }
+        oldIds.insert(row.id);
+        const auto it = newIndex.constFind(row.id);
+        if (it != newIndex.constEnd()) {
+            survivorPositions.append(it.value());
+        }
+    }
+
+    // stableByNewPosition[p] is true when the row that ends up at p never has to move.
+    QVector<bool> stableByNewPosition(newRows.size(), true);
+    if (!std::is_sorted(survivorPositions.constBegin(), survivorPositions.constEnd())) {
+        const QVector<bool> stable = longestIncreasingRun(survivorPositions);
+        const int moveCount = static_cast<int>(std::count(stable.constBegin(), stable.constEnd(), false));
+        if (moveCount > kMaxRowMoves) {
+            return false;
+        }
+        for (int i = 0; i < survivorPositions.size(); ++i) {
+            stableByNewPosition[survivorPositions[i]] = stable[i];
+        }
+    }
+
+    // Removals, bottom-up in contiguous runs.
+    for (int end = rows.size(); end > 0;) {
+        if (newIndex.contains(rows[end - 1].id)) {
+            --end;
+            continue;
+        }
+        int first = end - 1;
+        while (first > 0 && !newIndex.contains(rows[first - 1].id)) {
+            --first;
+        }
+        beginRemoveRows(QModelIndex(), first, end - 1);
+        rows.remove(first, end - first);
+        endRemoveRows();
+        end = first;
+    }
+
+    // Rows before i already match newRows. An out-of-order row found at i is parked at the end
+    // once and moved into place when its turn comes, so each one moves at most twice.
+    QVector<bool> parkedByNewPosition(newRows.size(), false);
+    for (int i = 0; i < newRows.size();) {
+        const QString& targetId = newRows[i].id;
+        if (i < rows.size() && rows[i].id == targetId) {
+            ++i;
+            continue;
+        }
+
+        if (i < rows.size()) {
+            const int currentTarget = newIndex.value(rows[i].id);
+            if (!stableByNewPosition[currentTarget] && !parkedByNewPosition[currentTarget]) {
+                parkedByNewPosition[currentTarget] = true;
+                if (i != rows.size() - 1) {
+                    beginMoveRows(QModelIndex(), i, i, QModelIndex(), rows.size());
+                    rows.move(i, rows.size() - 1);
+                    endMoveRows();
+                }
+                continue;
+            }
+        }
+
+        if (!oldIds.contains(targetId)) {
+            int runEnd = i + 1;
+            while (runEnd < newRows.size() && !oldIds.contains(newRows[runEnd].id)) {
+                ++runEnd;
+            }
+            beginInsertRows(QModelIndex(), i, runEnd - 1);
+            if (i == rows.size()) {
+                rows.append(newRows.mid(i, runEnd - i));
+            } else {
+                rows = rows.mid(0, i) + newRows.mid(i, runEnd - i) + rows.mid(i);
+            }
+            endInsertRows();
+            i = runEnd;
+            continue;
+        }
+
+        int source = i + 1;
+        while (source < rows.size() && rows[source].id != targetId) {
+            ++source;
+        }
+        if (source == rows.size()) {
+            // Unreachable with unique ids; recover with a reset rather than a broken model.
+            beginResetModel();
+            rows = newRows;
+            endResetModel();
+            return true;
+        }
+        beginMoveRows(QModelIndex(), source, source, QModelIndex(), i);
+        rows.move(source, i);
+        endMoveRows();
+        ++i;
+    }
+    return true;
+}
+
+void ToolGuiModelAdapter::emitRowDataChanges(const QVector<ToolGuiListRow>& previousRows) {
+    const int lastColumn = columnCount() - 1;
+    const int count = static_cast<int>(std::min(previousRows.size(), m_model.rows.size()));
+    if (lastColumn < 0 || count == 0) {
+        return;
+    }
+
+    int runStart = -1;
+    QList<int> runRoles;
+    const auto flush = [this, &runStart, &runRoles, lastColumn](int runLast) {
+        if (runStart >= 0) {
+            emit dataChanged(index(runStart, 0), index(runLast, lastColumn), runRoles);
+            runStart = -1;
+        }
+    };
+
+    for (int row = 0; row < count; ++row) {
+        const QList<int> roles = changedRoles(previousRows[row], m_model.rows[row]);
+        if (runStart >= 0 && roles != runRoles) {
+            flush(row - 1);
+        }
+        if (!roles.isEmpty() && runStart < 0) {
+            runStart = row;
+            runRoles = roles;
+        }
+    }
+    flush(count - 1);
 }
 
 void ToolGuiModelAdapter::setSelection(const QStringList& selectedIds) {
     if (m_selectedIds != selectedIds) {
+        const QSet<QString> before(m_selectedIds.constBegin(), m_selectedIds.constEnd());
+        const QSet<QString> after(selectedIds.constBegin(), selectedIds.constEnd());
         m_selectedIds = selectedIds;
         emit selectionChanged(m_selectedIds);
-        
-        // Emit data changed for all rows to update selection visual state
-        if (rowCount() > 0) {
-            emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+
+        // Only rows whose selection flipped need their selection visual state refreshed
+        const int lastColumn = columnCount() - 1;
+        if (lastColumn < 0) {
+            return;
+        }
+        int runStart = -1;
+        for (int row = 0; row <= m_model.rows.size(); ++row) {
+            const bool flipped = row < m_model.rows.size()
+                && before.contains(m_model.rows[row].id) != after.contains(m_model.rows[row].id);
+            if (flipped && runStart < 0) {
+                runStart = row;
+            } else if (!flipped && runStart >= 0) {
+                emit dataChanged(index(m_windowFirst + runStart, 0),
+                                 index(m_windowFirst + row - 1, lastColumn),
+                                 {kSelectedRole, kRowDataRole});
+                runStart = -1;
+            }
         }
     }
 }
 
 QString ToolGuiModelAdapter::rowRole(int row) const {
-    if (row < 0 || row >= m_model.rows.size()) {
-        return QString();
-    }
-    return m_model.rows[row].role;
+    const ToolGuiListRow* rowData = storedRow(row);
+    return rowData ? rowData->role : QString();
 }
 
 QString ToolGuiModelAdapter::cellRole(int row, int column) const {
-    if (row < 0 || row >= m_model.rows.size()) {
-        return QString();
-    }
-    
-    const auto& rowData = m_model.rows[row];
-    if (column < 0 || column >= rowData.cells.size()) {
+    const ToolGuiListRow* rowData = storedRow(row);
+    if (!rowData || column < 0 || column >= rowData->cells.size()) {
         return QString();
     }
     
-    return rowData.cells[column].role;
+    return rowData->cells[column].role;
 }
 
 QString ToolGuiModelAdapter::rowId(int row) const {
-    if (row < 0 || row >= m_model.rows.size()) {
-        return QString();
+    const ToolGuiListRow* rowData = storedRow(row);
+    return rowData ? rowData->id : QString();
+}
+
+QVariantMap ToolGuiModelAdapter::rowMap(const ToolGuiListRow& row,
+                                        const QVector<ToolGuiListColumn>& columns,
+                                        bool selected) {
+    QVariantMap result;
+    result.insert(QStringLiteral("id"), row.id);
+    result.insert(QStringLiteral("rowId"), row.rowId.isEmpty() ? row.id : row.rowId);
+    result.insert(QStringLiteral("role"), row.role);
+    result.insert(QStringLiteral("values"), row.values);
+    result.insert(QStringLiteral("state"), row.state);
+    result.insert(QStringLiteral("selected"), selected);
+
+    QVariantList cellList;
+    for (int index = 0; index < row.cells.size(); ++index) {
+        QVariantMap cellMap;
+        cellMap.insert(QStringLiteral("value"), row.cells.at(index).value);
+        cellMap.insert(QStringLiteral("role"), row.cells.at(index).role);
+        if (index < columns.size()) {
+            cellMap.insert(QStringLiteral("key"), columns.at(index).key);
+        }
+        cellList.append(cellMap);
     }
-    return m_model.rows[row].id;
+    result.insert(QStringLiteral("cells"), cellList);
+
+    for (int columnIndex = 0; columnIndex < columns.size(); ++columnIndex) {
+        const QString key = columns.at(columnIndex).key;
+        if (key.trimmed().isEmpty()) {
+            continue;
+        }
+        result.insert(key, columnIndex < row.cells.size() ? row.cells.at(columnIndex).value : row.values.value(key));
+    }
+
+    return result;
 }
 
 int ToolGuiModelAdapter::rowCount(const QModelIndex& parent) const {
     if (parent.isValid()) {
         return 0;
     }
-    return m_model.rows.size();
+    return m_windowed ? m_total : m_model.rows.size();
 }
 
 int ToolGuiModelAdapter::columnCount(const QModelIndex& parent) const {
@@ -77,14 +478,18 @@ QVariant ToolGuiModelAdapter::data(const QModelIndex& index, int role) const {
         return QVariant();
     }
     
-    int row = index.row();
     int column = index.column();
     
-    if (row < 0 || row >= m_model.rows.size()) {
-        return QVariant();
+    const ToolGuiListRow* storedData = storedRow(index.row());
+    if (!storedData) {
+        // Rows outside a list window stay empty until the worker sends them
+        return role == kRowDataRole ? QVariant(QVariantMap()) : QVariant();
     }
     
-    const auto& rowData = m_model.rows[row];
+    const auto& rowData = *storedData;
+    if (role == kRowDataRole) {
+        return rowMap(rowData, m_model.columns, m_selectedIds.contains(rowData.id));
+    }
     
     if (column < 0 || column >= rowData.cells.size()) {
         return QVariant();
@@ -150,3 +555,13 @@ Qt::ItemFlags ToolGuiModelAdapter::flags(const QModelIndex& index) const {
     
     return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
 }
+
+QHash<int, QByteArray> ToolGuiModelAdapter::roleNames() const {
+    QHash<int, QByteArray> names = QAbstractTableModel::roleNames();
+    names.insert(Qt::UserRole, QByteArrayLiteral("rowKey"));
+    names.insert(kRowRoleRole, QByteArrayLiteral("rowRole"));
+    names.insert(kCellRoleRole, QByteArrayLiteral("cellRole"));
+    names.insert(kSelectedRole, QByteArrayLiteral("selected"));
+    names.insert(kRowDataRole, QByteArrayLiteral("rowData"));
+    return names;
+}
@@ -10,7 +10,10 @@
 // - Adapts ToolGuiCollectionModel to QAbstractItemModel
 // - Supports column definitions, row data, selection state
 // - Supports row role and cell role for styling
-// - Incremental data updates
+// - Incremental data updates: rows are diffed by id and reported as
+//   insert/remove/move/dataChanged so views keep scroll position and delegates
+// - Windowed lists: the full row count is exposed while only the worker's window holds
+//   data; window rows are diffed by position
 //-------------------------------------------------------------------------------------
 #ifndef TOOLGUIMODELADAPTER_H
 #define TOOLGUIMODELADAPTER_H
@@ -18,6 +21,7 @@
 #include "ToolGuiRuntime.h"
 #include <QAbstractTableModel>
 #include <QStringList>
+#include <QVariantMap>
 
 // Model adapter for list controls
 class ToolGuiModelAdapter : public QAbstractTableModel {
@@ -28,6 +32,8 @@ public:
     
     // Set model data from worker state
     void setModel(const ToolGuiCollectionModel& model);
+    // Set the rows of a windowed list: model.rows are rows [first, first + rows) of total
+    void setWindowedModel(const ToolGuiCollectionModel& model, int first, int total);
     
     // Update selection
     void setSelection(const QStringList& selectedIds);
@@ -41,6 +47,12 @@ public:
     
     // Get selected row IDs
     QStringList selectedIds() const { return m_selectedIds; }
+
+    // Row as exposed to QML: id, rowId, role, values, state, selected, cells and one entry per
+    // column key
+    static QVariantMap rowMap(const ToolGuiListRow& row,
+                              const QVector<ToolGuiListColumn>& columns,
+                              bool selected);
     
     // QAbstractItemModel interface
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -48,14 +60,28 @@ public:
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
     Qt::ItemFlags flags(const QModelIndex& index) const override;
+    QHash<int, QByteArray> roleNames() const override;
 
 signals:
     // Emitted when selection changes
     void selectionChanged(const QStringList& selectedIds);
 
 private:
+    bool columnsCompatible(const QVector<ToolGuiListColumn>& columns) const;
+    bool headersDiffer(const QVector<ToolGuiListColumn>& columns) const;
+    void resetModel(const ToolGuiCollectionModel& model, bool windowed, int first, int total);
+    const ToolGuiListRow* storedRow(int row) const;
+    // Brings m_model.rows to the id order of newRows without touching row contents.
+    // Returns false when a reset is cheaper or the ids are not usable as keys.
+    bool applyRowStructure(const QVector<ToolGuiListRow>& newRows);
+    void emitRowDataChanges(const QVector<ToolGuiListRow>& previousRows);
+
     ToolGuiCollectionModel m_model;
     QStringList m_selectedIds;
+    // Windowed lists keep m_model.rows for view rows [m_windowFirst, m_windowFirst + rows)
+    bool m_windowed = false;
+    int m_windowFirst = 0;
+    int m_total = 0;
 };
 
 #endif // TOOLGUIMODELADAPTER_H
@@ -152,6 +152,11 @@ public:
                 return requestBinaryFile(root, relativePath);
             }
         );
+        ToolRuntimeContext::instance().setBinaryFileRangeReader(
+            [this](ToolRuntimeContext::FileRoot root, const QString& relativePath, qint64 offset, qint64 maxBytes) {
+                return requestBinaryFileRange(root, relativePath, offset, maxBytes);
+            }
+        );
         ToolRuntimeContext::instance().setTextFileReader(
             [this](ToolRuntimeContext::FileRoot root, const QString& relativePath) {
                 return requestTextFile(root, relativePath);
@@ -182,6 +187,11 @@ public:
                 return requestWriteBinaryFile(root, relativePath, content);
             }
         );
+        ToolRuntimeContext::instance().setBinaryFilesWriter(
+            [this](ToolRuntimeContext::FileRoot root, const QList<ToolRuntimeContext::FileWriteItem>& files) {
+                return requestWriteBinaryFiles(root, files);
+            }
+        );
         ToolRuntimeContext::instance().setTextFileWriter(
             [this](ToolRuntimeContext::FileRoot root, const QString& relativePath, const QString& content) {
                 return requestWriteTextFile(root, relativePath, content);
@@ -503,13 +513,16 @@ private:
         case ToolIpc::MessageType::ConfigResponse:
         case ToolIpc::MessageType::FileIndexResponse:
         case ToolIpc::MessageType::InvokePluginResponse:
+        case ToolIpc::MessageType::InvokePluginProgress:
         case ToolIpc::MessageType::ReadMatchingTextFilesResponse:
         case ToolIpc::MessageType::ReadBinaryFileResponse:
+        case ToolIpc::MessageType::ReadBinaryFileRangeResponse:
         case ToolIpc::MessageType::ReadTextFileResponse:
         case ToolIpc::MessageType::ReadEffectiveBinaryFileResponse:
         case ToolIpc::MessageType::ReadEffectiveTextFileResponse:
         case ToolIpc::MessageType::ReadEffectiveTextFilesResponse:
         case ToolIpc::MessageType::WriteBinaryFileResponse:
+        case ToolIpc::MessageType::WriteBinaryFilesResponse:
         case ToolIpc::MessageType::WriteTextFileResponse:
         case ToolIpc::MessageType::RemovePathResponse:
         case ToolIpc::MessageType::EnsureDirectoryResponse:
@@ -554,6 +567,13 @@ private:
                 argumentsUtf8.constData(),
                 &result
             );
+            // The packet may be a delta against the last one the host absorbed; forward it so the
+            // host's revision keeps pace with the worker's encoder.
+            if (result == TOOL_WORKER_SUCCESS && stateJson) {
+                QJsonObject payload;
+                payload["state"] = jsonObjectFromUtf8(stateJson);
+                sendMessage(ToolIpc::MessageType::StateUpdate, payload);
+            }
             if (stateJson && m_workerFreeString) {
                 m_workerFreeString(stateJson);
             }
@@ -689,6 +709,29 @@ private:
         sendMessage(ToolIpc::MessageType::StateQueryResponse, payload, msg.requestId);
     }
 
+    // The action that started the plugin call only answers once it returns, so progress the
+    // worker records meanwhile reaches the UI as unsolicited full snapshots, a few per second.
+    void pushWorkerProgressState() {
+        if (!m_workerMode || !m_workerHandle || !m_workerGetCurrentState) {
+            return;
+        }
+        if (m_workerProgressStateTimer.isValid() && m_workerProgressStateTimer.elapsed() < 150) {
+            return;
+        }
+        m_workerProgressStateTimer.start();
+
+        ToolWorkerResult result = TOOL_WORKER_ERROR_UNKNOWN;
+        const char* stateJson = m_workerGetCurrentState(m_workerHandle, &result);
+        if (result == TOOL_WORKER_SUCCESS) {
+            QJsonObject payload;
+            payload["state"] = jsonObjectFromUtf8(stateJson);
+            sendMessage(ToolIpc::MessageType::StateUpdate, payload);
+        }
+        if (stateJson && m_workerFreeString) {
+            m_workerFreeString(stateJson);
+        }
+    }
+
     void processPendingInitialStateQueries() {
         if (!m_dataReady || m_shutdownRequested || m_pendingInitialStateQueries.isEmpty()) {
             return;
@@ -757,29 +800,33 @@ private:
         payload["contentType"] = static_cast<int>(request.contentType);
         payload["flags"] = static_cast<int>(request.flags);
         payload["payloadBase64"] = QString::fromLatin1(request.payload.toBase64());
+        payload["streaming"] = static_cast<bool>(request.progressHandler);
 
         m_pluginInvokeRequestCompleted = false;
         m_pluginInvokeRequestResult = ToolRuntimeContext::PluginInvokeResponse{};
         m_pluginInvokeRequestId = requestId;
+        m_pluginInvokeProgressHandler = request.progressHandler;
+        m_pluginInvokeCancelSent = false;
 
         sendMessage(ToolIpc::MessageType::InvokePlugin, payload, requestId);
 
-        QElapsedTimer timer;
-        timer.start();
-        while (!m_pluginInvokeRequestCompleted && timer.elapsed() < 30000) {
+        // Progress events keep a long streaming call alive; the timeout only trips on silence.
+        m_pluginInvokeTimer.start();
+        while (!m_pluginInvokeRequestCompleted && m_pluginInvokeTimer.elapsed() < 30000) {
             processAvailableMessages();
             QCoreApplication::processEvents(QEventLoop::AllEvents, 20);
             processAvailableMessages();
             QThread::msleep(10);
         }
 
+        m_pluginInvokeRequestId = 0;
+        m_pluginInvokeProgressHandler = nullptr;
         if (!m_pluginInvokeRequestCompleted) {
-            m_pluginInvokeRequestId = 0;
+            sendMessage(ToolIpc::MessageType::CancelPluginInvocation, QJsonObject(), requestId);
             result.errorMessage = QStringLiteral("Timed out while invoking plugin operation: %1").arg(request.operation);
             return result;
         }
 
-        m_pluginInvokeRequestId = 0;
         return m_pluginInvokeRequestResult;
     }
 
@@ -820,6 +867,48 @@ private:
         return m_binaryReadRequestResult;
     }
 
+    ToolRuntimeContext::FileRangeReadResult requestBinaryFileRange(ToolRuntimeContext::FileRoot root,
+                                                                   const QString& relativePath,
+                                                                   qint64 offset,
+                                                                   qint64 maxBytes) {
+        ToolRuntimeContext::FileRangeReadResult result;
+        if (m_socket->state() != QLocalSocket::ConnectedState) {
+            result.errorMessage = "IPC socket is not connected.";
+            return result;
+        }
+
+        const quint32 requestId = ++m_requestId;
+        QJsonObject payload;
+        payload["root"] = ToolRuntimeContext::fileRootToString(root);
+        payload["relativePath"] = relativePath;
+        payload["offset"] = static_cast<double>(offset);
+        payload["maxBytes"] = static_cast<double>(maxBytes);
+
+        m_binaryRangeReadRequestCompleted = false;
+        m_binaryRangeReadRequestResult = ToolRuntimeContext::FileRangeReadResult{};
+        m_binaryRangeReadRequestId = requestId;
+
+        sendMessage(ToolIpc::MessageType::ReadBinaryFileRange, payload, requestId);
+
+        QElapsedTimer timer;
+        timer.start();
+        while (!m_binaryRangeReadRequestCompleted && timer.elapsed() < 5000) {
+            processAvailableMessages();
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 20);
+            processAvailableMessages();
+            QThread::msleep(10);
+        }
+
+        if (!m_binaryRangeReadRequestCompleted) {
+            m_binaryRangeReadRequestId = 0;
+            result.errorMessage = QString("Timed out while reading binary file: %1").arg(relativePath);
+            return result;
+        }
+
+        m_binaryRangeReadRequestId = 0;
+        return m_binaryRangeReadRequestResult;
+    }
+
     ToolRuntimeContext::TextReadResult requestTextFile(ToolRuntimeContext::FileRoot root, const QString& relativePath) {
         ToolRuntimeContext::TextReadResult result;
         if (m_socket->state() != QLocalSocket::ConnectedState) {
@@ -1009,6 +1098,57 @@ private:
         return m_writeRequestResult;
     }
 
+    ToolRuntimeContext::FileBatchWriteResult requestWriteBinaryFiles(ToolRuntimeContext::FileRoot root,
+                                                                     const QList<ToolRuntimeContext::FileWriteItem>& files) {
+        ToolRuntimeContext::FileBatchWriteResult result;
+        if (m_socket->state() != QLocalSocket::ConnectedState) {
+            result.errorMessage = "IPC socket is not connected.";
+            return result;
+        }
+
+        const quint32 requestId = ++m_requestId;
+        QJsonArray fileArray;
+        for (const ToolRuntimeContext::FileWriteItem& file : files) {
+            QJsonObject object;
+            object["relativePath"] = file.relativePath;
+            object["contentBase64"] = QString::fromLatin1(file.content.toBase64());
+            fileArray.append(object);
+        }
+        QJsonObject payload;
+        payload["root"] = ToolRuntimeContext::fileRootToString(root);
+        payload["files"] = fileArray;
+
+        m_batchWriteRequestCompleted = false;
+        m_batchWriteRequestResult = ToolRuntimeContext::FileBatchWriteResult{};
+        m_batchWriteRequestId = requestId;
+
+        sendMessage(ToolIpc::MessageType::WriteBinaryFiles, payload, requestId);
+
+        // The host writes the files one after another, so the timeout grows with the batch.
+        const qint64 timeoutMs = 5000 + 250 * static_cast<qint64>(files.size());
+        QElapsedTimer timer;
+        timer.start();
+        while (!m_batchWriteRequestCompleted && timer.elapsed() < timeoutMs) {
+            processAvailableMessages();
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 20);
+            processAvailableMessages();
+            QThread::msleep(10);
+        }
+
+        if (!m_batchWriteRequestCompleted) {
+            m_batchWriteRequestId = 0;
+            result.errorMessage = QString("Timed out while writing %1 binary files.").arg(files.size());
+            return result;
+        }
+
+        m_batchWriteRequestId = 0;
+        if (m_batchWriteRequestResult.success && m_batchWriteRequestResult.items.size() != files.size()) {
+            result.errorMessage = QStringLiteral("Batch write response does not match the request.");
+            return result;
+        }
+        return m_batchWriteRequestResult;
+    }
+
     ToolRuntimeContext::FileWriteResult requestWriteTextFile(ToolRuntimeContext::FileRoot root, const QString& relativePath, const QString& content) {
         ToolRuntimeContext::FileWriteResult result;
         if (m_socket->state() != QLocalSocket::ConnectedState) {
@@ -1229,6 +1369,29 @@ private:
             }
             break;
 
+        case ToolIpc::MessageType::InvokePluginProgress:
+            if (msg.requestId == m_pluginInvokeRequestId && m_pluginInvokeRequestId != 0) {
+                m_pluginInvokeTimer.restart();
+                if (!m_pluginInvokeProgressHandler || m_pluginInvokeCancelSent) {
+                    break;
+                }
+                ToolRuntimeContext::PluginProgressEvent event;
+                event.completed = static_cast<quint64>(msg.payload.value("completed").toDouble());
+                event.total = static_cast<quint64>(msg.payload.value("total").toDouble());
+                event.message = msg.payload.value("message").toString();
+                if (msg.payload.contains("chunkBase64")) {
+                    event.chunkContentType =
+                        static_cast<ToolRuntimeContext::PluginPayloadContentType>(msg.payload.value("chunkContentType").toInt());
+                    event.chunk = QByteArray::fromBase64(msg.payload.value("chunkBase64").toString().toLatin1());
+                }
+                if (!m_pluginInvokeProgressHandler(event)) {
+                    m_pluginInvokeCancelSent = true;
+                    sendMessage(ToolIpc::MessageType::CancelPluginInvocation, QJsonObject(), msg.requestId);
+                }
+                pushWorkerProgressState();
+            }
+            break;
+
         case ToolIpc::MessageType::ReadMatchingTextFilesResponse:
             if (msg.requestId == m_matchingTextFilesRequestId) {
                 m_matchingTextFilesRequestCompleted = true;
@@ -1258,6 +1421,18 @@ private:
             }
             break;
 
+        case ToolIpc::MessageType::ReadBinaryFileRangeResponse:
+            if (msg.requestId == m_binaryRangeReadRequestId) {
+                m_binaryRangeReadRequestCompleted = true;
+                m_binaryRangeReadRequestResult.success = msg.payload.value("success").toBool();
+                m_binaryRangeReadRequestResult.errorMessage = msg.payload.value("error").toString();
+                m_binaryRangeReadRequestResult.fileSize =
+                    static_cast<qint64>(msg.payload.value("fileSize").toDouble(-1));
+                m_binaryRangeReadRequestResult.content =
+                    QByteArray::fromBase64(msg.payload.value("contentBase64").toString().toLatin1());
+            }
+            break;
+
         case ToolIpc::MessageType::ReadTextFileResponse:
             if (msg.requestId == m_textReadRequestId) {
                 m_textReadRequestCompleted = true;
@@ -1316,6 +1491,21 @@ private:
             }
             break;
 
+        case ToolIpc::MessageType::WriteBinaryFilesResponse:
+            if (msg.requestId == m_batchWriteRequestId) {
+                m_batchWriteRequestCompleted = true;
+                m_batchWriteRequestResult.success = msg.payload.value("success").toBool();
+                m_batchWriteRequestResult.errorMessage = msg.payload.value("error").toString();
+                for (const QJsonValue& value : msg.payload.value("items").toArray()) {
+                    const QJsonObject object = value.toObject();
+                    m_batchWriteRequestResult.items.append({
+                        object.value("success").toBool(),
+                        object.value("error").toString()
+                    });
+                }
+            }
+            break;
+
         case ToolIpc::MessageType::ListDirectoryResponse:
             if (msg.requestId == m_directoryListRequestId) {
                 m_directoryListRequestCompleted = true;
@@ -1452,6 +1642,10 @@ private:
     bool m_pluginInvokeRequestCompleted = false;
     quint32 m_pluginInvokeRequestId = 0;
     ToolRuntimeContext::PluginInvokeResponse m_pluginInvokeRequestResult;
+    ToolRuntimeContext::PluginProgressHandler m_pluginInvokeProgressHandler;
+    bool m_pluginInvokeCancelSent = false;
+    QElapsedTimer m_pluginInvokeTimer;
+    QElapsedTimer m_workerProgressStateTimer;
 
     bool m_matchingTextFilesRequestCompleted = false;
     quint32 m_matchingTextFilesRequestId = 0;
@@ -1460,6 +1654,9 @@ private:
     bool m_binaryReadRequestCompleted = false;
     quint32 m_binaryReadRequestId = 0;
     ToolRuntimeContext::FileReadResult m_binaryReadRequestResult;
+    bool m_binaryRangeReadRequestCompleted = false;
+    quint32 m_binaryRangeReadRequestId = 0;
+    ToolRuntimeContext::FileRangeReadResult m_binaryRangeReadRequestResult;
 
     bool m_textReadRequestCompleted = false;
     quint32 m_textReadRequestId = 0;
@@ -1480,6 +1677,9 @@ private:
     bool m_writeRequestCompleted = false;
     quint32 m_writeRequestId = 0;
     ToolRuntimeContext::FileWriteResult m_writeRequestResult;
+    bool m_batchWriteRequestCompleted = false;
+    quint32 m_batchWriteRequestId = 0;
+    ToolRuntimeContext::FileBatchWriteResult m_batchWriteRequestResult;
 
     bool m_directoryListRequestCompleted = false;
     quint32 m_directoryListRequestId = 0;
@@ -72,13 +72,25 @@ enum class MessageType : quint32 {
     ConfigChanged = 70,
     FileIndexChanged = 71,
     ThemeChanged = 72,
-    
+
+    // Streaming plugin calls, keyed by the InvokePlugin request id
+    InvokePluginProgress = 75,      // Host -> Tool
+    CancelPluginInvocation = 76,    // Tool -> Host
+
+    // Partial file reads (Tool -> Host)
+    ReadBinaryFileRange = 77,
+    ReadBinaryFileRangeResponse = 78,
+
     // UI state synchronization (QML host <-> Worker)
     UiAction = 80,
     UiActionResponse = 81,
     StateUpdate = 82,
     StateQuery = 83,
     StateQueryResponse = 84,
+
+    // Batched binary writes (Tool -> Host)
+    WriteBinaryFiles = 85,
+    WriteBinaryFilesResponse = 86,
     
     // Worker management
     WorkerHeartbeat = 90,
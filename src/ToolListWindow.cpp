@@ -0,0 +1,57 @@
+//-------------------------------------------------------------------------------------
+// ToolListWindow.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "ToolListWindow.h"
+
+#include <QJsonValue>
+
+#include <algorithm>
+
+namespace ToolListWindow {
+
+bool ViewportSet::update(const QString& listId, const QJsonObject& arguments) {
+    const QJsonValue firstValue = arguments.value(QStringLiteral("first"));
+    const QJsonValue countValue = arguments.value(QStringLiteral("count"));
+    if (listId.trimmed().isEmpty() || !firstValue.isDouble() || !countValue.isDouble()) {
+        return false;
+    }
+
+    Range visible;
+    visible.first = std::max(0, firstValue.toInt());
+    visible.count = std::max(1, countValue.toInt());
+    m_visible.insert(listId, visible);
+    return true;
+}
+
+Range ViewportSet::requested(const QString& listId, int defaultCount) const {
+    const auto it = m_visible.constFind(listId);
+    if (it == m_visible.constEnd()) {
+        Range initial;
+        initial.count = defaultCount < 0 ? -1 : defaultCount;
+        return initial;
+    }
+
+    Range range;
+    range.first = std::max(0, it->first - it->count);
+    range.count = it->first - range.first + it->count * 2;
+    return range;
+}
+
+void ViewportSet::reset() {
+    m_visible.clear();
+}
+
+QJsonObject describe(int first, int count, int totalRows) {
+    QJsonObject window;
+    window[QStringLiteral("first")] = first;
+    window[QStringLiteral("count")] = count;
+    window[QStringLiteral("total")] = totalRows;
+    return window;
+}
+
+} // namespace ToolListWindow
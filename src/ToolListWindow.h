@@ -0,0 +1,52 @@
+//-------------------------------------------------------------------------------------
+// ToolListWindow.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef TOOLLISTWINDOW_H
+#define TOOLLISTWINDOW_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+// Windowed lists exchanged between tool workers and the host.
+//
+// A worker that windows a list serializes only a slice of its rows and publishes the slice under
+// viewState "listWindows".<listId> as {"first": N, "count": N, "total": N}. The host reports what
+// is on screen with a "set_viewport" action (targetId = list id, arguments {"first", "count"}) and
+// the worker answers with the rows around it.
+namespace ToolListWindow {
+
+// Rows sent for a windowed list before the host has reported its viewport.
+constexpr int kInitialWindowRows = 256;
+
+inline const char* viewportActionName() { return "set_viewport"; }
+
+struct Range {
+    int first = 0;
+    int count = -1; // -1: every row
+};
+
+// Worker-side record of the viewports the host has reported, one per list.
+class ViewportSet {
+public:
+    // Returns false when the arguments do not describe a range.
+    bool update(const QString& listId, const QJsonObject& arguments);
+    // The visible range widened by one screen on each side, or the first defaultCount rows
+    // when nothing has been reported yet. A negative defaultCount leaves the list unbounded.
+    Range requested(const QString& listId, int defaultCount = kInitialWindowRows) const;
+    void reset();
+
+private:
+    QHash<QString, Range> m_visible;
+};
+
+QJsonObject describe(int first, int count, int totalRows);
+
+} // namespace ToolListWindow
+
+#endif // TOOLLISTWINDOW_H
@@ -14,9 +14,11 @@
 #include "ToolDescriptorParser.h"
 #include "PluginAbiBroker.h"
 #include "ToolRuntimeContext.h"
+#include "ToolStatePatch.h"
 #include <QCoreApplication>
 #include <QFile>
 #include <QJsonDocument>
+#include <QPointer>
 #include <QStringConverter>
 #include <QTextStream>
 #include <QUuid>
@@ -943,7 +945,9 @@ void ToolProxyInterface::handleMessage(const ToolIpc::Message& msg) {
     case ToolIpc::MessageType::StateUpdate:
         {
             const QJsonObject stateObject = msg.payload.value(QStringLiteral("state")).toObject();
-            m_cachedStatePacket = parseStatePacket(stateObject);
+            if (!absorbStatePacket(stateObject)) {
+                break;
+            }
             int rowCount = 0;
             for (const QVariant& modelValue : m_cachedStatePacket.listModels) {
                 const QVariantMap modelMap = modelValue.toMap();
@@ -964,16 +968,24 @@ void ToolProxyInterface::handleMessage(const ToolIpc::Message& msg) {
         }
         break;
         
+    case ToolIpc::MessageType::CancelPluginInvocation:
+        if (const auto token = m_pluginCancelTokens.value(msg.requestId)) {
+            token->storeRelaxed(1);
+        }
+        break;
+
     case ToolIpc::MessageType::GetConfig:
     case ToolIpc::MessageType::GetFileIndex:
     case ToolIpc::MessageType::InvokePlugin:
     case ToolIpc::MessageType::ReadMatchingTextFiles:
     case ToolIpc::MessageType::ReadBinaryFile:
+    case ToolIpc::MessageType::ReadBinaryFileRange:
     case ToolIpc::MessageType::ReadTextFile:
     case ToolIpc::MessageType::ReadEffectiveBinaryFile:
     case ToolIpc::MessageType::ReadEffectiveTextFile:
     case ToolIpc::MessageType::ReadEffectiveTextFiles:
     case ToolIpc::MessageType::WriteBinaryFile:
+    case ToolIpc::MessageType::WriteBinaryFiles:
     case ToolIpc::MessageType::WriteTextFile:
     case ToolIpc::MessageType::RemovePath:
     case ToolIpc::MessageType::EnsureDirectory:
@@ -1041,6 +1053,11 @@ void ToolProxyInterface::stopHeartbeatTimers() {
 
 void ToolProxyInterface::clearPendingRequests() {
     m_pendingRequests.clear();
+    // Nobody is left to receive these results.
+    for (const auto& token : std::as_const(m_pluginCancelTokens)) {
+        token->storeRelaxed(1);
+    }
+    m_pluginCancelTokens.clear();
 }
 
 void ToolProxyInterface::markSessionAvailable() {
@@ -1061,6 +1078,7 @@ void ToolProxyInterface::setCachedLifecycleState(const QString& status, const QS
     packet.topbarState.insert(QStringLiteral("visible"), false);
     packet.sidebarState.insert(QStringLiteral("visible"), false);
     m_cachedStatePacket = packet;
+    m_stateRevision = 0;
 
     if (notify) {
         emit statePacketUpdated(statePacketToJsonObject(m_cachedStatePacket));
@@ -1160,7 +1178,10 @@ bool ToolProxyInterface::sendStateRequest(ToolIpc::MessageType type,
         const QString errorText = response.payload.value(QStringLiteral("error")).toString();
         const QJsonObject stateObject = response.payload.value(QStringLiteral("state")).toObject();
 
-        if (!success || stateObject.isEmpty()) {
+        // A failed action still reports the worker's current state; keeping it preserves the
+        // revision chain that later deltas are based on.
+        const bool absorbed = !stateObject.isEmpty() && absorbStatePacket(stateObject);
+        if (!success || !absorbed) {
             Logger::instance().logWarning(
                 "ToolProxyInterface",
                 QString("Worker async state request failed for %1 (type=%2, requestId=%3, reason=%4): %5")
@@ -1172,7 +1193,6 @@ bool ToolProxyInterface::sendStateRequest(ToolIpc::MessageType type,
             return;
         }
 
-        m_cachedStatePacket = parseStatePacket(stateObject);
         Logger::instance().logInfo(
             "ToolProxyInterface",
             QString("[STATE_CHAIN] Worker async state request succeeded for %1 (type=%2, requestId=%3, reason=%4): page=%5 listModels=%6")
@@ -1221,6 +1241,38 @@ bool ToolProxyInterface::sendStateRequest(ToolIpc::MessageType type,
     return true;
 }
 
+bool ToolProxyInterface::absorbStatePacket(const QJsonObject& stateObject) {
+    if (!ToolStatePatch::isDeltaPacket(stateObject)) {
+        m_cachedStatePacket = parseStatePacket(stateObject);
+        m_stateRevision = ToolStatePatch::revisionOf(stateObject);
+        m_stateResyncPending = false;
+        return true;
+    }
+
+    QString patchError;
+    if (m_stateRevision != 0
+        && ToolStatePatch::baseRevisionOf(stateObject) == m_stateRevision
+        && ToolStatePatch::applyToPacket(&m_cachedStatePacket,
+                                         stateObject.value(QStringLiteral("patches")).toArray(),
+                                         &patchError)) {
+        m_stateRevision = ToolStatePatch::revisionOf(stateObject);
+        return true;
+    }
+
+    // Missed or unusable delta: drop it and ask the worker for a full snapshot.
+    m_stateRevision = 0;
+    if (!m_stateResyncPending) {
+        Logger::instance().logWarning(
+            "ToolProxyInterface",
+            QString("Resynchronizing worker state for %1: %2")
+                .arg(m_toolInfo.id,
+                     patchError.isEmpty() ? QStringLiteral("state delta does not follow the cached revision") : patchError)
+        );
+        m_stateResyncPending = sendStateRequest(ToolIpc::MessageType::StateQuery, QJsonObject(), QStringLiteral("state_resync"));
+    }
+    return false;
+}
+
 ToolUiStatePacket ToolProxyInterface::parseStatePacket(const QJsonObject& jsonObject) {
     ToolUiStatePacket packet;
 
@@ -1491,15 +1543,47 @@ void ToolProxyInterface::handleDataRequest(const ToolIpc::Message& msg) {
             brokerRequest.payload = payloadBytes;
             brokerRequest.flags = flags;
             brokerRequest.authorizedDependencies = m_toolInfo.dependencies;
-
-            const PluginAbiBroker::Response brokerResponse = PluginAbiBroker::instance().invoke(brokerRequest);
-            payload["success"] = brokerResponse.success;
-            payload["status"] = static_cast<int>(brokerResponse.status);
-            payload["contentType"] = static_cast<int>(brokerResponse.contentType);
-            payload["flags"] = static_cast<int>(brokerResponse.flags);
-            payload["payloadBase64"] = QString::fromLatin1(brokerResponse.payload.toBase64());
-            payload["error"] = brokerResponse.errorMessage;
-            sendMessage(ToolIpc::MessageType::InvokePluginResponse, payload, msg.requestId);
+            brokerRequest.sessionId = m_serverName;
+            brokerRequest.cancelToken = std::make_shared<QAtomicInt>(0);
+
+            // Plugin work runs on the broker pool so a slow call never stalls the UI thread or other tools.
+            const QPointer<ToolProxyInterface> self(this);
+            const quint32 requestId = msg.requestId;
+            m_pluginCancelTokens.insert(requestId, brokerRequest.cancelToken);
+            if (msg.payload.value("streaming").toBool(false)) {
+                brokerRequest.streamHandler = [self, requestId](const PluginAbiBroker::StreamEvent& event) {
+                    QJsonObject progress;
+                    progress["completed"] = static_cast<double>(event.completed);
+                    progress["total"] = static_cast<double>(event.total);
+                    progress["message"] = event.message;
+                    if (!event.chunk.isEmpty()) {
+                        progress["chunkContentType"] = static_cast<int>(event.chunkContentType);
+                        progress["chunkBase64"] = QString::fromLatin1(event.chunk.toBase64());
+                    }
+                    QMetaObject::invokeMethod(qApp, [self, progress, requestId]() {
+                        if (self) {
+                            self->sendMessage(ToolIpc::MessageType::InvokePluginProgress, progress, requestId);
+                        }
+                    }, Qt::QueuedConnection);
+                    return true;
+                };
+            }
+            PluginAbiBroker::instance().invokeAsync(
+                brokerRequest,
+                [self, payload, requestId](const PluginAbiBroker::Response& brokerResponse) mutable {
+                    payload["success"] = brokerResponse.success;
+                    payload["status"] = static_cast<int>(brokerResponse.status);
+                    payload["contentType"] = static_cast<int>(brokerResponse.contentType);
+                    payload["flags"] = static_cast<int>(brokerResponse.flags);
+                    payload["payloadBase64"] = QString::fromLatin1(brokerResponse.payload.toBase64());
+                    payload["error"] = brokerResponse.errorMessage;
+                    QMetaObject::invokeMethod(qApp, [self, payload, requestId]() {
+                        if (self) {
+                            self->m_pluginCancelTokens.remove(requestId);
+                            self->sendMessage(ToolIpc::MessageType::InvokePluginResponse, payload, requestId);
+                        }
+                    }, Qt::QueuedConnection);
+                });
         }
         break;
 
@@ -1545,6 +1629,30 @@ void ToolProxyInterface::handleDataRequest(const ToolIpc::Message& msg) {
         }
         break;
 
+    case ToolIpc::MessageType::ReadBinaryFileRange:
+        {
+            const ToolRuntimeContext::FileRoot root = parseFileRootFromPayload(msg.payload);
+            const QString relativePath = msg.payload.value("relativePath").toString();
+            const qint64 offset = static_cast<qint64>(msg.payload.value("offset").toDouble());
+            const qint64 maxBytes = static_cast<qint64>(msg.payload.value("maxBytes").toDouble());
+            payload["root"] = ToolRuntimeContext::fileRootToString(root);
+            payload["relativePath"] = relativePath;
+            payload["offset"] = static_cast<double>(offset);
+
+            const ToolRuntimeContext::FileRangeReadResult result =
+                ToolRuntimeContext::instance().readFileRange(root, relativePath, offset, maxBytes);
+            payload["success"] = result.success;
+            payload["fileSize"] = static_cast<double>(result.fileSize);
+            if (result.success) {
+                payload["contentBase64"] = QString::fromLatin1(result.content.toBase64());
+            } else {
+                payload["error"] = result.errorMessage;
+            }
+
+            sendMessage(ToolIpc::MessageType::ReadBinaryFileRangeResponse, payload, msg.requestId);
+        }
+        break;
+
     case ToolIpc::MessageType::ReadTextFile:
         {
             const ToolRuntimeContext::FileRoot root = parseFileRootFromPayload(msg.payload);
@@ -1636,6 +1744,39 @@ void ToolProxyInterface::handleDataRequest(const ToolIpc::Message& msg) {
         }
         break;
 
+    case ToolIpc::MessageType::WriteBinaryFiles:
+        {
+            const ToolRuntimeContext::FileRoot root = parseFileRootFromPayload(msg.payload);
+            const QJsonArray fileArray = msg.payload.value("files").toArray();
+            QList<ToolRuntimeContext::FileWriteItem> files;
+            files.reserve(fileArray.size());
+            for (const QJsonValue& value : fileArray) {
+                const QJsonObject object = value.toObject();
+                files.append({
+                    object.value("relativePath").toString(),
+                    QByteArray::fromBase64(object.value("contentBase64").toString().toLatin1())
+                });
+            }
+
+            payload["root"] = ToolRuntimeContext::fileRootToString(root);
+
+            const ToolRuntimeContext::FileBatchWriteResult result =
+                ToolRuntimeContext::instance().writeFiles(root, files);
+            payload["success"] = result.success;
+            if (result.success) {
+                QJsonArray items;
+                for (const ToolRuntimeContext::FileWriteResult& item : result.items) {
+                    items.append(makeWriteResponsePayload(item));
+                }
+                payload["items"] = items;
+            } else {
+                payload["error"] = result.errorMessage;
+            }
+
+            sendMessage(ToolIpc::MessageType::WriteBinaryFilesResponse, payload, msg.requestId);
+        }
+        break;
+
     case ToolIpc::MessageType::WriteTextFile:
         {
             const ToolRuntimeContext::FileRoot root = parseFileRootFromPayload(msg.payload);
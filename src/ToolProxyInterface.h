@@ -14,8 +14,11 @@
 #include <QLocalServer>
 #include <QLocalSocket>
 #include <QTimer>
+#include <QAtomicInt>
+#include <QHash>
 #include <QMap>
 #include <functional>
+#include <memory>
 #include "ToolInterface.h"
 #include "ToolIpcProtocol.h"
 
@@ -49,6 +52,8 @@ public:
     void initializeWorkerSession() override;
     ToolUiStatePacket initialUiState() const override;
     ToolUiStatePacket handleUiAction(const ToolUiActionRequest& request) override;
+    // Latest state with every received delta applied.
+    const ToolUiStatePacket& cachedUiState() const { return m_cachedStatePacket; }
 
     void loadLanguage(const QString& lang) override;
     QMap<QString, QString> localizedStrings() const override { return m_localizedStrings; }
@@ -98,6 +103,7 @@ private:
                           const QString& reason = QString());
     void setCachedLifecycleState(const QString& status, const QString& message, bool notify);
     static ToolUiStatePacket parseStatePacket(const QJsonObject& jsonObject);
+    bool absorbStatePacket(const QJsonObject& stateObject);
     
     // Request-response handling
     using ResponseCallback = std::function<void(const ToolIpc::Message&)>;
@@ -126,7 +132,10 @@ private:
     
     quint32 m_requestIdCounter;
     QMap<quint32, ResponseCallback> m_pendingRequests;
+    QHash<quint32, std::shared_ptr<QAtomicInt>> m_pluginCancelTokens;
     ToolUiStatePacket m_cachedStatePacket;
+    quint64 m_stateRevision = 0;
+    bool m_stateResyncPending = false;
     QMap<QString, QString> m_localizedStrings;
     QString m_currentLanguageCode;
     QString m_currentGameLanguageCode;
@@ -8,10 +8,19 @@
 //-------------------------------------------------------------------------------------
 #include "ToolQmlBridge.h"
 
+#include "ToolListWindow.h"
+
 #include <QPoint>
+#include <QQmlEngine>
+#include <QUrl>
 #include <QVariantList>
 
+#include <algorithm>
+
 namespace {
+// Viewport reports are coalesced to at most one request per list per frame.
+constexpr int kViewportFlushIntervalMs = 16;
+
 QVariantMap toVariantMap(const QMap<QString, QString>& strings) {
     QVariantMap result;
     for (auto it = strings.constBegin(); it != strings.constEnd(); ++it) {
@@ -24,6 +33,9 @@ QVariantMap toVariantMap(const QMap<QString, QString>& strings) {
 
 ToolQmlBridge::ToolQmlBridge(QObject* parent)
     : QObject(parent) {
+    m_viewportTimer.setSingleShot(true);
+    m_viewportTimer.setInterval(kViewportFlushIntervalMs);
+    connect(&m_viewportTimer, &QTimer::timeout, this, &ToolQmlBridge::flushViewports);
 }
 
 QString ToolQmlBridge::currentPage() const {
@@ -54,6 +66,14 @@ void ToolQmlBridge::setStateSnapshot(const ToolGuiStateSnapshot& snapshot) {
     const bool pageDidChange = m_stateSnapshot.currentPage != snapshot.currentPage;
 
     m_stateSnapshot = snapshot;
+    for (auto it = m_listModels.constBegin(); it != m_listModels.constEnd(); ++it) {
+        syncListModel(it.key(), it.value());
+    }
+    // A new window may already cover the viewports that were asked for; re-check them next flush.
+    m_requestedViewports.clear();
+    if (!m_pendingViewports.isEmpty() && !m_viewportTimer.isActive()) {
+        m_viewportTimer.start();
+    }
 
     if (pageDidChange) {
         emit currentPageChanged();
@@ -108,6 +128,11 @@ QVariantList ToolQmlBridge::modelRows(const QString& modelId) const {
 }
 
 int ToolQmlBridge::modelRowCount(const QString& modelId) const {
+    const QVariantMap window = listWindow(modelId);
+    if (!window.isEmpty()) {
+        return window.value(QStringLiteral("total")).toInt();
+    }
+
     const auto modelIterator = m_stateSnapshot.models.constFind(modelId);
     return modelIterator == m_stateSnapshot.models.constEnd()
         ? 0
@@ -128,6 +153,11 @@ QVariantMap ToolQmlBridge::row(const QString& modelId, int rowIndex) const {
     }
 
     const ToolGuiCollectionModel& model = modelIterator.value();
+    const QVariantMap window = listWindow(modelId);
+    if (!window.isEmpty()) {
+        // Rows outside the window come back empty until the viewport request is answered.
+        rowIndex -= window.value(QStringLiteral("first")).toInt();
+    }
     if (rowIndex < 0 || rowIndex >= model.rows.size()) {
         return QVariantMap();
     }
@@ -135,6 +165,89 @@ QVariantMap ToolQmlBridge::row(const QString& modelId, int rowIndex) const {
     return convertRow(model.rows.at(rowIndex), model);
 }
 
+QObject* ToolQmlBridge::listModel(const QString& modelId) {
+    const auto existing = m_listModels.constFind(modelId);
+    if (existing != m_listModels.constEnd()) {
+        return existing.value();
+    }
+
+    auto* adapter = new ToolGuiModelAdapter(this);
+    QQmlEngine::setObjectOwnership(adapter, QQmlEngine::CppOwnership);
+    syncListModel(modelId, adapter);
+    m_listModels.insert(modelId, adapter);
+    return adapter;
+}
+
+void ToolQmlBridge::syncListModel(const QString& modelId, ToolGuiModelAdapter* listModel) const {
+    const ToolGuiCollectionModel model = m_stateSnapshot.models.value(modelId);
+    const QVariantMap window = listWindow(modelId);
+    if (window.isEmpty()) {
+        listModel->setModel(model);
+        return;
+    }
+    listModel->setWindowedModel(
+        model,
+        window.value(QStringLiteral("first")).toInt(),
+        window.value(QStringLiteral("total")).toInt()
+    );
+}
+
+void ToolQmlBridge::setViewport(const QString& listId, int first, int count) {
+    if (listId.trimmed().isEmpty() || count <= 0) {
+        return;
+    }
+
+    Viewport viewport;
+    viewport.first = std::max(0, first);
+    viewport.count = count;
+    m_pendingViewports.insert(listId, viewport);
+    if (!m_viewportTimer.isActive()) {
+        m_viewportTimer.start();
+    }
+}
+
+QVariantMap ToolQmlBridge::listWindow(const QString& listId) const {
+    return m_stateSnapshot.values.value(QStringLiteral("listWindows")).toMap().value(listId).toMap();
+}
+
+void ToolQmlBridge::flushViewports() {
+    const QHash<QString, Viewport> pending = m_pendingViewports;
+    m_pendingViewports.clear();
+
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        const QVariantMap window = listWindow(it.key());
+        if (window.isEmpty()) {
+            continue;
+        }
+
+        const Viewport& viewport = it.value();
+        const int heldFirst = window.value(QStringLiteral("first")).toInt();
+        const int heldEnd = heldFirst + window.value(QStringLiteral("count")).toInt();
+        const int total = window.value(QStringLiteral("total")).toInt();
+
+        // Fetch before the edge is reached: half a screen of margin must already be held.
+        const int margin = viewport.count / 2;
+        const int neededFirst = std::max(0, viewport.first - margin);
+        const int neededEnd = std::min(total, viewport.first + viewport.count + margin);
+        if (neededFirst >= heldFirst && neededEnd <= heldEnd) {
+            continue;
+        }
+
+        const auto requested = m_requestedViewports.constFind(it.key());
+        if (requested != m_requestedViewports.constEnd()
+            && requested->first == viewport.first
+            && requested->count == viewport.count) {
+            continue;
+        }
+        m_requestedViewports.insert(it.key(), viewport);
+
+        QVariantMap arguments;
+        arguments.insert(QStringLiteral("first"), viewport.first);
+        arguments.insert(QStringLiteral("count"), viewport.count);
+        emit actionRequested(QString::fromLatin1(ToolListWindow::viewportActionName()), it.key(), arguments);
+    }
+}
+
 QVariant ToolQmlBridge::value(const QString& key, const QVariant& defaultValue) const {
     return m_stateSnapshot.values.value(key, defaultValue);
 }
@@ -161,6 +274,18 @@ QString ToolQmlBridge::imageSource(const QString& pngBase64, const QString& cach
     return QStringLiteral("data:image/png;base64,%1").arg(trimmedBase64);
 }
 
+QString ToolQmlBridge::effectiveImageSource(const QString& logicalPath, int width, int height) const {
+    const QString trimmedPath = logicalPath.trimmed();
+    if (trimmedPath.isEmpty()) {
+        return {};
+    }
+
+    return QStringLiteral("image://apetoolthumbnail/%1x%2/%3")
+        .arg(std::max(0, width))
+        .arg(std::max(0, height))
+        .arg(QString::fromLatin1(QUrl::toPercentEncoding(trimmedPath, "/")));
+}
+
 void ToolQmlBridge::dispatchAction(const QString& actionType,
                                    const QString& targetId,
                                    const QVariantMap& arguments) {
@@ -193,45 +318,11 @@ QVariantMap ToolQmlBridge::convertModel(const ToolGuiCollectionModel& model) con
 }
 
 QVariantMap ToolQmlBridge::convertRow(const ToolGuiListRow& row, const ToolGuiCollectionModel& model) const {
-    QVariantMap result;
-    result.insert(QStringLiteral("id"), row.id);
-    result.insert(QStringLiteral("rowId"), row.rowId.isEmpty() ? row.id : row.rowId);
-    result.insert(QStringLiteral("role"), row.role);
-    result.insert(QStringLiteral("values"), row.values);
-    result.insert(QStringLiteral("state"), row.state);
-    result.insert(
-        QStringLiteral("selected"),
+    return ToolGuiModelAdapter::rowMap(
+        row,
+        model.columns,
         !row.id.isEmpty() && model.selection.contains(row.id)
     );
-
-    QVariantList cellList;
-    for (int index = 0; index < row.cells.size(); ++index) {
-        QVariantMap cellMap;
-        cellMap.insert(QStringLiteral("value"), row.cells.at(index).value);
-        cellMap.insert(QStringLiteral("role"), row.cells.at(index).role);
-        if (index >= 0 && index < model.columns.size()) {
-            cellMap.insert(QStringLiteral("key"), model.columns.at(index).key);
-        }
-        cellList.append(cellMap);
-    }
-    result.insert(QStringLiteral("cells"), cellList);
-
-    for (int columnIndex = 0; columnIndex < model.columns.size(); ++columnIndex) {
-        const QString key = model.columns.at(columnIndex).key;
-        if (key.trimmed().isEmpty()) {
-            continue;
-        }
-
-        QVariant cellValue;
-        if (columnIndex >= 0 && columnIndex < row.cells.size()) {
-            cellValue = row.cells.at(columnIndex).value;
-        } else {
-            cellValue = row.values.value(key);
-        }
-        result.insert(key, cellValue);
-    }
-
-    return result;
 }
 
 QVariantList ToolQmlBridge::convertColumns(const ToolGuiCollectionModel& model) const {
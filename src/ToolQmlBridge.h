@@ -10,10 +10,13 @@
 #define TOOLQMLBRIDGE_H
 
 #include "ToolGuiRuntime.h"
+#include "ToolGuiModelAdapter.h"
 
 #include <QMap>
 #include <QObject>
+#include <QHash>
 #include <QPoint>
+#include <QTimer>
 #include <QVariantMap>
 
 class ToolQmlBridge : public QObject {
@@ -46,9 +49,18 @@ public:
     Q_INVOKABLE int modelRowCount(const QString& modelId) const;
     Q_INVOKABLE QVariantList modelColumns(const QString& modelId) const;
     Q_INVOKABLE QVariantMap row(const QString& modelId, int rowIndex) const;
+    // Item model for a list view. It is diffed against every new state, so rows are inserted,
+    // removed, moved or changed in place instead of rebinding the whole view.
+    Q_INVOKABLE QObject* listModel(const QString& modelId);
+    // Reports the rows a view shows for a windowed list; rows outside the window the worker
+    // sent are requested once the viewport nears its edge.
+    Q_INVOKABLE void setViewport(const QString& listId, int first, int count);
     Q_INVOKABLE QVariant value(const QString& key, const QVariant& defaultValue = QVariant()) const;
     Q_INVOKABLE QString text(const QString& key, const QString& fallback = QString()) const;
     Q_INVOKABLE QString imageSource(const QString& pngBase64, const QString& cacheHint = QString()) const;
+    // Provider URL for an effective game/mod image, decoded and scaled off the GUI thread and
+    // cached on disk. A zero width or height keeps the native size.
+    Q_INVOKABLE QString effectiveImageSource(const QString& logicalPath, int width = 0, int height = 0) const;
     Q_INVOKABLE void dispatchAction(const QString& actionType,
                                     const QString& targetId = QString(),
                                     const QVariantMap& arguments = QVariantMap());
@@ -76,12 +88,24 @@ private:
     QVariantMap convertRow(const ToolGuiListRow& row, const ToolGuiCollectionModel& model) const;
     QVariantList convertColumns(const ToolGuiCollectionModel& model) const;
     QVariantList convertRows(const ToolGuiCollectionModel& model) const;
+    QVariantMap listWindow(const QString& listId) const;
+    void syncListModel(const QString& modelId, ToolGuiModelAdapter* listModel) const;
+    void flushViewports();
+
+    struct Viewport {
+        int first = 0;
+        int count = 0;
+    };
 
     ToolGuiStateSnapshot m_stateSnapshot;
     QMap<QString, QString> m_localizedStrings;
     int m_localizationRevision = 0;
     int m_acrylicRevision = 0;
     QString m_theme;
+    QHash<QString, Viewport> m_pendingViewports;
+    QHash<QString, Viewport> m_requestedViewports;
+    QHash<QString, ToolGuiModelAdapter*> m_listModels;
+    QTimer m_viewportTimer;
 };
 
 #endif // TOOLQMLBRIDGE_H
@@ -24,8 +24,10 @@
 #include "Logger.h"
 #include "ToolProxyInterface.h"
 #include "ToolQmlBridge.h"
+#include "ToolListWindow.h"
 #include "ToolQmlHostComponents.h"
 #include "ToolQmlThemeProvider.h"
+#include "ToolThumbnailCache.h"
 #include "ToolUiContainer.h"
 
 #include <QDir>
@@ -37,18 +39,22 @@
 #include <QQmlComponent>
 #include <QQmlContext>
 #include <QQmlEngine>
+#include <QQuickAsyncImageProvider>
 #include <QQuickImageProvider>
 #include <QQuickItem>
 #include <QQuickWindow>
 #include <QQuickWidget>
 #include <QScreen>
 #include <QSizePolicy>
+#include <QThread>
+#include <QThreadPool>
 #include <QTimer>
 #include <QUrl>
 #include <QVariantList>
 #include <QWindow>
 
 #include <algorithm>
+#include <atomic>
 
 #ifdef Q_OS_WIN
 #ifndef NOMINMAX
@@ -91,6 +97,73 @@ private:
     QImage m_image;
 };
 
+// Loads one "<width>x<height>/<percent-encoded logical path>" id through ToolThumbnailCache.
+// A 0x0 size keeps the image at its native size.
+class ToolQmlThumbnailResponse : public QQuickImageResponse, public QRunnable {
+public:
+    ToolQmlThumbnailResponse(const QString& id, const QSize& requestedSize)
+        : m_id(id),
+          m_requestedSize(requestedSize) {
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        if (!m_cancelled.load()) {
+            const int separator = m_id.indexOf(QLatin1Char('/'));
+            const QStringList sizeParts = m_id.left(separator).split(QLatin1Char('x'));
+            QSize size;
+            if (separator > 0 && sizeParts.size() == 2) {
+                size = QSize(sizeParts.at(0).toInt(), sizeParts.at(1).toInt());
+            }
+            if (!size.isValid() || size.isEmpty()) {
+                size = m_requestedSize.isValid() && !m_requestedSize.isEmpty() ? m_requestedSize : QSize();
+            }
+            const QString logicalPath = QUrl::fromPercentEncoding(m_id.mid(separator + 1).toUtf8());
+            m_image = ToolThumbnailCache::instance().thumbnail(logicalPath, size);
+        }
+        emit finished();
+    }
+
+    QQuickTextureFactory* textureFactory() const override {
+        return QQuickTextureFactory::textureFactoryForImage(m_image);
+    }
+
+    QString errorString() const override {
+        return m_image.isNull() ? QStringLiteral("Thumbnail is unavailable.") : QString();
+    }
+
+    void cancel() override {
+        m_cancelled.store(true);
+    }
+
+private:
+    QString m_id;
+    QSize m_requestedSize;
+    QImage m_image;
+    std::atomic<bool> m_cancelled{false};
+};
+
+// Thumbnails are decoded off the GUI thread, only for delegates that are actually created.
+class ToolQmlThumbnailProvider : public QQuickAsyncImageProvider {
+public:
+    ToolQmlThumbnailProvider() {
+        m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+    }
+
+    ~ToolQmlThumbnailProvider() override {
+        m_pool.waitForDone();
+    }
+
+    QQuickImageResponse* requestImageResponse(const QString& id, const QSize& requestedSize) override {
+        auto* response = new ToolQmlThumbnailResponse(id, requestedSize);
+        m_pool.start(response);
+        return response;
+    }
+
+private:
+    QThreadPool m_pool;
+};
+
 //-------------------------------------------------------------------------------------
 // DebugQuickWidget Implementation - Mouse Event Tracking
 //-------------------------------------------------------------------------------------
@@ -590,6 +663,7 @@ bool ToolQmlHostController::initialize(const QString& toolDirectoryPath,
         m_engine = new QQmlEngine(this);
         m_acrylicProvider = new ToolQmlAcrylicImageProvider();
         m_engine->addImageProvider(QStringLiteral("apetoolacrylic"), m_acrylicProvider);
+        m_engine->addImageProvider(QStringLiteral("apetoolthumbnail"), new ToolQmlThumbnailProvider());
         m_bridge = new ToolQmlBridge(this);
         m_themeProvider = new ToolQmlThemeProvider(this);
         ToolQmlHostComponents::setSharedThemeProvider(m_themeProvider);
@@ -1128,6 +1202,7 @@ DebugQuickWidget* ToolQmlHostController::createQuickWidget(QWidget* parent) {
         m_engine = new QQmlEngine(this);
         m_acrylicProvider = new ToolQmlAcrylicImageProvider();
         m_engine->addImageProvider(QStringLiteral("apetoolacrylic"), m_acrylicProvider);
+        m_engine->addImageProvider(QStringLiteral("apetoolthumbnail"), new ToolQmlThumbnailProvider());
     }
 
     if (kVerboseToolQmlHostLogging) {
@@ -1206,7 +1281,12 @@ void ToolQmlHostController::handleBridgeAction(const QString& actionType,
         request.arguments.insert(QStringLiteral("targetId"), request.targetId);
     }
 
-    applyStatePacket(m_proxy->handleUiAction(request), true);
+    const ToolUiStatePacket cachedPacket = m_proxy->handleUiAction(request);
+    // Viewport reports only fetch rows; the cached state has nothing new to show until they arrive.
+    if (actionType == QLatin1String(ToolListWindow::viewportActionName())) {
+        return;
+    }
+    applyStatePacket(cachedPacket, true);
 }
 
 QWidget* ToolQmlHostController::topLevelHostWindow() const {
@@ -8,6 +8,8 @@
 //-------------------------------------------------------------------------------------
 #include "ToolRuntimeContext.h"
 
+#include "PluginAbiBatch.h"
+
 ToolRuntimeContext& ToolRuntimeContext::instance() {
     static ToolRuntimeContext instance;
     return instance;
@@ -28,6 +30,67 @@ ToolRuntimeContext::PluginInvokeResponse ToolRuntimeContext::invokePlugin(const
     return m_pluginInvoker(request);
 }
 
+ToolRuntimeContext::PluginBatchResponse ToolRuntimeContext::invokePluginBatch(const QString& pluginName,
+                                                                              const QList<PluginInvokeRequest>& items,
+                                                                              PluginProgressHandler progressHandler) const {
+    PluginBatchResponse result;
+    if (items.isEmpty()) {
+        result.success = true;
+        return result;
+    }
+
+    QList<PluginAbiBatch::Item> batchItems;
+    batchItems.reserve(items.size());
+    for (const PluginInvokeRequest& item : items) {
+        PluginAbiBatch::Item batchItem;
+        batchItem.operation = item.operation;
+        batchItem.contentType = static_cast<quint32>(item.contentType);
+        batchItem.flags = item.flags;
+        batchItem.payload = item.payload;
+        batchItems.append(batchItem);
+    }
+
+    PluginInvokeRequest request;
+    request.pluginName = pluginName;
+    request.operation = QStringLiteral(APE_PLUGIN_ABI_BATCH_OPERATION);
+    request.contentType = PluginPayloadContentType::BinaryEnvelope;
+    request.payload = PluginAbiBatch::encodeRequest(batchItems);
+    request.progressHandler = progressHandler
+        ? std::move(progressHandler)
+        : [](const PluginProgressEvent&) { return true; };
+
+    const PluginInvokeResponse response = invokePlugin(request);
+    result.status = response.status;
+    if (!response.success) {
+        result.errorMessage = response.errorMessage;
+        return result;
+    }
+
+    QList<PluginAbiBatch::ItemResult> itemResults;
+    if (!PluginAbiBatch::decodeResponse(response.payload, &itemResults, &result.errorMessage)
+        || itemResults.size() != items.size()) {
+        if (result.errorMessage.isEmpty()) {
+            result.errorMessage = QStringLiteral("Plugin batch response does not match the request.");
+        }
+        return result;
+    }
+
+    result.items.reserve(itemResults.size());
+    for (const PluginAbiBatch::ItemResult& itemResult : itemResults) {
+        PluginInvokeResponse itemResponse;
+        itemResponse.status = itemResult.status;
+        itemResponse.success = itemResult.status == 0;
+        itemResponse.contentType = static_cast<PluginPayloadContentType>(itemResult.contentType);
+        itemResponse.flags = itemResult.flags;
+        itemResponse.payload = itemResult.payload;
+        itemResponse.payloadOwner = response.payloadOwner;
+        itemResponse.errorMessage = itemResult.errorMessage;
+        result.items.append(itemResponse);
+    }
+    result.success = true;
+    return result;
+}
+
 void ToolRuntimeContext::setMatchingTextFileReader(MatchingTextFileReader reader) {
     m_matchingTextFileReader = std::move(reader);
 }
@@ -67,6 +130,29 @@ ToolRuntimeContext::TextReadResult ToolRuntimeContext::readTextFile(FileRoot roo
     return m_textFileReader(root, relativePath);
 }
 
+void ToolRuntimeContext::setBinaryFileRangeReader(BinaryFileRangeReader reader) {
+    m_binaryFileRangeReader = std::move(reader);
+}
+
+ToolRuntimeContext::FileRangeReadResult ToolRuntimeContext::readFileRange(FileRoot root,
+                                                                          const QString& relativePath,
+                                                                          qint64 offset,
+                                                                          qint64 maxBytes) const {
+    if (offset < 0 || maxBytes < 0) {
+        return {false, QByteArray(), -1, "Invalid file range."};
+    }
+    if (m_binaryFileRangeReader) {
+        return m_binaryFileRangeReader(root, relativePath, offset, maxBytes);
+    }
+
+    const FileReadResult whole = readFile(root, relativePath);
+    if (!whole.success) {
+        return {false, QByteArray(), -1, whole.errorMessage};
+    }
+    const qint64 fileSize = whole.content.size();
+    return {true, offset < fileSize ? whole.content.mid(offset, maxBytes) : QByteArray(), fileSize, QString()};
+}
+
 void ToolRuntimeContext::setEffectiveBinaryFileReader(EffectiveBinaryFileReader reader) {
     m_effectiveBinaryFileReader = std::move(reader);
 }
@@ -129,6 +215,30 @@ ToolRuntimeContext::FileWriteResult ToolRuntimeContext::writeFile(FileRoot root,
     return m_binaryFileWriter(root, relativePath, content);
 }
 
+void ToolRuntimeContext::setBinaryFilesWriter(BinaryFilesWriter writer) {
+    m_binaryFilesWriter = std::move(writer);
+}
+
+ToolRuntimeContext::FileBatchWriteResult ToolRuntimeContext::writeFiles(FileRoot root,
+                                                                       const QList<FileWriteItem>& files) const {
+    if (m_binaryFilesWriter) {
+        return m_binaryFilesWriter(root, files);
+    }
+
+    FileBatchWriteResult result;
+    if (!m_binaryFileWriter) {
+        result.errorMessage = "Binary file writer is not available.";
+        return result;
+    }
+
+    result.items.reserve(files.size());
+    for (const FileWriteItem& file : files) {
+        result.items.append(m_binaryFileWriter(root, file.relativePath, file.content));
+    }
+    result.success = true;
+    return result;
+}
+
 void ToolRuntimeContext::setTextFileWriter(TextFileWriter writer) {
     m_textFileWriter = std::move(writer);
 }
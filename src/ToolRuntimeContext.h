@@ -15,6 +15,7 @@
 #include <QDateTime>
 #include <QList>
 #include <functional>
+#include <memory>
 
 class ToolRuntimeContext {
 public:
@@ -44,11 +45,31 @@ public:
         QString errorMessage;
     };
 
+    struct FileRangeReadResult {
+        bool success = false;
+        QByteArray content;
+        // Size of the whole file at the time of the read.
+        qint64 fileSize = -1;
+        QString errorMessage;
+    };
+
     struct FileWriteResult {
         bool success = false;
         QString errorMessage;
     };
 
+    struct FileWriteItem {
+        QString relativePath;
+        QByteArray content;
+    };
+
+    struct FileBatchWriteResult {
+        bool success = false;
+        // One entry per submitted file, in submission order.
+        QList<FileWriteResult> items;
+        QString errorMessage;
+    };
+
     struct DirectoryEntry {
         QString relativePath;
         QString name;
@@ -94,32 +115,58 @@ public:
         BinaryEnvelope = 3
     };
 
+    struct PluginProgressEvent {
+        quint64 completed = 0;
+        quint64 total = 0;
+        QString message;
+        // Partial result emitted by the plugin; empty for pure progress events.
+        PluginPayloadContentType chunkContentType = PluginPayloadContentType::None;
+        QByteArray chunk;
+    };
+
+    // Returning false cancels the plugin call.
+    using PluginProgressHandler = std::function<bool(const PluginProgressEvent&)>;
+
     struct PluginInvokeRequest {
         QString pluginName;
         QString operation;
         PluginPayloadContentType contentType = PluginPayloadContentType::None;
         QByteArray payload;
         quint32 flags = 0;
+        // Optional; only plugins exporting APE_Plugin_InvokeStreaming report progress.
+        PluginProgressHandler progressHandler;
     };
 
     struct PluginInvokeResponse {
         bool success = false;
         PluginPayloadContentType contentType = PluginPayloadContentType::None;
         QByteArray payload;
+        // Keeps a zero-copy plugin payload alive; see PluginAbiBroker::Response.
+        std::shared_ptr<void> payloadOwner;
         QString errorMessage;
         quint32 status = 0;
         quint32 flags = 0;
     };
 
+    struct PluginBatchResponse {
+        bool success = false;
+        // One entry per submitted item, in submission order, each with its own status.
+        QList<PluginInvokeResponse> items;
+        QString errorMessage;
+        quint32 status = 0;
+    };
+
     using PluginInvoker = std::function<PluginInvokeResponse(const PluginInvokeRequest&)>;
     using MatchingTextFileReader = std::function<MatchingTextFilesResult(FileRoot, const QString&, const QString&, bool)>;
     using BinaryFileReader = std::function<FileReadResult(FileRoot, const QString&)>;
     using TextFileReader = std::function<TextReadResult(FileRoot, const QString&)>;
+    using BinaryFileRangeReader = std::function<FileRangeReadResult(FileRoot, const QString&, qint64, qint64)>;
     using EffectiveBinaryFileReader = std::function<FileReadResult(const QString&)>;
     using EffectiveTextFileReader = std::function<TextReadResult(const QString&)>;
     using EffectiveFileEnumerator = std::function<EffectiveFileListResult(const QString&, const QString&)>;
     using EffectiveTextFilesReader = std::function<MatchingTextFilesResult(const QString&, const QString&)>;
     using BinaryFileWriter = std::function<FileWriteResult(FileRoot, const QString&, const QByteArray&)>;
+    using BinaryFilesWriter = std::function<FileBatchWriteResult(FileRoot, const QList<FileWriteItem>&)>;
     using TextFileWriter = std::function<FileWriteResult(FileRoot, const QString&, const QString&)>;
     using PathRemover = std::function<FileWriteResult(FileRoot, const QString&)>;
     using DirectoryEnsurer = std::function<FileWriteResult(FileRoot, const QString&)>;
@@ -129,6 +176,12 @@ public:
 
     void setPluginInvoker(PluginInvoker invoker);
     PluginInvokeResponse invokePlugin(const PluginInvokeRequest& request) const;
+    // Sends every item to pluginName in one invocation; the items' own pluginName is ignored. The
+    // batch always streams one progress event per finished item, so a long batch from a tool
+    // process never trips the host's silence timeout; progressHandler is optional.
+    PluginBatchResponse invokePluginBatch(const QString& pluginName,
+                                          const QList<PluginInvokeRequest>& items,
+                                          PluginProgressHandler progressHandler = PluginProgressHandler()) const;
 
     void setMatchingTextFileReader(MatchingTextFileReader reader);
     MatchingTextFilesResult readMatchingTextFiles(FileRoot root,
@@ -142,6 +195,11 @@ public:
     void setTextFileReader(TextFileReader reader);
     TextReadResult readTextFile(FileRoot root, const QString& relativePath) const;
 
+    // Reads at most maxBytes starting at offset. Without a range reader the whole file is read
+    // and sliced.
+    void setBinaryFileRangeReader(BinaryFileRangeReader reader);
+    FileRangeReadResult readFileRange(FileRoot root, const QString& relativePath, qint64 offset, qint64 maxBytes) const;
+
     void setEffectiveBinaryFileReader(EffectiveBinaryFileReader reader);
     FileReadResult readEffectiveFile(const QString& relativePath) const;
 
@@ -159,6 +217,11 @@ public:
     void setBinaryFileWriter(BinaryFileWriter writer);
     FileWriteResult writeFile(FileRoot root, const QString& relativePath, const QByteArray& content) const;
 
+    // Writes every file in one request. Without a batch writer the files are written one by one;
+    // success only reports that the batch was delivered, each item carries its own result.
+    void setBinaryFilesWriter(BinaryFilesWriter writer);
+    FileBatchWriteResult writeFiles(FileRoot root, const QList<FileWriteItem>& files) const;
+
     void setTextFileWriter(TextFileWriter writer);
     FileWriteResult writeTextFile(FileRoot root, const QString& relativePath, const QString& content) const;
 
@@ -183,11 +246,13 @@ private:
     MatchingTextFileReader m_matchingTextFileReader;
     BinaryFileReader m_binaryFileReader;
     TextFileReader m_textFileReader;
+    BinaryFileRangeReader m_binaryFileRangeReader;
     EffectiveBinaryFileReader m_effectiveBinaryFileReader;
     EffectiveTextFileReader m_effectiveTextFileReader;
     EffectiveFileEnumerator m_effectiveFileEnumerator;
     EffectiveTextFilesReader m_effectiveTextFilesReader;
     BinaryFileWriter m_binaryFileWriter;
+    BinaryFilesWriter m_binaryFilesWriter;
     TextFileWriter m_textFileWriter;
     PathRemover m_pathRemover;
     DirectoryEnsurer m_directoryEnsurer;
@@ -11,6 +11,7 @@
 #include "Logger.h"
 #include "ToolProxyInterface.h"
 #include "ToolQmlHostController.h"
+#include "ToolStatePatch.h"
 
 #include <QJsonObject>
 #include <QMetaObject>
@@ -229,7 +230,10 @@ bool ToolScriptedHostController::invokeTopbarShortcut(const QString& actionId) {
 }
 
 void ToolScriptedHostController::mergeStatePacket(const QJsonObject& statePacket) {
-    m_lastStatePacket = statePacketFromJsonObject(statePacket);
+    // Deltas have already been applied to the proxy's cached packet.
+    m_lastStatePacket = ToolStatePatch::isDeltaPacket(statePacket) && m_proxy
+        ? m_proxy->cachedUiState()
+        : statePacketFromJsonObject(statePacket);
     m_currentState = m_qmlHostController
         ? m_qmlHostController->stateSnapshotFromPacket(m_lastStatePacket)
         : ToolGuiStateSnapshot();
@@ -0,0 +1,500 @@
+//-------------------------------------------------------------------------------------
+// ToolStatePatch.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "ToolStatePatch.h"
+
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonValue>
+#include <QList>
+#include <QSet>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+
+namespace {
+// Deltas larger than this are compared with the full snapshot and the smaller one is sent.
+constexpr int kDeltaSizeCheckThreshold = 64 * 1024;
+
+struct PathSegment {
+    QString key;
+    bool rowId = false;
+};
+
+// Keys that mirror other keys or describe the packet itself; they are never diffed.
+bool isSkippedTopLevelKey(const QString& key) {
+    return key == QLatin1String("values")
+        || key == QLatin1String("currentPage")
+        || key == QLatin1String("models")
+        || key == QLatin1String("patches")
+        || key == QLatin1String("revision")
+        || key == QLatin1String("baseRevision")
+        || key == QLatin1String("delta");
+}
+
+QString escapeText(const QString& text) {
+    QString escaped = text;
+    escaped.replace(QLatin1Char('~'), QStringLiteral("~0"));
+    escaped.replace(QLatin1Char('/'), QStringLiteral("~1"));
+    return escaped;
+}
+
+QString keySegment(const QString& key) {
+    QString escaped = escapeText(key);
+    if (escaped.startsWith(QLatin1Char('#'))) {
+        escaped.replace(0, 1, QStringLiteral("~2"));
+    }
+    return escaped;
+}
+
+QString rowSegment(const QString& id) {
+    return QLatin1Char('#') + escapeText(id);
+}
+
+bool parsePath(const QString& path, QList<PathSegment>* outSegments) {
+    if (!path.startsWith(QLatin1Char('/'))) {
+        return false;
+    }
+
+    const QStringList parts = path.mid(1).split(QLatin1Char('/'));
+    for (const QString& part : parts) {
+        PathSegment segment;
+        qsizetype start = 0;
+        if (part.startsWith(QLatin1Char('#'))) {
+            segment.rowId = true;
+            start = 1;
+        }
+        segment.key.reserve(part.size());
+        for (qsizetype i = start; i < part.size(); ++i) {
+            const QChar ch = part.at(i);
+            if (ch != QLatin1Char('~')) {
+                segment.key.append(ch);
+                continue;
+            }
+            if (i + 1 >= part.size()) {
+                return false;
+            }
+            const QChar code = part.at(++i);
+            if (code == QLatin1Char('0')) {
+                segment.key.append(QLatin1Char('~'));
+            } else if (code == QLatin1Char('1')) {
+                segment.key.append(QLatin1Char('/'));
+            } else if (code == QLatin1Char('2')) {
+                segment.key.append(QLatin1Char('#'));
+            } else {
+                return false;
+            }
+        }
+        outSegments->append(segment);
+    }
+    return !outSegments->isEmpty();
+}
+
+bool jsonRowId(const QJsonValue& value, QString* outId) {
+    if (!value.isObject()) {
+        return false;
+    }
+    const QJsonValue id = value.toObject().value(QStringLiteral("id"));
+    if (!id.isString() && !id.isDouble()) {
+        return false;
+    }
+    // Converted through QVariant so the worker and the host stringify numeric ids identically.
+    *outId = id.toVariant().toString();
+    return true;
+}
+
+bool keyedRowIds(const QJsonArray& array, QStringList* outIds) {
+    QSet<QString> seen;
+    seen.reserve(array.size());
+    outIds->reserve(array.size());
+    for (const QJsonValue& value : array) {
+        QString id;
+        if (!jsonRowId(value, &id) || seen.contains(id)) {
+            return false;
+        }
+        seen.insert(id);
+        outIds->append(id);
+    }
+    return true;
+}
+
+QJsonObject makePatch(const QString& op, const QString& path) {
+    QJsonObject patch;
+    patch[QStringLiteral("op")] = op;
+    patch[QStringLiteral("path")] = path;
+    return patch;
+}
+
+void diffValue(const QString& path, const QJsonValue& before, const QJsonValue& after, QJsonArray* out);
+
+void diffObject(const QString& path,
+                const QJsonObject& before,
+                const QJsonObject& after,
+                bool topLevel,
+                QJsonArray* out) {
+    for (auto it = before.constBegin(); it != before.constEnd(); ++it) {
+        if ((topLevel && isSkippedTopLevelKey(it.key())) || after.contains(it.key())) {
+            continue;
+        }
+        out->append(makePatch(QStringLiteral("remove"), path + QLatin1Char('/') + keySegment(it.key())));
+    }
+
+    for (auto it = after.constBegin(); it != after.constEnd(); ++it) {
+        if (topLevel && isSkippedTopLevelKey(it.key())) {
+            continue;
+        }
+        const QString childPath = path + QLatin1Char('/') + keySegment(it.key());
+        const auto previous = before.constFind(it.key());
+        if (previous == before.constEnd()) {
+            QJsonObject patch = makePatch(QStringLiteral("add"), childPath);
+            patch[QStringLiteral("value")] = it.value();
+            out->append(patch);
+            continue;
+        }
+        diffValue(childPath, previous.value(), it.value(), out);
+    }
+}
+
+void diffArray(const QString& path, const QJsonArray& before, const QJsonArray& after, QJsonArray* out) {
+    QStringList beforeIds;
+    QStringList afterIds;
+    if (!keyedRowIds(before, &beforeIds) || !keyedRowIds(after, &afterIds)) {
+        QJsonObject patch = makePatch(QStringLiteral("replace"), path);
+        patch[QStringLiteral("value")] = after;
+        out->append(patch);
+        return;
+    }
+
+    QHash<QString, qsizetype> beforeIndex;
+    beforeIndex.reserve(beforeIds.size());
+    for (qsizetype i = 0; i < beforeIds.size(); ++i) {
+        beforeIndex.insert(beforeIds.at(i), i);
+    }
+
+    if (beforeIds != afterIds) {
+        QJsonArray ids;
+        QJsonArray inserted;
+        for (qsizetype i = 0; i < afterIds.size(); ++i) {
+            ids.append(afterIds.at(i));
+            if (!beforeIndex.contains(afterIds.at(i))) {
+                inserted.append(after.at(i));
+            }
+        }
+        QJsonObject patch = makePatch(QStringLiteral("rows"), path);
+        patch[QStringLiteral("ids")] = ids;
+        patch[QStringLiteral("insert")] = inserted;
+        out->append(patch);
+    }
+
+    for (qsizetype i = 0; i < afterIds.size(); ++i) {
+        const auto previous = beforeIndex.constFind(afterIds.at(i));
+        if (previous != beforeIndex.constEnd()) {
+            diffValue(path + QLatin1Char('/') + rowSegment(afterIds.at(i)), before.at(previous.value()), after.at(i), out);
+        }
+    }
+}
+
+void diffValue(const QString& path, const QJsonValue& before, const QJsonValue& after, QJsonArray* out) {
+    if (before == after) {
+        return;
+    }
+    if (before.isObject() && after.isObject()) {
+        diffObject(path, before.toObject(), after.toObject(), false, out);
+        return;
+    }
+    if (before.isArray() && after.isArray()) {
+        diffArray(path, before.toArray(), after.toArray(), out);
+        return;
+    }
+    QJsonObject patch = makePatch(QStringLiteral("replace"), path);
+    patch[QStringLiteral("value")] = after;
+    out->append(patch);
+}
+
+QString variantRowId(const QVariant& value) {
+    if (value.typeId() != QMetaType::QVariantMap) {
+        return QString();
+    }
+    return value.toMap().value(QStringLiteral("id")).toString();
+}
+
+// Row id to index of each keyed list reached by one batch of patches, keyed by the list's
+// pointer. Built on first use, so a batch of row patches does not rescan the list for each row.
+using RowIndexCache = QHash<QString, QHash<QString, qsizetype>>;
+
+QString pointerPrefix(const QList<PathSegment>& path, qsizetype depth) {
+    QString pointer;
+    for (qsizetype i = 0; i < depth; ++i) {
+        pointer += QLatin1Char('/');
+        pointer += path.at(i).rowId ? rowSegment(path.at(i).key) : keySegment(path.at(i).key);
+    }
+    return pointer;
+}
+
+// Forgets the indexes of the list at pointer and of every list inside it.
+void dropRowIndexes(RowIndexCache* cache, const QString& pointer) {
+    const QString nested = pointer + QLatin1Char('/');
+    for (auto it = cache->begin(); it != cache->end();) {
+        if (it.key() == pointer || it.key().startsWith(nested)) {
+            it = cache->erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+const QHash<QString, qsizetype>& rowIndexes(RowIndexCache* cache, const QString& pointer, const QVariantList& rows) {
+    auto it = cache->find(pointer);
+    if (it == cache->end()) {
+        QHash<QString, qsizetype> indexes;
+        indexes.reserve(rows.size());
+        for (qsizetype i = 0; i < rows.size(); ++i) {
+            indexes.insert(variantRowId(rows.at(i)), i);
+        }
+        it = cache->insert(pointer, std::move(indexes));
+    }
+    return it.value();
+}
+
+bool applyRows(QVariant* node, const QJsonObject& patch, QString* errorMessage) {
+    if (node->typeId() != QMetaType::QVariantList) {
+        *errorMessage = QStringLiteral("Row patch does not target a list.");
+        return false;
+    }
+
+    QVariantList rows = node->toList();
+    *node = QVariant();
+    QHash<QString, QVariant> rowsById;
+    rowsById.reserve(rows.size());
+    for (QVariant& row : rows) {
+        rowsById.insert(variantRowId(row), std::move(row));
+    }
+    const QJsonArray inserted = patch.value(QStringLiteral("insert")).toArray();
+    for (const QJsonValue& value : inserted) {
+        const QVariant row = value.toVariant();
+        rowsById.insert(variantRowId(row), row);
+    }
+
+    const QJsonArray ids = patch.value(QStringLiteral("ids")).toArray();
+    QVariantList ordered;
+    ordered.reserve(ids.size());
+    for (const QJsonValue& id : ids) {
+        auto row = rowsById.find(id.toString());
+        if (row == rowsById.end()) {
+            *errorMessage = QStringLiteral("Row patch references unknown row \"%1\".").arg(id.toString());
+            return false;
+        }
+        ordered.append(std::move(row.value()));
+    }
+    *node = ordered;
+    return true;
+}
+
+// Detaches each level on the way down and reattaches it on the way up, so only the containers on
+// the patched path are copied even when the packet is shared.
+bool applyAt(QVariant* node,
+             const QList<PathSegment>& path,
+             qsizetype depth,
+             const QString& op,
+             const QJsonObject& patch,
+             RowIndexCache* rowCache,
+             QString* errorMessage) {
+    if (depth == path.size()) {
+        if (op == QLatin1String("rows")) {
+            return applyRows(node, patch, errorMessage);
+        }
+        *node = patch.value(QStringLiteral("value")).toVariant();
+        return true;
+    }
+
+    const PathSegment& segment = path.at(depth);
+    const bool last = depth + 1 == path.size();
+
+    if (node->typeId() == QMetaType::QVariantMap && !segment.rowId) {
+        QVariantMap map = node->toMap();
+        *node = QVariant();
+        bool ok = true;
+        if (last && op == QLatin1String("remove")) {
+            map.remove(segment.key);
+        } else {
+            auto child = map.find(segment.key);
+            if (child == map.end() && !(last && op == QLatin1String("add"))) {
+                *errorMessage = QStringLiteral("Patch path segment \"%1\" does not exist.").arg(segment.key);
+                ok = false;
+            } else {
+                QVariant value = child == map.end() ? QVariant() : std::move(child.value());
+                ok = applyAt(&value, path, depth + 1, op, patch, rowCache, errorMessage);
+                map.insert(segment.key, std::move(value));
+            }
+        }
+        *node = map;
+        return ok;
+    }
+
+    if (node->typeId() == QMetaType::QVariantList && segment.rowId) {
+        QVariantList list = node->toList();
+        *node = QVariant();
+        const QString pointer = pointerPrefix(path, depth);
+        const qsizetype index = rowIndexes(rowCache, pointer, list).value(segment.key, -1);
+        bool ok = true;
+        if (last && op == QLatin1String("remove")) {
+            if (index >= 0) {
+                list.removeAt(index);
+                // Later rows shift down by one.
+                dropRowIndexes(rowCache, pointer);
+            }
+        } else if (index < 0 && !(last && op == QLatin1String("add"))) {
+            *errorMessage = QStringLiteral("Patch references unknown row \"%1\".").arg(segment.key);
+            ok = false;
+        } else {
+            QVariant value = index < 0 ? QVariant() : std::move(list[index]);
+            ok = applyAt(&value, path, depth + 1, op, patch, rowCache, errorMessage);
+            if (index < 0) {
+                // Looked up again: the recursion may have grown the cache and moved its entries.
+                const auto cached = rowCache->find(pointer);
+                if (cached != rowCache->end()) {
+                    cached->insert(segment.key, list.size());
+                }
+                list.append(std::move(value));
+            } else {
+                list[index] = std::move(value);
+            }
+        }
+        *node = list;
+        return ok;
+    }
+
+    *errorMessage = QStringLiteral("Patch path segment \"%1\" does not match the state layout.").arg(segment.key);
+    return false;
+}
+}
+
+namespace ToolStatePatch {
+
+QJsonArray diff(const QJsonObject& before, const QJsonObject& after) {
+    QJsonArray patches;
+    diffObject(QString(), before, after, true, &patches);
+    return patches;
+}
+
+bool applyToPacket(ToolUiStatePacket* packet, const QJsonArray& patches, QString* errorMessage) {
+    QString error;
+    RowIndexCache rowCache;
+    for (const QJsonValue& patchValue : patches) {
+        const QJsonObject patch = patchValue.toObject();
+        const QString op = patch.value(QStringLiteral("op")).toString();
+        QList<PathSegment> path;
+        if (!parsePath(patch.value(QStringLiteral("path")).toString(), &path)
+            || (op != QLatin1String("add") && op != QLatin1String("replace")
+                && op != QLatin1String("remove") && op != QLatin1String("rows"))) {
+            error = QStringLiteral("Malformed state patch.");
+            break;
+        }
+
+        const QString& root = path.first().key;
+        if (root == QLatin1String("pageId") || root == QLatin1String("modeId")) {
+            QString& target = root == QLatin1String("pageId") ? packet->pageId : packet->modeId;
+            target = op == QLatin1String("remove") ? QString() : patch.value(QStringLiteral("value")).toString();
+            continue;
+        }
+
+        QVariantMap* map = nullptr;
+        QVariantList* list = nullptr;
+        if (root == QLatin1String("viewState")) {
+            map = &packet->viewState;
+        } else if (root == QLatin1String("sidebarState")) {
+            map = &packet->sidebarState;
+        } else if (root == QLatin1String("topbarState")) {
+            map = &packet->topbarState;
+        } else if (root == QLatin1String("runtimeVariables")) {
+            map = &packet->runtimeVariables;
+        } else if (root == QLatin1String("listModels")) {
+            list = &packet->listModels;
+        } else {
+            // Keys without a ToolUiStatePacket counterpart are not retained by the host.
+            continue;
+        }
+
+        QVariant node = map ? QVariant(*map) : QVariant(*list);
+        if (map) {
+            map->clear();
+        } else {
+            list->clear();
+        }
+        bool ok = true;
+        if (path.size() == 1 && op == QLatin1String("remove")) {
+            node = map ? QVariant(QVariantMap()) : QVariant(QVariantList());
+        } else {
+            ok = applyAt(&node, path, 1, op, patch, &rowCache, &error);
+        }
+        // Whatever now sits at the patched path was not indexed.
+        dropRowIndexes(&rowCache, pointerPrefix(path, path.size()));
+        if (map) {
+            *map = node.toMap();
+        } else {
+            *list = node.toList();
+        }
+        if (!ok) {
+            break;
+        }
+    }
+
+    if (!error.isEmpty()) {
+        if (errorMessage) {
+            *errorMessage = error;
+        }
+        return false;
+    }
+    return true;
+}
+
+bool isDeltaPacket(const QJsonObject& statePacket) {
+    return statePacket.value(QStringLiteral("delta")).toBool(false);
+}
+
+quint64 revisionOf(const QJsonObject& statePacket) {
+    return static_cast<quint64>(statePacket.value(QStringLiteral("revision")).toDouble(0));
+}
+
+quint64 baseRevisionOf(const QJsonObject& statePacket) {
+    return static_cast<quint64>(statePacket.value(QStringLiteral("baseRevision")).toDouble(0));
+}
+
+QByteArray StateEncoder::encode(const QJsonObject& statePacket, bool allowDelta) {
+    const quint64 revision = ++m_revision;
+    const bool hadState = m_hasState;
+    const QJsonObject previous = m_lastState;
+    m_lastState = statePacket;
+    m_hasState = true;
+
+    QJsonObject full = statePacket;
+    full[QStringLiteral("revision")] = static_cast<double>(revision);
+    if (!allowDelta || !hadState) {
+        return QJsonDocument(full).toJson(QJsonDocument::Compact);
+    }
+
+    QJsonObject delta;
+    delta[QStringLiteral("delta")] = true;
+    delta[QStringLiteral("revision")] = static_cast<double>(revision);
+    delta[QStringLiteral("baseRevision")] = static_cast<double>(revision - 1);
+    delta[QStringLiteral("patches")] = diff(previous, statePacket);
+    const QByteArray deltaJson = QJsonDocument(delta).toJson(QJsonDocument::Compact);
+    if (deltaJson.size() <= kDeltaSizeCheckThreshold) {
+        return deltaJson;
+    }
+
+    const QByteArray fullJson = QJsonDocument(full).toJson(QJsonDocument::Compact);
+    return deltaJson.size() < fullJson.size() ? deltaJson : fullJson;
+}
+
+void StateEncoder::reset() {
+    m_lastState = QJsonObject();
+    m_hasState = false;
+}
+
+} // namespace ToolStatePatch
@@ -0,0 +1,55 @@
+//-------------------------------------------------------------------------------------
+// ToolStatePatch.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef TOOLSTATEPATCH_H
+#define TOOLSTATEPATCH_H
+
+#include "ToolInterface.h"
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+
+// Revisioned state packets exchanged between tool workers and the host.
+//
+// A full snapshot is a regular state packet carrying "revision". A delta packet carries only
+// {"delta": true, "revision": N, "baseRevision": N - 1, "patches": [...]}, where each patch is
+//   {"op": "add" | "replace", "path": P, "value": V}
+//   {"op": "remove", "path": P}
+//   {"op": "rows", "path": P, "ids": [...], "insert": [...]}
+// Paths are JSON pointers. Elements of arrays whose entries all carry a unique "id" are
+// addressed as "#<id>" instead of by index; a "rows" patch sets the id order of such an array,
+// keeping existing entries and taking new ones from "insert". In a segment, '~' is written "~0",
+// '/' is written "~1" and a leading '#' that is not a row id is written "~2".
+namespace ToolStatePatch {
+
+QJsonArray diff(const QJsonObject& before, const QJsonObject& after);
+bool applyToPacket(ToolUiStatePacket* packet, const QJsonArray& patches, QString* errorMessage = nullptr);
+
+bool isDeltaPacket(const QJsonObject& statePacket);
+quint64 revisionOf(const QJsonObject& statePacket);
+quint64 baseRevisionOf(const QJsonObject& statePacket);
+
+// Worker-side revision counter and diff base for one session.
+class StateEncoder {
+public:
+    // Produces a delta against the previously encoded state when allowed and worthwhile, and a
+    // full snapshot otherwise. State queries pass allowDelta = false so the host can resync.
+    QByteArray encode(const QJsonObject& statePacket, bool allowDelta);
+    void reset();
+
+private:
+    QJsonObject m_lastState;
+    quint64 m_revision = 0;
+    bool m_hasState = false;
+};
+
+} // namespace ToolStatePatch
+
+#endif // TOOLSTATEPATCH_H
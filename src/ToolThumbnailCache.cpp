@@ -0,0 +1,237 @@
+//-------------------------------------------------------------------------------------
+// ToolThumbnailCache.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "ToolThumbnailCache.h"
+
+#include "FileManager.h"
+#include "TgaCodec.h"
+#include "ToolRuntimeContext.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThreadPool>
+
+#include <algorithm>
+
+namespace {
+
+// Bump when decoding or scaling changes so entries written by an older build are not reused
+constexpr int kFormatVersion = 1;
+constexpr int kMemoryCapacityKiB = 32 * 1024;
+constexpr qint64 kDiskCapacityBytes = 128ll * 1024 * 1024;
+
+QImage tgaImageFromData(const QByteArray& data) {
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(data.constData());
+    const std::size_t size = static_cast<std::size_t>(data.size());
+    TgaCodec::Header header;
+    if (!TgaCodec::readHeader(bytes, size, &header)) {
+        return QImage::fromData(data);
+    }
+
+    QImage image(header.width, header.height, QImage::Format_RGBA8888);
+    if (image.isNull()) {
+        return {};
+    }
+    TgaCodec::decodePixels(bytes, size, header, TgaCodec::PixelOrder::Rgba, image.bits(),
+                           static_cast<std::size_t>(image.bytesPerLine()));
+    return image;
+}
+
+QByteArray makeKey(const QString& logicalPath, const QString& identity, const QSize& size) {
+    const QString sizeKey = size.isValid()
+        ? QStringLiteral("%1x%2").arg(size.width()).arg(size.height())
+        : QStringLiteral("native");
+    const QString key = QStringLiteral("%1|%2|%3|%4").arg(logicalPath, identity, sizeKey).arg(kFormatVersion);
+    return QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+}
+
+int imageCostKiB(const QImage& image) {
+    return std::max(1, static_cast<int>(image.sizeInBytes() / 1024));
+}
+
+} // namespace
+
+ToolThumbnailCache& ToolThumbnailCache::instance() {
+    static ToolThumbnailCache cache;
+    return cache;
+}
+
+ToolThumbnailCache::ToolThumbnailCache()
+    : m_memory(kMemoryCapacityKiB),
+      m_directoryPath(QStandardPaths::writableLocation(QStandardPaths::TempLocation)
+                      + QStringLiteral("/APE-HOI4-Tool-Studio/cache/thumbnails")) {
+}
+
+QImage ToolThumbnailCache::thumbnail(const QString& logicalPath, const QSize& size) {
+    const QString trimmedPath = logicalPath.trimmed();
+    if (trimmedPath.isEmpty()) {
+        return {};
+    }
+
+    // Resolving the path is a map lookup and a stat; the file itself is only read on a miss.
+    QByteArray content;
+    bool hasContent = false;
+    QString identity;
+    FileDetails details;
+    if (FileManager::instance().getEffectiveFile(trimmedPath, &details)) {
+        const QFileInfo info(details.absPath);
+        identity = QStringLiteral("%1|%2|%3")
+            .arg(QDir::cleanPath(details.absPath))
+            .arg(info.lastModified().toMSecsSinceEpoch())
+            .arg(info.size());
+    } else {
+        const ToolRuntimeContext::FileReadResult readResult =
+            ToolRuntimeContext::instance().readEffectiveFile(trimmedPath);
+        if (!readResult.success) {
+            return {};
+        }
+        content = readResult.content;
+        hasContent = true;
+        identity = QString::fromLatin1(QCryptographicHash::hash(content, QCryptographicHash::Sha1).toHex());
+    }
+
+    const QByteArray key = makeKey(trimmedPath, identity, size);
+    {
+        QMutexLocker locker(&m_mutex);
+        if (const QImage* cached = m_memory.object(key)) {
+            return *cached;
+        }
+    }
+
+    QImage image = readDisk(key);
+    if (!image.isNull()) {
+        insertMemory(key, image);
+        return image;
+    }
+
+    if (!hasContent) {
+        const ToolRuntimeContext::FileReadResult readResult =
+            ToolRuntimeContext::instance().readEffectiveFile(trimmedPath);
+        if (!readResult.success) {
+            return {};
+        }
+        content = readResult.content;
+    }
+
+    image = decodeImage(content);
+    if (image.isNull()) {
+        return {};
+    }
+    if (size.isValid() && image.size() != size) {
+        image = image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        if (image.isNull()) {
+            return {};
+        }
+    }
+
+    writeDisk(key, image);
+    insertMemory(key, image);
+    return image;
+}
+
+QImage ToolThumbnailCache::decodeImage(const QByteArray& data) {
+    QImage image = tgaImageFromData(data);
+    if (image.isNull()) {
+        image = QImage::fromData(data, "TGA");
+    }
+    return image;
+}
+
+void ToolThumbnailCache::clearMemory() {
+    QMutexLocker locker(&m_mutex);
+    m_memory.clear();
+}
+
+QString ToolThumbnailCache::diskPathFor(const QByteArray& key) const {
+    return QStringLiteral("%1/%2/%3.png")
+        .arg(m_directoryPath, QString::fromLatin1(key.left(2)), QString::fromLatin1(key));
+}
+
+QImage ToolThumbnailCache::readDisk(const QByteArray& key) const {
+    const QString path = diskPathFor(key);
+    if (!QFileInfo::exists(path)) {
+        return {};
+    }
+
+    QImage image;
+    if (!image.load(path, "PNG")) {
+        QFile::remove(path);
+        return {};
+    }
+    return image;
+}
+
+void ToolThumbnailCache::writeDisk(const QByteArray& key, const QImage& image) {
+    const QString path = diskPathFor(key);
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        return;
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit()) {
+        return;
+    }
+
+    // The first write of a process trims whatever earlier sessions left behind
+    bool schedulePrune = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_pruneScheduled) {
+            m_pruneScheduled = true;
+            schedulePrune = true;
+        }
+    }
+    if (schedulePrune) {
+        QThreadPool::globalInstance()->start([this]() { pruneDisk(); });
+    }
+}
+
+void ToolThumbnailCache::insertMemory(const QByteArray& key, const QImage& image) {
+    QMutexLocker locker(&m_mutex);
+    m_memory.insert(key, new QImage(image), imageCostKiB(image));
+}
+
+void ToolThumbnailCache::pruneDisk() const {
+    struct CachedFile {
+        QString path;
+        qint64 size = 0;
+        QDateTime lastModified;
+    };
+
+    QList<CachedFile> files;
+    qint64 totalBytes = 0;
+    QDirIterator iterator(m_directoryPath, {QStringLiteral("*.png")}, QDir::Files, QDirIterator::Subdirectories);
+    while (iterator.hasNext()) {
+        iterator.next();
+        const QFileInfo info = iterator.fileInfo();
+        files.append({info.absoluteFilePath(), info.size(), info.lastModified()});
+        totalBytes += info.size();
+    }
+    if (totalBytes <= kDiskCapacityBytes) {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(), [](const CachedFile& left, const CachedFile& right) {
+        return left.lastModified < right.lastModified;
+    });
+    for (const CachedFile& file : files) {
+        if (totalBytes <= kDiskCapacityBytes / 2) {
+            break;
+        }
+        if (QFile::remove(file.path)) {
+            totalBytes -= file.size;
+        }
+    }
+}
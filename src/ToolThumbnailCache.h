@@ -0,0 +1,53 @@
+//-------------------------------------------------------------------------------------
+// ToolThumbnailCache.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef TOOLTHUMBNAILCACHE_H
+#define TOOLTHUMBNAILCACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+
+// Decoded and scaled images of effective game/mod files, kept in memory and on disk.
+//
+// Entries are addressed by the logical path, the file it resolves to, that file's modification
+// time and the requested size, so a changed or overriding file is never served from a stale
+// entry. When the file cannot be resolved the key falls back to a hash of its contents.
+// All members are safe to call from any thread.
+class ToolThumbnailCache {
+public:
+    static ToolThumbnailCache& instance();
+
+    // An invalid size returns the image at its native size. Returns a null image when the file
+    // cannot be read or decoded.
+    QImage thumbnail(const QString& logicalPath, const QSize& size = QSize());
+
+    // TGA (uncompressed or RLE, 24/32 bpp) and every format Qt can read.
+    static QImage decodeImage(const QByteArray& data);
+
+    void clearMemory();
+
+private:
+    ToolThumbnailCache();
+
+    QString diskPathFor(const QByteArray& key) const;
+    QImage readDisk(const QByteArray& key) const;
+    void writeDisk(const QByteArray& key, const QImage& image);
+    void insertMemory(const QByteArray& key, const QImage& image);
+    void pruneDisk() const;
+
+    mutable QMutex m_mutex;
+    QCache<QByteArray, QImage> m_memory;
+    QString m_directoryPath;
+    bool m_pruneScheduled = false;
+};
+
+#endif // TOOLTHUMBNAILCACHE_H
@@ -140,6 +140,16 @@ std::string normalizedActionName(QString value) {
     return normalized.toUtf8().toStdString();
 }
 
+FileManager::RowWindow rowWindowFor(const WorkerSession* session, const QString& listId) {
+    FileManager::RowWindow window;
+    const ToolListWindow::Range range = session->viewports.requested(listId);
+    window.first = static_cast<std::size_t>(range.first);
+    if (range.count >= 0) {
+        window.count = static_cast<std::size_t>(range.count);
+    }
+    return window;
+}
+
 QString firstNonEmptyString(const QJsonObject& object, std::initializer_list<QString> keys) {
     for (const QString& key : keys) {
         const QString value = object.value(key).toString().trimmed();
@@ -184,6 +194,15 @@ QJsonObject buildViewState(WorkerSession* session, const FileManager::StateSnaps
         treeRows.append(row);
     }
     view[QStringLiteral("treeRows")] = treeRows;
+    view[QStringLiteral("treeRowsFirst")] = static_cast<int>(state.treeRowsFirst);
+
+    QJsonObject listWindows;
+    listWindows[QStringLiteral("file_tree")] = ToolListWindow::describe(
+        static_cast<int>(state.treeRowsFirst),
+        static_cast<int>(state.treeRows.size()),
+        static_cast<int>(state.visibleCount)
+    );
+    view[QStringLiteral("listWindows")] = listWindows;
 
     if (state.hasSelection) {
         view[QStringLiteral("selectedName")] = QString::fromUtf8(state.selectedDisplayName.c_str());
@@ -300,7 +319,7 @@ QJsonObject buildStatePacket(WorkerSession* session) {
         return packet;
     }
 
-    const FileManager::StateSnapshot state = session->core.buildState();
+    const FileManager::StateSnapshot state = session->core.buildState(rowWindowFor(session, QStringLiteral("file_tree")));
     const QJsonObject viewState = buildViewState(session, state);
 
     packet[QStringLiteral("viewState")] = viewState;
@@ -314,12 +333,12 @@ QJsonObject buildStatePacket(WorkerSession* session) {
     return packet;
 }
 
-char* serializeStatePacket(WorkerSession* session) {
-    const QByteArray stateJson = QJsonDocument(buildStatePacket(session)).toJson(QJsonDocument::Compact);
-    if (session) {
-        session->lastSerializedState = stateJson.toStdString();
+char* serializeStatePacket(WorkerSession* session, bool allowDelta) {
+    const QJsonObject packet = buildStatePacket(session);
+    if (!session) {
+        return allocateCString(QJsonDocument(packet).toJson(QJsonDocument::Compact));
     }
-    return allocateCString(stateJson);
+    return allocateCString(session->stateEncoder.encode(packet, allowDelta));
 }
 
 ToolWorkerResult initializeSession(WorkerSession* session, const char* configJson) {
@@ -333,7 +352,8 @@ ToolWorkerResult initializeSession(WorkerSession* session, const char* configJso
     session->fileSystem = std::make_unique<ToolRuntimeFileSystem>();
     session->core.setFileSystem(session->fileSystem.get());
     session->lastError.clear();
-    session->lastSerializedState.clear();
+    session->stateEncoder.reset();
+    session->viewports.reset();
 
     return applyCoreActionResult(session, session->core.initialize());
 }
@@ -360,6 +380,19 @@ ToolWorkerResult applyActionInternal(WorkerSession* session,
         return TOOL_WORKER_SUCCESS;
     }
 
+    if (action == ToolListWindow::viewportActionName()) {
+        QString listId = firstNonEmptyString(arguments, {QStringLiteral("listId"), QStringLiteral("modelId")});
+        if (listId.isEmpty() && targetId) {
+            listId = QString::fromUtf8(targetId).trimmed();
+        }
+        if (!session->viewports.update(listId, arguments)) {
+            setSessionError(session, QStringLiteral("Invalid viewport for list '%1'.").arg(listId));
+            return TOOL_WORKER_ERROR_INVALID_ARGUMENT;
+        }
+        clearSessionError(session);
+        return TOOL_WORKER_SUCCESS;
+    }
+
     if (action == "refresh" || action == "refresh_files" || action == "reload") {
         return applyCoreActionResult(session, session->core.refresh());
     }
@@ -424,7 +457,7 @@ const char* handleWorkerAction(ToolWorkerHandle handle,
     if (outResult) {
         *outResult = result;
     }
-    return serializeStatePacket(session);
+    return serializeStatePacket(session, true);
 }
 
 const char* getWorkerCurrentState(ToolWorkerHandle handle, ToolWorkerResult* outResult) {
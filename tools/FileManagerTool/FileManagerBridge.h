@@ -9,6 +9,8 @@
 #ifndef FILEMANAGERBRIDGE_H
 #define FILEMANAGERBRIDGE_H
 
+#include "../../src/ToolListWindow.h"
+#include "../../src/ToolStatePatch.h"
 #include "../../src/ToolWorkerInterface.h"
 #include "main/FileManagerCore.h"
 
@@ -27,7 +29,8 @@ struct WorkerSession {
     std::unique_ptr<FileManager::IFileSystem> fileSystem;
     QMap<QString, QString> localizedStrings;
     std::string lastError;
-    std::string lastSerializedState;
+    ToolStatePatch::StateEncoder stateEncoder;
+    ToolListWindow::ViewportSet viewports;
 };
 
 extern std::unique_ptr<WorkerSession> g_legacySession;
@@ -39,7 +42,8 @@ void destroyWorkerHandle(ToolWorkerHandle handle);
 WorkerSession* sessionFromHandle(ToolWorkerHandle handle);
 
 QJsonObject buildStatePacket(WorkerSession* session);
-char* serializeStatePacket(WorkerSession* session);
+// Action responses may be deltas; state queries always return a full snapshot.
+char* serializeStatePacket(WorkerSession* session, bool allowDelta = false);
 QJsonObject parseJsonObject(const char* jsonText);
 ToolWorkerResult initializeSession(WorkerSession* session, const char* configJson);
 ToolWorkerResult applyActionInternal(WorkerSession* session,
@@ -17,6 +17,8 @@ Rectangle {
     color: "transparent"
 
     property var treeRows: []
+    property int treeRowsFirst: 0
+    property bool treeWindowShifting: false
     property string filterText: ""
     property string selectedRelativePath: ""
     property string lastError: ""
@@ -57,8 +59,15 @@ Rectangle {
 
     function refreshState() {
         var nextTreeRows = toolBridge.value("treeRows", [])
+        var nextTreeRowsFirst = Number(toolBridge.value("treeRowsFirst", 0))
         treeRows = nextTreeRows
+        treeWindowShifting = nextTreeRowsFirst !== treeRowsFirst
+        if (treeWindowShifting) {
+            trimTreeWindow(nextTreeRowsFirst, nextTreeRows.length)
+        }
+        treeRowsFirst = nextTreeRowsFirst
         syncTreeRows(nextTreeRows)
+        treeWindowShifting = false
         filterText = safeString(toolBridge.value("filterText", ""))
         selectedRelativePath = safeString(toolBridge.value("selectedRelativePath", ""))
         lastError = safeString(toolBridge.value("lastError", ""))
@@ -68,6 +77,34 @@ Rectangle {
         visibleCount = Number(toolBridge.value("visibleCount", 0))
         loadingActive = !!toolBridge.value("loadingActive", false)
         loadingText = safeString(toolBridge.value("loadingText", trText("LoadingFiles", "Loading files...")))
+        reportViewport()
+    }
+
+    // treeModel only holds the rows the worker sent; the header and footer of the view stand in
+    // for the rest of the tree.
+    function reportViewport() {
+        if (treeView.height <= 0) {
+            return
+        }
+        var firstVisible = Math.floor(Math.max(0, treeView.contentY - treeView.originY) / rowHeight)
+        toolBridge.setViewport("file_tree", firstVisible, Math.ceil(treeView.height / rowHeight) + 1)
+    }
+
+    // Drops rows that scrolled out of the window so the diff below only sees the new edge rows.
+    function trimTreeWindow(nextFirst, nextCount) {
+        var keepFirst = Math.max(treeRowsFirst, nextFirst)
+        var keepEnd = Math.min(treeRowsFirst + treeModel.count, nextFirst + nextCount)
+        if (keepEnd <= keepFirst) {
+            treeModel.clear()
+            return
+        }
+        var tailStart = keepEnd - treeRowsFirst
+        if (tailStart < treeModel.count) {
+            treeModel.remove(tailStart, treeModel.count - tailStart)
+        }
+        if (keepFirst > treeRowsFirst) {
+            treeModel.remove(0, keepFirst - treeRowsFirst)
+        }
     }
 
     function dispatchAction(actionType, targetId, argumentsObject) {
@@ -307,24 +344,39 @@ Rectangle {
                 highlightMoveDuration: 180
                 highlightResizeDuration: 180
                 ScrollBar.vertical: MacScrollBar {}
+                onContentYChanged: root.reportViewport()
+                onHeightChanged: root.reportViewport()
+                header: Item {
+                    width: treeView.width
+                    height: root.treeRowsFirst * root.rowHeight
+                }
+                footer: Item {
+                    width: treeView.width
+                    height: Math.max(0, root.visibleCount - root.treeRowsFirst - treeModel.count) * root.rowHeight
+                }
                 add: Transition {
+                    enabled: !root.treeWindowShifting
                     NumberAnimation { properties: "expansionProgress"; from: 0; to: 1; duration: 220; easing.type: Easing.OutCubic }
                     NumberAnimation { properties: "opacity"; from: 0; to: 1; duration: 190; easing.type: Easing.OutCubic }
                     NumberAnimation { properties: "scale"; from: 0.985; to: 1.0; duration: 210; easing.type: Easing.OutCubic }
                     NumberAnimation { properties: "y"; duration: 210; easing.type: Easing.OutCubic }
                 }
                 addDisplaced: Transition {
+                    enabled: !root.treeWindowShifting
                     NumberAnimation { properties: "y"; duration: 220; easing.type: Easing.OutCubic }
                 }
                 remove: Transition {
+                    enabled: !root.treeWindowShifting
                     NumberAnimation { properties: "expansionProgress"; from: 1; to: 0; duration: 150; easing.type: Easing.InCubic }
                     NumberAnimation { properties: "opacity"; from: 1; to: 0; duration: 130; easing.type: Easing.InCubic }
                     NumberAnimation { properties: "scale"; from: 1.0; to: 0.985; duration: 130; easing.type: Easing.InCubic }
                 }
                 removeDisplaced: Transition {
+                    enabled: !root.treeWindowShifting
                     NumberAnimation { properties: "y"; duration: 230; easing.type: Easing.OutCubic }
                 }
                 displaced: Transition {
+                    enabled: !root.treeWindowShifting
                     NumberAnimation { properties: "y"; duration: 210; easing.type: Easing.OutCubic }
                 }
 
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <functional>
 #include <map>
 #include <memory>
 #include <utility>
@@ -22,6 +23,7 @@ struct BuildNode {
     std::string relativePath;
     FileSource source = FileSource::Unknown;
     bool isDirectory = true;
+    std::size_t recordIndex = static_cast<std::size_t>(-1);
     std::map<std::string, std::unique_ptr<BuildNode>> children;
 };
 
@@ -36,6 +38,13 @@ std::string normalizePath(std::string value) {
     return value;
 }
 
+// Keeps the window inside the list, sliding it back from the end so a list that shrank under
+// the viewport still fills it.
+std::pair<std::size_t, std::size_t> clampWindow(const RowWindow& window, std::size_t total) {
+    const std::size_t count = std::min(window.count, total);
+    return {std::min(window.first, total - count), count};
+}
+
 std::vector<std::string> splitPath(const std::string& path) {
     std::vector<std::string> parts;
     std::size_t start = 0;
@@ -68,27 +77,15 @@ std::string lowerAscii(std::string value) {
     return value;
 }
 
-bool containsCaseInsensitive(const std::string& value, const std::string& needle) {
-    if (needle.empty()) {
-        return true;
-    }
-    return lowerAscii(value).find(lowerAscii(needle)) != std::string::npos;
-}
-
-bool recordMatchesFilter(const FileRecord& record, const std::string& filterText) {
-    if (filterText.empty()) {
-        return true;
-    }
-    return containsCaseInsensitive(record.displayName, filterText)
-        || containsCaseInsensitive(record.relativePath, filterText)
-        || containsCaseInsensitive(fileSourceName(record.source), filterText);
-}
-
 std::string childSortKey(bool isDirectory, const std::string& displayName) {
     return std::string(isDirectory ? "0:" : "1:") + lowerAscii(displayName) + ":" + displayName;
 }
 
-void addRecordToTree(BuildNode* root, const FileRecord& record) {
+std::string directoryKey(const std::string& relativePath) {
+    return relativePath + "/";
+}
+
+void addRecordToTree(BuildNode* root, const FileRecord& record, std::size_t recordIndex) {
     if (!root) {
         return;
     }
@@ -116,90 +113,14 @@ void addRecordToTree(BuildNode* root, const FileRecord& record) {
             child->isDirectory = !isFile;
         }
 
-        child->isDirectory = !isFile;
-        child->relativePath = currentPath;
-        child->displayName = parts[index];
         if (isFile) {
             child->source = record.source;
+            child->recordIndex = recordIndex;
         }
         parent = child.get();
     }
 }
 
-bool nodeMatchesFilter(const BuildNode& node, const std::string& filterText) {
-    if (filterText.empty()) {
-        return true;
-    }
-
-    if (containsCaseInsensitive(node.displayName, filterText)
-        || containsCaseInsensitive(node.relativePath, filterText)) {
-        return true;
-    }
-
-    if (!node.isDirectory) {
-        return containsCaseInsensitive(fileSourceName(node.source), filterText);
-    }
-
-    return false;
-}
-
-TreeRow makeTreeRow(const BuildNode& node,
-                    int depth,
-                    const std::set<std::string>& expandedDirectories,
-                    const std::string& selectedPath,
-                    bool forceExpanded) {
-    TreeRow row;
-    row.rowId = node.relativePath;
-    row.displayName = node.displayName;
-    row.relativePath = node.relativePath;
-    row.source = node.source;
-    row.isDirectory = node.isDirectory;
-    row.expanded = node.isDirectory
-        && (forceExpanded || expandedDirectories.count(node.relativePath) > 0);
-    row.hasChildren = !node.children.empty();
-    row.selected = selectedPath == node.relativePath;
-    row.depth = depth;
-    row.childCount = node.children.size();
-    return row;
-}
-
-bool appendFilteredRows(const BuildNode& node,
-                        int depth,
-                        const std::set<std::string>& expandedDirectories,
-                        const std::string& selectedPath,
-                        const std::string& filterText,
-                        std::vector<TreeRow>* rows) {
-    std::vector<TreeRow> childRows;
-    for (const auto& childPair : node.children) {
-        appendFilteredRows(*childPair.second, depth + 1, expandedDirectories, selectedPath, filterText, &childRows);
-    }
-
-    const bool includeNode = nodeMatchesFilter(node, filterText) || !childRows.empty();
-    if (!includeNode) {
-        return false;
-    }
-
-    rows->push_back(makeTreeRow(node, depth, expandedDirectories, selectedPath, true));
-    rows->insert(rows->end(), childRows.begin(), childRows.end());
-    return true;
-}
-
-void appendVisibleRows(const BuildNode& node,
-                       int depth,
-                       const std::set<std::string>& expandedDirectories,
-                       const std::string& selectedPath,
-                       std::vector<TreeRow>* rows) {
-    const bool expanded = node.isDirectory && expandedDirectories.count(node.relativePath) > 0;
-    rows->push_back(makeTreeRow(node, depth, expandedDirectories, selectedPath, false));
-    if (!expanded) {
-        return;
-    }
-
-    for (const auto& childPair : node.children) {
-        appendVisibleRows(*childPair.second, depth + 1, expandedDirectories, selectedPath, rows);
-    }
-}
-
 } // namespace
 
 std::string fileSourceKey(FileSource source) {
@@ -234,8 +155,12 @@ void FileManagerCore::setFileSystem(IFileSystem* fileSystem) {
 
 bool FileManagerCore::initialize() {
     m_allRows.clear();
-    m_expandedDirectories.clear();
+    m_nodes.clear();
+    m_nodeIndex.clear();
+    m_filterListed.clear();
+    m_searchIndex.clear();
     m_filterText.clear();
+    m_filteredCount = 0;
     m_selectedPath.clear();
     clearError();
     return true;
@@ -273,27 +198,42 @@ bool FileManagerCore::refresh() {
         return lowerAscii(left.relativePath) < lowerAscii(right.relativePath);
     });
 
-    m_allRows = std::move(nextRows);
-    if (!m_selectedPath.empty()
-        && !fileExists(m_selectedPath)
-        && !directoryExists(m_selectedPath)) {
-        m_selectedPath.clear();
+    std::vector<std::string> expandedDirectories;
+    for (const TreeNode& node : m_nodes) {
+        if (node.expanded) {
+            expandedDirectories.push_back(node.relativePath);
+        }
     }
 
-    for (auto iterator = m_expandedDirectories.begin(); iterator != m_expandedDirectories.end();) {
-        if (directoryExists(*iterator)) {
-            ++iterator;
-        } else {
-            iterator = m_expandedDirectories.erase(iterator);
+    m_allRows = std::move(nextRows);
+    rebuildTree();
+
+    // Expansion survives the refresh for directories that still exist.
+    for (const std::string& path : expandedDirectories) {
+        const std::size_t nodeIndex = directoryNode(path);
+        if (nodeIndex != kNoNode) {
+            m_nodes[nodeIndex].expanded = true;
         }
     }
+    recountVisibleRows();
+    applyFilter();
+
+    if (!m_selectedPath.empty()
+        && fileNode(m_selectedPath) == kNoNode
+        && directoryNode(m_selectedPath) == kNoNode) {
+        m_selectedPath.clear();
+    }
 
     clearError();
     return true;
 }
 
 void FileManagerCore::setSearchText(const std::string& text) {
+    if (text == m_filterText) {
+        return;
+    }
     m_filterText = text;
+    applyFilter();
 }
 
 bool FileManagerCore::selectNode(const std::string& relativePath) {
@@ -304,7 +244,7 @@ bool FileManagerCore::selectNode(const std::string& relativePath) {
         return true;
     }
 
-    if (!fileExists(normalizedPath) && !directoryExists(normalizedPath)) {
+    if (fileNode(normalizedPath) == kNoNode && directoryNode(normalizedPath) == kNoNode) {
         setError("Selected path is not present in the effective file tree.");
         return false;
     }
@@ -316,41 +256,50 @@ bool FileManagerCore::selectNode(const std::string& relativePath) {
 
 bool FileManagerCore::toggleDirectory(const std::string& relativePath) {
     const std::string normalizedPath = normalizePath(relativePath);
-    if (normalizedPath.empty() || !directoryExists(normalizedPath)) {
+    const std::size_t nodeIndex = normalizedPath.empty() ? kNoNode : directoryNode(normalizedPath);
+    if (nodeIndex == kNoNode) {
         setError("Selected path is not a directory in the effective file tree.");
         return false;
     }
 
-    const auto expandedIt = m_expandedDirectories.find(normalizedPath);
-    if (expandedIt == m_expandedDirectories.end()) {
-        m_expandedDirectories.insert(normalizedPath);
-    } else {
-        m_expandedDirectories.erase(expandedIt);
-    }
-
+    setExpanded(nodeIndex, !m_nodes[nodeIndex].expanded);
     clearError();
     return true;
 }
 
-StateSnapshot FileManagerCore::buildState() const {
+StateSnapshot FileManagerCore::buildState(const RowWindow& treeWindow) const {
     StateSnapshot state;
-    state.rows = filteredRows();
-    state.treeRows = buildTreeRows();
+    const bool filtered = !m_filterText.empty();
+    const std::size_t visibleCount = m_nodes.empty()
+        ? 0
+        : (filtered ? m_nodes.front().filterRows : m_nodes.front().childRows);
+
     state.filterText = m_filterText;
     state.selectedPath = m_selectedPath;
     state.totalCount = m_allRows.size();
-    state.filteredCount = state.rows.size();
-    state.visibleCount = state.treeRows.size();
+    state.filteredCount = filtered ? m_filteredCount : m_allRows.size();
+    state.visibleCount = visibleCount;
+
+    // Only the rows inside the window are materialized; whole subtrees before it are skipped
+    // by their cached row counts.
+    const auto [windowFirst, windowCount] = clampWindow(treeWindow, visibleCount);
+    state.treeRowsFirst = windowFirst;
+    if (windowCount > 0) {
+        std::size_t skip = windowFirst;
+        std::size_t remaining = windowCount;
+        state.treeRows.reserve(windowCount);
+        appendTreeRows(0, filtered, &skip, &remaining, &state.treeRows);
+    }
     state.lastError = m_lastError;
 
     if (!m_selectedPath.empty()) {
-        FileRecord selectedRecord;
-        if (fileExists(m_selectedPath, &selectedRecord)) {
-            state.selectedFile = selectedRecord;
-            state.selectedDisplayName = selectedRecord.displayName;
+        const std::size_t selectedFileNode = fileNode(m_selectedPath);
+        if (selectedFileNode != kNoNode) {
+            state.selectedFile = m_allRows[m_nodes[selectedFileNode].recordIndex];
+            state.selectedDisplayName = state.selectedFile.displayName;
             state.hasSelection = true;
             state.hasSelectedFile = true;
-        } else if (directoryExists(m_selectedPath)) {
+        } else if (directoryNode(m_selectedPath) != kNoNode) {
             state.selectedDisplayName = fileNameFromPath(m_selectedPath);
             state.hasSelection = true;
             state.selectedIsDirectory = true;
@@ -364,63 +313,200 @@ const std::string& FileManagerCore::lastError() const {
     return m_lastError;
 }
 
-std::vector<FileRecord> FileManagerCore::filteredRows() const {
-    std::vector<FileRecord> rows;
-    rows.reserve(m_allRows.size());
-    for (const FileRecord& record : m_allRows) {
-        if (recordMatchesFilter(record, m_filterText)) {
-            rows.push_back(record);
+void FileManagerCore::rebuildTree() {
+    BuildNode root;
+    root.isDirectory = true;
+    for (std::size_t index = 0; index < m_allRows.size(); ++index) {
+        addRecordToTree(&root, m_allRows[index], index);
+    }
+
+    m_nodes.clear();
+    m_nodeIndex.clear();
+    m_filterListed.clear();
+    m_nodeIndex.reserve(m_allRows.size() * 2);
+
+    // Breadth-first flattening: every node's children are appended as one block.
+    std::vector<const BuildNode*> pending;
+    pending.push_back(&root);
+    m_nodes.emplace_back();
+    for (std::size_t nodeIndex = 0; nodeIndex < pending.size(); ++nodeIndex) {
+        const BuildNode& source = *pending[nodeIndex];
+        m_nodes[nodeIndex].firstChild = m_nodes.size();
+        m_nodes[nodeIndex].childCount = source.children.size();
+        for (const auto& childPair : source.children) {
+            const BuildNode& child = *childPair.second;
+            TreeNode node;
+            node.displayName = child.displayName;
+            node.relativePath = child.relativePath;
+            node.source = child.source;
+            node.isDirectory = child.isDirectory;
+            node.depth = m_nodes[nodeIndex].depth + 1;
+            node.parent = nodeIndex;
+            node.recordIndex = child.recordIndex;
+
+            const std::string key = child.isDirectory ? directoryKey(child.relativePath) : child.relativePath;
+            m_nodeIndex.emplace(key, m_nodes.size());
+            m_nodes.push_back(std::move(node));
+            pending.push_back(&child);
         }
     }
-    return rows;
+
+    std::vector<std::string> paths;
+    paths.reserve(m_nodes.size());
+    for (const TreeNode& node : m_nodes) {
+        paths.push_back(node.relativePath);
+    }
+    m_searchIndex.build(paths);
 }
 
-std::vector<TreeRow> FileManagerCore::buildTreeRows() const {
-    BuildNode root;
-    root.isDirectory = true;
-    for (const FileRecord& record : m_allRows) {
-        addRecordToTree(&root, record);
+void FileManagerCore::recountVisibleRows() {
+    // Children always follow their parent in the arena, so a reverse sweep sees them first.
+    for (std::size_t nodeIndex = m_nodes.size(); nodeIndex-- > 0;) {
+        TreeNode& node = m_nodes[nodeIndex];
+        node.childRows = 0;
+        for (std::size_t child = node.firstChild; child < node.firstChild + node.childCount; ++child) {
+            node.childRows += 1 + (m_nodes[child].expanded ? m_nodes[child].childRows : 0);
+        }
     }
+}
 
-    std::vector<TreeRow> rows;
-    if (!m_filterText.empty()) {
-        for (const auto& childPair : root.children) {
-            appendFilteredRows(*childPair.second, 0, m_expandedDirectories, m_selectedPath, m_filterText, &rows);
+void FileManagerCore::applyFilter() {
+    for (const std::size_t nodeIndex : m_filterListed) {
+        m_nodes[nodeIndex].filterMatch = false;
+        m_nodes[nodeIndex].filterRows = 0;
+    }
+    m_filterListed.clear();
+    m_filteredCount = 0;
+    if (m_nodes.empty()) {
+        return;
+    }
+    m_nodes.front().filterRows = 0;
+    if (m_filterText.empty()) {
+        return;
+    }
+
+    // A node is listed when it matches or when something below it does; listed directories
+    // show all of their listed children. Only the matches and their ancestors are touched.
+    const auto listMatch = [this](std::size_t nodeIndex) {
+        TreeNode& node = m_nodes[nodeIndex];
+        if (nodeIndex == 0 || node.filterMatch) {
+            return;
+        }
+        node.filterMatch = true;
+        if (!node.isDirectory) {
+            ++m_filteredCount;
+        }
+        for (std::size_t current = nodeIndex; current != 0 && m_nodes[current].filterRows == 0;
+             current = m_nodes[current].parent) {
+            m_nodes[current].filterRows = 1;
+            m_filterListed.push_back(current);
+        }
+    };
+
+    const PathSearchIndex::Query query = PathSearchIndex::parseQuery(m_filterText);
+    for (const std::uint32_t nodeIndex : m_searchIndex.search(query)) {
+        listMatch(nodeIndex);
+    }
+
+    // Plain text also finds files by the name of their source.
+    if (query.mode == PathSearchIndex::Mode::Substring) {
+        const FileSource sources[] = {FileSource::Game, FileSource::Mod, FileSource::Dlc, FileSource::Unknown};
+        bool sourceMatches[4] = {};
+        bool anySourceMatches = false;
+        for (std::size_t index = 0; index < 4; ++index) {
+            sourceMatches[index] = lowerAscii(fileSourceName(sources[index])).find(query.pattern) != std::string::npos;
+            anySourceMatches = anySourceMatches || sourceMatches[index];
+        }
+        for (std::size_t nodeIndex = 1; anySourceMatches && nodeIndex < m_nodes.size(); ++nodeIndex) {
+            const TreeNode& node = m_nodes[nodeIndex];
+            if (!node.isDirectory && sourceMatches[static_cast<std::size_t>(node.source)]) {
+                listMatch(nodeIndex);
+            }
         }
-        return rows;
     }
 
-    for (const auto& childPair : root.children) {
-        appendVisibleRows(*childPair.second, 0, m_expandedDirectories, m_selectedPath, &rows);
+    // Children follow their parents in the arena, so in descending order every subtree total
+    // is complete before it is added to its parent.
+    std::sort(m_filterListed.begin(), m_filterListed.end(), std::greater<std::size_t>());
+    for (const std::size_t nodeIndex : m_filterListed) {
+        m_nodes[m_nodes[nodeIndex].parent].filterRows += m_nodes[nodeIndex].filterRows;
     }
-    return rows;
 }
 
-bool FileManagerCore::directoryExists(const std::string& relativePath) const {
-    const std::string normalizedPath = normalizePath(relativePath);
-    if (normalizedPath.empty()) {
-        return false;
+void FileManagerCore::setExpanded(std::size_t nodeIndex, bool expanded) {
+    TreeNode& node = m_nodes[nodeIndex];
+    if (node.expanded == expanded) {
+        return;
     }
+    node.expanded = expanded;
 
-    const std::string childPrefix = normalizedPath + "/";
-    return std::any_of(m_allRows.begin(), m_allRows.end(), [&childPrefix](const FileRecord& record) {
-        return record.relativePath.rfind(childPrefix, 0) == 0;
-    });
+    // Only the ancestors' counts change, and only up to the first collapsed one.
+    const std::size_t delta = node.childRows;
+    for (std::size_t parent = node.parent; parent != kNoNode; parent = m_nodes[parent].parent) {
+        TreeNode& ancestor = m_nodes[parent];
+        ancestor.childRows = expanded ? ancestor.childRows + delta : ancestor.childRows - delta;
+        if (ancestor.parent != kNoNode && !ancestor.expanded) {
+            break;
+        }
+    }
 }
 
-bool FileManagerCore::fileExists(const std::string& relativePath, FileRecord* outRecord) const {
-    const std::string normalizedPath = normalizePath(relativePath);
-    const auto recordIt = std::find_if(m_allRows.begin(), m_allRows.end(), [&normalizedPath](const FileRecord& record) {
-        return record.relativePath == normalizedPath;
-    });
-    if (recordIt == m_allRows.end()) {
-        return false;
-    }
+void FileManagerCore::appendTreeRows(std::size_t parentIndex,
+                                     bool filtered,
+                                     std::size_t* skip,
+                                     std::size_t* remaining,
+                                     std::vector<TreeRow>* rows) const {
+    const TreeNode& parent = m_nodes[parentIndex];
+    for (std::size_t child = parent.firstChild;
+         child < parent.firstChild + parent.childCount && *remaining > 0;
+         ++child) {
+        const TreeNode& node = m_nodes[child];
+        const bool open = node.isDirectory && (filtered || node.expanded);
+        const std::size_t subtreeRows = filtered ? node.filterRows : 1 + (open ? node.childRows : 0);
+        if (subtreeRows == 0) {
+            continue;
+        }
+        if (*skip >= subtreeRows) {
+            *skip -= subtreeRows;
+            continue;
+        }
 
-    if (outRecord) {
-        *outRecord = *recordIt;
+        if (*skip > 0) {
+            --*skip;
+        } else {
+            rows->push_back(makeTreeRow(child, filtered));
+            --*remaining;
+        }
+        if (open) {
+            appendTreeRows(child, filtered, skip, remaining, rows);
+        }
     }
-    return true;
+}
+
+TreeRow FileManagerCore::makeTreeRow(std::size_t nodeIndex, bool filtered) const {
+    const TreeNode& node = m_nodes[nodeIndex];
+    TreeRow row;
+    row.rowId = node.relativePath;
+    row.displayName = node.displayName;
+    row.relativePath = node.relativePath;
+    row.source = node.source;
+    row.isDirectory = node.isDirectory;
+    row.expanded = node.isDirectory && (filtered || node.expanded);
+    row.hasChildren = node.childCount > 0;
+    row.selected = m_selectedPath == node.relativePath;
+    row.depth = node.depth;
+    row.childCount = node.childCount;
+    return row;
+}
+
+std::size_t FileManagerCore::directoryNode(const std::string& relativePath) const {
+    const auto it = m_nodeIndex.find(directoryKey(normalizePath(relativePath)));
+    return it == m_nodeIndex.end() ? kNoNode : it->second;
+}
+
+std::size_t FileManagerCore::fileNode(const std::string& relativePath) const {
+    const auto it = m_nodeIndex.find(normalizePath(relativePath));
+    return it == m_nodeIndex.end() || m_nodes[it->second].recordIndex == kNoNode ? kNoNode : it->second;
 }
 
 void FileManagerCore::setError(const std::string& message) {
@@ -9,9 +9,11 @@
 #ifndef FILEMANAGERCORE_H
 #define FILEMANAGERCORE_H
 
+#include "PathSearchIndex.h"
+
 #include <cstddef>
-#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace FileManager {
@@ -61,9 +63,15 @@ struct TreeRow {
     std::size_t childCount = 0;
 };
 
+// Slice of a list to include in a snapshot; the default covers every row.
+struct RowWindow {
+    std::size_t first = 0;
+    std::size_t count = static_cast<std::size_t>(-1);
+};
+
 struct StateSnapshot {
-    std::vector<FileRecord> rows;
     std::vector<TreeRow> treeRows;
+    std::size_t treeRowsFirst = 0;  // Position of treeRows.front() among all visibleCount rows
     std::string filterText;
     std::string selectedPath;
     std::string selectedDisplayName;
@@ -87,21 +95,55 @@ public:
     bool selectNode(const std::string& relativePath);
     bool toggleDirectory(const std::string& relativePath);
 
-    StateSnapshot buildState() const;
+    StateSnapshot buildState(const RowWindow& treeWindow = RowWindow()) const;
     const std::string& lastError() const;
 
 private:
-    std::vector<FileRecord> filteredRows() const;
-    std::vector<TreeRow> buildTreeRows() const;
-    bool directoryExists(const std::string& relativePath) const;
-    bool fileExists(const std::string& relativePath, FileRecord* outRecord = nullptr) const;
+    static constexpr std::size_t kNoNode = static_cast<std::size_t>(-1);
+
+    // Directory tree built once per refresh. Nodes live in a flat arena in breadth-first order,
+    // so the children of a node occupy one contiguous range and always follow their parent.
+    struct TreeNode {
+        std::string displayName;
+        std::string relativePath;
+        FileSource source = FileSource::Unknown;
+        bool isDirectory = true;
+        bool expanded = false;
+        bool filterMatch = false;
+        int depth = -1;
+        std::size_t parent = kNoNode;
+        std::size_t firstChild = 0;
+        std::size_t childCount = 0;
+        std::size_t recordIndex = kNoNode;
+        std::size_t childRows = 0;   // Visible rows below this directory while it is expanded
+        std::size_t filterRows = 0;  // Rows of this subtree while a filter is active
+    };
+
+    void rebuildTree();
+    void recountVisibleRows();
+    void applyFilter();
+    void setExpanded(std::size_t nodeIndex, bool expanded);
+    void appendTreeRows(std::size_t parentIndex,
+                        bool filtered,
+                        std::size_t* skip,
+                        std::size_t* remaining,
+                        std::vector<TreeRow>* rows) const;
+    TreeRow makeTreeRow(std::size_t nodeIndex, bool filtered) const;
+    std::size_t directoryNode(const std::string& relativePath) const;
+    std::size_t fileNode(const std::string& relativePath) const;
     void setError(const std::string& message);
     void clearError();
 
     IFileSystem* m_fileSystem = nullptr;
     std::vector<FileRecord> m_allRows;
-    std::set<std::string> m_expandedDirectories;
+    std::vector<TreeNode> m_nodes;
+    // Files are keyed by their path and directories by their path plus a trailing '/'.
+    std::unordered_map<std::string, std::size_t> m_nodeIndex;
+    // Ids are node indices.
+    PathSearchIndex m_searchIndex;
+    std::vector<std::size_t> m_filterListed;
     std::string m_filterText;
+    std::size_t m_filteredCount = 0;
     std::string m_selectedPath;
     std::string m_lastError;
 };
@@ -0,0 +1,347 @@
+//-------------------------------------------------------------------------------------
+// PathSearchIndex.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "PathSearchIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+namespace FileManager {
+namespace {
+
+// Grams are taken over a 64-symbol folding of the case-folded bytes, which keeps every posting
+// list addressable by a small flat table. Folding only merges rare characters; candidates are
+// always verified against the real path.
+constexpr std::uint32_t kSymbolBits = 6;
+constexpr std::uint32_t kSymbolCount = 1u << kSymbolBits;
+constexpr std::uint32_t kUnigramBase = 0;
+constexpr std::uint32_t kBigramBase = kUnigramBase + kSymbolCount;
+constexpr std::uint32_t kTrigramBase = kBigramBase + kSymbolCount * kSymbolCount;
+constexpr std::uint32_t kGramSpace = kTrigramBase + kSymbolCount * kSymbolCount * kSymbolCount;
+
+struct PostingRange {
+    const std::uint32_t* begin = nullptr;
+    const std::uint32_t* end = nullptr;
+};
+
+std::string lowerAscii(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char ch) {
+        return static_cast<char>(std::tolower(ch));
+    });
+    return value;
+}
+
+std::uint32_t foldSymbol(char value) {
+    const unsigned char ch = static_cast<unsigned char>(value);
+    if (ch >= 'a' && ch <= 'z') {
+        return 1 + (ch - 'a');
+    }
+    if (ch >= '0' && ch <= '9') {
+        return 27 + (ch - '0');
+    }
+    switch (ch) {
+    case '_':
+        return 37;
+    case '.':
+        return 38;
+    case '/':
+        return 39;
+    case '-':
+        return 40;
+    case ' ':
+        return 41;
+    default:
+        return 42 + ch % (kSymbolCount - 42);
+    }
+}
+
+// Calls visit with the gram key of every unigram, bigram and trigram of text.
+template <typename Visitor>
+void forEachGram(const std::string& text, Visitor&& visit) {
+    std::uint32_t previous = 0;
+    std::uint32_t beforePrevious = 0;
+    for (std::size_t position = 0; position < text.size(); ++position) {
+        const std::uint32_t symbol = foldSymbol(text[position]);
+        visit(kUnigramBase + symbol);
+        if (position >= 1) {
+            visit(kBigramBase + ((previous << kSymbolBits) | symbol));
+        }
+        if (position >= 2) {
+            visit(kTrigramBase + ((beforePrevious << (2 * kSymbolBits)) | (previous << kSymbolBits) | symbol));
+        }
+        beforePrevious = previous;
+        previous = symbol;
+    }
+}
+
+// Grams that every text containing literal also contains: its trigrams, or the literal itself
+// when it is shorter than three characters.
+std::vector<std::uint32_t> requiredGrams(const std::string& literal) {
+    std::vector<std::uint32_t> grams;
+    if (literal.size() >= 3) {
+        forEachGram(literal, [&grams](std::uint32_t gram) {
+            if (gram >= kTrigramBase) {
+                grams.push_back(gram);
+            }
+        });
+    } else if (literal.size() == 2) {
+        grams.push_back(kBigramBase + ((foldSymbol(literal[0]) << kSymbolBits) | foldSymbol(literal[1])));
+    } else if (literal.size() == 1) {
+        grams.push_back(kUnigramBase + foldSymbol(literal[0]));
+    }
+    return grams;
+}
+
+// '*' matches any run of characters and '?' any single character.
+bool globMatches(std::string_view pattern, std::string_view text) {
+    std::size_t patternPos = 0;
+    std::size_t textPos = 0;
+    std::size_t starPos = std::string_view::npos;
+    std::size_t starText = 0;
+    while (textPos < text.size()) {
+        if (patternPos < pattern.size()
+            && (pattern[patternPos] == '?' || pattern[patternPos] == text[textPos])) {
+            ++patternPos;
+            ++textPos;
+        } else if (patternPos < pattern.size() && pattern[patternPos] == '*') {
+            starPos = patternPos++;
+            starText = textPos;
+        } else if (starPos != std::string_view::npos) {
+            patternPos = starPos + 1;
+            textPos = ++starText;
+        } else {
+            return false;
+        }
+    }
+    while (patternPos < pattern.size() && pattern[patternPos] == '*') {
+        ++patternPos;
+    }
+    return patternPos == pattern.size();
+}
+
+bool isSubsequence(const std::string& needle, const std::string& text) {
+    std::size_t textPos = 0;
+    for (const char ch : needle) {
+        textPos = text.find(ch, textPos);
+        if (textPos == std::string::npos) {
+            return false;
+        }
+        ++textPos;
+    }
+    return true;
+}
+
+// Runs of the glob pattern without wildcards; every match contains each of them.
+std::vector<std::string> globLiterals(const std::string& pattern) {
+    std::vector<std::string> literals;
+    std::string current;
+    for (const char ch : pattern) {
+        if (ch == '*' || ch == '?') {
+            if (!current.empty()) {
+                literals.push_back(std::move(current));
+                current.clear();
+            }
+        } else {
+            current.push_back(ch);
+        }
+    }
+    if (!current.empty()) {
+        literals.push_back(std::move(current));
+    }
+    return literals;
+}
+
+} // namespace
+
+PathSearchIndex::Query PathSearchIndex::parseQuery(const std::string& text) {
+    Query query;
+    if (text.size() > 1 && text.front() == '~') {
+        query.mode = Mode::Fuzzy;
+        query.pattern = lowerAscii(text.substr(1));
+    } else {
+        query.mode = text.find_first_of("*?") == std::string::npos ? Mode::Substring : Mode::Glob;
+        query.pattern = lowerAscii(text);
+    }
+    return query;
+}
+
+void PathSearchIndex::build(const std::vector<std::string>& paths) {
+    clear();
+    m_paths.reserve(paths.size());
+    for (const std::string& path : paths) {
+        m_paths.push_back(lowerAscii(path));
+    }
+
+    // Counting sort into one flat posting array: count each gram once per path, turn the
+    // counts into offsets, then fill. Ids are visited in order, so every list comes out sorted.
+    m_offsets.assign(kGramSpace + 1, 0);
+    std::vector<std::uint32_t> lastSeen(kGramSpace, static_cast<std::uint32_t>(-1));
+    for (std::uint32_t id = 0; id < static_cast<std::uint32_t>(m_paths.size()); ++id) {
+        forEachGram(m_paths[id], [this, id, &lastSeen](std::uint32_t gram) {
+            if (lastSeen[gram] != id) {
+                lastSeen[gram] = id;
+                ++m_offsets[gram + 1];
+            }
+        });
+    }
+    for (std::uint32_t gram = 0; gram < kGramSpace; ++gram) {
+        m_offsets[gram + 1] += m_offsets[gram];
+    }
+
+    m_postings.resize(m_offsets[kGramSpace]);
+    std::vector<std::uint32_t> cursors(m_offsets.begin(), m_offsets.end() - 1);
+    std::fill(lastSeen.begin(), lastSeen.end(), static_cast<std::uint32_t>(-1));
+    for (std::uint32_t id = 0; id < static_cast<std::uint32_t>(m_paths.size()); ++id) {
+        forEachGram(m_paths[id], [this, id, &lastSeen, &cursors](std::uint32_t gram) {
+            if (lastSeen[gram] != id) {
+                lastSeen[gram] = id;
+                m_postings[cursors[gram]++] = id;
+            }
+        });
+    }
+}
+
+void PathSearchIndex::clear() {
+    m_paths.clear();
+    m_offsets.clear();
+    m_postings.clear();
+    m_hasPrevious = false;
+    m_previousQuery = Query();
+    m_previousResult.clear();
+}
+
+const std::vector<std::uint32_t>& PathSearchIndex::search(const Query& query) {
+    std::vector<std::uint32_t> candidates;
+    bool scanAll = false;
+    if (narrowsPrevious(query)) {
+        candidates = std::move(m_previousResult);
+    } else {
+        std::vector<std::string> literals;
+        if (query.mode == Mode::Substring) {
+            literals.push_back(query.pattern);
+        } else if (query.mode == Mode::Glob) {
+            literals = globLiterals(query.pattern);
+        } else {
+            // A fuzzy match contains every character of the pattern.
+            for (const char ch : query.pattern) {
+                literals.push_back(std::string(1, ch));
+            }
+        }
+
+        std::vector<std::uint32_t> grams;
+        for (const std::string& literal : literals) {
+            const std::vector<std::uint32_t> literalGrams = requiredGrams(literal);
+            grams.insert(grams.end(), literalGrams.begin(), literalGrams.end());
+        }
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+
+        std::vector<PostingRange> ranges;
+        bool possible = !m_offsets.empty() || grams.empty();
+        for (std::size_t index = 0; possible && index < grams.size(); ++index) {
+            const PostingRange range{m_postings.data() + m_offsets[grams[index]],
+                                     m_postings.data() + m_offsets[grams[index] + 1]};
+            possible = range.begin != range.end;
+            ranges.push_back(range);
+        }
+
+        if (!possible) {
+            // Some required gram occurs nowhere, so nothing can match.
+        } else if (ranges.empty()) {
+            scanAll = true;
+        } else {
+            std::sort(ranges.begin(), ranges.end(), [](const PostingRange& left, const PostingRange& right) {
+                return left.end - left.begin < right.end - right.begin;
+            });
+            candidates.assign(ranges.front().begin, ranges.front().end);
+            std::vector<std::uint32_t> intersection;
+            for (std::size_t index = 1; index < ranges.size() && !candidates.empty(); ++index) {
+                const PostingRange& range = ranges[index];
+                intersection.clear();
+                if (candidates.size() * 16 < static_cast<std::size_t>(range.end - range.begin)) {
+                    // Few candidates against a long list: search instead of walking the list.
+                    const std::uint32_t* cursor = range.begin;
+                    for (const std::uint32_t id : candidates) {
+                        cursor = std::lower_bound(cursor, range.end, id);
+                        if (cursor == range.end) {
+                            break;
+                        }
+                        if (*cursor == id) {
+                            intersection.push_back(id);
+                        }
+                    }
+                } else {
+                    std::set_intersection(candidates.begin(), candidates.end(),
+                                          range.begin, range.end,
+                                          std::back_inserter(intersection));
+                }
+                candidates.swap(intersection);
+            }
+        }
+    }
+
+    std::vector<std::uint32_t> result;
+    if (scanAll) {
+        for (std::size_t id = 0; id < m_paths.size(); ++id) {
+            if (matches(query, m_paths[id])) {
+                result.push_back(static_cast<std::uint32_t>(id));
+            }
+        }
+    } else {
+        for (const std::uint32_t id : candidates) {
+            if (matches(query, m_paths[id])) {
+                result.push_back(id);
+            }
+        }
+    }
+
+    m_previousQuery = query;
+    m_previousResult = std::move(result);
+    m_hasPrevious = true;
+    return m_previousResult;
+}
+
+bool PathSearchIndex::matches(const Query& query, const std::string& path) const {
+    switch (query.mode) {
+    case Mode::Glob: {
+        std::string_view subject(path);
+        if (query.pattern.find('/') == std::string::npos) {
+            const std::size_t separator = subject.find_last_of('/');
+            if (separator != std::string_view::npos) {
+                subject.remove_prefix(separator + 1);
+            }
+        }
+        return globMatches(query.pattern, subject);
+    }
+    case Mode::Fuzzy:
+        return isSubsequence(query.pattern, path);
+    case Mode::Substring:
+    default:
+        return path.find(query.pattern) != std::string::npos;
+    }
+}
+
+bool PathSearchIndex::narrowsPrevious(const Query& query) const {
+    if (!m_hasPrevious || m_previousQuery.mode != query.mode) {
+        return false;
+    }
+    switch (query.mode) {
+    case Mode::Substring:
+        return query.pattern.find(m_previousQuery.pattern) != std::string::npos;
+    case Mode::Fuzzy:
+        return isSubsequence(m_previousQuery.pattern, query.pattern);
+    case Mode::Glob:
+    default:
+        return false;
+    }
+}
+
+} // namespace FileManager
@@ -0,0 +1,65 @@
+//-------------------------------------------------------------------------------------
+// PathSearchIndex.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef PATHSEARCHINDEX_H
+#define PATHSEARCHINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace FileManager {
+
+// Case-insensitive search over a fixed list of paths, built once per refresh.
+//
+// Query syntax:
+//   text      substring of the path
+//   a*b?c     glob; matched against the file name, or against the whole path when it has a '/'
+//   ~text     fuzzy; the characters of text appear in the path in order
+//
+// Candidates come from posting lists of the grams (one to three characters) every match must
+// contain, and are then verified. A query that can only match a subset of the previous query's
+// results, as when typing further, starts from those results instead.
+class PathSearchIndex {
+public:
+    enum class Mode {
+        Substring,
+        Glob,
+        Fuzzy
+    };
+
+    struct Query {
+        Mode mode = Mode::Substring;
+        std::string pattern;  // Case-folded, without the mode prefix
+    };
+
+    static Query parseQuery(const std::string& text);
+
+    void build(const std::vector<std::string>& paths);
+    void clear();
+
+    // Sorted ids (positions in the built list) of the matching paths.
+    const std::vector<std::uint32_t>& search(const Query& query);
+
+private:
+    bool matches(const Query& query, const std::string& path) const;
+    bool narrowsPrevious(const Query& query) const;
+
+    std::vector<std::string> m_paths;
+    // Ids of the paths containing gram g are m_postings[m_offsets[g] .. m_offsets[g + 1]).
+    std::vector<std::uint32_t> m_offsets;
+    std::vector<std::uint32_t> m_postings;
+
+    bool m_hasPrevious = false;
+    Query m_previousQuery;
+    std::vector<std::uint32_t> m_previousResult;
+};
+
+} // namespace FileManager
+
+#endif // PATHSEARCHINDEX_H
@@ -8,15 +8,14 @@
 //-------------------------------------------------------------------------------------
 #include "FlagManagerBridge.h"
 
+#include "../../src/ToolListWindow.h"
 #include "../../src/ToolRuntimeContext.h"
 
 #include <QByteArray>
-#include <QBuffer>
 #include <QCryptographicHash>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
-#include <QImage>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -42,20 +41,25 @@ std::string g_legacyLastError;
 std::string g_legacySerializedState;
 
 namespace {
+using FlagManager::CropResizeJob;
 using FlagManager::EffectiveFileEntry;
 using FlagManager::EffectiveFileListResult;
+using FlagManager::FileBatchWriteResult;
 using FlagManager::FileReadResult;
+using FlagManager::FileWriteItem;
 using FlagManager::FileWriteResult;
 using FlagManager::FlagImage;
 using FlagManager::FlagManagerCore;
 using FlagManager::FlagStatus;
 using FlagManager::IFileSystem;
 using FlagManager::IImagePipeline;
+using FlagManager::ImageSize;
 using FlagManager::ImportedImage;
 using FlagManager::ImportItem;
 using FlagManager::ManageVariantDisplay;
 using FlagManager::Rect;
 using FlagManager::Snapshot;
+using FlagManager::RowWindow;
 using FlagManager::TagListRow;
 using FlagManager::TagRecord;
 using FlagManager::ToolMode;
@@ -65,7 +69,6 @@ constexpr int kSmallFlagIconHeight = 7;
 constexpr int kImportThumbnailWidth = 32;
 constexpr int kImportThumbnailHeight = 32;
 constexpr int kImportPreviewMaxDimension = 1024;
-constexpr int kPreviewCacheEntryLimit = 512;
 constexpr int kImportThumbnailCacheEntryLimit = 256;
 
 enum LumorphaPixelFormatBridge {
@@ -94,6 +97,18 @@ enum LumorphaResizeFilterBridge {
     APE_LUMORPHA_FILTER_LANCZOS3 = 6
 };
 
+enum LumorphaPipelineSourceBridge {
+    APE_LUMORPHA_PIPELINE_SOURCE_ENCODED = 0,
+    APE_LUMORPHA_PIPELINE_SOURCE_IMAGE = 1
+};
+
+enum LumorphaPipelineOpBridge {
+    APE_LUMORPHA_PIPELINE_OP_CROP = 1,
+    APE_LUMORPHA_PIPELINE_OP_RESIZE = 2,
+    APE_LUMORPHA_PIPELINE_OP_FLIP = 3,
+    APE_LUMORPHA_PIPELINE_OP_PREMULTIPLY = 4
+};
+
 QString normalizeRuntimePath(QString value) {
     value.replace('\\', '/');
     value = QDir::cleanPath(value.trimmed());
@@ -121,6 +136,9 @@ QString localizedFallback(const QString& key) {
         fallbacks.insert(QStringLiteral("Crop"), QStringLiteral("Crop:"));
         fallbacks.insert(QStringLiteral("Export"), QStringLiteral("Export Current"));
         fallbacks.insert(QStringLiteral("ExportAll"), QStringLiteral("Export All"));
+        fallbacks.insert(QStringLiteral("CompressTga"), QStringLiteral("RLE TGA"));
+        fallbacks.insert(QStringLiteral("Exporting"), QStringLiteral("Exporting flags... %1/%2"));
+        fallbacks.insert(QStringLiteral("CancelExport"), QStringLiteral("Cancel Export"));
         fallbacks.insert(QStringLiteral("ImportFiles"), QStringLiteral("Import Files"));
         fallbacks.insert(QStringLiteral("BrowserPlaceholder"), QStringLiteral("Select a TAG to view flags."));
         fallbacks.insert(QStringLiteral("NoImage"), QStringLiteral("No Image"));
@@ -355,14 +373,13 @@ QByteArray imageEnvelopeFromFlagImage(const FlagImage& image) {
     return payload;
 }
 
-bool flagImageFromEnvelope(const QByteArray& payload, FlagImage* outImage) {
+// Reads one image record and leaves the cursor after its pixel bytes.
+bool readFlagImage(const unsigned char*& cursor, const unsigned char* end, FlagImage* outImage) {
     if (!outImage) {
         return false;
     }
     *outImage = {};
 
-    const auto* cursor = reinterpret_cast<const unsigned char*>(payload.constData());
-    const auto* end = cursor ? cursor + payload.size() : nullptr;
     std::uint32_t width = 0;
     std::uint32_t height = 0;
     std::uint32_t stride = 0;
@@ -413,10 +430,63 @@ bool flagImageFromEnvelope(const QByteArray& payload, FlagImage* outImage) {
         }
     }
 
+    cursor += byteSize;
     *outImage = std::move(result);
     return FlagManager::isValidImage(*outImage);
 }
 
+bool flagImageFromEnvelope(const QByteArray& payload, FlagImage* outImage) {
+    const auto* cursor = reinterpret_cast<const unsigned char*>(payload.constData());
+    const auto* end = cursor ? cursor + payload.size() : nullptr;
+    return readFlagImage(cursor, end, outImage);
+}
+
+// lumorpha.runPipeline source: the image record, sent once for every output derived from it
+QByteArray pipelineSourceFromFlagImage(const FlagImage& image) {
+    QByteArray payload = imageEnvelopeFromFlagImage(image);
+    if (payload.isEmpty()) {
+        return {};
+    }
+    QByteArray kind;
+    appendU32(&kind, APE_LUMORPHA_PIPELINE_SOURCE_IMAGE);
+    payload.prepend(kind);
+    return payload;
+}
+
+void appendPipelineResize(QByteArray* payload, int width, int height, std::uint32_t filter) {
+    appendU32(payload, APE_LUMORPHA_PIPELINE_OP_RESIZE);
+    appendU32(payload, static_cast<std::uint32_t>(std::max(0, width)));
+    appendU32(payload, static_cast<std::uint32_t>(std::max(0, height)));
+    appendU32(payload, filter);
+}
+
+// A u32 count followed by that many encoded files, each a u32 size and its bytes.
+bool encodedFilesFromEnvelope(const QByteArray& payload, std::vector<QByteArray>* outFiles) {
+    if (!outFiles) {
+        return false;
+    }
+    outFiles->clear();
+
+    const auto* cursor = reinterpret_cast<const unsigned char*>(payload.constData());
+    const auto* end = cursor ? cursor + payload.size() : nullptr;
+    std::uint32_t count = 0;
+    if (!readU32(cursor, end, &count) || count > static_cast<std::uint32_t>(payload.size() / 4)) {
+        return false;
+    }
+
+    std::vector<QByteArray> files(count);
+    for (QByteArray& file : files) {
+        std::uint32_t size = 0;
+        if (!readU32(cursor, end, &size) || size == 0 || static_cast<std::size_t>(end - cursor) < size) {
+            return false;
+        }
+        file = QByteArray(reinterpret_cast<const char*>(cursor), static_cast<int>(size));
+        cursor += size;
+    }
+    *outFiles = std::move(files);
+    return true;
+}
+
 class LumorphaClient {
 public:
     bool decodeImage(const QByteArray& data, std::uint32_t formatHint, FlagImage* outImage) {
@@ -506,74 +576,129 @@ public:
         return true;
     }
 
-    bool resizeImage(const FlagImage& image, const QSize& targetSize, FlagImage* outImage) {
-        if (!outImage) {
-            return false;
-        }
-        *outImage = {};
-        if (!FlagManager::isValidImage(image) || !targetSize.isValid()) {
-            m_lastError = QStringLiteral("Invalid resize arguments.");
-            return false;
+    QByteArray encodeImage(const FlagImage& image, std::uint32_t outputFormat) {
+        if (!FlagManager::isValidImage(image)) {
+            m_lastError = QStringLiteral("Source image is invalid.");
+            return {};
         }
 
         QByteArray payload = imageEnvelopeFromFlagImage(image);
         if (payload.isEmpty()) {
             m_lastError = QStringLiteral("Source image is invalid.");
-            return false;
+            return {};
         }
-        appendU32(&payload, static_cast<std::uint32_t>(targetSize.width()));
-        appendU32(&payload, static_cast<std::uint32_t>(targetSize.height()));
-        appendU32(&payload, APE_LUMORPHA_FILTER_BOX);
+        appendU32(&payload, outputFormat);
+        appendU32(&payload, 0);
 
         const ToolRuntimeContext::PluginInvokeResponse response = invokePluginOperation(
             QStringLiteral("Lumorpha"),
-            QStringLiteral("lumorpha.resizeImage"),
+            QStringLiteral("lumorpha.encodeImage"),
             ToolRuntimeContext::PluginPayloadContentType::BinaryEnvelope,
             payload
         );
-        if (!response.success) {
-            setLastErrorFromResponse(response, QStringLiteral("Lumorpha resize failed."));
-            return false;
+        if (!response.success
+            || response.contentType != ToolRuntimeContext::PluginPayloadContentType::Binary
+            || response.payload.isEmpty()) {
+            setLastErrorFromResponse(response, QStringLiteral("Lumorpha encode failed."));
+            return {};
         }
 
-        if (response.contentType != ToolRuntimeContext::PluginPayloadContentType::BinaryEnvelope
-            || !flagImageFromEnvelope(response.payload, outImage)) {
-            m_lastError = QStringLiteral("Lumorpha returned an invalid image.");
-            return false;
-        }
         m_lastError.clear();
-        return true;
+        return response.payload;
     }
 
-    QByteArray encodeImage(const FlagImage& image, std::uint32_t outputFormat) {
-        if (!FlagManager::isValidImage(image)) {
-            m_lastError = QStringLiteral("Source image is invalid.");
-            return {};
-        }
-
-        QByteArray payload = imageEnvelopeFromFlagImage(image);
+    // Resizes (when targetSize is valid) and encodes in one lumorpha.runPipeline call, so the
+    // resized pixels never come back over the plugin boundary.
+    QByteArray resizeEncodeImage(const FlagImage& image, const QSize& targetSize, std::uint32_t outputFormat) {
+        QByteArray payload = pipelineSourceFromFlagImage(image);
         if (payload.isEmpty()) {
             m_lastError = QStringLiteral("Source image is invalid.");
             return {};
         }
-        appendU32(&payload, outputFormat);
+        // No shared ops, then a single output with at most one resize
         appendU32(&payload, 0);
+        appendU32(&payload, 1);
+        appendU32(&payload, outputFormat);
+        if (targetSize.isValid()) {
+            appendU32(&payload, 1);
+            appendPipelineResize(&payload, targetSize.width(), targetSize.height(), APE_LUMORPHA_FILTER_BOX);
+        } else {
+            appendU32(&payload, 0);
+        }
 
         const ToolRuntimeContext::PluginInvokeResponse response = invokePluginOperation(
             QStringLiteral("Lumorpha"),
-            QStringLiteral("lumorpha.encodeImage"),
+            QStringLiteral("lumorpha.runPipeline"),
             ToolRuntimeContext::PluginPayloadContentType::BinaryEnvelope,
             payload
         );
+        std::vector<QByteArray> files;
         if (!response.success
-            || response.contentType != ToolRuntimeContext::PluginPayloadContentType::Binary
-            || response.payload.isEmpty()) {
-            setLastErrorFromResponse(response, QStringLiteral("Lumorpha encode failed."));
+            || response.contentType != ToolRuntimeContext::PluginPayloadContentType::BinaryEnvelope
+            || !encodedFilesFromEnvelope(response.payload, &files)
+            || files.size() != 1) {
+            setLastErrorFromResponse(response, QStringLiteral("Lumorpha pipeline failed."));
             return {};
         }
 
         m_lastError.clear();
-        return response.payload;
+        return files.front();
+    }
+
+    // One pipeline per job in a single plugin batch: the crop is shared, every size is an output
+    // encoded as outputFormat, and the broker spreads the items over its workers.
+    std::vector<std::vector<QByteArray>> cropResizeEncodeImages(const std::vector<CropResizeJob>& jobs,
+                                                                std::uint32_t outputFormat) {
+        std::vector<std::vector<QByteArray>> results(jobs.size());
+        QList<ToolRuntimeContext::PluginInvokeRequest> requests;
+        requests.reserve(static_cast<qsizetype>(jobs.size()));
+        for (const CropResizeJob& job : jobs) {
+            ToolRuntimeContext::PluginInvokeRequest request;
+            request.operation = QStringLiteral("lumorpha.runPipeline");
+            request.contentType = ToolRuntimeContext::PluginPayloadContentType::BinaryEnvelope;
+            if (job.image && !job.sizes.empty()
+                && job.crop.left >= 0 && job.crop.top >= 0
+                && job.crop.right >= job.crop.left && job.crop.bottom >= job.crop.top) {
+                request.payload = pipelineSourceFromFlagImage(*job.image);
+            }
+            if (!request.payload.isEmpty()) {
+                // The crop is the one shared op; each size is an output that resizes and encodes
+                appendU32(&request.payload, 1);
+                appendU32(&request.payload, APE_LUMORPHA_PIPELINE_OP_CROP);
+                appendU32(&request.payload, static_cast<std::uint32_t>(job.crop.left));
+                appendU32(&request.payload, static_cast<std::uint32_t>(job.crop.top));
+                appendU32(&request.payload, static_cast<std::uint32_t>(job.crop.right - job.crop.left + 1));
+                appendU32(&request.payload, static_cast<std::uint32_t>(job.crop.bottom - job.crop.top + 1));
+                appendU32(&request.payload, static_cast<std::uint32_t>(job.sizes.size()));
+                for (const ImageSize& size : job.sizes) {
+                    appendU32(&request.payload, outputFormat);
+                    appendU32(&request.payload, 1);
+                    appendPipelineResize(&request.payload, size.width, size.height, APE_LUMORPHA_FILTER_LANCZOS3);
+                }
+            }
+            requests.append(request);
+        }
+
+        const ToolRuntimeContext::PluginBatchResponse batch =
+            ToolRuntimeContext::instance().invokePluginBatch(QStringLiteral("Lumorpha"), requests);
+        if (!batch.success) {
+            m_lastError = batch.errorMessage.trimmed().isEmpty()
+                ? QStringLiteral("Lumorpha pipeline failed.")
+                : batch.errorMessage.trimmed();
+            return results;
+        }
+
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const ToolRuntimeContext::PluginInvokeResponse& response = batch.items.at(static_cast<qsizetype>(i));
+            if (!response.success
+                || response.contentType != ToolRuntimeContext::PluginPayloadContentType::BinaryEnvelope
+                || !encodedFilesFromEnvelope(response.payload, &results[i])
+                || results[i].size() != jobs[i].sizes.size()) {
+                results[i].assign(jobs[i].sizes.size(), QByteArray());
+            }
+        }
+        m_lastError.clear();
+        return results;
     }
 
     QString lastError() const {
@@ -613,6 +738,20 @@ public:
         return std::vector<std::uint8_t>(begin, begin + encoded.size());
     }
 
+    std::vector<std::vector<std::vector<std::uint8_t>>> cropResizeEncodeTga32Images(
+        const std::vector<CropResizeJob>& jobs) const override {
+        const std::vector<std::vector<QByteArray>> encoded = m_client.cropResizeEncodeImages(jobs, APE_LUMORPHA_FORMAT_TGA);
+        std::vector<std::vector<std::vector<std::uint8_t>>> results(encoded.size());
+        for (std::size_t i = 0; i < encoded.size(); ++i) {
+            results[i].reserve(encoded[i].size());
+            for (const QByteArray& bytes : encoded[i]) {
+                const auto* begin = reinterpret_cast<const std::uint8_t*>(bytes.constData());
+                results[i].emplace_back(begin, begin + bytes.size());
+            }
+        }
+        return results;
+    }
+
 private:
     mutable LumorphaClient m_client;
 };
@@ -657,150 +796,10 @@ QString pngBase64FromFlagImage(const FlagImage& image, const QSize& targetSize =
     }
 
     LumorphaClient client;
-    FlagImage renderImage = image;
-    if (targetSize.isValid()) {
-        FlagImage resized;
-        if (client.resizeImage(image, targetSize, &resized) && FlagManager::isValidImage(resized)) {
-            renderImage = std::move(resized);
-        }
-    }
-
-    const QByteArray png = client.encodeImage(renderImage, APE_LUMORPHA_FORMAT_PNG);
+    const QByteArray png = client.resizeEncodeImage(image, targetSize, APE_LUMORPHA_FORMAT_PNG);
     return png.isEmpty() ? QString() : QString::fromLatin1(png.toBase64());
 }
 
-QImage tgaImageFromData(const QByteArray& data) {
-    if (data.size() < 18) {
-        return {};
-    }
-
-    const auto* bytes = reinterpret_cast<const uchar*>(data.constData());
-    const int idLength = bytes[0];
-    const int colorMapType = bytes[1];
-    const int imageType = bytes[2];
-    const int width = bytes[12] | (bytes[13] << 8);
-    const int height = bytes[14] | (bytes[15] << 8);
-    const int bpp = bytes[16];
-    const int descriptor = bytes[17];
-
-    if (colorMapType != 0 || (imageType != 2 && imageType != 10)) {
-        return QImage::fromData(data);
-    }
-    if ((bpp != 24 && bpp != 32) || width <= 0 || height <= 0) {
-        return {};
-    }
-
-    const int bytesPerPixel = bpp / 8;
-    const int pixelDataOffset = 18 + idLength;
-    if (pixelDataOffset < 0 || pixelDataOffset >= data.size()) {
-        return {};
-    }
-    if (height > 0 && width > std::numeric_limits<int>::max() / height) {
-        return {};
-    }
-
-    QImage image(width, height, QImage::Format_RGBA8888);
-    if (image.isNull()) {
-        return {};
-    }
-    image.fill(0);
-
-    const uchar* pixelData = bytes + pixelDataOffset;
-    const int pixelCount = width * height;
-    const int maxDataSize = data.size() - pixelDataOffset;
-
-    auto writePixel = [&](int currentPixel, uchar blue, uchar green, uchar red, uchar alpha) {
-        const int x = currentPixel % width;
-        const int sourceY = currentPixel / width;
-        const int destY = (descriptor & 0x20) ? sourceY : (height - 1 - sourceY);
-        uchar* line = image.scanLine(destY);
-        const int offset = x * 4;
-        line[offset] = red;
-        line[offset + 1] = green;
-        line[offset + 2] = blue;
-        line[offset + 3] = alpha;
-    };
-
-    if (imageType == 2) {
-        for (int currentPixel = 0; currentPixel < pixelCount; ++currentPixel) {
-            const int srcIndex = currentPixel * bytesPerPixel;
-            if (srcIndex + bytesPerPixel > maxDataSize) {
-                break;
-            }
-            writePixel(
-                currentPixel,
-                pixelData[srcIndex],
-                pixelData[srcIndex + 1],
-                pixelData[srcIndex + 2],
-                bytesPerPixel == 4 ? pixelData[srcIndex + 3] : 255
-            );
-        }
-        return image;
-    }
-
-    int currentPixel = 0;
-    int dataIndex = 0;
-    while (currentPixel < pixelCount && dataIndex < maxDataSize) {
-        const uchar header = pixelData[dataIndex++];
-        const int count = (header & 0x7F) + 1;
-
-        if ((header & 0x80) != 0) {
-            if (dataIndex + bytesPerPixel > maxDataSize) {
-                break;
-            }
-            const uchar blue = pixelData[dataIndex];
-            const uchar green = pixelData[dataIndex + 1];
-            const uchar red = pixelData[dataIndex + 2];
-            const uchar alpha = bytesPerPixel == 4 ? pixelData[dataIndex + 3] : 255;
-            dataIndex += bytesPerPixel;
-            for (int i = 0; i < count && currentPixel < pixelCount; ++i, ++currentPixel) {
-                writePixel(currentPixel, blue, green, red, alpha);
-            }
-        } else {
-            for (int i = 0; i < count && currentPixel < pixelCount; ++i, ++currentPixel) {
-                if (dataIndex + bytesPerPixel > maxDataSize) {
-                    break;
-                }
-                writePixel(
-                    currentPixel,
-                    pixelData[dataIndex],
-                    pixelData[dataIndex + 1],
-                    pixelData[dataIndex + 2],
-                    bytesPerPixel == 4 ? pixelData[dataIndex + 3] : 255
-                );
-                dataIndex += bytesPerPixel;
-            }
-        }
-    }
-
-    return image;
-}
-
-QString pngBase64FromTgaBytes(const QByteArray& data, const QSize& targetSize = QSize()) {
-    QImage image = tgaImageFromData(data);
-    if (image.isNull()) {
-        image = QImage::fromData(data, "TGA");
-    }
-    if (image.isNull()) {
-        return {};
-    }
-
-    if (targetSize.isValid() && image.size() != targetSize) {
-        image = image.scaled(targetSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-        if (image.isNull()) {
-            return {};
-        }
-    }
-
-    QByteArray png;
-    QBuffer buffer(&png);
-    if (!buffer.open(QIODevice::WriteOnly) || !image.save(&buffer, "PNG")) {
-        return {};
-    }
-
-    return QString::fromLatin1(png.toBase64());
-}
-
 QString importThumbnailCacheKey(const ImportItem& item) {
     return QStringLiteral("%1|%2x%3")
         .arg(fromStdString(item.id))
@@ -868,107 +867,6 @@ void releaseRetiredImports(WorkerSession* session) {
     retiredImports.clear();
 }
 
-QString previewCacheKey(const std::string& relativePath, const QSize& targetSize) {
-    const QString sizeKey = targetSize.isValid()
-        ? QStringLiteral("%1x%2").arg(targetSize.width()).arg(targetSize.height())
-        : QStringLiteral("native");
-    return QStringLiteral("%1|%2").arg(fromStdString(relativePath), sizeKey);
-}
-
-QString effectivePngBase64(WorkerSession* session,
-                           const std::string& relativePath,
-                           const QSize& targetSize = QSize()) {
-    if (!session || !session->fileSystem || relativePath.empty()) {
-        return {};
-    }
-
-    const bool cacheable = targetSize == QSize(kSmallFlagIconWidth, kSmallFlagIconHeight);
-    const QString cacheKey = previewCacheKey(relativePath, targetSize);
-    if (cacheable) {
-        const auto cached = session->previewBase64Cache.constFind(cacheKey);
-        if (cached != session->previewBase64Cache.constEnd()) {
-            return cached.value();
-        }
-    }
-
-    const FileReadResult readResult = session->fileSystem->readEffectiveFile(relativePath);
-    if (!readResult.success) {
-        return {};
-    }
-
-    QByteArray content(reinterpret_cast<const char*>(readResult.content.data()), static_cast<int>(readResult.content.size()));
-    auto cachePreview = [&](const QString& base64, const QSize& renderedSize) {
-        if (base64.isEmpty()) {
-            return base64;
-        }
-        if (cacheable) {
-            if (session->previewBase64Cache.size() >= kPreviewCacheEntryLimit) {
-                session->previewBase64Cache.clear();
-                session->previewSizeCache.clear();
-            }
-            session->previewBase64Cache.insert(cacheKey, base64);
-            session->previewSizeCache.insert(cacheKey, renderedSize);
-        }
-        return base64;
-    };
-    auto fallbackPreview = [&]() {
-        return cachePreview(
-            pngBase64FromTgaBytes(content, targetSize),
-            targetSize.isValid() ? targetSize : QSize()
-        );
-    };
-
-    LumorphaClient client;
-    FlagImage image;
-    if (!client.decodeImage(content, APE_LUMORPHA_FORMAT_TGA, &image)) {
-        return fallbackPreview();
-    }
-    if (!FlagManager::isValidImage(image)) {
-        return fallbackPreview();
-    }
-
-    const QSize sourceSize(image.width, image.height);
-    FlagImage renderImage = image;
-    if (targetSize.isValid()) {
-        FlagImage resized;
-        if (client.resizeImage(image, targetSize, &resized) && FlagManager::isValidImage(resized)) {
-            renderImage = std::move(resized);
-        }
-    }
-
-    const QByteArray png = client.encodeImage(renderImage, APE_LUMORPHA_FORMAT_PNG);
-    if (png.isEmpty()) {
-        return fallbackPreview();
-    }
-    const QString base64 = QString::fromLatin1(png.toBase64());
-    return cachePreview(base64, targetSize.isValid() ? QSize(renderImage.width, renderImage.height) : sourceSize);
-}
-
-QSize effectivePngSize(WorkerSession* session,
-                       const std::string& relativePath,
-                       const QSize& targetSize = QSize()) {
-    if (!session || relativePath.empty()) {
-        return {};
-    }
-
-    if (targetSize.isValid()) {
-        const QString cacheKey = previewCacheKey(relativePath, targetSize);
-        const auto loaded = session->previewSizeCache.constFind(cacheKey);
-        if (loaded != session->previewSizeCache.constEnd()) {
-            return loaded.value();
-        }
-
-        if (!effectivePngBase64(session, relativePath, targetSize).isEmpty()) {
-            const auto refreshed = session->previewSizeCache.constFind(cacheKey);
-            if (refreshed != session->previewSizeCache.constEnd()) {
-                return refreshed.value();
-            }
-        }
-    }
-
-    return {};
-}
-
 class ToolRuntimeFileSystem final : public IFileSystem {
 public:
     EffectiveFileListResult listEffectiveFiles() const override {
@@ -1016,15 +914,26 @@ public:
         return {runtimeResult.success, toStdString(runtimeResult.errorMessage)};
     }
 
-    FileWriteResult writeModFile(const std::string& logicalPath, const std::vector<std::uint8_t>& content) const override {
-        const QByteArray bytes(reinterpret_cast<const char*>(content.data()), static_cast<int>(content.size()));
-        const ToolRuntimeContext::FileWriteResult runtimeResult =
-            ToolRuntimeContext::instance().writeFile(
-                ToolRuntimeContext::FileRoot::Mod,
-                fromStdString(logicalPath),
-                bytes
-            );
-        return {runtimeResult.success, toStdString(runtimeResult.errorMessage)};
+    FileBatchWriteResult writeModFiles(const std::vector<FileWriteItem>& files) const override {
+        QList<ToolRuntimeContext::FileWriteItem> runtimeFiles;
+        runtimeFiles.reserve(static_cast<qsizetype>(files.size()));
+        for (const FileWriteItem& file : files) {
+            runtimeFiles.append({
+                fromStdString(file.logicalPath),
+                QByteArray(reinterpret_cast<const char*>(file.content.data()), static_cast<int>(file.content.size()))
+            });
+        }
+
+        const ToolRuntimeContext::FileBatchWriteResult runtimeResult =
+            ToolRuntimeContext::instance().writeFiles(ToolRuntimeContext::FileRoot::Mod, runtimeFiles);
+        FileBatchWriteResult result;
+        result.success = runtimeResult.success;
+        result.errorMessage = toStdString(runtimeResult.errorMessage);
+        result.files.reserve(static_cast<std::size_t>(runtimeResult.items.size()));
+        for (const ToolRuntimeContext::FileWriteResult& item : runtimeResult.items) {
+            result.files.push_back({item.success, toStdString(item.errorMessage)});
+        }
+        return result;
     }
 
 private:
@@ -1080,7 +989,8 @@ QJsonObject buildButton(const QString& actionId,
 QJsonArray buildTopbarButtons(const QJsonObject& first,
                               const QJsonObject& second = QJsonObject(),
                               const QJsonObject& third = QJsonObject(),
-                              const QJsonObject& fourth = QJsonObject()) {
+                              const QJsonObject& fourth = QJsonObject(),
+                              const QJsonObject& fifth = QJsonObject()) {
     QJsonArray array;
     if (!first.isEmpty()) {
         array.append(first);
@@ -1094,6 +1004,9 @@ QJsonArray buildTopbarButtons(const QJsonObject& first,
     if (!fourth.isEmpty()) {
         array.append(fourth);
     }
+    if (!fifth.isEmpty()) {
+        array.append(fifth);
+    }
     return array;
 }
 
@@ -1289,12 +1202,8 @@ QJsonArray buildFlagCards(WorkerSession* session, const Snapshot& state) {
         card[QStringLiteral("hasMedium")] = variant.hasMedium;
         card[QStringLiteral("hasSmall")] = variant.hasSmall;
         card[QStringLiteral("missing")] = variant.previewPath.empty();
-        if (!variant.previewPath.empty()) {
-            const QString imageBase64 = effectivePngBase64(session, variant.previewPath);
-            if (!imageBase64.isEmpty()) {
-                card[QStringLiteral("imageBase64")] = imageBase64;
-            }
-        }
+        // The host decodes and caches the preview when the card is shown
+        card[QStringLiteral("imagePath")] = fromStdString(variant.previewPath);
         cards.append(card);
     }
     return cards;
@@ -1328,8 +1237,14 @@ QJsonObject buildViewState(WorkerSession* session, const Snapshot& state) {
     object[QStringLiteral("canExportAll")] = state.canExportAll;
     object[QStringLiteral("hasSelection")] = state.hasSelection;
     object[QStringLiteral("pendingOverwrite")] = state.pendingOverwrite;
-    object[QStringLiteral("loadingActive")] = false;
-    object[QStringLiteral("loadingText")] = QString();
+    object[QStringLiteral("exportActive")] = state.exportActive;
+    object[QStringLiteral("compressTga")] = state.compressTgaExports;
+    object[QStringLiteral("loadingActive")] = state.exportActive;
+    object[QStringLiteral("loadingText")] = state.exportActive
+        ? localizedString(session, QStringLiteral("Exporting"))
+              .arg(static_cast<qulonglong>(state.exportCompleted))
+              .arg(static_cast<qulonglong>(state.exportTotal))
+        : QString();
     object[QStringLiteral("statusText")] = state.statusText.empty()
         ? localizedString(session, QStringLiteral("Ready"))
         : fromStdString(state.statusText);
@@ -1358,6 +1273,14 @@ QJsonObject buildViewState(WorkerSession* session, const Snapshot& state) {
         }
         object[QStringLiteral("currentImport")] = QJsonObject();
     }
+
+    QJsonObject listWindows;
+    listWindows[QStringLiteral("tag_list")] = ToolListWindow::describe(
+        static_cast<int>(state.tagsFirst),
+        static_cast<int>(state.tags.size()),
+        static_cast<int>(state.tagsTotal)
+    );
+    object[QStringLiteral("listWindows")] = listWindows;
     return object;
 }
 
@@ -1403,11 +1326,16 @@ QJsonObject buildTopbarState(WorkerSession* session, const Snapshot& state) {
         buildButton(QStringLiteral("set_mode_new"), localizedString(session, QStringLiteral("TabNew")), createMode, true, 92)
     );
 
-    if (createMode) {
+    if (createMode && state.exportActive) {
+        topbar[QStringLiteral("rightButtons")] = buildTopbarButtons(
+            buildButton(QStringLiteral("cancel_export"), localizedString(session, QStringLiteral("CancelExport")), false, true, 104, QStringLiteral("Escape"))
+        );
+    } else if (createMode) {
         topbar[QStringLiteral("rightButtons")] = buildTopbarButtons(
             buildButton(QStringLiteral("import_files"), localizedString(session, QStringLiteral("ImportFiles")), false, true, 104, QStringLiteral("Ctrl+O")),
             buildButton(QStringLiteral("export_current"), localizedString(session, QStringLiteral("Export")), false, state.canExportCurrent, 118, QStringLiteral("Ctrl+S")),
             buildButton(QStringLiteral("export_all"), localizedString(session, QStringLiteral("ExportAll")), false, state.canExportAll, 104, QStringLiteral("Ctrl+Shift+S")),
+            buildButton(QStringLiteral("set_tga_rle"), localizedString(session, QStringLiteral("CompressTga")), state.compressTgaExports, true, 96),
             buildButton(
                 state.selectedImportIds.size() == state.imports.size() && !state.imports.empty()
                     ? QStringLiteral("deselect_all")
@@ -1595,7 +1523,15 @@ QJsonObject buildStatePacket(WorkerSession* session) {
         return packet;
     }
 
-    const Snapshot state = session->core.buildSnapshot();
+    // The tag list is shown by the host sidebar, which does not report a viewport; it stays
+    // complete until one is reported.
+    RowWindow tagWindow;
+    const ToolListWindow::Range tagRange = session->viewports.requested(QStringLiteral("tag_list"), -1);
+    tagWindow.first = static_cast<std::size_t>(tagRange.first);
+    if (tagRange.count >= 0) {
+        tagWindow.count = static_cast<std::size_t>(tagRange.count);
+    }
+    const Snapshot state = session->core.buildSnapshot(tagWindow);
     const QJsonArray listModels = buildListModels(session, state);
 
     packet[QStringLiteral("modeId")] = state.mode == ToolMode::New ? QStringLiteral("new") : QStringLiteral("manage");
@@ -1610,12 +1546,12 @@ QJsonObject buildStatePacket(WorkerSession* session) {
     return packet;
 }
 
-char* serializeStatePacket(WorkerSession* session) {
-    const QByteArray stateJson = QJsonDocument(buildStatePacket(session)).toJson(QJsonDocument::Compact);
-    if (session) {
-        session->lastSerializedState = stateJson.toStdString();
+char* serializeStatePacket(WorkerSession* session, bool allowDelta) {
+    const QJsonObject packet = buildStatePacket(session);
+    if (!session) {
+        return allocateCString(QJsonDocument(packet).toJson(QJsonDocument::Compact));
     }
-    return allocateCString(stateJson);
+    return allocateCString(session->stateEncoder.encode(packet, allowDelta));
 }
 
 ToolWorkerResult initializeSession(WorkerSession* session, const char* configJson) {
@@ -1642,12 +1578,11 @@ ToolWorkerResult initializeSession(WorkerSession* session, const char* configJso
     session->core.setFileSystem(session->fileSystem.get());
     session->core.setImagePipeline(session->imagePipeline.get());
     session->coreInitialized = false;
-    session->previewBase64Cache.clear();
-    session->previewSizeCache.clear();
     clearImportPreviewCaches(session);
     session->managePreviewWarmupLimit = 0;
     session->lastError.clear();
-    session->lastSerializedState.clear();
+    session->stateEncoder.reset();
+    session->viewports.reset();
 
     clearSessionError(session);
     return TOOL_WORKER_SUCCESS;
@@ -1677,14 +1612,25 @@ ToolWorkerResult applyActionInternal(WorkerSession* session,
         return TOOL_WORKER_SUCCESS;
     }
 
+    if (action == QLatin1String(ToolListWindow::viewportActionName())) {
+        QString listId = arguments.value(QStringLiteral("listId")).toString().trimmed();
+        if (listId.isEmpty() && targetId) {
+            listId = QString::fromUtf8(targetId).trimmed();
+        }
+        if (!session->viewports.update(listId, arguments)) {
+            setSessionError(session, QStringLiteral("Invalid viewport for list '%1'.").arg(listId));
+            return TOOL_WORKER_ERROR_INVALID_ARGUMENT;
+        }
+        clearSessionError(session);
+        return TOOL_WORKER_SUCCESS;
+    }
+
     if (!ensureCoreInitialized(session)) {
         return TOOL_WORKER_ERROR_INITIALIZATION_FAILED;
     }
 
     if (action == QStringLiteral("refresh") || action == QStringLiteral("refresh_flags")) {
         session->core.setKnownTags(loadTagsFromPluginRuntime());
-        session->previewBase64Cache.clear();
-        session->previewSizeCache.clear();
         if (session->core.buildSnapshot().mode != ToolMode::New) {
             clearImportPreviewCaches(session);
         }
@@ -1754,8 +1700,6 @@ ToolWorkerResult applyActionInternal(WorkerSession* session,
             setSessionError(session, fromStdString(result.errorMessage));
             return TOOL_WORKER_ERROR_ACTION_FAILED;
         }
-        session->previewBase64Cache.clear();
-        session->previewSizeCache.clear();
         clearImportPreviewCaches(session);
         session->managePreviewWarmupLimit = 0;
         clearSessionError(session);
@@ -1776,8 +1720,6 @@ ToolWorkerResult applyActionInternal(WorkerSession* session,
             setSessionError(session, fromStdString(result.errorMessage));
             return TOOL_WORKER_ERROR_ACTION_FAILED;
         }
-        session->previewBase64Cache.clear();
-        session->previewSizeCache.clear();
         clearImportPreviewCaches(session);
         session->managePreviewWarmupLimit = 0;
         clearSessionError(session);
@@ -1788,8 +1730,6 @@ ToolWorkerResult applyActionInternal(WorkerSession* session,
         if (!session->core.confirmPendingOverwrite()) {
             return applyCoreResult(session, false);
         }
-        session->previewBase64Cache.clear();
-        session->previewSizeCache.clear();
         clearImportPreviewCaches(session);
         session->managePreviewWarmupLimit = 0;
         clearSessionError(session);
@@ -1827,12 +1767,12 @@ ToolWorkerResult applyActionInternal(WorkerSession* session,
     if (result == TOOL_WORKER_SUCCESS
         && (action == QStringLiteral("remove_import")
             || action == QStringLiteral("remove_selected")
-            || action == QStringLiteral("remove_from_list"))) {
+            || action == QStringLiteral("remove_from_list")
+            || action == QStringLiteral("continue_export")
+            || action == QStringLiteral("cancel_export"))) {
         clearImportPreviewCaches(session);
     }
     if (previousMode != currentMode) {
-        session->previewBase64Cache.clear();
-        session->previewSizeCache.clear();
         if (currentMode != ToolMode::New) {
             clearImportPreviewCaches(session);
         }
@@ -1866,7 +1806,7 @@ const char* handleWorkerAction(ToolWorkerHandle handle,
         if (outResult) {
             *outResult = TOOL_WORKER_ERROR_ACTION_FAILED;
         }
-        return serializeStatePacket(session);
+        return serializeStatePacket(session, true);
     }
 
     session->actionInProgress = true;
@@ -1875,7 +1815,7 @@ const char* handleWorkerAction(ToolWorkerHandle handle,
     if (outResult) {
         *outResult = result;
     }
-    char* state = serializeStatePacket(session);
+    char* state = serializeStatePacket(session, true);
     releaseRetiredImports(session);
     return state;
 }
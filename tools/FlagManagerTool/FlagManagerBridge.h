@@ -9,13 +9,14 @@
 #ifndef FLAGMANAGERBRIDGE_H
 #define FLAGMANAGERBRIDGE_H
 
+#include "../../src/ToolListWindow.h"
+#include "../../src/ToolStatePatch.h"
 #include "../../src/ToolWorkerInterface.h"
 #include "main/FlagFileSystem.h"
 #include "main/FlagManagerCore.h"
 
 #include <QMap>
 #include <QJsonObject>
-#include <QSize>
 #include <QString>
 
 #include <memory>
@@ -30,8 +31,6 @@ struct WorkerSession {
     QString toolDirectoryPath;
     QString currentLanguageCode;
     QMap<QString, QString> localizedStrings;
-    QMap<QString, QString> previewBase64Cache;
-    QMap<QString, QSize> previewSizeCache;
     QMap<QString, QString> importThumbnailBase64Cache;
     QString currentImportPreviewId;
     QString currentImportPreviewBase64;
@@ -39,7 +38,8 @@ struct WorkerSession {
     bool coreInitialized = false;
     bool actionInProgress = false;
     std::string lastError;
-    std::string lastSerializedState;
+    ToolStatePatch::StateEncoder stateEncoder;
+    ToolListWindow::ViewportSet viewports;
 };
 
 extern std::unique_ptr<WorkerSession> g_legacySession;
@@ -51,7 +51,8 @@ void destroyWorkerHandle(ToolWorkerHandle handle);
 WorkerSession* sessionFromHandle(ToolWorkerHandle handle);
 
 QJsonObject buildStatePacket(WorkerSession* session);
-char* serializeStatePacket(WorkerSession* session);
+// Action responses may be deltas; state queries always return a full snapshot.
+char* serializeStatePacket(WorkerSession* session, bool allowDelta = false);
 QJsonObject parseJsonObject(const char* jsonText);
 ToolWorkerResult initializeSession(WorkerSession* session, const char* configJson);
 ToolWorkerResult applyActionInternal(WorkerSession* session,
@@ -31,6 +31,8 @@ Rectangle {
     property bool nameDirty: false
     property bool cropDirty: false
     property bool loadingActive: true
+    property bool exportActive: false
+    property bool compressTga: false
     property string loadingText: ""
 
     readonly property var colors: toolTheme.colors
@@ -49,11 +51,6 @@ Rectangle {
         return toolBridge.text(key, fallback)
     }
 
-    function dataSource(base64) {
-        const value = safeString(base64)
-        return value.length ? toolBridge.imageSource(value) : ""
-    }
-
     function loadingDisplayText() {
         var text = safeString(loadingText)
         if (!text.length || text === "Starting worker process...") {
@@ -102,6 +99,8 @@ Rectangle {
         statusText = safeString(toolBridge.value("statusText", ""))
         loadingActive = !!toolBridge.value("loadingActive", false)
         loadingText = safeString(toolBridge.value("loadingText", trText("LoadingFlags", "Loading flags...")))
+        exportActive = !!toolBridge.value("exportActive", false)
+        compressTga = !!toolBridge.value("compressTga", false)
 
         refreshingFields = true
         flagName = safeString(currentImport && currentImport.name !== undefined ? currentImport.name : "")
@@ -119,6 +118,10 @@ Rectangle {
         if (pendingOverwrite && !overwriteDialog.opened) {
             overwriteDialog.open()
         }
+
+        if (exportActive) {
+            continueExportTimer.restart()
+        }
     }
 
     function imageWidth() {
@@ -328,6 +331,10 @@ Rectangle {
             cropDirty = false
             return
         }
+        if (actionId === "set_tga_rle") {
+            dispatchAction(actionId, "", { "enabled": !compressTga })
+            return
+        }
         if (actionId === "set_mode_manage" || actionId === "set_mode_new") {
             if (!isCropValid() && selectedImportId.length) {
                 invalidCropField = "crop"
@@ -354,6 +361,17 @@ Rectangle {
 
     Component.onCompleted: refreshState()
 
+    Timer {
+        id: continueExportTimer
+        interval: 1  // Let the progress render before the worker exports the next batch
+        repeat: false
+        onTriggered: {
+            if (root.exportActive) {
+                root.dispatchAction("continue_export", "", {})
+            }
+        }
+    }
+
     FileDialog {
         id: importDialog
         title: root.trText("ImportFiles", "Import Files")
@@ -413,7 +431,8 @@ Rectangle {
                     ? [
                         { "actionId": "import_files", "text": root.trText("ImportFiles", "Import Files"), "shortcut": "Ctrl+O", "width": 106 },
                         { "actionId": "export_current", "text": root.trText("Export", "Export Current"), "shortcut": "Ctrl+S", "enabled": root.canExportCurrent(), "width": 118 },
-                        { "actionId": "export_all", "text": root.trText("ExportAll", "Export All"), "shortcut": "Ctrl+Shift+S", "enabled": root.canExportAll(), "width": 100 }
+                        { "actionId": "export_all", "text": root.trText("ExportAll", "Export All"), "shortcut": "Ctrl+Shift+S", "enabled": root.canExportAll(), "width": 100 },
+                        { "actionId": "set_tga_rle", "text": root.trText("CompressTga", "RLE TGA"), "checked": root.compressTga, "variant": "toolbar", "width": 96 }
                     ]
                     : [
                         { "actionId": "set_size_0", "text": root.trText("SizeLarge", "Large"), "shortcut": "L", "checked": root.sizeIndex === 0, "width": 82 },
@@ -451,76 +470,75 @@ Rectangle {
                 visible: root.mode !== "new"
                 clip: true
 
-                GridLayout {
-                    width: Math.max(parent.width, 1)
-                    columns: Math.max(1, Math.floor(width / 180))
-                    rowSpacing: 20
-                    columnSpacing: 20
-
-                    Repeater {
-                        model: root.flagCards
-
-                        delegate: Item {
-                            Layout.preferredWidth: 160
-                            Layout.preferredHeight: 116
-                            property string cardImageSource: root.dataSource(modelData.imageBase64)
-                            property int expectedFlagWidth: root.sizeIndex === 2 ? 10 : (root.sizeIndex === 1 ? 41 : 82)
-                            property int expectedFlagHeight: root.sizeIndex === 2 ? 7 : (root.sizeIndex === 1 ? 26 : 52)
+                // Delegates, and with them the provider requests for their previews, only exist
+                // for the rows in view.
+                GridView {
+                    model: root.flagCards
+                    cellWidth: 180
+                    cellHeight: 136
+
+                    delegate: Item {
+                        width: 160
+                        height: 116
+                        property string cardImageSource: modelData.missing
+                            ? ""
+                            : toolBridge.effectiveImageSource(root.safeString(modelData.imagePath))
+                        property int expectedFlagWidth: root.sizeIndex === 2 ? 10 : (root.sizeIndex === 1 ? 41 : 82)
+                        property int expectedFlagHeight: root.sizeIndex === 2 ? 7 : (root.sizeIndex === 1 ? 26 : 52)
+
+                        Column {
+                            anchors.centerIn: parent
+                            width: parent.width
+                            spacing: 6
 
-                            Column {
-                                anchors.centerIn: parent
-                                width: parent.width
-                                spacing: 6
-
-                                Rectangle {
-                                    anchors.horizontalCenter: parent.horizontalCenter
-                                    width: flagImage.visible && flagImage.implicitWidth > 0
-                                        ? flagImage.implicitWidth + 2
-                                        : Math.max(expectedFlagWidth, missingText.implicitWidth) + 8
-                                    height: flagImage.visible && flagImage.implicitHeight > 0
-                                        ? flagImage.implicitHeight + 2
-                                        : Math.max(expectedFlagHeight, missingText.implicitHeight) + 8
-                                    color: flagImage.visible ? "transparent" : colors.surfaceAlt
-                                    border.color: colors.border
-                                    border.width: 1
-
-                                    Image {
-                                        id: flagImage
-                                        anchors.centerIn: parent
-                                        width: implicitWidth
-                                        height: implicitHeight
-                                        fillMode: Image.PreserveAspectFit
-                                        source: cardImageSource
-                                        visible: cardImageSource.length > 0
-                                        cache: false
-                                        asynchronous: false
-                                        smooth: false
-                                    }
+                            Rectangle {
+                                anchors.horizontalCenter: parent.horizontalCenter
+                                width: flagImage.visible && flagImage.implicitWidth > 0
+                                    ? flagImage.implicitWidth + 2
+                                    : Math.max(expectedFlagWidth, missingText.implicitWidth) + 8
+                                height: flagImage.visible && flagImage.implicitHeight > 0
+                                    ? flagImage.implicitHeight + 2
+                                    : Math.max(expectedFlagHeight, missingText.implicitHeight) + 8
+                                color: flagImage.visible ? "transparent" : colors.surfaceAlt
+                                border.color: colors.border
+                                border.width: 1
 
-                                    Text {
-                                        id: missingText
-                                        anchors.centerIn: parent
-                                        visible: !modelData.imageBase64 || !String(modelData.imageBase64).length
-                                        text: root.trText("Missing", "MISSING")
-                                        color: colors.textMuted
-                                        font.family: fonts.small.family
-                                        font.pixelSize: root.sizeIndex === 2 ? 8 : Number(fonts.small.pixelSize)
-                                        font.weight: Font.DemiBold
-                                    }
+                                Image {
+                                    id: flagImage
+                                    anchors.centerIn: parent
+                                    width: implicitWidth
+                                    height: implicitHeight
+                                    fillMode: Image.PreserveAspectFit
+                                    source: cardImageSource
+                                    visible: cardImageSource.length > 0 && status !== Image.Error
+                                    cache: false
+                                    asynchronous: true
+                                    smooth: false
                                 }
 
                                 Text {
-                                    width: parent.width
-                                    text: root.safeString(modelData.name)
-                                    color: colors.textPrimary
-                                    horizontalAlignment: Text.AlignHCenter
-                                    wrapMode: Text.Wrap
-                                    maximumLineCount: 2
-                                    elide: Text.ElideRight
-                                    font.family: fonts.body.family
-                                    font.pixelSize: Number(fonts.body.pixelSize)
+                                    id: missingText
+                                    anchors.centerIn: parent
+                                    visible: !cardImageSource.length || flagImage.status === Image.Error
+                                    text: root.trText("Missing", "MISSING")
+                                    color: colors.textMuted
+                                    font.family: fonts.small.family
+                                    font.pixelSize: root.sizeIndex === 2 ? 8 : Number(fonts.small.pixelSize)
+                                    font.weight: Font.DemiBold
                                 }
                             }
+
+                            Text {
+                                width: parent.width
+                                text: root.safeString(modelData.name)
+                                color: colors.textPrimary
+                                horizontalAlignment: Text.AlignHCenter
+                                wrapMode: Text.Wrap
+                                maximumLineCount: 2
+                                elide: Text.ElideRight
+                                font.family: fonts.body.family
+                                font.pixelSize: Number(fonts.body.pixelSize)
+                            }
                         }
                     }
                 }
@@ -39,6 +39,17 @@ struct FileWriteResult {
     std::string errorMessage;
 };
 
+struct FileWriteItem {
+    std::string logicalPath;
+    std::vector<std::uint8_t> content;
+};
+
+struct FileBatchWriteResult {
+    bool success = false;
+    std::vector<FileWriteResult> files;  // In request order
+    std::string errorMessage;
+};
+
 class IFileSystem {
 public:
     virtual ~IFileSystem() = default;
@@ -47,7 +58,7 @@ public:
     virtual FileReadResult readEffectiveFile(const std::string& logicalPath) const = 0;
     virtual FileReadResult readModFile(const std::string& logicalPath) const = 0;
     virtual FileWriteResult ensureModDirectory(const std::string& logicalPath) const = 0;
-    virtual FileWriteResult writeModFile(const std::string& logicalPath, const std::vector<std::uint8_t>& content) const = 0;
+    virtual FileBatchWriteResult writeModFiles(const std::vector<FileWriteItem>& files) const = 0;
 };
 
 } // namespace FlagManager
@@ -8,9 +8,15 @@
 //-------------------------------------------------------------------------------------
 #include "FlagImage.h"
 
+#include "TgaCodec.h"
+
 #include <algorithm>
 #include <cmath>
 
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#error "FlagImage TGA I/O assumes little-endian pixel storage"
+#endif
+
 namespace FlagManager {
 
 namespace {
@@ -36,6 +42,101 @@ std::uint8_t blendChannel(std::uint8_t c00,
     return static_cast<std::uint8_t>(std::clamp(std::lround(value), 0L, 255L));
 }
 
+struct AreaTap {
+    int index = 0;
+    double weight = 0.0;
+};
+
+// Source pixels covered by each target pixel along one axis, weighted by overlap
+std::vector<std::vector<AreaTap>> areaTaps(int sourceSize, int targetSize) {
+    std::vector<std::vector<AreaTap>> taps(static_cast<std::size_t>(targetSize));
+    const double scale = static_cast<double>(sourceSize) / static_cast<double>(targetSize);
+    for (int target = 0; target < targetSize; ++target) {
+        const double begin = target * scale;
+        const double end = (target + 1) * scale;
+        for (int source = static_cast<int>(std::floor(begin)); source < sourceSize && source < end; ++source) {
+            const double overlap = std::min(end, source + 1.0) - std::max(begin, static_cast<double>(source));
+            if (overlap > 0.0) {
+                taps[static_cast<std::size_t>(target)].push_back({source, overlap / scale});
+            }
+        }
+    }
+    return taps;
+}
+
+// Box filter with fractional coverage; only meant for downscaling
+FlagImage areaResizeImage(const FlagImage& image, int targetWidth, int targetHeight) {
+    const std::vector<std::vector<AreaTap>> columns = areaTaps(image.width, targetWidth);
+    const std::vector<std::vector<AreaTap>> rows = areaTaps(image.height, targetHeight);
+
+    FlagImage result;
+    result.width = targetWidth;
+    result.height = targetHeight;
+    result.pixels.resize(static_cast<std::size_t>(targetWidth * targetHeight));
+
+    for (int y = 0; y < targetHeight; ++y) {
+        for (int x = 0; x < targetWidth; ++x) {
+            double red = 0.0;
+            double green = 0.0;
+            double blue = 0.0;
+            double alpha = 0.0;
+            for (const AreaTap& row : rows[static_cast<std::size_t>(y)]) {
+                const std::uint32_t* line = image.pixels.data() + static_cast<std::size_t>(row.index * image.width);
+                for (const AreaTap& column : columns[static_cast<std::size_t>(x)]) {
+                    const std::uint32_t pixel = line[column.index];
+                    const double weight = row.weight * column.weight;
+                    red += rgbaRed(pixel) * weight;
+                    green += rgbaGreen(pixel) * weight;
+                    blue += rgbaBlue(pixel) * weight;
+                    alpha += rgbaAlpha(pixel) * weight;
+                }
+            }
+            result.pixels[static_cast<std::size_t>(y * targetWidth + x)] = makeRgba(
+                static_cast<std::uint8_t>(std::clamp(std::lround(red), 0L, 255L)),
+                static_cast<std::uint8_t>(std::clamp(std::lround(green), 0L, 255L)),
+                static_cast<std::uint8_t>(std::clamp(std::lround(blue), 0L, 255L)),
+                static_cast<std::uint8_t>(std::clamp(std::lround(alpha), 0L, 255L))
+            );
+        }
+    }
+    return result;
+}
+
+// Averages 2x2 blocks; odd dimensions fall back to the fractional area filter
+FlagImage halveImage(const FlagImage& image) {
+    const int targetWidth = std::max(1, image.width / 2);
+    const int targetHeight = std::max(1, image.height / 2);
+    if (image.width != targetWidth * 2 || image.height != targetHeight * 2) {
+        return areaResizeImage(image, targetWidth, targetHeight);
+    }
+
+    FlagImage result;
+    result.width = targetWidth;
+    result.height = targetHeight;
+    result.pixels.resize(static_cast<std::size_t>(targetWidth * targetHeight));
+
+    for (int y = 0; y < targetHeight; ++y) {
+        const std::uint32_t* top = image.pixels.data() + static_cast<std::size_t>(y * 2 * image.width);
+        const std::uint32_t* bottom = top + image.width;
+        for (int x = 0; x < targetWidth; ++x) {
+            const std::uint32_t p00 = top[x * 2];
+            const std::uint32_t p10 = top[x * 2 + 1];
+            const std::uint32_t p01 = bottom[x * 2];
+            const std::uint32_t p11 = bottom[x * 2 + 1];
+            // Alternate channels are summed in 16-bit lanes, two channels per add
+            constexpr std::uint32_t kLaneMask = 0x00FF00FFu;
+            constexpr std::uint32_t kRounding = 0x00020002u;
+            const std::uint32_t even = (p00 & kLaneMask) + (p10 & kLaneMask) + (p01 & kLaneMask)
+                + (p11 & kLaneMask) + kRounding;
+            const std::uint32_t odd = ((p00 >> 8) & kLaneMask) + ((p10 >> 8) & kLaneMask)
+                + ((p01 >> 8) & kLaneMask) + ((p11 >> 8) & kLaneMask) + kRounding;
+            result.pixels[static_cast<std::size_t>(y * targetWidth + x)] =
+                ((even >> 2) & kLaneMask) | (((odd >> 2) & kLaneMask) << 8);
+        }
+    }
+    return result;
+}
+
 } // namespace
 
 bool isValidImage(const FlagImage& image) {
@@ -193,130 +294,82 @@ FlagImage resizeCropImage(const FlagImage& image, const Rect& crop, int targetWi
     return result;
 }
 
-FlagImage decodeTga(const std::vector<std::uint8_t>& data) {
-    if (data.size() < 18) {
-        return {};
-    }
-
-    const int idLength = data[0];
-    const int colorMapType = data[1];
-    const int imageType = data[2];
-    const int width = data[12] | (data[13] << 8);
-    const int height = data[14] | (data[15] << 8);
-    const int bpp = data[16];
-    const int descriptor = data[17];
-
-    if (colorMapType != 0 || (imageType != 2 && imageType != 10)) {
-        return {};
-    }
-    if ((bpp != 24 && bpp != 32) || width <= 0 || height <= 0) {
-        return {};
-    }
-
-    const int bytesPerPixel = bpp / 8;
-    const int pixelDataOffset = 18 + idLength;
-    if (pixelDataOffset < 0 || static_cast<std::size_t>(pixelDataOffset) >= data.size()) {
-        return {};
+std::vector<FlagImage> resizeCropImageSizes(const FlagImage& image, const Rect& crop, const std::vector<ImageSize>& sizes) {
+    std::vector<FlagImage> results(sizes.size());
+    std::vector<FlagImage> levels;
+    levels.push_back(cropImage(image, crop));
+    if (!isValidImage(levels.front())) {
+        return results;
     }
 
-    FlagImage image;
-    image.width = width;
-    image.height = height;
-    image.pixels.assign(static_cast<std::size_t>(width * height), makeRgba(0, 0, 0, 0));
-
-    const std::uint8_t* pixelData = data.data() + pixelDataOffset;
-    const int pixelCount = width * height;
-    const int maxDataSize = static_cast<int>(data.size()) - pixelDataOffset;
-
-    auto writePixel = [&](int currentPixel, std::uint8_t blue, std::uint8_t green, std::uint8_t red, std::uint8_t alpha) {
-        const int x = currentPixel % width;
-        const int sourceY = currentPixel / width;
-        const int destY = (descriptor & 0x20) ? sourceY : (height - 1 - sourceY);
-        image.pixels[static_cast<std::size_t>(destY * width + x)] = makeRgba(red, green, blue, alpha);
-    };
-
-    if (imageType == 2) {
-        for (int currentPixel = 0; currentPixel < pixelCount; ++currentPixel) {
-            const int srcIndex = currentPixel * bytesPerPixel;
-            if (srcIndex + bytesPerPixel > maxDataSize) {
-                break;
-            }
-
-            const std::uint8_t blue = pixelData[srcIndex];
-            const std::uint8_t green = pixelData[srcIndex + 1];
-            const std::uint8_t red = pixelData[srcIndex + 2];
-            const std::uint8_t alpha = bytesPerPixel == 4 ? pixelData[srcIndex + 3] : 255;
-            writePixel(currentPixel, blue, green, red, alpha);
+    for (std::size_t index = 0; index < sizes.size(); ++index) {
+        const ImageSize& size = sizes[index];
+        if (size.width <= 0 || size.height <= 0) {
+            continue;
+        }
+        if (size.width > levels.front().width || size.height > levels.front().height) {
+            // Upscaling gains nothing from the pyramid
+            results[index] = resizeImage(levels.front(), size.width, size.height);
+            continue;
         }
-        return image;
-    }
-
-    int currentPixel = 0;
-    int dataIndex = 0;
-    while (currentPixel < pixelCount && dataIndex < maxDataSize) {
-        const std::uint8_t header = pixelData[dataIndex++];
-        const int count = (header & 0x7F) + 1;
 
-        if (header & 0x80) {
-            if (dataIndex + bytesPerPixel > maxDataSize) {
+        // Levels are only built as deep as the smallest size needs
+        std::size_t level = 0;
+        while (true) {
+            if (level + 1 < levels.size()) {
+                if (levels[level + 1].width < size.width || levels[level + 1].height < size.height) {
+                    break;
+                }
+                ++level;
+                continue;
+            }
+            const FlagImage& last = levels.back();
+            if (last.width / 2 < size.width || last.height / 2 < size.height) {
                 break;
             }
+            levels.push_back(halveImage(last));
+            ++level;
+        }
 
-            const std::uint8_t blue = pixelData[dataIndex];
-            const std::uint8_t green = pixelData[dataIndex + 1];
-            const std::uint8_t red = pixelData[dataIndex + 2];
-            const std::uint8_t alpha = bytesPerPixel == 4 ? pixelData[dataIndex + 3] : 255;
-            dataIndex += bytesPerPixel;
+        const FlagImage& source = levels[level];
+        results[index] = source.width == size.width && source.height == size.height
+            ? source
+            : areaResizeImage(source, size.width, size.height);
+    }
 
-            for (int i = 0; i < count && currentPixel < pixelCount; ++i, ++currentPixel) {
-                writePixel(currentPixel, blue, green, red, alpha);
-            }
-        } else {
-            for (int i = 0; i < count && currentPixel < pixelCount; ++i, ++currentPixel) {
-                if (dataIndex + bytesPerPixel > maxDataSize) {
-                    break;
-                }
+    return results;
+}
 
-                const std::uint8_t blue = pixelData[dataIndex];
-                const std::uint8_t green = pixelData[dataIndex + 1];
-                const std::uint8_t red = pixelData[dataIndex + 2];
-                const std::uint8_t alpha = bytesPerPixel == 4 ? pixelData[dataIndex + 3] : 255;
-                dataIndex += bytesPerPixel;
-                writePixel(currentPixel, blue, green, red, alpha);
-            }
-        }
+FlagImage decodeTga(const std::vector<std::uint8_t>& data) {
+    TgaCodec::Header header;
+    if (!TgaCodec::readHeader(data.data(), data.size(), &header)) {
+        return {};
     }
 
+    FlagImage image;
+    image.width = header.width;
+    image.height = header.height;
+    image.pixels.resize(static_cast<std::size_t>(header.width) * static_cast<std::size_t>(header.height));
+    TgaCodec::decodePixels(data.data(),
+                           data.size(),
+                           header,
+                           TgaCodec::PixelOrder::Bgra,
+                           reinterpret_cast<std::uint8_t*>(image.pixels.data()),
+                           static_cast<std::size_t>(header.width) * 4);
     return image;
 }
 
-std::vector<std::uint8_t> encodeTga32(const FlagImage& image) {
+std::vector<std::uint8_t> encodeTga32(const FlagImage& image, bool rle) {
     if (!isValidImage(image)) {
         return {};
     }
 
-    std::vector<std::uint8_t> output;
-    output.resize(18 + static_cast<std::size_t>(image.width * image.height * 4));
-    output[2] = 2;
-    output[12] = static_cast<std::uint8_t>(image.width & 0xFF);
-    output[13] = static_cast<std::uint8_t>((image.width >> 8) & 0xFF);
-    output[14] = static_cast<std::uint8_t>(image.height & 0xFF);
-    output[15] = static_cast<std::uint8_t>((image.height >> 8) & 0xFF);
-    output[16] = 32;
-    output[17] = 0;
-
-    std::size_t offset = 18;
-    for (int y = image.height - 1; y >= 0; --y) {
-        for (int x = 0; x < image.width; ++x) {
-            const std::uint32_t pixel = image.pixels[static_cast<std::size_t>(y * image.width + x)];
-            output[offset++] = rgbaBlue(pixel);
-            output[offset++] = rgbaGreen(pixel);
-            output[offset++] = rgbaRed(pixel);
-            output[offset++] = rgbaAlpha(pixel);
-        }
-    }
-
-    return output;
+    return TgaCodec::encode32(reinterpret_cast<const std::uint8_t*>(image.pixels.data()),
+                              image.width,
+                              image.height,
+                              static_cast<std::size_t>(image.width) * 4,
+                              TgaCodec::PixelOrder::Bgra,
+                              rle);
 }
 
 } // namespace FlagManager
@@ -27,8 +27,15 @@ std::uint8_t rgbaAlpha(std::uint32_t pixel);
 FlagImage cropImage(const FlagImage& image, const Rect& crop);
 FlagImage resizeImage(const FlagImage& image, int targetWidth, int targetHeight);
 FlagImage resizeCropImage(const FlagImage& image, const Rect& crop, int targetWidth, int targetHeight);
+// Crops once and derives every size from a 2x2 area-averaged pyramid of the crop, so each
+// size is area-filtered from a level less than twice as large. Results are in size order; an
+// invalid size yields an empty image.
+std::vector<FlagImage> resizeCropImageSizes(const FlagImage& image, const Rect& crop, const std::vector<ImageSize>& sizes);
+// 0xAARRGGBB pixels sit in memory as B, G, R, A on little-endian targets, which is the byte
+// order of a 32 bpp TGA, so both directions hand the pixel buffer straight to TgaCodec.
 FlagImage decodeTga(const std::vector<std::uint8_t>& data);
-std::vector<std::uint8_t> encodeTga32(const FlagImage& image);
+// rle writes a type 10 file; flat flag areas usually shrink it well below the raw size.
+std::vector<std::uint8_t> encodeTga32(const FlagImage& image, bool rle = false);
 
 } // namespace FlagManager
 
@@ -16,6 +16,13 @@
 
 namespace FlagManager {
 
+// Every size is cut from the same crop, so the crop and the downscale are shared between them
+struct CropResizeJob {
+    const FlagImage* image = nullptr;
+    Rect crop;
+    std::vector<ImageSize> sizes;
+};
+
 class IImagePipeline {
 public:
     virtual ~IImagePipeline() = default;
@@ -25,6 +32,12 @@ public:
                                       int targetWidth,
                                       int targetHeight) const = 0;
     virtual std::vector<std::uint8_t> encodeTga32(const FlagImage& image) const = 0;
+
+    // Batch form of the calls above: each job is cropped, resized and encoded without its
+    // pixels coming back in between. Jobs may run in parallel; results are in job order with one
+    // TGA file per requested size, and a failed job yields empty buffers.
+    virtual std::vector<std::vector<std::vector<std::uint8_t>>> cropResizeEncodeTga32Images(
+        const std::vector<CropResizeJob>& jobs) const = 0;
 };
 
 } // namespace FlagManager
@@ -9,10 +9,12 @@
 #include "FlagManagerCore.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cstdlib>
 #include <iterator>
 #include <memory>
+#include <thread>
 #include <utility>
 
 namespace FlagManager {
@@ -52,6 +54,31 @@ std::string fileNameWithoutExtension(const std::string& fileName) {
 bool containsString(const std::vector<std::string>& values, const std::string& needle) {
     return std::find(values.begin(), values.end(), needle) != values.end();
 }
+
+// Imports exported per step; each step makes one crop-resize, one encode and one write request
+constexpr std::size_t kExportBatchSize = 32;
+
+// Calls function(index) for every index in [0, count) across the available cores
+template <typename Function>
+void runParallel(std::size_t count, const Function& function) {
+    const std::size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t workerCount = std::min(count, hardwareThreads);
+    std::atomic<std::size_t> nextIndex{0};
+    auto drain = [&]() {
+        for (std::size_t index = nextIndex++; index < count; index = nextIndex++) {
+            function(index);
+        }
+    };
+
+    std::vector<std::thread> helpers;
+    for (std::size_t worker = 1; worker < workerCount; ++worker) {
+        helpers.emplace_back(drain);
+    }
+    drain();
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+}
 } // namespace
 
 void FlagManagerCore::setFileSystem(IFileSystem* fileSystem) {
@@ -137,6 +164,12 @@ bool FlagManagerCore::selectImport(const std::string& importId) {
     return true;
 }
 
+bool FlagManagerCore::setCompressTgaExports(bool enabled) {
+    m_compressTgaExports = enabled;
+    m_lastError.clear();
+    return true;
+}
+
 bool FlagManagerCore::importFiles(std::vector<ImportedImage> files) {
     bool importedAny = false;
     std::vector<std::string> addedImportIds;
@@ -307,6 +340,9 @@ bool FlagManagerCore::deselectAllImports() {
 }
 
 ExportResult FlagManagerCore::exportCurrent() {
+    if (m_exportJob.active) {
+        return {false, false, "An export is already running."};
+    }
     if (m_selectedImportId.empty()) {
         return {false, false, "No imported image is selected."};
     }
@@ -322,6 +358,9 @@ ExportResult FlagManagerCore::exportCurrent() {
 }
 
 ExportResult FlagManagerCore::exportAll() {
+    if (m_exportJob.active) {
+        return {false, false, "An export is already running."};
+    }
     std::vector<std::string> ids;
     ids.reserve(m_imports.size());
     for (const ImportItem& item : m_imports) {
@@ -387,6 +426,21 @@ bool FlagManagerCore::handleAction(const std::string& actionType,
     if (action == "search" || action == "search_changed" || action == "set_search_text") {
         return setSearchText(params.count("text") ? params.at("text") : params.count("value") ? params.at("value") : "");
     }
+    if (action == "set_tga_rle" || action == "set_compress_tga") {
+        const std::string value = normalizeText(params.count("enabled") ? params.at("enabled") : params.count("value") ? params.at("value") : "");
+        return setCompressTgaExports(value == "1" || value == "true" || value == "on");
+    }
+    if (action == "continue_export") {
+        const ExportResult result = continueExport();
+        if (!result.success) {
+            m_lastError = result.errorMessage;
+        }
+        return result.success;
+    }
+    if (action == "cancel_export") {
+        cancelExport();
+        return true;
+    }
     if (action == "fill_name" || action == "fill_name_from_file") {
         return fillNamesFromFileName();
     }
@@ -404,7 +458,7 @@ bool FlagManagerCore::handleAction(const std::string& actionType,
     return false;
 }
 
-Snapshot FlagManagerCore::buildSnapshot() const {
+Snapshot FlagManagerCore::buildSnapshot(const RowWindow& tagWindow) const {
     Snapshot snapshot;
     snapshot.mode = m_mode;
     snapshot.sizeIndex = m_sizeIndex;
@@ -412,10 +466,14 @@ Snapshot FlagManagerCore::buildSnapshot() const {
     snapshot.selectedTag = m_selectedTag;
     snapshot.selectedImportId = m_selectedImportId;
     snapshot.statusText = m_statusText;
-    snapshot.canExportCurrent = m_mode == ToolMode::New && !m_selectedImportId.empty();
-    snapshot.canExportAll = m_mode == ToolMode::New && !m_imports.empty();
+    snapshot.canExportCurrent = m_mode == ToolMode::New && !m_selectedImportId.empty() && !m_exportJob.active;
+    snapshot.canExportAll = m_mode == ToolMode::New && !m_imports.empty() && !m_exportJob.active;
     snapshot.pendingOverwrite = m_pendingExport.kind != PendingExportKind::None;
     snapshot.pendingOverwriteFiles = m_pendingExport.overwriteFiles;
+    snapshot.exportActive = m_exportJob.active;
+    snapshot.exportCompleted = m_exportJob.nextIndex;
+    snapshot.exportTotal = m_exportJob.importIds.size();
+    snapshot.compressTgaExports = m_compressTgaExports;
     snapshot.lastError = m_lastError;
     snapshot.hasSelection = m_mode == ToolMode::New
         ? (!m_selectedImportId.empty() || !m_selectedImportIds.empty())
@@ -423,7 +481,12 @@ Snapshot FlagManagerCore::buildSnapshot() const {
 
     if (m_mode == ToolMode::Manage) {
         const ManageDisplayData manageData = buildManageDisplayData();
-        snapshot.tags = manageData.tags;
+        snapshot.tagsTotal = manageData.tags.size();
+        // Slide the window back from the end so a viewport near the bottom still fills it.
+        const std::size_t count = std::min(tagWindow.count, snapshot.tagsTotal);
+        snapshot.tagsFirst = std::min(tagWindow.first, snapshot.tagsTotal - count);
+        const auto first = manageData.tags.begin() + static_cast<std::ptrdiff_t>(snapshot.tagsFirst);
+        snapshot.tags.assign(first, first + static_cast<std::ptrdiff_t>(count));
         snapshot.selectedTagVariants = manageData.selectedTagVariants;
     } else {
         snapshot.imports = m_imports;
@@ -857,36 +920,24 @@ ExportResult FlagManagerCore::performExport(const std::vector<std::string>& impo
         return {false, false, "File system bridge is not available."};
     }
 
-    struct ExportWorkItem {
-        std::string id;
-        ImportItem item;
-    };
-
-    std::map<std::string, ImportItem> importsById;
-    for (const ImportItem& item : m_imports) {
-        importsById.emplace(item.id, item);
-    }
-
-    std::vector<ExportWorkItem> workItems;
-    workItems.reserve(importIds.size());
+    std::vector<std::string> exportIds;
+    exportIds.reserve(importIds.size());
     std::string firstValidationError;
     for (const std::string& id : importIds) {
-        const auto itemIt = importsById.find(id);
-        if (itemIt == importsById.end()) {
+        const ImportItem* item = findImport(id);
+        if (!item) {
             continue;
         }
-
-        const ImportItem& item = itemIt->second;
-        if (!isExportableImport(item)) {
+        if (!isExportableImport(*item)) {
             if (firstValidationError.empty()) {
-                firstValidationError = exportValidationError(item);
+                firstValidationError = exportValidationError(*item);
             }
             continue;
         }
-        workItems.push_back({id, item});
+        exportIds.push_back(id);
     }
 
-    if (workItems.empty()) {
+    if (exportIds.empty()) {
         return {false, false, firstValidationError.empty()
             ? "No imported image was exported."
             : firstValidationError};
@@ -897,21 +948,60 @@ ExportResult FlagManagerCore::performExport(const std::vector<std::string>& impo
         return directoryResult;
     }
 
-    std::vector<std::string> exportedIds;
-    exportedIds.reserve(workItems.size());
-    for (const ExportWorkItem& workItem : workItems) {
-        const ExportResult result = exportSingleImport(workItem.item);
-        if (!result.success) {
-            return result;
+    m_exportJob = {};
+    m_exportJob.active = true;
+    m_exportJob.exportedIds.reserve(exportIds.size());
+    m_exportJob.importIds = std::move(exportIds);
+    return continueExport();
+}
+
+ExportResult FlagManagerCore::continueExport() {
+    if (!m_exportJob.active) {
+        return {false, false, "No export is running."};
+    }
+
+    // Imports are looked up again on every step, so ones removed meanwhile are skipped
+    const std::size_t end = std::min(m_exportJob.nextIndex + kExportBatchSize, m_exportJob.importIds.size());
+    std::vector<const ImportItem*> batch;
+    batch.reserve(end - m_exportJob.nextIndex);
+    for (std::size_t index = m_exportJob.nextIndex; index < end; ++index) {
+        const ImportItem* item = findImport(m_exportJob.importIds[index]);
+        if (item && isExportableImport(*item)) {
+            batch.push_back(item);
         }
-        exportedIds.push_back(workItem.id);
     }
+    m_exportJob.nextIndex = end;
 
-    if (exportedIds.empty()) {
-        return {false, false, "No imported image was exported."};
+    const ExportResult batchResult = exportBatch(batch);
+    if (!batchResult.success) {
+        finishExport("");
+        m_lastError = batchResult.errorMessage;
+        return batchResult;
     }
 
-    const std::set<std::string> exportedIdSet(exportedIds.begin(), exportedIds.end());
+    if (m_exportJob.nextIndex >= m_exportJob.importIds.size()) {
+        if (m_exportJob.exportedIds.empty()) {
+            finishExport("");
+            return {false, false, "No imported image was exported."};
+        }
+        return finishExport("Export complete.");
+    }
+
+    m_statusText = "Exporting " + std::to_string(m_exportJob.nextIndex)
+        + "/" + std::to_string(m_exportJob.importIds.size()) + "...";
+    m_lastError.clear();
+    return {true, false, ""};
+}
+
+void FlagManagerCore::cancelExport() {
+    if (m_exportJob.active) {
+        finishExport("Export cancelled.");
+    }
+}
+
+ExportResult FlagManagerCore::finishExport(const std::string& statusText) {
+    const std::set<std::string> exportedIdSet(m_exportJob.exportedIds.begin(), m_exportJob.exportedIds.end());
+    m_exportJob = {};
 
     std::vector<ImportItem> retainedImports;
     retainedImports.reserve(m_imports.size());
@@ -943,7 +1033,7 @@ ExportResult FlagManagerCore::performExport(const std::vector<std::string>& impo
         }
     }
 
-    m_statusText = "Export complete.";
+    m_statusText = statusText;
     m_lastError.clear();
     return {true, false, ""};
 }
@@ -973,29 +1063,119 @@ ExportResult FlagManagerCore::ensureExportDirectories() {
     return {true, false, ""};
 }
 
-ExportResult FlagManagerCore::exportSingleImport(const ImportItem& item) {
-    if (!isExportableImport(item)) {
-        return {false, false, exportValidationError(item)};
+ExportResult FlagManagerCore::exportBatch(const std::vector<const ImportItem*>& items) {
+    constexpr std::size_t sizeCount = std::size(kExportSizes);
+    if (items.empty()) {
+        return {true, false, ""};
     }
 
+    // Each import is one resize job for all of its sizes; encoding every size is independent
+    std::vector<ImageSize> sizes;
+    sizes.reserve(sizeCount);
     for (const ExportSize& size : kExportSizes) {
-        const std::string relativeDir = std::string("gfx/flags/") + size.prefix;
-        const std::string relativePath = relativeDir + item.name + ".tga";
-
-        const FlagImage resized = m_imagePipeline
-            ? m_imagePipeline->cropResizeImage(*item.image, item.crop, size.width, size.height)
-            : FlagManager::resizeCropImage(*item.image, item.crop, size.width, size.height);
-        const std::vector<std::uint8_t> encoded = m_imagePipeline
-            ? m_imagePipeline->encodeTga32(resized)
-            : FlagManager::encodeTga32(resized);
-        if (encoded.empty()) {
+        sizes.push_back({size.width, size.height});
+    }
+    std::vector<CropResizeJob> jobs;
+    jobs.reserve(items.size());
+    for (const ImportItem* item : items) {
+        jobs.push_back({item->image.get(), item->crop, sizes});
+    }
+
+    std::vector<std::vector<std::uint8_t>> encoded;
+    encoded.reserve(items.size() * sizeCount);
+    if (m_imagePipeline) {
+        // The pipeline crops, resizes and encodes in one call per import; only the files come back
+        std::vector<std::vector<std::vector<std::uint8_t>>> encodedJobs = m_imagePipeline->cropResizeEncodeTga32Images(jobs);
+        if (encodedJobs.size() != jobs.size()) {
             return {false, false, "Failed to encode TGA image."};
         }
+        for (std::vector<std::vector<std::uint8_t>>& files : encodedJobs) {
+            if (files.size() != sizeCount) {
+                return {false, false, "Failed to encode TGA image."};
+            }
+            for (std::vector<std::uint8_t>& content : files) {
+                encoded.push_back(std::move(content));
+            }
+        }
+    } else {
+        std::vector<std::vector<FlagImage>> resizedJobs(jobs.size());
+        runParallel(jobs.size(), [&jobs, &resizedJobs](std::size_t index) {
+            const CropResizeJob& job = jobs[index];
+            resizedJobs[index] = FlagManager::resizeCropImageSizes(*job.image, job.crop, job.sizes);
+        });
 
-        const FileWriteResult writeResult = m_fileSystem->writeModFile(relativePath, encoded);
-        if (!writeResult.success) {
-            return {false, false, writeResult.errorMessage};
+        std::vector<const FlagImage*> encodeInputs;
+        encodeInputs.reserve(items.size() * sizeCount);
+        for (const std::vector<FlagImage>& images : resizedJobs) {
+            if (images.size() != sizeCount) {
+                return {false, false, "Failed to resize image."};
+            }
+            for (const FlagImage& image : images) {
+                if (!FlagManager::isValidImage(image)) {
+                    return {false, false, "Failed to resize image."};
+                }
+                encodeInputs.push_back(&image);
+            }
         }
+
+        encoded.resize(encodeInputs.size());
+        const bool rle = m_compressTgaExports;
+        runParallel(encodeInputs.size(), [&encodeInputs, &encoded, rle](std::size_t index) {
+            encoded[index] = FlagManager::encodeTga32(*encodeInputs[index], rle);
+        });
+    }
+    if (m_imagePipeline && m_compressTgaExports) {
+        // The pipeline only writes uncompressed TGAs, so its files are repacked here
+        runParallel(encoded.size(), [&encoded](std::size_t index) {
+            if (!encoded[index].empty()) {
+                encoded[index] = FlagManager::encodeTga32(FlagManager::decodeTga(encoded[index]), true);
+            }
+        });
+    }
+    for (const std::vector<std::uint8_t>& content : encoded) {
+        if (content.empty()) {
+            return {false, false, "Failed to encode TGA image."};
+        }
+    }
+
+    std::vector<FileWriteItem> files;
+    files.reserve(encoded.size());
+    for (std::size_t itemIndex = 0; itemIndex < items.size(); ++itemIndex) {
+        for (std::size_t sizeIndex = 0; sizeIndex < sizeCount; ++sizeIndex) {
+            files.push_back({
+                std::string("gfx/flags/") + kExportSizes[sizeIndex].prefix + items[itemIndex]->name + ".tga",
+                std::move(encoded[itemIndex * sizeCount + sizeIndex])
+            });
+        }
+    }
+
+    const FileBatchWriteResult writeResult = m_fileSystem->writeModFiles(files);
+    if (!writeResult.success) {
+        return {false, false, writeResult.errorMessage};
+    }
+    if (writeResult.files.size() != files.size()) {
+        return {false, false, "File write results do not match the request."};
+    }
+
+    // An import counts as exported only when all of its sizes were written
+    std::string firstError;
+    for (std::size_t itemIndex = 0; itemIndex < items.size(); ++itemIndex) {
+        bool written = true;
+        for (std::size_t sizeIndex = 0; sizeIndex < sizeCount; ++sizeIndex) {
+            const FileWriteResult& fileResult = writeResult.files[itemIndex * sizeCount + sizeIndex];
+            if (!fileResult.success) {
+                written = false;
+                if (firstError.empty()) {
+                    firstError = fileResult.errorMessage;
+                }
+            }
+        }
+        if (written) {
+            m_exportJob.exportedIds.push_back(items[itemIndex]->id);
+        }
+    }
+    if (!firstError.empty()) {
+        return {false, false, firstError};
     }
 
     return {true, false, ""};
@@ -37,6 +37,8 @@ public:
     bool setSearchText(const std::string& text);
     bool selectTag(const std::string& tag);
     bool selectImport(const std::string& importId);
+    // Exports RLE-compressed TGAs (type 10) instead of uncompressed ones; off by default.
+    bool setCompressTgaExports(bool enabled);
 
     bool importFiles(std::vector<ImportedImage> files);
     bool updateImportName(const std::string& importId, const std::string& name);
@@ -48,12 +50,17 @@ public:
 
     ExportResult exportCurrent();
     ExportResult exportAll();
+    // An export runs in steps of a few imports so the UI can show progress between them.
+    // continueExport() runs the next step; cancelExport() keeps what was already written.
+    ExportResult continueExport();
+    void cancelExport();
+    bool isExportActive() const noexcept { return m_exportJob.active; }
     bool confirmPendingOverwrite();
     void cancelPendingOverwrite();
 
     bool handleAction(const std::string& actionType, const std::map<std::string, std::string>& params);
 
-    Snapshot buildSnapshot() const;
+    Snapshot buildSnapshot(const RowWindow& tagWindow = RowWindow()) const;
     std::vector<ImportItem> takeRetiredImports();
     const std::string& lastError() const noexcept { return m_lastError; }
 
@@ -64,6 +71,13 @@ private:
         std::vector<std::string> overwriteFiles;
     };
 
+    struct ExportJob {
+        bool active = false;
+        std::vector<std::string> importIds;
+        std::size_t nextIndex = 0;
+        std::vector<std::string> exportedIds;
+    };
+
     struct ManageDisplayData {
         std::vector<TagListRow> tags;
         std::vector<ManageVariantDisplay> selectedTagVariants;
@@ -94,7 +108,8 @@ private:
     static std::string exportValidationError(const ImportItem& item);
     ExportResult ensureExportDirectories();
     ExportResult performExport(const std::vector<std::string>& importIds);
-    ExportResult exportSingleImport(const ImportItem& item);
+    ExportResult exportBatch(const std::vector<const ImportItem*>& items);
+    ExportResult finishExport(const std::string& statusText);
     std::vector<std::string> collectOverwriteFiles(const std::vector<std::string>& importIds) const;
     std::string nextImportId();
 
@@ -104,6 +119,7 @@ private:
     std::map<std::string, TagRecord> m_tagRecords;
     ToolMode m_mode = ToolMode::Manage;
     int m_sizeIndex = 0;
+    bool m_compressTgaExports = false;
     std::string m_searchText;
     std::string m_selectedTag;
     std::vector<ImportItem> m_imports;
@@ -113,6 +129,7 @@ private:
     std::string m_lastError;
     std::string m_statusText;
     ExportContext m_pendingExport;
+    ExportJob m_exportJob;
     std::vector<ImportItem> m_retiredImports;
 };
 
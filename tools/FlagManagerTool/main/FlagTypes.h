@@ -9,6 +9,7 @@
 #ifndef FLAGTYPES_H
 #define FLAGTYPES_H
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -43,6 +44,11 @@ struct Rect {
     int bottom = 0;
 };
 
+struct ImageSize {
+    int width = 0;
+    int height = 0;
+};
+
 struct FlagImage {
     int width = 0;
     int height = 0;
@@ -97,6 +103,12 @@ struct ManageVariantDisplay {
     std::string tooltip;
 };
 
+// Slice of a row list to include in a snapshot; the default keeps every row.
+struct RowWindow {
+    std::size_t first = 0;
+    std::size_t count = static_cast<std::size_t>(-1);
+};
+
 struct Snapshot {
     ToolMode mode = ToolMode::Manage;
     int sizeIndex = 0;
@@ -109,8 +121,14 @@ struct Snapshot {
     bool canExportAll = false;
     bool pendingOverwrite = false;
     std::vector<std::string> pendingOverwriteFiles;
+    bool exportActive = false;
+    std::size_t exportCompleted = 0;  // Imports handled so far by the running export
+    std::size_t exportTotal = 0;
+    bool compressTgaExports = false;
     std::string lastError;
     std::vector<TagListRow> tags;
+    std::size_t tagsFirst = 0;
+    std::size_t tagsTotal = 0;
     std::vector<ManageVariantDisplay> selectedTagVariants;
     std::vector<ImportItem> imports;
     std::vector<std::string> selectedImportIds;
@@ -51,6 +51,7 @@ using FontManager::IFontFileSystem;
 using FontManager::ImportedFont;
 using FontManager::Snapshot;
 using FontManager::ToolMode;
+using FontManager::TtfInfoResult;
 
 QString localizedFallback(const QString& key) {
     static QMap<QString, QString> fallbacks;
@@ -98,6 +99,9 @@ QString localizedFallback(const QString& key) {
         fallbacks.insert(QStringLiteral("ConfirmOverwriteTitle"), QStringLiteral("Confirm Overwrite"));
         fallbacks.insert(QStringLiteral("ConfirmOverwrite"), QStringLiteral("The following files already exist. Do you want to overwrite them?\n\n%1"));
         fallbacks.insert(QStringLiteral("Ready"), QStringLiteral("Ready"));
+        fallbacks.insert(QStringLiteral("GeneratingFont"), QStringLiteral("Generating font..."));
+        fallbacks.insert(QStringLiteral("CancelGeneration"), QStringLiteral("Cancel"));
+        fallbacks.insert(QStringLiteral("GenerationCancelled"), QStringLiteral("Font generation was cancelled."));
     }
     return fallbacks.value(key, key);
 }
@@ -124,13 +128,15 @@ ToolRuntimeContext::PluginInvokeResponse invokePluginOperation(
     const QString& pluginName,
     const QString& operation,
     ToolRuntimeContext::PluginPayloadContentType contentType,
-    const QByteArray& payload
+    const QByteArray& payload,
+    ToolRuntimeContext::PluginProgressHandler progressHandler = ToolRuntimeContext::PluginProgressHandler()
 ) {
     ToolRuntimeContext::PluginInvokeRequest request;
     request.pluginName = pluginName;
     request.operation = operation;
     request.contentType = contentType;
     request.payload = payload;
+    request.progressHandler = std::move(progressHandler);
     return ToolRuntimeContext::instance().invokePlugin(request);
 }
 
@@ -517,42 +523,54 @@ private:
 
 class DryadAtlasRuntimeService final : public IDryadAtlasService {
 public:
-    DryadAtlasRuntimeService(IFontFileSystem* fileSystem)
-        : m_fileSystem(fileSystem) {}
+    DryadAtlasRuntimeService(WorkerSession* session, IFontFileSystem* fileSystem)
+        : m_session(session)
+        , m_fileSystem(fileSystem) {}
 
     bool readTtfInfo(const std::vector<std::uint8_t>& ttfBytes,
                      std::string* outFamilyName,
                      int* outGlyphCount,
                      std::string* outError) const override {
-        QJsonObject request;
-        request[QStringLiteral("ttfBase64")] = QString::fromLatin1(bytesToBase64(ttfBytes));
-        const ToolRuntimeContext::PluginInvokeResponse response = invokePluginOperation(
-            QStringLiteral("DryadAtlas"),
-            QStringLiteral("dryadAtlas.getTtfInfo"),
-            ToolRuntimeContext::PluginPayloadContentType::JsonUtf8,
-            QJsonDocument(request).toJson(QJsonDocument::Compact)
-        );
-        if (!response.success) {
-            setResponseError(outError, response, "Failed to read TTF info.");
-            return false;
-        }
-
-        const QJsonDocument document = QJsonDocument::fromJson(response.payload);
-        if (!document.isObject()) {
-            setOutError(outError, "DryadAtlas returned invalid TTF info.");
+        const ToolRuntimeContext::PluginInvokeRequest request = ttfInfoRequest(ttfBytes);
+        const TtfInfoResult result = ttfInfoFromResponse(
+            ToolRuntimeContext::instance().invokePlugin(request));
+        if (!result.success) {
+            setOutError(outError, result.errorMessage);
             return false;
         }
-
-        const QJsonObject object = document.object();
         if (outFamilyName) {
-            *outFamilyName = toStdString(object.value(QStringLiteral("family")).toString());
+            *outFamilyName = result.familyName;
         }
         if (outGlyphCount) {
-            *outGlyphCount = object.value(QStringLiteral("glyphCount")).toInt(0);
+            *outGlyphCount = result.glyphCount;
         }
         return true;
     }
 
+    std::vector<TtfInfoResult> readTtfInfoBatch(const std::vector<const std::vector<std::uint8_t>*>& ttfFiles) const override {
+        std::vector<TtfInfoResult> results(ttfFiles.size());
+        QList<ToolRuntimeContext::PluginInvokeRequest> requests;
+        requests.reserve(static_cast<qsizetype>(ttfFiles.size()));
+        for (const std::vector<std::uint8_t>* ttfBytes : ttfFiles) {
+            requests.append(ttfInfoRequest(ttfBytes ? *ttfBytes : std::vector<std::uint8_t>()));
+        }
+
+        const ToolRuntimeContext::PluginBatchResponse batch =
+            ToolRuntimeContext::instance().invokePluginBatch(QStringLiteral("DryadAtlas"), requests);
+        if (!batch.success) {
+            const QString error = batch.errorMessage.trimmed();
+            for (TtfInfoResult& result : results) {
+                result.errorMessage = error.isEmpty() ? std::string("Failed to read TTF info.") : toStdString(error);
+            }
+            return results;
+        }
+
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            results[i] = ttfInfoFromResponse(batch.items.at(static_cast<qsizetype>(i)));
+        }
+        return results;
+    }
+
     bool generateFont(const ImportedFont& imported,
                       const FontGenerationSettings& settings,
                       GeneratedFontPackage* outPackage,
@@ -565,12 +583,41 @@ public:
         QJsonObject request = settingsToJson(settings, imported.familyName);
         request[QStringLiteral("textColors")] = textColorsToJson(settings.textColors);
         request[QStringLiteral("ttfBase64")] = QString::fromLatin1(bytesToBase64(imported.ttfBytes));
+
+        WorkerSession* session = m_session;
+        if (session) {
+            session->generationActive = true;
+            session->generationCancelRequested = false;
+            session->generationCompleted = 0;
+            session->generationTotal = 0;
+            session->generationMessage.clear();
+        }
         const ToolRuntimeContext::PluginInvokeResponse response = invokePluginOperation(
             QStringLiteral("DryadAtlas"),
             QStringLiteral("dryadAtlas.generateFromTtf"),
             ToolRuntimeContext::PluginPayloadContentType::JsonUtf8,
-            QJsonDocument(request).toJson(QJsonDocument::Compact)
+            QJsonDocument(request).toJson(QJsonDocument::Compact),
+            [session](const ToolRuntimeContext::PluginProgressEvent& event) {
+                if (!session) {
+                    return true;
+                }
+                session->generationCompleted = event.completed;
+                session->generationTotal = event.total;
+                if (!event.message.isEmpty()) {
+                    session->generationMessage = event.message;
+                }
+                return !session->generationCancelRequested;
+            }
         );
+        const bool cancelled = session && session->generationCancelRequested;
+        if (session) {
+            session->generationActive = false;
+            session->generationCancelRequested = false;
+        }
+        if (cancelled) {
+            setOutError(outError, toStdString(localizedString(session, QStringLiteral("GenerationCancelled"))));
+            return false;
+        }
         if (!response.success) {
             setResponseError(outError, response, "Failed to generate font atlas.");
             return false;
@@ -927,6 +974,37 @@ private:
         }
     }
 
+    static ToolRuntimeContext::PluginInvokeRequest ttfInfoRequest(const std::vector<std::uint8_t>& ttfBytes) {
+        QJsonObject payload;
+        payload[QStringLiteral("ttfBase64")] = QString::fromLatin1(bytesToBase64(ttfBytes));
+        ToolRuntimeContext::PluginInvokeRequest request;
+        request.pluginName = QStringLiteral("DryadAtlas");
+        request.operation = QStringLiteral("dryadAtlas.getTtfInfo");
+        request.contentType = ToolRuntimeContext::PluginPayloadContentType::JsonUtf8;
+        request.payload = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+        return request;
+    }
+
+    static TtfInfoResult ttfInfoFromResponse(const ToolRuntimeContext::PluginInvokeResponse& response) {
+        TtfInfoResult result;
+        if (!response.success) {
+            setResponseError(&result.errorMessage, response, "Failed to read TTF info.");
+            return result;
+        }
+
+        const QJsonDocument document = QJsonDocument::fromJson(response.payload);
+        if (!document.isObject()) {
+            result.errorMessage = "DryadAtlas returned invalid TTF info.";
+            return result;
+        }
+
+        const QJsonObject object = document.object();
+        result.familyName = toStdString(object.value(QStringLiteral("family")).toString());
+        result.glyphCount = object.value(QStringLiteral("glyphCount")).toInt(0);
+        result.success = true;
+        return result;
+    }
+
     static void setResponseError(std::string* outError,
                                  const ToolRuntimeContext::PluginInvokeResponse& response,
                                  const char* fallback) {
@@ -934,6 +1012,7 @@ private:
         setOutError(outError, error.isEmpty() ? std::string(fallback ? fallback : "DryadAtlas operation failed.") : toStdString(error));
     }
 
+    WorkerSession* m_session = nullptr;
     IFontFileSystem* m_fileSystem = nullptr;
     mutable QString m_existingFontCacheKey;
     mutable QJsonArray m_existingFontFilesCache;
@@ -1079,6 +1158,14 @@ QJsonObject buildViewState(WorkerSession* session, const Snapshot& state) {
     object[QStringLiteral("pendingOverwrite")] = state.pendingOverwrite;
     object[QStringLiteral("statusText")] = state.statusText.empty() ? localizedString(session, QStringLiteral("Ready")) : fromStdString(state.statusText);
     object[QStringLiteral("lastError")] = fromStdString(state.lastError);
+    object[QStringLiteral("generationProgress")] = QJsonObject{
+        {QStringLiteral("active"), session && session->generationActive},
+        {QStringLiteral("completed"), session ? static_cast<double>(session->generationCompleted) : 0.0},
+        {QStringLiteral("total"), session ? static_cast<double>(session->generationTotal) : 0.0},
+        {QStringLiteral("message"), session && !session->generationMessage.isEmpty()
+            ? session->generationMessage
+            : localizedString(session, QStringLiteral("GeneratingFont"))}
+    };
     QJsonArray overwriteFiles;
     for (const std::string& path : state.pendingOverwriteFiles) overwriteFiles.append(fromStdString(path));
     object[QStringLiteral("pendingOverwriteFiles")] = overwriteFiles;
@@ -1285,10 +1372,10 @@ QJsonObject buildStatePacket(WorkerSession* session) {
     return packet;
 }
 
-char* serializeStatePacket(WorkerSession* session) {
-    const QByteArray stateJson = QJsonDocument(buildStatePacket(session)).toJson(QJsonDocument::Compact);
-    if (session) session->lastSerializedState = stateJson.toStdString();
-    return allocateCString(stateJson);
+char* serializeStatePacket(WorkerSession* session, bool allowDelta) {
+    const QJsonObject packet = buildStatePacket(session);
+    if (!session) return allocateCString(QJsonDocument(packet).toJson(QJsonDocument::Compact));
+    return allocateCString(session->stateEncoder.encode(packet, allowDelta));
 }
 
 ToolWorkerResult initializeSession(WorkerSession* session, const char* configJson) {
@@ -1300,7 +1387,7 @@ ToolWorkerResult initializeSession(WorkerSession* session, const char* configJso
     session->gameLanguage = config.value(QStringLiteral("gameLanguage")).toString(QStringLiteral("l_english"));
     session->gameLanguageNames = localizedStringsFromJson(config.value(QStringLiteral("gameLanguageNames")).toObject());
     session->fileSystem = std::make_unique<ToolRuntimeFontFileSystem>(session);
-    session->dryadAtlas = std::make_unique<DryadAtlasRuntimeService>(session->fileSystem.get());
+    session->dryadAtlas = std::make_unique<DryadAtlasRuntimeService>(session, session->fileSystem.get());
     session->core.setFileSystem(session->fileSystem.get());
     session->core.setDryadAtlas(session->dryadAtlas.get());
     session->coreInitialized = false;
@@ -1337,6 +1424,8 @@ ToolWorkerResult applyActionInternal(WorkerSession* session,
         std::vector<ImportedFont> imports;
         QStringList importErrors;
         imports.reserve(static_cast<std::size_t>(paths.size()));
+        std::vector<ImportedFont> candidates;
+        candidates.reserve(static_cast<std::size_t>(paths.size()));
         for (const QJsonValue& value : paths) {
             const QString path = value.toString();
             QFile file(path);
@@ -1351,12 +1440,31 @@ ToolWorkerResult applyActionInternal(WorkerSession* session,
             imported.fileName = toStdString(fileName);
             const auto* begin = reinterpret_cast<const std::uint8_t*>(bytes.constData());
             imported.ttfBytes.assign(begin, begin + bytes.size());
+            candidates.push_back(std::move(imported));
+        }
+
+        // One batched DryadAtlas call instead of a plugin round trip per font.
+        std::vector<TtfInfoResult> infos;
+        if (session->dryadAtlas && !candidates.empty()) {
+            std::vector<const std::vector<std::uint8_t>*> ttfFiles;
+            ttfFiles.reserve(candidates.size());
+            for (const ImportedFont& candidate : candidates) {
+                ttfFiles.push_back(&candidate.ttfBytes);
+            }
+            infos = session->dryadAtlas->readTtfInfoBatch(ttfFiles);
+        }
+
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            ImportedFont& imported = candidates[i];
+            const QString fileName = fromStdString(imported.fileName);
             if (session->dryadAtlas) {
-                std::string error;
-                if (!session->dryadAtlas->readTtfInfo(imported.ttfBytes, &imported.familyName, &imported.glyphCount, &error)) {
-                    importErrors.append(QStringLiteral("%1: %2").arg(fileName, fromStdString(error)));
+                const TtfInfoResult& info = infos[i];
+                if (!info.success) {
+                    importErrors.append(QStringLiteral("%1: %2").arg(fileName, fromStdString(info.errorMessage)));
                     continue;
                 }
+                imported.familyName = info.familyName;
+                imported.glyphCount = info.glyphCount;
             }
             if (imported.glyphCount <= 0) {
                 importErrors.append(QStringLiteral("%1: no usable glyphs were discovered.").arg(fileName));
@@ -1442,14 +1550,21 @@ TOOL_WORKER_API const char* ToolWorker_HandleAction(
         return nullptr;
     }
     if (session->actionInProgress) {
+        // The host keeps dispatching UI actions while a plugin call waits; only a cancel of the
+        // running generation is meaningful then, and the progress handler picks it up.
+        if (session->generationActive && std::strcmp(actionType ? actionType : "", "cancel_generation") == 0) {
+            session->generationCancelRequested = true;
+            if (outResult) *outResult = TOOL_WORKER_SUCCESS;
+            return FontManagerBridge::serializeStatePacket(session, true);
+        }
         if (outResult) *outResult = TOOL_WORKER_ERROR_ACTION_FAILED;
-        return FontManagerBridge::serializeStatePacket(session);
+        return FontManagerBridge::serializeStatePacket(session, true);
     }
     session->actionInProgress = true;
     const ToolWorkerResult result = FontManagerBridge::applyActionInternal(session, actionType, targetId, argumentsJson);
     session->actionInProgress = false;
     if (outResult) *outResult = result;
-    return FontManagerBridge::serializeStatePacket(session);
+    return FontManagerBridge::serializeStatePacket(session, true);
 }
 
 TOOL_WORKER_API const char* ToolWorker_GetCurrentState(ToolWorkerHandle handle, ToolWorkerResult* outResult) {
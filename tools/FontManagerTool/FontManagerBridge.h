@@ -9,6 +9,7 @@
 #ifndef FONTMANAGERBRIDGE_H
 #define FONTMANAGERBRIDGE_H
 
+#include "../../src/ToolStatePatch.h"
 #include "../../src/ToolWorkerInterface.h"
 #include "main/FontFileSystem.h"
 #include "main/FontManagerCore.h"
@@ -32,8 +33,15 @@ struct WorkerSession {
     QMap<QString, QString> gameLanguageNames;
     bool coreInitialized = false;
     bool actionInProgress = false;
+    // Font generation running inside the current action. Progress snapshots read these fields,
+    // and cancel_generation is the one action accepted while another is still in progress.
+    bool generationActive = false;
+    bool generationCancelRequested = false;
+    quint64 generationCompleted = 0;
+    quint64 generationTotal = 0;
+    QString generationMessage;
     std::string lastError;
-    std::string lastSerializedState;
+    ToolStatePatch::StateEncoder stateEncoder;
 };
 
 ToolWorkerHandle createWorkerHandle(const char* toolId);
@@ -42,7 +50,8 @@ WorkerSession* sessionFromHandle(ToolWorkerHandle handle);
 
 QJsonObject parseJsonObject(const char* jsonText);
 QJsonObject buildStatePacket(WorkerSession* session);
-char* serializeStatePacket(WorkerSession* session);
+// Action responses may be deltas; state queries always return a full snapshot.
+char* serializeStatePacket(WorkerSession* session, bool allowDelta = false);
 ToolWorkerResult initializeSession(WorkerSession* session, const char* configJson);
 ToolWorkerResult applyActionInternal(WorkerSession* session,
                                      const char* actionType,
@@ -22,6 +22,7 @@ Rectangle {
     property bool loadingActive: true
     property string loadingText: ""
     property int previewRevision: 0
+    property var generationProgress: ({})
 
     readonly property var colors: toolTheme.colors
     readonly property var surfaces: toolTheme.surfaces
@@ -88,12 +89,21 @@ Rectangle {
         statusText = safeString(toolBridge.value("statusText", ""))
         loadingActive = !!toolBridge.value("loadingActive", false)
         loadingText = safeString(toolBridge.value("loadingText", trText("LoadingFonts", "Loading fonts...")))
+        generationProgress = toolBridge.value("generationProgress", {}) || {}
         refreshing = false
         if (pendingOverwrite && !overwriteDialog.opened) {
             overwriteDialog.open()
         }
     }
 
+    function generationFraction() {
+        var total = Number(generationProgress.total)
+        if (!isFinite(total) || total <= 0) {
+            return 0
+        }
+        return Math.max(0, Math.min(1, Number(generationProgress.completed) / total))
+    }
+
     function setting(key, fallback) {
         return settings && settings[key] !== undefined ? settings[key] : fallback
     }
@@ -374,6 +384,72 @@ Rectangle {
                         font.pixelSize: Number(fonts.body.pixelSize)
                     }
 
+                    RowLayout {
+                        visible: !!root.generationProgress.active
+                        Layout.fillWidth: true
+                        spacing: 10
+
+                        ColumnLayout {
+                            Layout.fillWidth: true
+                            spacing: 6
+
+                            Label {
+                                Layout.fillWidth: true
+                                text: root.safeString(root.generationProgress.message).length
+                                    ? root.safeString(root.generationProgress.message)
+                                    : root.trText("GeneratingFont", "Generating font...")
+                                color: colors.textMuted
+                                elide: Text.ElideRight
+                                font.family: fonts.body.family
+                                font.pixelSize: Number(fonts.body.pixelSize)
+                            }
+
+                            Rectangle {
+                                Layout.fillWidth: true
+                                Layout.preferredHeight: 4
+                                radius: height / 2
+                                color: colors.loadingTrack
+                                clip: true
+
+                                Rectangle {
+                                    width: parent.width * root.generationFraction()
+                                    height: parent.height
+                                    radius: height / 2
+                                    color: colors.accent
+                                }
+                            }
+                        }
+
+                        Rectangle {
+                            id: cancelGenerationButton
+                            Layout.preferredWidth: Math.max(72, cancelGenerationText.implicitWidth + 24)
+                            Layout.preferredHeight: 30
+                            radius: 6
+                            color: cancelGenerationMouse.pressed
+                                ? colors.accentPressed
+                                : (cancelGenerationMouse.containsMouse ? colors.accentHover : colors.surface)
+                            border.color: cancelGenerationMouse.containsMouse ? colors.accent : toolTheme.dividers.default.color
+                            border.width: 1
+
+                            Text {
+                                id: cancelGenerationText
+                                anchors.centerIn: parent
+                                text: root.trText("CancelGeneration", "Cancel")
+                                color: cancelGenerationMouse.containsMouse ? colors.textInverted : colors.textPrimary
+                                font.family: fonts.body.family
+                                font.pixelSize: Number(fonts.body.pixelSize)
+                            }
+
+                            MouseArea {
+                                id: cancelGenerationMouse
+                                anchors.fill: parent
+                                hoverEnabled: true
+                                cursorShape: Qt.PointingHandCursor
+                                onClicked: root.dispatchAction("cancel_generation")
+                            }
+                        }
+                    }
+
                     Item {
                         Layout.fillWidth: true
                         Layout.fillHeight: true
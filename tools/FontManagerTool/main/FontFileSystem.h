@@ -34,6 +34,13 @@ struct FileWriteResult {
     std::string errorMessage;
 };
 
+struct TtfInfoResult {
+    bool success = false;
+    std::string familyName;
+    int glyphCount = 0;
+    std::string errorMessage;
+};
+
 class IFontFileSystem {
 public:
     virtual ~IFontFileSystem() = default;
@@ -53,6 +60,8 @@ public:
                              std::string* outFamilyName,
                              int* outGlyphCount,
                              std::string* outError) const = 0;
+    // Reads every font in one plugin round trip; results follow the input order.
+    virtual std::vector<TtfInfoResult> readTtfInfoBatch(const std::vector<const std::vector<std::uint8_t>*>& ttfFiles) const = 0;
     virtual bool generateFont(const ImportedFont& imported,
                               const FontGenerationSettings& settings,
                               GeneratedFontPackage* outPackage,
@@ -35,6 +35,7 @@ std::string g_legacyLastError;
 std::string g_legacySerializedState;
 
 namespace {
+using LogManager::ByteRangeReadResult;
 using LogManager::CompareRow;
 using LogManager::DirectoryEntry;
 using LogManager::DirectoryListResult;
@@ -42,6 +43,7 @@ using LogManager::IFileSystem;
 using LogManager::LoadingStateSnapshot;
 using LogManager::LogEntry;
 using LogManager::LogFileRecord;
+using LogManager::RowWindow;
 using LogManager::SortMode;
 using LogManager::StateSnapshot;
 using LogManager::StatisticsSnapshot;
@@ -147,6 +149,27 @@ public:
 
         return readSingleMatchingTextFile(requestedPath);
     }
+
+    ByteRangeReadResult readFileRange(const std::string& relativePath,
+                                      uint64_t offset,
+                                      uint64_t maxBytes) const override {
+        const ToolRuntimeContext::FileRangeReadResult runtimeResult =
+            ToolRuntimeContext::instance().readFileRange(
+                ToolRuntimeContext::FileRoot::Doc,
+                QString::fromUtf8(relativePath.c_str()),
+                static_cast<qint64>(offset),
+                static_cast<qint64>(maxBytes)
+            );
+
+        ByteRangeReadResult result{};
+        result.success = runtimeResult.success;
+        if (runtimeResult.success) {
+            result.content.assign(runtimeResult.content.constData(),
+                                  static_cast<std::size_t>(runtimeResult.content.size()));
+            result.fileSize = static_cast<uint64_t>(std::max<qint64>(0, runtimeResult.fileSize));
+        }
+        return result;
+    }
 };
 
 QMap<QString, QString> parseMetaFile(const QString& filePath) {
@@ -218,15 +241,19 @@ QString localizedFallback(const QString& key) {
         fallbacks.insert(QStringLiteral("Refresh"), QStringLiteral("Refresh"));
         fallbacks.insert(QStringLiteral("SortByTime"), QStringLiteral("Sort by Time"));
         fallbacks.insert(QStringLiteral("SortByCategory"), QStringLiteral("Sort by Category"));
+        fallbacks.insert(QStringLiteral("LiveTail"), QStringLiteral("Live"));
         fallbacks.insert(QStringLiteral("SearchPlaceholder"), QStringLiteral("Search logs"));
         fallbacks.insert(QStringLiteral("Latest"), QStringLiteral("Latest"));
         fallbacks.insert(QStringLiteral("LogFiles"), QStringLiteral("Log Files"));
         fallbacks.insert(QStringLiteral("ErrorLog"), QStringLiteral("Error Log"));
         fallbacks.insert(QStringLiteral("CompareMode"), QStringLiteral("Compare Mode"));
+        fallbacks.insert(QStringLiteral("AllSessions"), QStringLiteral("All Sessions"));
         fallbacks.insert(QStringLiteral("ColSystemTime"), QStringLiteral("Time"));
         fallbacks.insert(QStringLiteral("ColGameTime"), QStringLiteral("Date"));
         fallbacks.insert(QStringLiteral("ColCategory"), QStringLiteral("Category"));
         fallbacks.insert(QStringLiteral("ColMessage"), QStringLiteral("Message Preview"));
+        fallbacks.insert(QStringLiteral("ColOccurrences"), QStringLiteral("Count"));
+        fallbacks.insert(QStringLiteral("ColSessions"), QStringLiteral("Sessions"));
         fallbacks.insert(QStringLiteral("Compare"), QStringLiteral("Compare"));
         fallbacks.insert(QStringLiteral("StopCompare"), QStringLiteral("Stop Compare"));
         fallbacks.insert(QStringLiteral("Total"), QStringLiteral("Total"));
@@ -330,11 +357,23 @@ QString sortActionId(SortMode mode) {
 }
 
 QString viewModeKey(const StateSnapshot& state) {
-    return state.isCompareMode
-        ? QStringLiteral("compare")
+    if (state.isCompareMode) {
+        return QStringLiteral("compare");
+    }
+    return state.isAggregateMode
+        ? QStringLiteral("aggregate")
         : QStringLiteral("normal");
 }
 
+QString resultTitle(const WorkerSession* session, const StateSnapshot& state) {
+    if (state.isCompareMode) {
+        return localizedString(session, QStringLiteral("CompareMode"));
+    }
+    return state.isAggregateMode
+        ? localizedString(session, QStringLiteral("AllSessions"))
+        : localizedString(session, QStringLiteral("ErrorLog"));
+}
+
 QJsonObject buildColumn(const QString& key, const QString& title, int width = -1, bool stretch = false, bool hidden = false) {
     QJsonObject column;
     column[QStringLiteral("key")] = key;
@@ -379,6 +418,18 @@ QJsonObject serializeStatisticsState(const StatisticsSnapshot& statistics) {
     return object;
 }
 
+QJsonArray serializeCategoryFacets(const std::vector<CategoryFacet>& facets) {
+    QJsonArray array;
+    for (const CategoryFacet& facet : facets) {
+        QJsonObject object;
+        object[QStringLiteral("name")] = QString::fromUtf8(facet.name.c_str());
+        object[QStringLiteral("count")] = facet.count;
+        object[QStringLiteral("selected")] = facet.selected;
+        array.append(object);
+    }
+    return array;
+}
+
 QJsonObject serializeEntry(const LogEntry& entry) {
     QJsonObject object;
     object[QStringLiteral("systemTime")] = QString::fromUtf8(entry.systemTime.c_str());
@@ -406,7 +457,7 @@ QJsonObject serializeFile(const WorkerSession* session,
     object[QStringLiteral("isCompare")] = isCompare;
     object[QStringLiteral("canCompare")] = !isCurrent && !isCompare;
     object[QStringLiteral("canStopCompare")] = isCompare;
-    object[QStringLiteral("entryCount")] = static_cast<int>(file.entries.size());
+    object[QStringLiteral("entryCount")] = static_cast<int>(file.entryCount());
     return object;
 }
 
@@ -465,7 +516,7 @@ QJsonObject buildFileListModel(const WorkerSession* session, const StateSnapshot
         values[QStringLiteral("name")] = uiDisplayName;
         values[QStringLiteral("displayName")] = QString::fromUtf8(file.displayName.c_str());
         values[QStringLiteral("sourcePath")] = QString::fromUtf8(file.sourcePath.c_str());
-        values[QStringLiteral("entryCount")] = static_cast<int>(file.entries.size());
+        values[QStringLiteral("entryCount")] = static_cast<int>(file.entryCount());
         row[QStringLiteral("values")] = values;
 
         QJsonArray cells;
@@ -498,7 +549,56 @@ QJsonObject buildFileListModel(const WorkerSession* session, const StateSnapshot
     return model;
 }
 
+QJsonObject buildAggregateModel(const WorkerSession* session, const StateSnapshot& state) {
+    QJsonObject model;
+    model[QStringLiteral("id")] = QStringLiteral("log_entries");
+    model[QStringLiteral("title")] = localizedString(session, QStringLiteral("AllSessions"));
+
+    QJsonArray columns;
+    columns.append(buildColumn(QStringLiteral("occurrences"), localizedString(session, QStringLiteral("ColOccurrences")), 80));
+    columns.append(buildColumn(QStringLiteral("sessions"), localizedString(session, QStringLiteral("ColSessions")), 80));
+    columns.append(buildColumn(QStringLiteral("category"), localizedString(session, QStringLiteral("ColCategory")), 220));
+    columns.append(buildColumn(QStringLiteral("message"), localizedString(session, QStringLiteral("ColMessage")), -1, true));
+    model[QStringLiteral("columns")] = columns;
+
+    QJsonArray rows;
+    int aggregateRowIndex = static_cast<int>(state.entriesFirst);
+    for (const AggregateRow& aggregateRow : state.aggregateRows) {
+        const LogEntry& entry = aggregateRow.entry;
+        const QString categoryText = QString::fromUtf8(entry.category.c_str());
+        const QString compactRowId = QStringLiteral("group_%1").arg(aggregateRowIndex++);
+
+        QJsonObject row;
+        row[QStringLiteral("id")] = compactRowId;
+        row[QStringLiteral("rowId")] = compactRowId;
+        row[QStringLiteral("role")] = entry.isHighPriority ? QStringLiteral("priority") : QString();
+
+        QJsonObject values;
+        values[QStringLiteral("occurrences")] = QString::number(aggregateRow.occurrences);
+        values[QStringLiteral("sessions")] = QString::number(aggregateRow.sessions);
+        values[QStringLiteral("timestamp")] = QString::fromUtf8(entry.systemTime.c_str());
+        values[QStringLiteral("game_date")] = QString::fromUtf8(entry.gameTime.c_str());
+        values[QStringLiteral("category")] = categoryText;
+        values[QStringLiteral("message")] = buildPreviewText(QString::fromUtf8(entry.message.c_str()));
+        values[QStringLiteral("first_file")] = displayNameForFile(session, state.files, aggregateRow.firstFileName);
+        values[QStringLiteral("last_file")] = displayNameForFile(session, state.files, aggregateRow.lastFileName);
+        row[QStringLiteral("values")] = values;
+
+        QJsonObject stateObject;
+        stateObject[QStringLiteral("is_high_priority")] = entry.isHighPriority;
+        row[QStringLiteral("state")] = stateObject;
+
+        rows.append(row);
+    }
+    model[QStringLiteral("rows")] = rows;
+    return model;
+}
+
 QJsonObject buildEntriesModel(const WorkerSession* session, const StateSnapshot& state) {
+    if (state.isAggregateMode) {
+        return buildAggregateModel(session, state);
+    }
+
     QJsonObject model;
     model[QStringLiteral("id")] = QStringLiteral("log_entries");
     model[QStringLiteral("title")] = localizedString(session, QStringLiteral("ErrorLog"));
@@ -560,7 +660,7 @@ QJsonObject buildCompareModel(const WorkerSession* session, const StateSnapshot&
     model[QStringLiteral("columns")] = columns;
 
     QJsonArray rows;
-    int compareRowIndex = 0;
+    int compareRowIndex = static_cast<int>(state.compareRowsFirst);
     for (const CompareRow& compareRow : state.compareRows) {
         const QString leftValue = compareRow.hasLeft
             ? buildPreviewText(buildCompareCellText(compareRow.leftEntry))
@@ -652,6 +752,7 @@ QJsonObject buildTopbarState(const WorkerSession* session, const StateSnapshot&
     functionOrder.append(QStringLiteral("error_log::sort_time"));
     functionOrder.append(QStringLiteral("error_log::sort_category"));
     functionOrder.append(QStringLiteral("error_log::toggle_compare_mode"));
+    functionOrder.append(QStringLiteral("error_log::toggle_aggregate"));
     topbarState[QStringLiteral("functionOrder")] = functionOrder;
 
     topbarState[QStringLiteral("activeFunction")] = sortActionId(state.sortMode);
@@ -659,6 +760,7 @@ QJsonObject buildTopbarState(const WorkerSession* session, const StateSnapshot&
     topbarState[QStringLiteral("searchText")] = QString::fromUtf8(state.searchText.c_str());
     topbarState[QStringLiteral("searchPlaceholder")] = localizedString(session, QStringLiteral("SearchPlaceholder"));
     topbarState[QStringLiteral("compareMode")] = state.isCompareMode;
+    topbarState[QStringLiteral("aggregateMode")] = state.isAggregateMode;
 
     QJsonArray rightButtons;
     rightButtons.append(QJsonObject{
@@ -683,9 +785,7 @@ QJsonObject buildViewState(const WorkerSession* session, const StateSnapshot& st
     QJsonObject viewState;
     viewState[QStringLiteral("title")] = localizedString(session, QStringLiteral("ErrorLog"));
     viewState[QStringLiteral("pageTitle")] = localizedString(session, QStringLiteral("ErrorLog"));
-    viewState[QStringLiteral("resultTitle")] = state.isCompareMode
-        ? localizedString(session, QStringLiteral("CompareMode"))
-        : localizedString(session, QStringLiteral("ErrorLog"));
+    viewState[QStringLiteral("resultTitle")] = resultTitle(session, state);
     viewState[QStringLiteral("viewMode")] = viewModeKey(state);
     viewState[QStringLiteral("activeModelId")] = QString::fromUtf8(state.activeModelId.c_str());
     viewState[QStringLiteral("currentFileName")] = QString::fromUtf8(state.currentFileName.c_str());
@@ -696,10 +796,14 @@ QJsonObject buildViewState(const WorkerSession* session, const StateSnapshot& st
     viewState[QStringLiteral("compareTargetName")] = QString::fromUtf8(state.compareFileName.c_str());
     viewState[QStringLiteral("searchText")] = QString::fromUtf8(state.searchText.c_str());
     viewState[QStringLiteral("searchFilterActive")] = !state.searchText.empty();
+    viewState[QStringLiteral("categoryFilter")] = QString::fromUtf8(state.categoryFilter.c_str());
+    viewState[QStringLiteral("categoryFacets")] = serializeCategoryFacets(state.categoryFacets);
     viewState[QStringLiteral("sortMode")] = sortModeKey(state.sortMode);
     viewState[QStringLiteral("sortModeIndex")] = state.sortMode == SortMode::ByCategory ? 1 : 0;
     viewState[QStringLiteral("sortActionId")] = sortActionId(state.sortMode);
     viewState[QStringLiteral("isCompareMode")] = state.isCompareMode;
+    viewState[QStringLiteral("isAggregateMode")] = state.isAggregateMode;
+    viewState[QStringLiteral("tailMode")] = state.tailMode;
     viewState[QStringLiteral("hasCurrentFile")] = state.hasCurrentFile;
     viewState[QStringLiteral("hasCompareFile")] = state.hasCompareFile;
     viewState[QStringLiteral("hasFiles")] = state.hasFiles;
@@ -710,6 +814,19 @@ QJsonObject buildViewState(const WorkerSession* session, const StateSnapshot& st
     viewState[QStringLiteral("loading")] = serializeLoadingState(state.loading);
     viewState[QStringLiteral("statistics")] = serializeStatisticsState(state.statistics);
 
+    QJsonObject listWindows;
+    listWindows[QStringLiteral("log_entries")] = ToolListWindow::describe(
+        static_cast<int>(state.entriesFirst),
+        static_cast<int>(state.isAggregateMode ? state.aggregateRows.size() : state.entries.size()),
+        static_cast<int>(state.entriesTotal)
+    );
+    listWindows[QStringLiteral("compare_entries")] = ToolListWindow::describe(
+        static_cast<int>(state.compareRowsFirst),
+        static_cast<int>(state.compareRows.size()),
+        static_cast<int>(state.compareRowsTotal)
+    );
+    viewState[QStringLiteral("listWindows")] = listWindows;
+
     return viewState;
 }
 
@@ -730,11 +847,14 @@ QJsonObject buildRuntimeVariables(const WorkerSession* session, const StateSnaps
     runtimeVariables[QStringLiteral("compareFileName")] = QString::fromUtf8(state.compareFileName.c_str());
     runtimeVariables[QStringLiteral("compareFileDisplayName")] = displayNameForFile(session, state.files, state.compareFileName);
     runtimeVariables[QStringLiteral("searchText")] = QString::fromUtf8(state.searchText.c_str());
+    runtimeVariables[QStringLiteral("categoryFilter")] = QString::fromUtf8(state.categoryFilter.c_str());
     runtimeVariables[QStringLiteral("searchPlaceholder")] = localizedString(session, QStringLiteral("SearchPlaceholder"));
     runtimeVariables[QStringLiteral("sortMode")] = sortModeKey(state.sortMode);
     runtimeVariables[QStringLiteral("sortModeIndex")] = state.sortMode == SortMode::ByCategory ? 1 : 0;
     runtimeVariables[QStringLiteral("sortActionId")] = sortActionId(state.sortMode);
     runtimeVariables[QStringLiteral("isCompareMode")] = state.isCompareMode;
+    runtimeVariables[QStringLiteral("isAggregateMode")] = state.isAggregateMode;
+    runtimeVariables[QStringLiteral("tailMode")] = state.tailMode;
     runtimeVariables[QStringLiteral("hasCurrentFile")] = state.hasCurrentFile;
     runtimeVariables[QStringLiteral("hasCompareFile")] = state.hasCompareFile;
     runtimeVariables[QStringLiteral("hasFiles")] = state.hasFiles;
@@ -744,8 +864,8 @@ QJsonObject buildRuntimeVariables(const WorkerSession* session, const StateSnaps
     runtimeVariables[QStringLiteral("fileCount")] = state.statistics.fileCount;
     runtimeVariables[QStringLiteral("totalCount")] = state.statistics.totalCount;
     runtimeVariables[QStringLiteral("filteredCount")] = state.statistics.filteredCount;
-    runtimeVariables[QStringLiteral("statusMessage")] = state.isCompareMode
-        ? localizedString(session, QStringLiteral("CompareMode"))
+    runtimeVariables[QStringLiteral("statusMessage")] = state.isCompareMode || state.isAggregateMode
+        ? resultTitle(session, state)
         : localizedString(session, QStringLiteral("Ready"));
     runtimeVariables[QStringLiteral("emptyStateText")] = state.hasFiles
         ? localizedString(session, QStringLiteral("NoEntries"))
@@ -762,6 +882,16 @@ QJsonObject buildLegacyValues(const QJsonObject& viewState, const QJsonObject& r
     return values;
 }
 
+RowWindow rowWindowFor(const WorkerSession* session, const QString& listId) {
+    RowWindow window;
+    const ToolListWindow::Range range = session->viewports.requested(listId);
+    window.first = static_cast<std::size_t>(range.first);
+    if (range.count >= 0) {
+        window.count = static_cast<std::size_t>(range.count);
+    }
+    return window;
+}
+
 ToolWorkerResult refreshSessionState(WorkerSession* session) {
     if (!session) {
         return TOOL_WORKER_ERROR_INVALID_HANDLE;
@@ -951,15 +1081,18 @@ QJsonObject buildStatePacket(WorkerSession* session) {
         return packet;
     }
 
-    const StateSnapshot state = session->core.buildState();
+    const StateSnapshot state = session->core.buildState(
+        rowWindowFor(session, QStringLiteral("log_entries")),
+        rowWindowFor(session, QStringLiteral("compare_entries"))
+    );
     const QJsonObject viewState = buildViewState(session, state);
     const QJsonObject sidebarState = buildSidebarState(session, state);
     const QJsonObject topbarState = buildTopbarState(session, state);
     const QJsonObject runtimeVariables = buildRuntimeVariables(session, state);
     const QJsonArray listModels = buildListModels(session, state);
 
-    packet[QStringLiteral("modeId")] = state.isCompareMode
-        ? QStringLiteral("compare")
+    packet[QStringLiteral("modeId")] = state.isCompareMode || state.isAggregateMode
+        ? viewModeKey(state)
         : QStringLiteral("default");
     packet[QStringLiteral("viewState")] = viewState;
     packet[QStringLiteral("sidebarState")] = sidebarState;
@@ -974,15 +1107,13 @@ QJsonObject buildStatePacket(WorkerSession* session) {
     return packet;
 }
 
-char* serializeStatePacket(WorkerSession* session) {
+char* serializeStatePacket(WorkerSession* session, bool allowDelta) {
     if (!session) {
         const QByteArray emptyState = QJsonDocument(buildStatePacket(nullptr)).toJson(QJsonDocument::Compact);
         return allocateCString(emptyState);
     }
 
-    const QByteArray stateJson = QJsonDocument(buildStatePacket(session)).toJson(QJsonDocument::Compact);
-    session->lastSerializedState = stateJson.toStdString();
-    return allocateCString(stateJson);
+    return allocateCString(session->stateEncoder.encode(buildStatePacket(session), allowDelta));
 }
 
 ToolWorkerResult initializeSession(WorkerSession* session, const char* configJson) {
@@ -1007,7 +1138,8 @@ ToolWorkerResult initializeSession(WorkerSession* session, const char* configJso
     session->fileSystem = std::make_unique<ToolRuntimeFileSystem>();
     session->core.setFileSystem(session->fileSystem.get());
     session->lastError.clear();
-    session->lastSerializedState.clear();
+    session->stateEncoder.reset();
+    session->viewports.reset();
 
     if (!session->core.initialize()) {
         setSessionError(session, QString::fromUtf8(session->core.lastError().c_str()));
@@ -1048,6 +1180,19 @@ ToolWorkerResult applyActionInternal(WorkerSession* session,
         return TOOL_WORKER_SUCCESS;
     }
 
+    if (action == ToolListWindow::viewportActionName()) {
+        QString listId = argumentsObject.value(QStringLiteral("listId")).toString().trimmed();
+        if (listId.isEmpty() && targetId) {
+            listId = QString::fromUtf8(targetId).trimmed();
+        }
+        if (!session->viewports.update(listId, argumentsObject)) {
+            setSessionError(session, QStringLiteral("Invalid viewport for list '%1'.").arg(listId));
+            return TOOL_WORKER_ERROR_INVALID_ARGUMENT;
+        }
+        clearSessionError(session);
+        return TOOL_WORKER_SUCCESS;
+    }
+
     if (action == "on_file_context_menu"
         || action == "on_entry_context_menu"
         || action == "on_compare_context_menu") {
@@ -1165,7 +1310,7 @@ const char* handleWorkerAction(ToolWorkerHandle handle,
     if (outResult) {
         *outResult = result;
     }
-    return serializeStatePacket(session);
+    return serializeStatePacket(session, true);
 }
 
 const char* getWorkerCurrentState(ToolWorkerHandle handle, ToolWorkerResult* outResult) {
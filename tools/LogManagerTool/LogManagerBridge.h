@@ -9,6 +9,8 @@
 #ifndef LOGMANAGERBRIDGE_H
 #define LOGMANAGERBRIDGE_H
 
+#include "../../src/ToolListWindow.h"
+#include "../../src/ToolStatePatch.h"
 #include "../../src/ToolWorkerInterface.h"
 #include "main/LogManagerCore.h"
 #include "main/LogFileSystem.h"
@@ -32,7 +34,8 @@ struct WorkerSession {
     QString currentLanguageCode;
     QMap<QString, QString> localizedStrings;
     std::string lastError;
-    std::string lastSerializedState;
+    ToolStatePatch::StateEncoder stateEncoder;
+    ToolListWindow::ViewportSet viewports;
 };
 
 // Global legacy session for backward compatibility
@@ -47,7 +50,8 @@ WorkerSession* sessionFromHandle(ToolWorkerHandle handle);
 
 // State building and serialization
 QJsonObject buildStatePacket(WorkerSession* session);
-char* serializeStatePacket(WorkerSession* session);
+// Action responses may be deltas; state queries always return a full snapshot.
+char* serializeStatePacket(WorkerSession* session, bool allowDelta = false);
 
 // JSON parsing
 QJsonObject parseJsonObject(const char* jsonText);
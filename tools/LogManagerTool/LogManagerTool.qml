@@ -20,6 +20,10 @@ Rectangle {
     property string searchText: ""
     property string searchPlaceholder: ""
     property string sortMode: "time"
+    property bool tailMode: false
+    property bool aggregateMode: false
+    property string categoryFilter: ""
+    property var categoryFacets: []
     property string currentFileName: ""
     property string currentFileDisplayName: ""
     property string compareFileDisplayName: ""
@@ -27,10 +31,10 @@ Rectangle {
     property string selectedEntryId: ""
     property string selectedCompareId: ""
     property string pendingClipboardText: ""
+    property string pendingCategory: ""
     property bool initialFileSelectionRequested: false
     property string initialFileSelectionName: ""
     property string currentPage: "error_log"
-    property int stateRevision: 0
 
     readonly property var surfaces: toolTheme.surfaces
     readonly property var metrics: toolTheme.metrics
@@ -54,7 +58,6 @@ Rectangle {
     property var compareColumns: []
     property int mainRowCount: 0
     property int compareRowCount: 0
-    property int stateRevision: 0
 
     signal searchChanged(string text)
     signal rowSelected(string modelKind, var rowData)
@@ -104,6 +107,20 @@ Rectangle {
         return toolBridge.text(key, fallback)
     }
 
+    // Entry lists are windowed by the worker; rows outside the window are fetched on scroll.
+    function reportViewport() {
+        var listView = compareMode ? compareListView : mainListView
+        if (!listView.visible || listView.height <= 0) {
+            return
+        }
+        var firstVisible = Math.floor(Math.max(0, listView.contentY - listView.originY) / tableRowHeight)
+        toolBridge.setViewport(
+            compareMode ? compareModelId : mainModelId,
+            firstVisible,
+            Math.ceil(listView.height / tableRowHeight) + 1
+        )
+    }
+
     function rowValue(rowData, key, fallbackValue) {
         if (!rowData) {
             return fallbackValue === undefined ? "" : fallbackValue
@@ -319,8 +336,10 @@ Rectangle {
                 anchors.fill: parent
                 visible: !compareMode && hasFiles && mainRowCount > 0
                 clip: true
-                model: mainRowCount
+                model: toolBridge.listModel(root.mainModelId)
                 boundsBehavior: Flickable.StopAtBounds
+                onContentYChanged: root.reportViewport()
+                onHeightChanged: root.reportViewport()
                 ScrollBar.vertical: ScrollBar {
                     policy: ScrollBar.AlwaysOff
                 }
@@ -330,12 +349,7 @@ Rectangle {
                     width: mainListView.width
                     height: tableRowHeight
 
-                    property int rowIndex: index
-                    property int revisionToken: root.stateRevision
-                    property var rowData: {
-                        revisionToken
-                        return toolBridge.row(root.mainModelId, rowIndex)
-                    }
+                    property var rowData: model.rowData
                     property bool hovered: mainMouseArea.containsMouse
                     property string rowId: root.safeString(root.rowValue(rowData, "rowId", root.rowValue(rowData, "id", "")))
                     property bool selected: rowId === root.mainSelectedId
@@ -406,8 +420,10 @@ Rectangle {
                 anchors.fill: parent
                 visible: compareMode && hasFiles && compareRowCount > 0
                 clip: true
-                model: compareRowCount
+                model: toolBridge.listModel(root.compareModelId)
                 boundsBehavior: Flickable.StopAtBounds
+                onContentYChanged: root.reportViewport()
+                onHeightChanged: root.reportViewport()
                 ScrollBar.vertical: ScrollBar {
                     policy: ScrollBar.AlwaysOff
                 }
@@ -417,12 +433,7 @@ Rectangle {
                     width: compareListView.width
                     height: tableRowHeight
 
-                    property int rowIndex: index
-                    property int revisionToken: root.stateRevision
-                    property var rowData: {
-                        revisionToken
-                        return toolBridge.row(root.compareModelId, rowIndex)
-                    }
+                    property var rowData: model.rowData
                     property bool hovered: compareMouseArea.containsMouse
                     property string rowId: root.safeString(root.rowValue(rowData, "rowId", root.rowValue(rowData, "id", "")))
                     property bool selected: rowId === root.compareSelectedId
@@ -647,6 +658,7 @@ Rectangle {
     function openEntryContext(rowData, localX, localY) {
         selectedEntryId = safeString(rowValue(rowData, "rowId", rowValue(rowData, "id", "")))
         pendingClipboardText = entryClipboardText(rowData)
+        pendingCategory = safeString(rowValue(rowData, "category", ""))
         if (!pendingClipboardText.length) {
             return
         }
@@ -705,6 +717,10 @@ Rectangle {
             ? stateSearchPlaceholder
             : safeString(trText("SearchPlaceholder", "Search entries in the current view..."))
         sortMode = safeString(toolBridge.value("sortMode", "time"))
+        tailMode = !!toolBridge.value("tailMode", false)
+        aggregateMode = !!toolBridge.value("isAggregateMode", false)
+        categoryFilter = safeString(toolBridge.value("categoryFilter", ""))
+        categoryFacets = toolBridge.value("categoryFacets", []) || []
         currentFileName = safeString(toolBridge.value("currentFileName", ""))
         currentFileDisplayName = safeString(toolBridge.value("currentFileDisplayName", ""))
         compareFileDisplayName = safeString(toolBridge.value("compareFileDisplayName", ""))
@@ -723,8 +739,12 @@ Rectangle {
             initialFileSelectionName = currentFileName
         }
 
-        stateRevision += 1
+        if (loadingActive && (hasCurrentFile || aggregateMode)) {
+            continueLoadingTimer.restart()
+        }
+
         requestInitialCurrentFileLoad()
+        hostResultList.reportViewport()
     }
 
     Connections {
@@ -758,6 +778,25 @@ Rectangle {
         }
     }
 
+    Timer {
+        id: tailPollTimer
+        interval: 1000
+        repeat: true
+        running: root.tailMode && (root.hasCurrentFile || root.aggregateMode) && !root.loadingActive
+        onTriggered: root.dispatchAction("poll_tail", "", {})
+    }
+
+    Timer {
+        id: continueLoadingTimer
+        interval: 1  // Let each loaded step render before the worker reads the next one
+        repeat: false
+        onTriggered: {
+            if (root.loadingActive && (root.hasCurrentFile || root.aggregateMode)) {
+                root.dispatchAction("continue_loading", "", {})
+            }
+        }
+    }
+
     TextArea {
         id: clipboardBuffer
         x: -4096
@@ -802,6 +841,22 @@ Rectangle {
                     }
                 ],
                 "rightButtons": [
+                    {
+                        "actionId": "error_log::toggle_aggregate",
+                        "text": root.trText("AllSessions", "All Sessions"),
+                        "shortcut": "A",
+                        "checked": aggregateMode,
+                        "variant": "toolbar",
+                        "width": metrics.toolbarButtonWidth
+                    },
+                    {
+                        "actionId": "error_log::toggle_tail",
+                        "text": root.trText("LiveTail", "Live"),
+                        "shortcut": "L",
+                        "checked": tailMode,
+                        "variant": "toolbar",
+                        "width": metrics.toolbarButtonWidth
+                    },
                     {
                         "actionId": "error_log::sort_time",
                         "text": root.trText("SortByTime", "Time"),
@@ -825,6 +880,67 @@ Rectangle {
             }
         }
 
+        Rectangle {
+            Layout.fillWidth: true
+            Layout.preferredHeight: visible ? 40 : 0
+            visible: !root.compareMode && root.categoryFacets.length > 0
+            color: root.surfaces.window
+
+            ListView {
+                id: categoryFacetList
+                anchors.fill: parent
+                anchors.leftMargin: 10
+                anchors.rightMargin: 10
+                anchors.topMargin: 6
+                anchors.bottomMargin: 6
+                orientation: ListView.Horizontal
+                spacing: 6
+                clip: true
+                boundsBehavior: Flickable.StopAtBounds
+                model: root.categoryFacets
+
+                delegate: Rectangle {
+                    id: facetChip
+                    readonly property string facetName: root.safeString(modelData.name)
+                    readonly property bool facetSelected: !!modelData.selected
+
+                    width: facetChipText.implicitWidth + 20
+                    height: categoryFacetList.height
+                    radius: height / 2
+                    color: facetSelected
+                        ? toolTheme.colors.accent
+                        : (facetChipMouse.containsMouse ? toolTheme.colors.surfaceAlt : toolTheme.colors.surface)
+                    border.color: facetSelected || facetChipMouse.containsMouse
+                        ? toolTheme.colors.accent
+                        : toolTheme.dividers.default.color
+                    border.width: 1
+
+                    Text {
+                        id: facetChipText
+                        anchors.centerIn: parent
+                        text: facetChip.facetName + "  " + Number(modelData.count)
+                        color: facetChip.facetSelected ? toolTheme.colors.textInverted : toolTheme.colors.textPrimary
+                        font.family: toolTheme.fonts.body.family
+                        font.pixelSize: Number(toolTheme.fonts.body.pixelSize)
+                    }
+
+                    MouseArea {
+                        id: facetChipMouse
+                        anchors.fill: parent
+                        hoverEnabled: true
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: {
+                            if (facetChip.facetSelected) {
+                                root.dispatchAction("clear_category_filter", "", {})
+                                return
+                            }
+                            root.dispatchAction("set_category_filter", facetChip.facetName, { "category": facetChip.facetName })
+                        }
+                    }
+                }
+            }
+        }
+
         LogResultPane {
             id: hostResultList
             Layout.fillWidth: true
@@ -845,7 +961,6 @@ Rectangle {
             compareColumns: root.compareColumns
             mainRowCount: root.entryRowCount
             compareRowCount: root.compareRowCount
-            stateRevision: root.stateRevision
             onSearchChanged: function(text) {
                 dispatchAction("search_changed", "", { "text": text })
             }
@@ -872,7 +987,7 @@ Rectangle {
         anchors.fill: parent
         backdropSource: toolBridge.acrylicSource
         hostState: ({
-            "active": loadingActive,
+            "active": loadingActive && !hasCurrentFile,
             "text": loadingText.length ? loadingText : root.trText("LoadingLogs", "Loading logs...")
         })
     }
@@ -886,6 +1001,20 @@ Rectangle {
             text: root.trText("CopyFullEntry", "Copy Full Entry")
             onTriggered: root.copyToClipboard(root.pendingClipboardText)
         }
+
+        MenuItem {
+            text: root.trText("FilterCategory", "Only This Category")
+            visible: root.pendingCategory.length > 0 && root.pendingCategory !== root.categoryFilter
+            height: visible ? implicitHeight : 0
+            onTriggered: root.dispatchAction("set_category_filter", root.pendingCategory, { "category": root.pendingCategory })
+        }
+
+        MenuItem {
+            text: root.trText("ClearCategoryFilter", "Show All Categories")
+            visible: root.categoryFilter.length > 0
+            height: visible ? implicitHeight : 0
+            onTriggered: root.dispatchAction("clear_category_filter", "", {})
+        }
     }
 
     Menu {
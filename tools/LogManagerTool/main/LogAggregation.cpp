@@ -0,0 +1,161 @@
+//-------------------------------------------------------------------------------------
+// LogAggregation.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "LogAggregation.h"
+
+#include "LogKeyTable.h"
+#include "LogParallel.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace LogManager {
+
+namespace {
+
+// Below this many records per worker, starting threads costs more than it saves
+constexpr std::size_t kRecordsPerWorker = 1u << 16;
+
+// Group the keys of one hash partition; partitions own disjoint keys, so each can run on
+// its own thread.
+std::vector<AggregateGroup> aggregatePartition(const std::vector<const LogFileData*>& files,
+                                               const std::vector<char>& blankCategories,
+                                               std::size_t totalRecords,
+                                               uint32_t partition,
+                                               uint32_t partitionBits) {
+    const std::size_t expected = totalRecords >> partitionBits;
+    std::vector<AggregateGroup> groups;
+    groups.reserve(expected);
+    FlatKeyTable<AggregateGroup> table(expected);
+
+    for (uint32_t file = 0; file < static_cast<uint32_t>(files.size()); ++file) {
+        const std::vector<LogRecord>& records = files[file]->records;
+        for (uint32_t index = 0; index < static_cast<uint32_t>(records.size()); ++index) {
+            const LogRecord& record = records[index];
+            if (keyPartition(record.keyHash, partitionBits) != partition) {
+                continue;
+            }
+
+            bool inserted = false;
+            AggregateGroup& group = table.findOrInsert(record.keyHash, &groups, &inserted);
+            if (inserted) {
+                group.firstFile = file;
+                group.firstRecord = index;
+            }
+            if (inserted || blankCategories[group.category] != 0) {
+                group.category = record.category;
+            }
+            group.isHighPriority = group.isHighPriority || record.isHighPriority;
+            ++group.occurrences;
+            if (inserted || group.lastFile != file) {
+                ++group.sessions;
+                group.lastFile = file;
+            }
+        }
+    }
+    return groups;
+}
+
+} // namespace
+
+const std::vector<AggregateGroup>& LogAggregation::aggregate(const std::vector<const LogFileData*>& files,
+                                                             const LogCategoryTable& categories) {
+    bool changed = !m_hasGroups || files != m_files;
+    for (std::size_t file = 0; !changed && file < files.size(); ++file) {
+        changed = files[file]->index.generation() != m_generations[file];
+    }
+
+    if (changed) {
+        build(files, categories);
+        m_files = files;
+        m_generations.resize(files.size());
+        for (std::size_t file = 0; file < files.size(); ++file) {
+            m_generations[file] = files[file]->index.generation();
+        }
+        m_hasGroups = true;
+        m_hasOrder = false;
+    }
+    return m_groups;
+}
+
+const std::vector<uint32_t>& LogAggregation::order(SortMode mode, const std::vector<uint32_t>& ranks) {
+    if (m_hasOrder
+        && m_orderMode == mode
+        && m_order.size() == m_groups.size()
+        && (mode != SortMode::ByCategory || m_orderRanks == ranks)) {
+        return m_order;
+    }
+
+    // Groups are already in timeline order, which is what ByTime shows and ByCategory keeps
+    // within each category.
+    m_order.resize(m_groups.size());
+    std::iota(m_order.begin(), m_order.end(), 0u);
+    if (mode == SortMode::ByCategory) {
+        std::stable_sort(m_order.begin(), m_order.end(), [this, &ranks](uint32_t leftRow, uint32_t rightRow) {
+            const AggregateGroup& leftGroup = m_groups[leftRow];
+            const AggregateGroup& rightGroup = m_groups[rightRow];
+            if (leftGroup.isHighPriority != rightGroup.isHighPriority) {
+                return leftGroup.isHighPriority > rightGroup.isHighPriority;
+            }
+            return ranks[leftGroup.category] < ranks[rightGroup.category];
+        });
+    }
+
+    m_hasOrder = true;
+    m_orderMode = mode;
+    m_orderRanks = mode == SortMode::ByCategory ? ranks : std::vector<uint32_t>();
+    return m_order;
+}
+
+void LogAggregation::clear() {
+    m_files.clear();
+    m_generations.clear();
+    m_hasGroups = false;
+    m_groups.clear();
+    m_groups.shrink_to_fit();
+    m_hasOrder = false;
+    m_orderRanks.clear();
+    m_order.clear();
+    m_order.shrink_to_fit();
+}
+
+void LogAggregation::build(const std::vector<const LogFileData*>& files, const LogCategoryTable& categories) {
+    std::size_t totalRecords = 0;
+    for (const LogFileData* file : files) {
+        totalRecords += file->records.size();
+    }
+
+    const uint32_t partitionBits = keyPartitionBits(totalRecords, kRecordsPerWorker, hardwareWorkerCount());
+    const uint32_t partitions = 1u << partitionBits;
+
+    std::vector<char> blankCategories(categories.size(), 0);
+    for (uint32_t category = 0; category < static_cast<uint32_t>(blankCategories.size()); ++category) {
+        blankCategories[category] = categories.name(category).empty() ? 1 : 0;
+    }
+
+    std::vector<std::vector<AggregateGroup>> partitionGroups(partitions);
+    runParallel(partitions, partitions, [&](std::size_t partition) {
+        partitionGroups[partition] = aggregatePartition(
+            files, blankCategories, totalRecords, static_cast<uint32_t>(partition), partitionBits);
+    });
+
+    m_groups.clear();
+    for (std::vector<AggregateGroup>& groups : partitionGroups) {
+        m_groups.insert(m_groups.end(), groups.begin(), groups.end());
+        std::vector<AggregateGroup>().swap(groups);
+    }
+
+    // Each partition is in first-occurrence order already; merging them makes the timeline.
+    std::sort(m_groups.begin(), m_groups.end(), [](const AggregateGroup& left, const AggregateGroup& right) {
+        return left.firstFile != right.firstFile
+            ? left.firstFile < right.firstFile
+            : left.firstRecord < right.firstRecord;
+    });
+}
+
+} // namespace LogManager
@@ -0,0 +1,64 @@
+//-------------------------------------------------------------------------------------
+// LogAggregation.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LOGAGGREGATION_H
+#define LOGAGGREGATION_H
+
+#include "LogEntry.h"
+#include "LogParser.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace LogManager {
+
+// One distinct entry across the aggregated files. File positions index the file list that
+// was passed to LogAggregation::aggregate().
+struct AggregateGroup {
+    uint64_t keyHash = 0;
+    uint32_t category = 0;
+    bool isHighPriority = false;
+    uint32_t occurrences = 0;
+    uint32_t sessions = 0;     // Files with at least one occurrence
+    uint32_t firstFile = 0;
+    uint32_t firstRecord = 0;  // Record of the first occurrence, the one shown for the group
+    uint32_t lastFile = 0;
+};
+
+// Groups the records of several log files by key hash, counting occurrences and sessions.
+//
+// Files are given oldest first, so groups come out as a timeline: ordered by the session and
+// position of their first occurrence. Duplicates are only counted, never materialized. The
+// result is kept until the file list or any file's records change.
+class LogAggregation {
+public:
+    const std::vector<AggregateGroup>& aggregate(const std::vector<const LogFileData*>& files,
+                                                 const LogCategoryTable& categories);
+
+    // Group indices sorted for the view. ranks orders categories and is only used by ByCategory.
+    const std::vector<uint32_t>& order(SortMode mode, const std::vector<uint32_t>& ranks);
+
+    void clear();
+
+private:
+    void build(const std::vector<const LogFileData*>& files, const LogCategoryTable& categories);
+
+    std::vector<const LogFileData*> m_files;
+    std::vector<uint64_t> m_generations;
+    bool m_hasGroups = false;
+    std::vector<AggregateGroup> m_groups;
+
+    bool m_hasOrder = false;
+    SortMode m_orderMode = SortMode::ByTime;
+    std::vector<uint32_t> m_orderRanks;
+    std::vector<uint32_t> m_order;
+};
+
+} // namespace LogManager
+
+#endif // LOGAGGREGATION_H
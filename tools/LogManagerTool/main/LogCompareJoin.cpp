@@ -0,0 +1,173 @@
+//-------------------------------------------------------------------------------------
+// LogCompareJoin.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "LogCompareJoin.h"
+
+#include "LogKeyTable.h"
+#include "LogParallel.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace LogManager {
+
+namespace {
+
+// Below this many records per worker, starting threads costs more than it saves
+constexpr std::size_t kRecordsPerWorker = 1u << 16;
+
+// Join the keys of one hash partition. Each finished slot is stored at the position of the
+// record that opened it, in leftFirst or rightFirst; partitions own disjoint keys, so their
+// writes never overlap.
+void joinPartition(const LogFileData& left,
+                   const LogFileData& right,
+                   const std::vector<char>& blankCategories,
+                   uint32_t partition,
+                   uint32_t partitionBits,
+                   std::vector<CompareSlot>* leftFirst,
+                   std::vector<CompareSlot>* rightFirst) {
+    const std::size_t expected = (left.records.size() + right.records.size()) >> partitionBits;
+    std::vector<CompareSlot> slots;
+    slots.reserve(expected);
+    FlatKeyTable<CompareSlot> table(expected);
+
+    auto addRecord = [&](const LogRecord& record, int32_t index, bool isLeft) {
+        if (keyPartition(record.keyHash, partitionBits) != partition) {
+            return;
+        }
+
+        bool inserted = false;
+        CompareSlot& slot = table.findOrInsert(record.keyHash, &slots, &inserted);
+        if (inserted || blankCategories[slot.category] != 0) {
+            slot.category = record.category;
+        }
+        slot.isHighPriority = slot.isHighPriority || record.isHighPriority;
+
+        if (isLeft && slot.left < 0) {
+            slot.left = index;
+        }
+        if (!isLeft && slot.right < 0) {
+            slot.right = index;
+        }
+    };
+
+    for (std::size_t index = 0; index < left.records.size(); ++index) {
+        addRecord(left.records[index], static_cast<int32_t>(index), true);
+    }
+    for (std::size_t index = 0; index < right.records.size(); ++index) {
+        addRecord(right.records[index], static_cast<int32_t>(index), false);
+    }
+
+    for (const CompareSlot& slot : slots) {
+        if (slot.left >= 0) {
+            (*leftFirst)[static_cast<std::size_t>(slot.left)] = slot;
+        } else {
+            (*rightFirst)[static_cast<std::size_t>(slot.right)] = slot;
+        }
+    }
+}
+
+} // namespace
+
+const std::vector<CompareSlot>& LogCompareJoin::join(const LogFileData& left,
+                                                     const LogFileData& right,
+                                                     const LogCategoryTable& categories) {
+    if (m_left != &left
+        || m_right != &right
+        || m_leftGeneration != left.index.generation()
+        || m_rightGeneration != right.index.generation()) {
+        build(left, right, categories);
+        m_left = &left;
+        m_right = &right;
+        m_leftGeneration = left.index.generation();
+        m_rightGeneration = right.index.generation();
+        m_hasOrder = false;
+    }
+    return m_slots;
+}
+
+const std::vector<uint32_t>& LogCompareJoin::order(SortMode mode, const std::vector<uint32_t>& ranks) {
+    if (m_hasOrder
+        && m_orderMode == mode
+        && m_order.size() == m_slots.size()
+        && (mode != SortMode::ByCategory || m_orderRanks == ranks)) {
+        return m_order;
+    }
+
+    m_order.resize(m_slots.size());
+    std::iota(m_order.begin(), m_order.end(), 0u);
+    std::stable_sort(m_order.begin(), m_order.end(), [this, mode, &ranks](uint32_t leftRow, uint32_t rightRow) {
+        const CompareSlot& leftSlot = m_slots[leftRow];
+        const CompareSlot& rightSlot = m_slots[rightRow];
+        if (mode == SortMode::ByCategory) {
+            if (leftSlot.isHighPriority != rightSlot.isHighPriority) {
+                return leftSlot.isHighPriority > rightSlot.isHighPriority;
+            }
+            if (ranks[leftSlot.category] != ranks[rightSlot.category]) {
+                return ranks[leftSlot.category] < ranks[rightSlot.category];
+            }
+        }
+
+        const int32_t leftIndex = leftSlot.left >= 0 ? leftSlot.left : leftSlot.right;
+        const int32_t rightIndex = rightSlot.left >= 0 ? rightSlot.left : rightSlot.right;
+        return leftIndex < rightIndex;
+    });
+
+    m_hasOrder = true;
+    m_orderMode = mode;
+    m_orderRanks = mode == SortMode::ByCategory ? ranks : std::vector<uint32_t>();
+    return m_order;
+}
+
+void LogCompareJoin::clear() {
+    m_left = nullptr;
+    m_right = nullptr;
+    m_leftGeneration = 0;
+    m_rightGeneration = 0;
+    m_slots.clear();
+    m_slots.shrink_to_fit();
+    m_hasOrder = false;
+    m_orderRanks.clear();
+    m_order.clear();
+    m_order.shrink_to_fit();
+}
+
+void LogCompareJoin::build(const LogFileData& left, const LogFileData& right, const LogCategoryTable& categories) {
+    // One partition per worker; a power of two so the top hash bits select it.
+    const uint32_t partitionBits = keyPartitionBits(
+        left.records.size() + right.records.size(), kRecordsPerWorker, hardwareWorkerCount());
+    const uint32_t partitions = 1u << partitionBits;
+
+    // Looked up once here rather than per record from every worker
+    std::vector<char> blankCategories(categories.size(), 0);
+    for (uint32_t category = 0; category < static_cast<uint32_t>(blankCategories.size()); ++category) {
+        blankCategories[category] = categories.name(category).empty() ? 1 : 0;
+    }
+
+    std::vector<CompareSlot> leftFirst(left.records.size());
+    std::vector<CompareSlot> rightFirst(right.records.size());
+    runParallel(partitions, partitions, [&](std::size_t partition) {
+        joinPartition(left, right, blankCategories, static_cast<uint32_t>(partition), partitionBits,
+                      &leftFirst, &rightFirst);
+    });
+
+    // Records that opened a slot, in file order, give the first-occurrence row order.
+    m_slots.clear();
+    for (std::size_t index = 0; index < leftFirst.size(); ++index) {
+        if (leftFirst[index].left == static_cast<int32_t>(index)) {
+            m_slots.push_back(leftFirst[index]);
+        }
+    }
+    for (std::size_t index = 0; index < rightFirst.size(); ++index) {
+        if (rightFirst[index].right == static_cast<int32_t>(index)) {
+            m_slots.push_back(rightFirst[index]);
+        }
+    }
+}
+
+} // namespace LogManager
@@ -0,0 +1,63 @@
+//-------------------------------------------------------------------------------------
+// LogCompareJoin.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LOGCOMPAREJOIN_H
+#define LOGCOMPAREJOIN_H
+
+#include "LogEntry.h"
+#include "LogParser.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace LogManager {
+
+// One row of the compare view before materialization; left and right are record indices
+struct CompareSlot {
+    uint64_t keyHash = 0;
+    uint32_t category = 0;
+    bool isHighPriority = false;
+    int32_t left = -1;
+    int32_t right = -1;
+};
+
+// Pairs the records of two log files by key hash.
+//
+// Rows come out in first-occurrence order: every distinct key of the left file in the order it
+// first appears, then the keys only found in the right file. Each row points at the first record
+// of its key on either side. The join is kept until either file's records change, so repeated
+// state builds and searches only cost a pass over the cached rows.
+class LogCompareJoin {
+public:
+    const std::vector<CompareSlot>& join(const LogFileData& left,
+                                         const LogFileData& right,
+                                         const LogCategoryTable& categories);
+
+    // Row indices sorted for the view. ranks orders categories and is only used by ByCategory.
+    const std::vector<uint32_t>& order(SortMode mode, const std::vector<uint32_t>& ranks);
+
+    void clear();
+
+private:
+    void build(const LogFileData& left, const LogFileData& right, const LogCategoryTable& categories);
+
+    const LogFileData* m_left = nullptr;
+    const LogFileData* m_right = nullptr;
+    uint64_t m_leftGeneration = 0;
+    uint64_t m_rightGeneration = 0;
+    std::vector<CompareSlot> m_slots;
+
+    bool m_hasOrder = false;
+    SortMode m_orderMode = SortMode::ByTime;
+    std::vector<uint32_t> m_orderRanks;
+    std::vector<uint32_t> m_order;
+};
+
+} // namespace LogManager
+
+#endif // LOGCOMPAREJOIN_H
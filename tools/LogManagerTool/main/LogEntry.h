@@ -9,6 +9,11 @@
 #ifndef LOGENTRY_H
 #define LOGENTRY_H
 
+#include "LogSearchIndex.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -31,13 +36,55 @@ struct LogEntry {
     int originalIndex = -1;
 };
 
+// Byte range inside the text retained by LogFileData
+struct TextSpan {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+// Stored form of a log entry: spans into the file text and an interned category id.
+// LogEntry values are only materialized for the rows a snapshot actually shows.
+struct LogRecord {
+    TextSpan systemTime;
+    TextSpan gameTime;
+    TextSpan message;          // Trimmed; may still contain "\r\n" line breaks
+    uint32_t category = 0;     // Index into LogCategoryTable
+    uint64_t keyHash = 0;      // Hash of the normalized key, used to pair compare rows
+    bool isHighPriority = false;
+};
+
+// Parser state just before finishing, kept so appended text can resume the last line
+struct LogResumePoint {
+    std::size_t recordCount = 0;
+    std::size_t parsedBytes = 0;
+    bool hasOpenRecord = false;
+    LogRecord openRecord;
+};
+
+// Text of one log file and the records parsed from it so far. Files are read in steps,
+// so the data stays partial until complete is set.
+struct LogFileData {
+    std::string text;
+    std::vector<LogRecord> records;
+    uint64_t fileSize = 0;
+    std::size_t parsedBytes = 0;  // Prefix of text already split into lines
+    bool hasOpenRecord = false;   // openRecord may still gain continuation lines
+    LogRecord openRecord;
+    bool complete = false;
+    LogResumePoint resumePoint;   // Valid while complete
+    LogSearchIndex index;         // Covers every entry of records
+};
+
 // Log file record structure
 struct LogFileRecord {
     std::string displayName;
     std::string sourcePath;
     bool isLatest = false;
     bool isLoaded = false;
-    std::vector<LogEntry> entries;
+    std::shared_ptr<LogFileData> data;
+
+    std::size_t entryCount() const noexcept { return data ? data->records.size() : 0; }
+    bool isComplete() const noexcept { return data && data->complete; }
 };
 
 // Compare row structure for side-by-side comparison
@@ -51,6 +98,15 @@ struct CompareRow {
     LogEntry rightEntry;
 };
 
+// Aggregate row: the first occurrence of an entry and how often it recurs across sessions
+struct AggregateRow {
+    LogEntry entry;
+    std::string firstFileName;
+    std::string lastFileName;
+    int occurrences = 0;
+    int sessions = 0;
+};
+
 // Loading state snapshot for UI rendering
 struct LoadingStateSnapshot {
     bool active = false;
@@ -58,6 +114,13 @@ struct LoadingStateSnapshot {
     std::string text;
 };
 
+// Number of filtered entries per category, for category filtering
+struct CategoryFacet {
+    std::string name;
+    int count = 0;
+    bool selected = false;
+};
+
 // Statistics snapshot for UI rendering
 struct StatisticsSnapshot {
     int fileCount = 0;
@@ -65,21 +128,39 @@ struct StatisticsSnapshot {
     int filteredCount = 0;
 };
 
+// Slice of a list to include in a snapshot; the default covers every row
+struct RowWindow {
+    std::size_t first = 0;
+    std::size_t count = static_cast<std::size_t>(-1);
+};
+
 // State snapshot for UI rendering
 struct StateSnapshot {
     std::string currentFileName;
     std::string compareFileName;
     std::string searchText;
+    std::string categoryFilter;
     std::string viewMode;
     std::string activeModelId;
     SortMode sortMode = SortMode::ByTime;
     bool isCompareMode = false;
+    bool isAggregateMode = false;
+    bool tailMode = false;
     bool hasCurrentFile = false;
     bool hasCompareFile = false;
     bool hasFiles = false;
     std::vector<LogFileRecord> files;
     std::vector<LogEntry> entries;
     std::vector<CompareRow> compareRows;
+    std::vector<AggregateRow> aggregateRows;  // Replaces entries in aggregate mode
+    // entries (or aggregateRows) and compareRows hold a window of the filtered lists; these
+    // locate it
+    std::size_t entriesFirst = 0;
+    std::size_t entriesTotal = 0;
+    std::size_t compareRowsFirst = 0;
+    std::size_t compareRowsTotal = 0;
+    // Categories seen in the search results, before the category filter is applied
+    std::vector<CategoryFacet> categoryFacets;
     LoadingStateSnapshot loading;
     StatisticsSnapshot statistics;
 };
@@ -9,6 +9,7 @@
 #ifndef LOGFILESYSTEM_H
 #define LOGFILESYSTEM_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -33,6 +34,13 @@ struct TextReadResult {
     std::string content;
 };
 
+// Byte range read result; fileSize is the size of the whole file
+struct ByteRangeReadResult {
+    bool success;
+    std::string content;
+    uint64_t fileSize;
+};
+
 // Abstract file system interface
 class IFileSystem {
 public:
@@ -43,6 +51,11 @@ public:
     
     // Read text file
     virtual TextReadResult readTextFile(const std::string& relativePath) const = 0;
+
+    // Read at most maxBytes starting at offset
+    virtual ByteRangeReadResult readFileRange(const std::string& relativePath,
+                                              uint64_t offset,
+                                              uint64_t maxBytes) const = 0;
 };
 
 } // namespace LogManager
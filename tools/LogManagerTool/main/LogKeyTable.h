@@ -0,0 +1,105 @@
+//-------------------------------------------------------------------------------------
+// LogKeyTable.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LOGKEYTABLE_H
+#define LOGKEYTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace LogManager {
+
+// FNV-1a leaves the low bits poorly mixed. Joins pick a partition from the top bits and a
+// bucket from the low bits, so both need the full hash folded in.
+inline uint64_t mixKeyHash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Partition of a key hash when the keys are split into 1 << partitionBits partitions
+inline uint32_t keyPartition(uint64_t hash, uint32_t partitionBits) {
+    return partitionBits == 0 ? 0 : static_cast<uint32_t>(mixKeyHash(hash) >> (64 - partitionBits));
+}
+
+// Open-addressing table from key hash to the index of its slot. Slot must have a keyHash
+// member; the slots live in a separate vector, so the table itself is only a flat array of
+// indices probed linearly.
+template <typename Slot>
+class FlatKeyTable {
+public:
+    explicit FlatKeyTable(std::size_t expected) {
+        std::size_t capacity = 16;
+        while (capacity < expected * 2) {
+            capacity *= 2;
+        }
+        m_buckets.assign(capacity, kEmpty);
+    }
+
+    // Slot of hash, appending a new one to slots when the key has not been seen
+    Slot& findOrInsert(uint64_t hash, std::vector<Slot>* slots, bool* inserted) {
+        if ((slots->size() + 1) * 2 > m_buckets.size()) {
+            grow(*slots);
+        }
+
+        const std::size_t mask = m_buckets.size() - 1;
+        for (std::size_t bucket = mixKeyHash(hash) & mask;; bucket = (bucket + 1) & mask) {
+            const uint32_t slot = m_buckets[bucket];
+            if (slot == kEmpty) {
+                m_buckets[bucket] = static_cast<uint32_t>(slots->size());
+                slots->emplace_back();
+                slots->back().keyHash = hash;
+                *inserted = true;
+                return slots->back();
+            }
+            if ((*slots)[slot].keyHash == hash) {
+                *inserted = false;
+                return (*slots)[slot];
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t kEmpty = 0xFFFFFFFFu;
+
+    void grow(const std::vector<Slot>& slots) {
+        m_buckets.assign(m_buckets.size() * 2, kEmpty);
+        const std::size_t mask = m_buckets.size() - 1;
+        for (uint32_t slot = 0; slot < static_cast<uint32_t>(slots.size()); ++slot) {
+            std::size_t bucket = mixKeyHash(slots[slot].keyHash) & mask;
+            while (m_buckets[bucket] != kEmpty) {
+                bucket = (bucket + 1) & mask;
+            }
+            m_buckets[bucket] = slot;
+        }
+    }
+
+    std::vector<uint32_t> m_buckets;
+};
+
+// Partition count for joining totalRecords records: one per worker that would have at least
+// recordsPerWorker records, rounded down to a power of two.
+inline uint32_t keyPartitionBits(std::size_t totalRecords, std::size_t recordsPerWorker, std::size_t maxWorkers) {
+    std::size_t workers = totalRecords / recordsPerWorker;
+    if (workers > maxWorkers) {
+        workers = maxWorkers;
+    }
+    uint32_t partitionBits = 0;
+    while ((std::size_t(1) << (partitionBits + 1)) <= workers) {
+        ++partitionBits;
+    }
+    return partitionBits;
+}
+
+} // namespace LogManager
+
+#endif // LOGKEYTABLE_H
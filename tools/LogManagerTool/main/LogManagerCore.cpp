@@ -8,16 +8,64 @@
 //-------------------------------------------------------------------------------------
 #include "LogManagerCore.h"
 
+#include "LogParallel.h"
+
 #include <algorithm>
 #include <cctype>
 #include <initializer_list>
 #include <map>
+#include <numeric>
+#include <string_view>
 #include <utility>
 
 namespace LogManager {
 
 namespace {
 
+// Files are read in steps of this size; each step is parsed and shown before the next.
+constexpr uint64_t kLoadStepBytes = 4ULL * 1024 * 1024;
+// Tail reads start this many already-read bytes early; if those bytes changed, the file was
+// replaced rather than appended to.
+constexpr uint64_t kTailAnchorBytes = 256;
+
+// Locate the window in a list of total rows, sliding it back from the end so a list that shrank
+// under the viewport still fills it. Returns the first row and stores the row count.
+std::size_t clampWindow(std::size_t total, const RowWindow& window, std::size_t* count) {
+    *count = std::min(window.count, total);
+    return std::min(window.first, total - *count);
+}
+
+// needle must already be lower case
+bool containsCaseInsensitive(std::string_view haystack, std::string_view needle) {
+    if (needle.empty()) {
+        return true;
+    }
+    if (haystack.size() < needle.size()) {
+        return false;
+    }
+
+    const std::size_t last = haystack.size() - needle.size();
+    for (std::size_t position = 0; position <= last; ++position) {
+        if (static_cast<char>(std::tolower(static_cast<unsigned char>(haystack[position]))) != needle[0]) {
+            continue;
+        }
+        std::size_t matched = 1;
+        while (matched < needle.size()
+               && static_cast<char>(std::tolower(static_cast<unsigned char>(haystack[position + matched])))
+                   == needle[matched]) {
+            ++matched;
+        }
+        if (matched == needle.size()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string_view spanView(const LogFileData& data, const TextSpan& span) {
+    return std::string_view(data.text.data() + span.offset, span.length);
+}
+
 // Convert string to lowercase.
 std::string toLower(std::string value) {
     std::transform(value.begin(), value.end(), value.begin(), [](unsigned char character) {
@@ -42,30 +90,34 @@ std::string trim(const std::string& value) {
     return std::string(begin, end);
 }
 
-// Replace all occurrences in string.
-std::string replaceAll(std::string value, const std::string& from, const std::string& to) {
-    if (from.empty()) {
-        return value;
-    }
+// Split search text into lower-cased terms on whitespace. Double quotes keep the spaces of a
+// phrase inside one term; a line break always ends a term.
+std::vector<std::string> parseSearchTerms(const std::string& value) {
+    std::vector<std::string> terms;
+    std::string current;
+    bool quoted = false;
+    auto flush = [&terms, &current]() {
+        const std::string term = trim(current);
+        if (!term.empty() && std::find(terms.begin(), terms.end(), term) == terms.end()) {
+            terms.push_back(term);
+        }
+        current.clear();
+    };
 
-    std::size_t position = 0;
-    while ((position = value.find(from, position)) != std::string::npos) {
-        value.replace(position, from.length(), to);
-        position += to.length();
+    for (const unsigned char character : value) {
+        if (character == '"') {
+            flush();
+            quoted = !quoted;
+            continue;
+        }
+        if (std::isspace(character) != 0 && (!quoted || character == '\n' || character == '\r')) {
+            flush();
+            continue;
+        }
+        current.push_back(static_cast<char>(std::tolower(character)));
     }
-    return value;
-}
-
-// Normalize newlines.
-std::string normalizeNewlines(std::string value) {
-    value = replaceAll(std::move(value), "\r\n", "\n");
-    value = replaceAll(std::move(value), "\r", "\n");
-    return value;
-}
-
-// Normalize search text.
-std::string normalizeSearchText(const std::string& value) {
-    return toLower(trim(normalizeNewlines(value)));
+    flush();
+    return terms;
 }
 
 // Case-insensitive string comparison.
@@ -140,6 +192,14 @@ std::string normalizeViewModeValue(const std::string& value) {
         return "compare";
     }
 
+    if (normalized == "aggregate"
+        || normalized == "aggregation"
+        || normalized == "sessions"
+        || normalized == "all_sessions"
+        || normalized == "timeline") {
+        return "aggregate";
+    }
+
     return std::string();
 }
 
@@ -153,18 +213,26 @@ bool LogManagerCore::initialize() {
 
     m_scanner.setFileSystem(m_fileSystem);
     m_files.clear();
+    m_categories.clear();
     m_currentFileName.clear();
     m_compareFileName.clear();
     m_searchText.clear();
+    m_categoryFilter.clear();
+    m_termMatches.clear();
+    m_compareJoin.clear();
     m_sortMode = SortMode::ByTime;
+    m_tailMode = false;
+    m_aggregateMode = false;
+    m_aggregation.clear();
     clearError();
     return true;
 }
 
 bool LogManagerCore::refreshFiles(bool loadSelectedFile) {
     std::map<std::string, LogFileRecord> cachedLoadedFiles;
+    // Latest files are kept too; loading one again only reads what was appended since.
     for (const LogFileRecord& record : m_files) {
-        if (!record.isLoaded || record.isLatest) {
+        if (!record.isLoaded) {
             continue;
         }
         cachedLoadedFiles.insert_or_assign(record.displayName, record);
@@ -173,10 +241,6 @@ bool LogManagerCore::refreshFiles(bool loadSelectedFile) {
     std::vector<LogFileRecord> discoveredFiles = m_scanner.scanLogFiles();
 
     for (LogFileRecord& record : discoveredFiles) {
-        if (record.isLatest) {
-            continue;
-        }
-
         const auto cachedIterator = cachedLoadedFiles.find(record.displayName);
         if (cachedIterator == cachedLoadedFiles.end()) {
             continue;
@@ -186,7 +250,7 @@ bool LogManagerCore::refreshFiles(bool loadSelectedFile) {
         }
 
         record.isLoaded = true;
-        record.entries = cachedIterator->second.entries;
+        record.data = cachedIterator->second.data;
     }
 
     m_files = std::move(discoveredFiles);
@@ -203,6 +267,9 @@ bool LogManagerCore::refreshFiles(bool loadSelectedFile) {
         return true;
     }
 
+    if (loadSelectedFile && m_aggregateMode) {
+        return loadAggregateFiles();
+    }
     if (loadSelectedFile) {
         if (!m_currentFileName.empty() && !loadFile(m_currentFileName)) {
             return false;
@@ -231,6 +298,7 @@ bool LogManagerCore::selectFile(const std::string& displayName) {
 
     m_currentFileName = displayName;
     m_compareFileName.clear();
+    stopAggregate();
     clearError();
     return true;
 }
@@ -257,12 +325,14 @@ bool LogManagerCore::startCompare(const std::string& displayName) {
     }
 
     m_compareFileName = displayName;
+    stopAggregate();
     clearError();
     return true;
 }
 
 void LogManagerCore::stopCompare() {
     m_compareFileName.clear();
+    m_compareJoin.clear();
     clearError();
 }
 
@@ -275,9 +345,14 @@ bool LogManagerCore::switchViewMode(const std::string& viewMode, const std::stri
 
     if (normalizedViewMode == "normal") {
         stopCompare();
+        stopAggregate();
         return true;
     }
 
+    if (normalizedViewMode == "aggregate") {
+        return startAggregate();
+    }
+
     if (normalizedViewMode == "compare") {
         if (!compareDisplayName.empty()) {
             return startCompare(compareDisplayName);
@@ -294,24 +369,99 @@ bool LogManagerCore::switchViewMode(const std::string& viewMode, const std::stri
     return false;
 }
 
+bool LogManagerCore::startAggregate() {
+    if (m_files.empty()) {
+        setError("No log files to aggregate.");
+        return false;
+    }
+
+    stopCompare();
+    m_aggregateMode = true;
+    return loadAggregateFiles();
+}
+
+void LogManagerCore::stopAggregate() {
+    m_aggregateMode = false;
+    m_aggregation.clear();
+}
+
 void LogManagerCore::setSearchText(const std::string& text) {
     m_searchText = text;
     clearError();
 }
 
+void LogManagerCore::setCategoryFilter(const std::string& category) {
+    m_categoryFilter = category;
+    clearError();
+}
+
 void LogManagerCore::setSortMode(SortMode mode) {
     m_sortMode = mode;
     clearError();
 }
 
-StateSnapshot LogManagerCore::buildState() const {
+bool LogManagerCore::continueLoading() {
+    std::vector<LogFileRecord*> pending;
+    for (LogFileRecord* record : shownFiles()) {
+        if (record->data && !record->data->complete) {
+            pending.push_back(record);
+        }
+    }
+
+    const bool success = loadNextSteps(pending);
+    if (success) {
+        clearError();
+    }
+    return success;
+}
+
+void LogManagerCore::setTailMode(bool enabled) {
+    m_tailMode = enabled;
+    clearError();
+}
+
+bool LogManagerCore::pollTail() {
+    if (!m_tailMode) {
+        clearError();
+        return true;
+    }
+
+    bool success = true;
+    for (LogFileRecord* record : shownFiles()) {
+        // Crash logs are finished; in aggregate mode only the latest log can still grow.
+        if (m_aggregateMode && !record->isLatest) {
+            continue;
+        }
+        if (record->data && !readAppended(record)) {
+            success = false;
+        }
+    }
+    if (success) {
+        clearError();
+    }
+    return success;
+}
+
+bool LogManagerCore::isLoading() const {
+    for (const LogFileRecord* record : shownFiles()) {
+        if (record->data && !record->data->complete) {
+            return true;
+        }
+    }
+    return false;
+}
+
+StateSnapshot LogManagerCore::buildState(const RowWindow& entryWindow, const RowWindow& compareWindow) const {
     StateSnapshot snapshot;
     snapshot.currentFileName = m_currentFileName;
     snapshot.compareFileName = m_compareFileName;
     snapshot.searchText = m_searchText;
+    snapshot.categoryFilter = m_categoryFilter;
     snapshot.sortMode = m_sortMode;
     snapshot.isCompareMode = isCompareMode();
-    snapshot.viewMode = snapshot.isCompareMode ? "compare" : "normal";
+    snapshot.isAggregateMode = m_aggregateMode;
+    snapshot.tailMode = m_tailMode;
+    snapshot.viewMode = snapshot.isCompareMode ? "compare" : (snapshot.isAggregateMode ? "aggregate" : "normal");
     snapshot.activeModelId = snapshot.isCompareMode ? "compare_entries" : "log_entries";
     snapshot.files = m_files;
     snapshot.hasFiles = !m_files.empty();
@@ -323,24 +473,92 @@ StateSnapshot LogManagerCore::buildState() const {
 
     // OPTIMIZATION: Only build entries and compare rows if files are actually loaded.
     // This prevents unnecessary processing when displaying the file list before content is loaded.
-    if (snapshot.hasCurrentFile || snapshot.hasCompareFile) {
-        snapshot.entries = sortEntries(buildFilteredEntries());
-        snapshot.compareRows = buildCompareRows();
+    ++m_searchPass;
+    const std::vector<std::string> terms = parseSearchTerms(m_searchText);
+    std::size_t compareTotalCount = 0;
+    std::size_t aggregateTotalCount = 0;
+    if (snapshot.isAggregateMode) {
+        // Only complete files are grouped, so the groups are rebuilt once per finished file
+        // rather than after every loading step.
+        const std::vector<const LogFileRecord*> sessions = aggregateSessions();
+        std::vector<const LogFileData*> sessionData;
+        sessionData.reserve(sessions.size());
+        for (const LogFileRecord* session : sessions) {
+            sessionData.push_back(session->data.get());
+        }
+
+        const std::vector<AggregateGroup>& groups = m_aggregation.aggregate(sessionData, m_categories);
+        const std::vector<uint32_t> rows = filterAggregateGroups(groups, sessionData, terms, &snapshot.categoryFacets);
+        aggregateTotalCount = groups.size();
+
+        std::size_t count = 0;
+        snapshot.entriesTotal = rows.size();
+        snapshot.entriesFirst = clampWindow(rows.size(), entryWindow, &count);
+        snapshot.aggregateRows.reserve(count);
+        for (std::size_t row = snapshot.entriesFirst; row < snapshot.entriesFirst + count; ++row) {
+            snapshot.aggregateRows.push_back(materializeAggregateRow(groups[rows[row]], sessions));
+        }
+    } else if (snapshot.hasCurrentFile) {
+        const LogFileData& data = *currentFile->data;
+        std::vector<uint32_t> indices = buildFilteredEntries(
+            data, terms, snapshot.isCompareMode ? nullptr : &snapshot.categoryFacets);
+        sortEntries(data, &indices);
+
+        std::size_t count = 0;
+        snapshot.entriesTotal = indices.size();
+        snapshot.entriesFirst = clampWindow(indices.size(), entryWindow, &count);
+        snapshot.entries.reserve(count);
+        for (std::size_t row = snapshot.entriesFirst; row < snapshot.entriesFirst + count; ++row) {
+            snapshot.entries.push_back(m_parser.materialize(data, indices[row], m_categories));
+        }
+
+        if (snapshot.hasCompareFile) {
+            const LogFileData& compareData = *compareFile->data;
+            const std::vector<CompareSlot>& slots = m_compareJoin.join(data, compareData, m_categories);
+            const std::vector<uint32_t> rows = filterCompareSlots(
+                slots, data, compareData, terms, snapshot.isCompareMode ? &snapshot.categoryFacets : nullptr);
+            compareTotalCount = slots.size();
+
+            snapshot.compareRowsTotal = rows.size();
+            snapshot.compareRowsFirst = clampWindow(rows.size(), compareWindow, &count);
+            snapshot.compareRows.reserve(count);
+            for (std::size_t row = snapshot.compareRowsFirst; row < snapshot.compareRowsFirst + count; ++row) {
+                snapshot.compareRows.push_back(materializeCompareRow(slots[rows[row]], data, compareData));
+            }
+        }
+    }
+
+    if (isLoading()) {
+        uint64_t loadedBytes = 0;
+        uint64_t totalBytes = 0;
+        for (const LogFileRecord* record : shownFiles()) {
+            if (record->data && !record->data->complete) {
+                loadedBytes += record->data->text.size();
+                totalBytes += std::max<uint64_t>(record->data->fileSize, record->data->text.size());
+            }
+        }
+        snapshot.loading.active = true;
+        snapshot.loading.progress = totalBytes > 0
+            ? static_cast<double>(loadedBytes) / static_cast<double>(totalBytes)
+            : -1.0;
     }
 
     snapshot.statistics.fileCount = static_cast<int>(m_files.size());
     if (snapshot.isCompareMode) {
-        snapshot.statistics.totalCount = snapshot.hasCompareFile
-            ? static_cast<int>(buildCompareRows(std::string()).size())
-            : 0;
-        snapshot.statistics.filteredCount = static_cast<int>(snapshot.compareRows.size());
+        snapshot.statistics.totalCount = static_cast<int>(compareTotalCount);
+        snapshot.statistics.filteredCount = static_cast<int>(snapshot.compareRowsTotal);
+    } else if (snapshot.isAggregateMode) {
+        snapshot.statistics.totalCount = static_cast<int>(aggregateTotalCount);
+        snapshot.statistics.filteredCount = static_cast<int>(snapshot.entriesTotal);
     } else {
-        snapshot.statistics.totalCount = (currentFile && currentFile->isLoaded)
-            ? static_cast<int>(currentFile->entries.size())
-            : 0;
-        snapshot.statistics.filteredCount = static_cast<int>(snapshot.entries.size());
+        snapshot.statistics.totalCount = static_cast<int>(currentFile ? currentFile->entryCount() : 0);
+        snapshot.statistics.filteredCount = static_cast<int>(snapshot.entriesTotal);
     }
 
+    // Keep only the matches of this query's terms for the next one to refine.
+    m_termMatches.erase(std::remove_if(m_termMatches.begin(), m_termMatches.end(), [this](const TermMatches& matches) {
+        return matches.pass != m_searchPass;
+    }), m_termMatches.end());
     return snapshot;
 }
 
@@ -383,6 +601,22 @@ bool LogManagerCore::handleAction(const std::string& actionType,
             || normalizedTargetId == "refresh_logs") {
             return refreshFiles();
         }
+        if (normalizedTargetId == "error_log::toggle_tail"
+            || normalizedTargetId == "manage::toggle_tail"
+            || normalizedTargetId == "toggle_tail") {
+            setTailMode(!m_tailMode);
+            return pollTail();
+        }
+        if (normalizedTargetId == "error_log::toggle_aggregate"
+            || normalizedTargetId == "manage::toggle_aggregate"
+            || normalizedTargetId == "toggle_aggregate") {
+            if (m_aggregateMode) {
+                stopAggregate();
+                clearError();
+                return true;
+            }
+            return startAggregate();
+        }
         if (normalizedTargetId == "error_log::stop_compare"
             || normalizedTargetId == "manage::stop_compare"
             || normalizedTargetId == "stop_compare"
@@ -419,6 +653,44 @@ bool LogManagerCore::handleAction(const std::string& actionType,
         }
     }
 
+    if (normalizedAction == "continue_loading") {
+        return continueLoading();
+    }
+
+    if (normalizedAction == "start_aggregate" || normalizedAction == "aggregate") {
+        return startAggregate();
+    }
+
+    if (normalizedAction == "stop_aggregate") {
+        stopAggregate();
+        clearError();
+        return true;
+    }
+
+    if (normalizedAction == "toggle_aggregate") {
+        if (m_aggregateMode) {
+            stopAggregate();
+            clearError();
+            return true;
+        }
+        return startAggregate();
+    }
+
+    if (normalizedAction == "poll_tail") {
+        return pollTail();
+    }
+
+    if (normalizedAction == "toggle_tail") {
+        setTailMode(!m_tailMode);
+        return pollTail();
+    }
+
+    if (normalizedAction == "set_tail_mode") {
+        const std::string value = toLower(trim(firstNonEmptyParam(params, {"enabled", "value", "tailMode"})));
+        setTailMode(value == "1" || value == "true" || value == "on");
+        return pollTail();
+    }
+
     if (normalizedAction == "page_select" || normalizedAction == "sidebar_button_click") {
         clearError();
         return true;
@@ -433,6 +705,16 @@ bool LogManagerCore::handleAction(const std::string& actionType,
         return true;
     }
 
+    if (normalizedAction == "set_category_filter" || normalizedAction == "filter_category") {
+        setCategoryFilter(trim(firstNonEmptyParam(params, {"category", "value", "name"})));
+        return true;
+    }
+
+    if (normalizedAction == "clear_category_filter") {
+        setCategoryFilter(std::string());
+        return true;
+    }
+
     if (normalizedAction == "sort_time") {
         setSortMode(SortMode::ByTime);
         return true;
@@ -519,20 +801,182 @@ bool LogManagerCore::loadFile(const std::string& displayName) {
         setError("Requested log file was not found: " + displayName);
         return false;
     }
-    if (record->isLoaded && !record->isLatest) {
+
+    bool success = true;
+    if (!record->data) {
+        success = restartLoad(record);
+    } else if (record->isLatest && record->data->complete) {
+        // The game may still be writing to it; pick up whatever was appended.
+        success = readAppended(record);
+    }
+    if (success) {
+        clearError();
+    }
+    return success;
+}
+
+bool LogManagerCore::loadAggregateFiles() {
+    std::vector<LogFileRecord*> pending;
+    bool success = true;
+    for (LogFileRecord& record : m_files) {
+        if (!record.data) {
+            record.data = std::make_shared<LogFileData>();
+            record.isLoaded = true;
+            pending.push_back(&record);
+        } else if (record.isLatest && record.data->complete && !readAppended(&record)) {
+            success = false;
+        }
+    }
+
+    // First steps of every file at once; continueLoading() reads the rest.
+    if (!loadNextSteps(pending)) {
+        success = false;
+    }
+    if (success) {
         clearError();
+    }
+    return success;
+}
+
+bool LogManagerCore::restartLoad(LogFileRecord* record) {
+    record->data = std::make_shared<LogFileData>();
+    record->isLoaded = true;
+    if (!loadNextStep(record)) {
+        record->data.reset();
+        record->isLoaded = false;
+        return false;
+    }
+    return true;
+}
+
+bool LogManagerCore::readAppended(LogFileRecord* record) {
+    LogFileData& data = *record->data;
+    if (!data.complete) {
+        // Still loading; continueLoading() reaches the current end by itself.
         return true;
     }
 
-    std::string content;
-    if (!readTextFile(record->sourcePath, &content)) {
-        setError("Failed to read log file: " + record->sourcePath);
+    const uint64_t retained = data.text.size();
+    const uint64_t anchor = std::min(retained, kTailAnchorBytes);
+    ByteRangeReadResult step{false, std::string(), 0};
+    if (m_fileSystem) {
+        step = m_fileSystem->readFileRange(record->sourcePath, retained - anchor, anchor + kLoadStepBytes);
+    }
+
+    // A file shorter than what was read was truncated; one whose bytes before the old end no
+    // longer match was rotated or rewritten. Both are loaded again from the start.
+    if (!step.success
+        || step.fileSize < retained
+        || step.content.size() < anchor
+        || step.content.compare(0, static_cast<std::size_t>(anchor), data.text,
+                                static_cast<std::size_t>(retained - anchor), static_cast<std::size_t>(anchor)) != 0) {
+        return restartLoad(record);
+    }
+
+    const std::size_t appendedSize = step.content.size() - static_cast<std::size_t>(anchor);
+    if (appendedSize == 0) {
+        return true;
+    }
+
+    m_parser.resume(&data);
+    data.fileSize = std::max<uint64_t>(step.fileSize, retained + appendedSize);
+    if (!m_parser.append(&data, step.content.data() + anchor, appendedSize, &m_categories)) {
+        m_parser.finish(&data, &m_categories);
+        setError("Log file is too large to load: " + record->sourcePath);
         return false;
     }
+    if (appendedSize < kLoadStepBytes || data.text.size() >= data.fileSize) {
+        m_parser.finish(&data, &m_categories);
+    }
+    return true;
+}
 
-    record->entries = m_parser.parseLogContent(content);
-    record->isLoaded = true;
-    clearError();
+bool LogManagerCore::loadNextStep(LogFileRecord* record) {
+    LoadStep step = readNextStep(record);
+    if (!parseStep(&step, &m_parser)) {
+        setError(step.error);
+        return false;
+    }
+    return true;
+}
+
+bool LogManagerCore::loadNextSteps(const std::vector<LogFileRecord*>& records) {
+    // The file system is read from this thread only; the steps are then parsed side by side,
+    // each file by its own parser.
+    std::vector<LoadStep> steps;
+    steps.reserve(records.size());
+    for (LogFileRecord* record : records) {
+        steps.push_back(readNextStep(record));
+    }
+
+    std::vector<char> parsed(steps.size(), 0);
+    runParallel(steps.size(), steps.size(), [this, &steps, &parsed](std::size_t index) {
+        LogParser parser;
+        parsed[index] = parseStep(&steps[index], &parser) ? 1 : 0;
+    });
+
+    for (std::size_t index = 0; index < steps.size(); ++index) {
+        if (parsed[index] == 0) {
+            setError(steps[index].error);
+            return false;
+        }
+    }
+    return true;
+}
+
+LogManagerCore::LoadStep LogManagerCore::readNextStep(LogFileRecord* record) const {
+    LoadStep step;
+    step.record = record;
+    const uint64_t offset = record->data->text.size();
+    if (m_fileSystem) {
+        step.range = m_fileSystem->readFileRange(record->sourcePath, offset, kLoadStepBytes);
+    }
+
+    // The file can only be read whole; it is then parsed in one go.
+    if (!step.range.success && offset == 0 && readTextFile(record->sourcePath, &step.range.content)) {
+        step.wholeFile = true;
+    }
+    return step;
+}
+
+bool LogManagerCore::parseStep(LoadStep* step, LogParser* parser) {
+    LogFileRecord* record = step->record;
+    LogFileData& data = *record->data;
+
+    if (step->wholeFile) {
+        const std::string& content = step->range.content;
+        data.fileSize = content.size();
+        const bool appended = parser->append(&data, content.data(), content.size(), &m_categories);
+        parser->finish(&data, &m_categories);
+        if (!appended) {
+            step->error = "Log file is too large to load: " + record->sourcePath;
+            return false;
+        }
+        return true;
+    }
+
+    if (!step->range.success) {
+        parser->finish(&data, &m_categories);
+        step->error = "Failed to read log file: " + record->sourcePath;
+        return false;
+    }
+
+    const uint64_t offset = data.text.size();
+    const std::string& content = step->range.content;
+    if (offset == 0) {
+        // Reserve once so the retained text is not reallocated while it grows.
+        data.text.reserve(static_cast<std::size_t>(std::min<uint64_t>(step->range.fileSize, UINT32_MAX)));
+    }
+    data.fileSize = std::max<uint64_t>(step->range.fileSize, offset + content.size());
+
+    if (!parser->append(&data, content.data(), content.size(), &m_categories)) {
+        parser->finish(&data, &m_categories);
+        step->error = "Log file is too large to load: " + record->sourcePath;
+        return false;
+    }
+    if (content.size() < kLoadStepBytes || data.text.size() >= data.fileSize) {
+        parser->finish(&data, &m_categories);
+    }
     return true;
 }
 
@@ -556,159 +1000,332 @@ bool LogManagerCore::readTextFile(const std::string& relativePath, std::string*
     return true;
 }
 
-std::vector<LogEntry> LogManagerCore::buildFilteredEntries() const {
-    const LogFileRecord* currentFile = findFile(m_currentFileName);
-    if (!currentFile || !currentFile->isLoaded) {
-        return {};
+std::vector<uint32_t> LogManagerCore::buildFilteredEntries(const LogFileData& data,
+                                                           const std::vector<std::string>& terms,
+                                                           std::vector<CategoryFacet>* facets) const {
+    RecordBitmap matches = RecordBitmap::all(data.records.size());
+    for (const std::string& term : terms) {
+        matches.intersect(matchTerm(data, term));
     }
 
-    const std::string normalizedSearch = normalizeSearchText(m_searchText);
-    if (normalizedSearch.empty()) {
-        return currentFile->entries;
+    if (facets) {
+        std::vector<std::size_t> counts(m_categories.size(), 0);
+        for (uint32_t category = 0; category < static_cast<uint32_t>(counts.size()); ++category) {
+            counts[category] = terms.empty()
+                ? data.index.categoryCount(category)
+                : matches.countCommon(data.index.categoryRecords(category));
+        }
+        appendFacets(counts, facets);
     }
 
-    std::vector<LogEntry> filteredEntries;
-    filteredEntries.reserve(currentFile->entries.size());
-    for (const LogEntry& entry : currentFile->entries) {
-        if (matchesSearch(entry, normalizedSearch)) {
-            filteredEntries.push_back(entry);
+    if (!m_categoryFilter.empty()) {
+        uint32_t category = 0;
+        if (!findCategory(m_categoryFilter, &category)) {
+            return {};
         }
+        matches.intersect(data.index.categoryRecords(category));
     }
-    return filteredEntries;
+    return matches.toIndices();
 }
 
-std::vector<LogEntry> LogManagerCore::sortEntries(const std::vector<LogEntry>& entries) const {
-    std::vector<LogEntry> sortedEntries = entries;
-    std::sort(sortedEntries.begin(), sortedEntries.end(), [this](const LogEntry& left, const LogEntry& right) {
-        if (m_sortMode == SortMode::ByTime) {
-            return left.originalIndex < right.originalIndex;
-        }
+void LogManagerCore::sortEntries(const LogFileData& data, std::vector<uint32_t>* indices) const {
+    // Indices arrive in file order, which is already the time order and the final tie-break.
+    if (m_sortMode == SortMode::ByTime) {
+        return;
+    }
 
+    const std::vector<uint32_t> ranks = categoryRanks();
+    std::stable_sort(indices->begin(), indices->end(), [&data, &ranks](uint32_t leftIndex, uint32_t rightIndex) {
+        const LogRecord& left = data.records[leftIndex];
+        const LogRecord& right = data.records[rightIndex];
         if (left.isHighPriority != right.isHighPriority) {
             return left.isHighPriority > right.isHighPriority;
         }
-        if (caseInsensitiveLess(left.category, right.category)) {
-            return true;
-        }
-        if (caseInsensitiveLess(right.category, left.category)) {
-            return false;
-        }
-        return left.originalIndex < right.originalIndex;
+        return ranks[left.category] < ranks[right.category];
     });
-    return sortedEntries;
 }
 
-std::vector<CompareRow> LogManagerCore::buildCompareRows() const {
-    return buildCompareRows(normalizeSearchText(m_searchText));
+std::vector<uint32_t> LogManagerCore::categoryRanks() const {
+    std::vector<uint32_t> order(m_categories.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [this](uint32_t left, uint32_t right) {
+        return caseInsensitiveLess(m_categories.name(left), m_categories.name(right));
+    });
+
+    std::vector<uint32_t> ranks(order.size());
+    for (uint32_t rank = 0; rank < static_cast<uint32_t>(order.size()); ++rank) {
+        ranks[order[rank]] = rank;
+    }
+    return ranks;
 }
 
-std::vector<CompareRow> LogManagerCore::buildCompareRows(const std::string& normalizedSearch) const {
-    const LogFileRecord* currentFile = findFile(m_currentFileName);
-    const LogFileRecord* compareFile = findFile(m_compareFileName);
-    if (!currentFile || !compareFile || !currentFile->isLoaded || !compareFile->isLoaded) {
-        return {};
+std::vector<uint32_t> LogManagerCore::filterCompareSlots(const std::vector<CompareSlot>& slots,
+                                                         const LogFileData& left,
+                                                         const LogFileData& right,
+                                                         const std::vector<std::string>& terms,
+                                                         std::vector<CategoryFacet>* facets) const {
+    // A row matches a term when either of its entries does.
+    std::vector<std::pair<const RecordBitmap*, const RecordBitmap*>> termMatches;
+    termMatches.reserve(terms.size());
+    for (const std::string& term : terms) {
+        termMatches.emplace_back(&matchTerm(left, term), &matchTerm(right, term));
+    }
+
+    uint32_t filterCategory = 0;
+    const bool filterActive = !m_categoryFilter.empty();
+    const bool filterKnown = filterActive && findCategory(m_categoryFilter, &filterCategory);
+
+    // The sorted order is cached with the join, so filtering keeps it without sorting again.
+    const std::vector<uint32_t> ranks = m_sortMode == SortMode::ByCategory ? categoryRanks() : std::vector<uint32_t>();
+    const std::vector<uint32_t>& order = m_compareJoin.order(m_sortMode, ranks);
+
+    std::vector<std::size_t> counts(m_categories.size(), 0);
+    std::vector<uint32_t> rows;
+    rows.reserve(order.size());
+    for (const uint32_t index : order) {
+        const CompareSlot& slot = slots[index];
+        bool matches = true;
+        for (const auto& term : termMatches) {
+            if (!(slot.left >= 0 && term.first->test(static_cast<uint32_t>(slot.left)))
+                && !(slot.right >= 0 && term.second->test(static_cast<uint32_t>(slot.right)))) {
+                matches = false;
+                break;
+            }
+        }
+        if (!matches) {
+            continue;
+        }
+
+        ++counts[slot.category];
+        if (!filterActive || (filterKnown && slot.category == filterCategory)) {
+            rows.push_back(index);
+        }
     }
+    if (facets) {
+        appendFacets(counts, facets);
+    }
+    return rows;
+}
 
-    std::map<std::string, CompareRow> compareRowMap;
-    std::vector<std::string> insertionOrder;
+CompareRow LogManagerCore::materializeCompareRow(const CompareSlot& slot,
+                                                 const LogFileData& left,
+                                                 const LogFileData& right) const {
+    CompareRow row;
+    row.category = m_categories.name(slot.category);
+    row.isHighPriority = slot.isHighPriority;
+    row.hasLeft = slot.left >= 0;
+    row.hasRight = slot.right >= 0;
+    if (row.hasLeft) {
+        row.leftEntry = m_parser.materialize(left, static_cast<std::size_t>(slot.left), m_categories);
+    }
+    if (row.hasRight) {
+        row.rightEntry = m_parser.materialize(right, static_cast<std::size_t>(slot.right), m_categories);
+    }
+    row.normalizedKey = row.hasLeft ? row.leftEntry.normalizedKey : row.rightEntry.normalizedKey;
+    return row;
+}
 
-    auto appendEntry = [&compareRowMap, &insertionOrder](const LogEntry& entry, bool isLeft) {
-        auto iterator = compareRowMap.find(entry.normalizedKey);
-        if (iterator == compareRowMap.end()) {
-            CompareRow row;
-            row.normalizedKey = entry.normalizedKey;
-            row.category = entry.category;
-            row.isHighPriority = entry.isHighPriority;
-            compareRowMap.insert_or_assign(entry.normalizedKey, row);
-            insertionOrder.push_back(entry.normalizedKey);
-            iterator = compareRowMap.find(entry.normalizedKey);
+std::vector<uint32_t> LogManagerCore::filterAggregateGroups(const std::vector<AggregateGroup>& groups,
+                                                            const std::vector<const LogFileData*>& files,
+                                                            const std::vector<std::string>& terms,
+                                                            std::vector<CategoryFacet>* facets) const {
+    // A group matches through its first occurrence; the others share its key, and differ at
+    // most in the time fields.
+    std::vector<std::vector<const RecordBitmap*>> termMatches(files.size());
+    for (std::size_t file = 0; file < files.size(); ++file) {
+        for (const std::string& term : terms) {
+            termMatches[file].push_back(&matchTerm(*files[file], term));
         }
+    }
 
-        CompareRow& row = iterator->second;
-        if (row.category.empty()) {
-            row.category = entry.category;
+    uint32_t filterCategory = 0;
+    const bool filterActive = !m_categoryFilter.empty();
+    const bool filterKnown = filterActive && findCategory(m_categoryFilter, &filterCategory);
+
+    const std::vector<uint32_t> ranks = m_sortMode == SortMode::ByCategory ? categoryRanks() : std::vector<uint32_t>();
+    const std::vector<uint32_t>& order = m_aggregation.order(m_sortMode, ranks);
+
+    std::vector<std::size_t> counts(m_categories.size(), 0);
+    std::vector<uint32_t> rows;
+    rows.reserve(order.size());
+    for (const uint32_t index : order) {
+        const AggregateGroup& group = groups[index];
+        bool matches = true;
+        for (const RecordBitmap* records : termMatches[group.firstFile]) {
+            if (!records->test(group.firstRecord)) {
+                matches = false;
+                break;
+            }
+        }
+        if (!matches) {
+            continue;
         }
-        row.isHighPriority = row.isHighPriority || entry.isHighPriority;
 
-        if (isLeft && !row.hasLeft) {
-            row.hasLeft = true;
-            row.leftEntry = entry;
+        ++counts[group.category];
+        if (!filterActive || (filterKnown && group.category == filterCategory)) {
+            rows.push_back(index);
         }
-        if (!isLeft && !row.hasRight) {
-            row.hasRight = true;
-            row.rightEntry = entry;
+    }
+    if (facets) {
+        appendFacets(counts, facets);
+    }
+    return rows;
+}
+
+AggregateRow LogManagerCore::materializeAggregateRow(const AggregateGroup& group,
+                                                     const std::vector<const LogFileRecord*>& sessions) const {
+    AggregateRow row;
+    row.entry = m_parser.materialize(*sessions[group.firstFile]->data, group.firstRecord, m_categories);
+    row.firstFileName = sessions[group.firstFile]->displayName;
+    row.lastFileName = sessions[group.lastFile]->displayName;
+    row.occurrences = static_cast<int>(group.occurrences);
+    row.sessions = static_cast<int>(group.sessions);
+    return row;
+}
+
+void LogManagerCore::appendFacets(const std::vector<std::size_t>& counts, std::vector<CategoryFacet>* facets) const {
+    const std::vector<uint32_t> ranks = categoryRanks();
+    std::vector<uint32_t> categories;
+    for (uint32_t category = 0; category < static_cast<uint32_t>(counts.size()); ++category) {
+        if (counts[category] > 0 || m_categories.name(category) == m_categoryFilter) {
+            categories.push_back(category);
         }
-    };
+    }
+    std::sort(categories.begin(), categories.end(), [&ranks](uint32_t left, uint32_t right) {
+        return ranks[left] < ranks[right];
+    });
 
-    for (const LogEntry& entry : currentFile->entries) {
-        appendEntry(entry, true);
+    facets->reserve(categories.size());
+    for (const uint32_t category : categories) {
+        CategoryFacet facet;
+        facet.name = m_categories.name(category);
+        facet.count = static_cast<int>(counts[category]);
+        facet.selected = facet.name == m_categoryFilter;
+        facets->push_back(std::move(facet));
     }
-    for (const LogEntry& entry : compareFile->entries) {
-        appendEntry(entry, false);
+}
+
+bool LogManagerCore::findCategory(const std::string& name, uint32_t* outId) const {
+    for (uint32_t category = 0; category < static_cast<uint32_t>(m_categories.size()); ++category) {
+        if (m_categories.name(category) == name) {
+            *outId = category;
+            return true;
+        }
     }
+    return false;
+}
 
-    std::vector<CompareRow> rows;
-    rows.reserve(compareRowMap.size());
-    for (const std::string& key : insertionOrder) {
-        const CompareRow& row = compareRowMap.at(key);
-        if (normalizedSearch.empty() || compareRowMatchesSearch(row, normalizedSearch)) {
-            rows.push_back(row);
+const RecordBitmap& LogManagerCore::matchTerm(const LogFileData& data, const std::string& term) const {
+    const TermMatches* narrower = nullptr;
+    for (TermMatches& cached : m_termMatches) {
+        if (cached.data != &data || cached.generation != data.index.generation()) {
+            continue;
+        }
+        if (cached.term == term) {
+            cached.pass = m_searchPass;
+            return cached.records;
+        }
+        // Anything containing term also contains a shorter term inside it.
+        if (term.find(cached.term) != std::string::npos
+            && (!narrower || cached.term.size() > narrower->term.size())) {
+            narrower = &cached;
         }
     }
 
-    std::sort(rows.begin(), rows.end(), [this](const CompareRow& left, const CompareRow& right) {
-        if (m_sortMode == SortMode::ByCategory) {
-            if (left.isHighPriority != right.isHighPriority) {
-                return left.isHighPriority > right.isHighPriority;
-            }
-            if (caseInsensitiveLess(left.category, right.category)) {
-                return true;
+    RecordBitmap candidates;
+    bool exact = false;
+    if (narrower) {
+        candidates = narrower->records;
+    } else {
+        candidates = data.index.tokenCandidates(term, &exact);
+        for (uint32_t category = 0; category < static_cast<uint32_t>(m_categories.size()); ++category) {
+            if (data.index.categoryCount(category) > 0
+                && containsCaseInsensitive(m_categories.name(category), term)) {
+                candidates.unite(data.index.categoryRecords(category));
             }
-            if (caseInsensitiveLess(right.category, left.category)) {
-                return false;
+        }
+    }
+
+    if (!exact) {
+        for (const uint32_t index : candidates.toIndices()) {
+            if (!recordContains(data, index, term)) {
+                candidates.reset(index);
             }
         }
+    }
 
-        const int leftIndex = left.hasLeft ? left.leftEntry.originalIndex : left.rightEntry.originalIndex;
-        const int rightIndex = right.hasLeft ? right.leftEntry.originalIndex : right.rightEntry.originalIndex;
-        return leftIndex < rightIndex;
-    });
+    TermMatches matches;
+    matches.data = &data;
+    matches.generation = data.index.generation();
+    matches.term = term;
+    matches.records = std::move(candidates);
+    matches.pass = m_searchPass;
+    m_termMatches.push_back(std::move(matches));
+    return m_termMatches.back().records;
+}
 
-    return rows;
+bool LogManagerCore::recordContains(const LogFileData& data, uint32_t index, const std::string& term) const {
+    // Terms never hold line breaks, so a raw "\r\n" in the message cannot affect a match.
+    const LogRecord& record = data.records[index];
+    return containsCaseInsensitive(spanView(data, record.systemTime), term)
+        || containsCaseInsensitive(spanView(data, record.gameTime), term)
+        || containsCaseInsensitive(m_categories.name(record.category), term)
+        || containsCaseInsensitive(spanView(data, record.message), term);
 }
 
-bool LogManagerCore::matchesSearch(const LogEntry& entry, const std::string& normalizedSearch) const {
-    if (normalizedSearch.empty()) {
-        return true;
+std::vector<LogFileRecord*> LogManagerCore::shownFiles() {
+    std::vector<LogFileRecord*> records;
+    if (m_aggregateMode) {
+        for (LogFileRecord& record : m_files) {
+            records.push_back(&record);
+        }
+        return records;
     }
-
-    const std::string haystack = toLower(
-        entry.systemTime + "\n"
-        + entry.gameTime + "\n"
-        + entry.category + "\n"
-        + normalizeNewlines(entry.message)
-    );
-    return haystack.find(normalizedSearch) != std::string::npos;
+    for (const std::string* displayName : {&m_currentFileName, &m_compareFileName}) {
+        LogFileRecord* record = displayName->empty() ? nullptr : findFile(*displayName);
+        if (record) {
+            records.push_back(record);
+        }
+    }
+    return records;
 }
 
-bool LogManagerCore::compareRowMatchesSearch(const CompareRow& row, const std::string& normalizedSearch) const {
-    if (normalizedSearch.empty()) {
-        return true;
+std::vector<const LogFileRecord*> LogManagerCore::shownFiles() const {
+    std::vector<const LogFileRecord*> records;
+    if (m_aggregateMode) {
+        for (const LogFileRecord& record : m_files) {
+            records.push_back(&record);
+        }
+        return records;
+    }
+    for (const std::string* displayName : {&m_currentFileName, &m_compareFileName}) {
+        const LogFileRecord* record = displayName->empty() ? nullptr : findFile(*displayName);
+        if (record) {
+            records.push_back(record);
+        }
     }
+    return records;
+}
 
-    std::string haystack = row.category + "\n" + row.normalizedKey;
-    if (row.hasLeft) {
-        haystack += "\n" + row.leftEntry.systemTime;
-        haystack += "\n" + row.leftEntry.gameTime;
-        haystack += "\n" + normalizeNewlines(row.leftEntry.message);
+std::vector<const LogFileRecord*> LogManagerCore::aggregateSessions() const {
+    // Crash and rotated logs are listed oldest first by the timestamp in their folder names;
+    // the latest log is the newest session of all.
+    std::vector<const LogFileRecord*> sessions;
+    const LogFileRecord* latest = nullptr;
+    for (const LogFileRecord& record : m_files) {
+        if (!record.isComplete()) {
+            continue;
+        }
+        if (record.isLatest) {
+            latest = &record;
+        } else {
+            sessions.push_back(&record);
+        }
     }
-    if (row.hasRight) {
-        haystack += "\n" + row.rightEntry.systemTime;
-        haystack += "\n" + row.rightEntry.gameTime;
-        haystack += "\n" + normalizeNewlines(row.rightEntry.message);
+    if (latest) {
+        sessions.push_back(latest);
     }
-
-    return toLower(haystack).find(normalizedSearch) != std::string::npos;
+    return sessions;
 }
 
 LogFileRecord* LogManagerCore::findFile(const std::string& displayName) {
@@ -9,11 +9,15 @@
 #ifndef LOGMANAGERCORE_H
 #define LOGMANAGERCORE_H
 
+#include "LogAggregation.h"
+#include "LogCompareJoin.h"
 #include "LogEntry.h"
 #include "LogFileSystem.h"
 #include "LogParser.h"
 #include "LogScanner.h"
 
+#include <cstdint>
+#include <deque>
 #include <map>
 #include <string>
 #include <vector>
@@ -44,20 +48,42 @@ public:
     bool switchViewMode(const std::string& viewMode,
                         const std::string& compareDisplayName = std::string());
 
-    // Search and sort operations
+    // Aggregate mode loads every discovered log and groups identical entries across them, oldest
+    // session first. Selecting a file or starting a compare leaves it.
+    bool startAggregate();
+    void stopAggregate();
+    bool isAggregateMode() const noexcept { return m_aggregateMode; }
+
+    // Read the next step of every shown file that is still partial. Files are loaded
+    // progressively so each step can be shown before the next is read; the steps of several
+    // files are parsed in parallel.
+    bool continueLoading();
+    bool isLoading() const;
+
+    // Tail mode: pollTail() picks up text appended to the shown files since the last read,
+    // and reloads a file that was truncated or replaced.
+    void setTailMode(bool enabled);
+    bool tailMode() const noexcept { return m_tailMode; }
+    bool pollTail();
+
+    // Search, filter and sort operations. Search text is split into terms on whitespace,
+    // with double quotes keeping a phrase together; an entry must contain every term.
     void setSearchText(const std::string& text);
+    void setCategoryFilter(const std::string& category);
     void setSortMode(SortMode mode);
 
     // State accessors
     SortMode sortMode() const noexcept { return m_sortMode; }
     const std::string& searchText() const noexcept { return m_searchText; }
+    const std::string& categoryFilter() const noexcept { return m_categoryFilter; }
     const std::string& currentFileName() const noexcept { return m_currentFileName; }
     const std::string& compareFileName() const noexcept { return m_compareFileName; }
     bool isCompareMode() const noexcept { return !m_compareFileName.empty(); }
     const std::vector<LogFileRecord>& files() const noexcept { return m_files; }
 
-    // Build complete state snapshot for UI
-    StateSnapshot buildState() const;
+    // Build state snapshot for UI; only the rows inside each window are copied
+    StateSnapshot buildState(const RowWindow& entryWindow = RowWindow(),
+                             const RowWindow& compareWindow = RowWindow()) const;
 
     // Handle UI actions
     bool handleAction(const std::string& actionType, const std::map<std::string, std::string>& params);
@@ -66,18 +92,68 @@ public:
     const std::string& lastError() const noexcept { return m_lastError; }
 
 private:
+    // One read of a file, kept apart from parsing so several files can be parsed at once
+    struct LoadStep {
+        LogFileRecord* record = nullptr;
+        ByteRangeReadResult range{false, std::string(), 0};
+        bool wholeFile = false;  // range.content is the whole file, read without ranges
+        std::string error;
+    };
+
     // Helper methods
     bool ensureDefaultSelection();
     bool loadFile(const std::string& displayName);
+    bool loadAggregateFiles();
+    bool loadNextStep(LogFileRecord* record);
+    bool loadNextSteps(const std::vector<LogFileRecord*>& records);
+    LoadStep readNextStep(LogFileRecord* record) const;
+    bool parseStep(LoadStep* step, LogParser* parser);
+    bool restartLoad(LogFileRecord* record);
+    bool readAppended(LogFileRecord* record);
     bool readTextFile(const std::string& relativePath, std::string* outContent) const;
 
-    // Filtering and sorting
-    std::vector<LogEntry> buildFilteredEntries() const;
-    std::vector<LogEntry> sortEntries(const std::vector<LogEntry>& entries) const;
-    std::vector<CompareRow> buildCompareRows() const;
-    std::vector<CompareRow> buildCompareRows(const std::string& normalizedSearch) const;
-    bool matchesSearch(const LogEntry& entry, const std::string& normalizedSearch) const;
-    bool compareRowMatchesSearch(const CompareRow& row, const std::string& normalizedSearch) const;
+    // Files the current view shows: every file in aggregate mode, otherwise the current and
+    // compare files
+    std::vector<LogFileRecord*> shownFiles();
+    std::vector<const LogFileRecord*> shownFiles() const;
+    // Completely loaded files for aggregation, oldest session first
+    std::vector<const LogFileRecord*> aggregateSessions() const;
+
+    // Verified matches of one search term in one file
+    struct TermMatches {
+        const LogFileData* data = nullptr;
+        uint64_t generation = 0;
+        std::string term;
+        RecordBitmap records;
+        uint64_t pass = 0;
+    };
+
+    // Filtering and sorting work on record indices; only rows inside a window are materialized
+    std::vector<uint32_t> buildFilteredEntries(const LogFileData& data,
+                                               const std::vector<std::string>& terms,
+                                               std::vector<CategoryFacet>* facets) const;
+    void sortEntries(const LogFileData& data, std::vector<uint32_t>* indices) const;
+    std::vector<uint32_t> filterCompareSlots(const std::vector<CompareSlot>& slots,
+                                             const LogFileData& left,
+                                             const LogFileData& right,
+                                             const std::vector<std::string>& terms,
+                                             std::vector<CategoryFacet>* facets) const;
+    CompareRow materializeCompareRow(const CompareSlot& slot, const LogFileData& left, const LogFileData& right) const;
+    std::vector<uint32_t> filterAggregateGroups(const std::vector<AggregateGroup>& groups,
+                                                const std::vector<const LogFileData*>& files,
+                                                const std::vector<std::string>& terms,
+                                                std::vector<CategoryFacet>* facets) const;
+    AggregateRow materializeAggregateRow(const AggregateGroup& group,
+                                         const std::vector<const LogFileRecord*>& sessions) const;
+    std::vector<uint32_t> categoryRanks() const;
+    void appendFacets(const std::vector<std::size_t>& counts, std::vector<CategoryFacet>* facets) const;
+    bool findCategory(const std::string& name, uint32_t* outId) const;
+
+    // Search terms are answered from the file's index and verified against the entry text.
+    // Results of the last query are kept, so a term that extends one of them only rechecks
+    // that term's matches.
+    const RecordBitmap& matchTerm(const LogFileData& data, const std::string& term) const;
+    bool recordContains(const LogFileData& data, uint32_t index, const std::string& term) const;
 
     // File lookup
     LogFileRecord* findFile(const std::string& displayName);
@@ -91,12 +167,20 @@ private:
     IFileSystem* m_fileSystem = nullptr;
     LogScanner m_scanner;
     LogParser m_parser;
+    LogCategoryTable m_categories;
     std::vector<LogFileRecord> m_files;
     std::string m_currentFileName;
     std::string m_compareFileName;
     std::string m_searchText;
+    std::string m_categoryFilter;
     SortMode m_sortMode = SortMode::ByTime;
+    bool m_tailMode = false;
+    bool m_aggregateMode = false;
     std::string m_lastError;
+    mutable std::deque<TermMatches> m_termMatches;  // Deque keeps returned references valid
+    mutable uint64_t m_searchPass = 0;
+    mutable LogCompareJoin m_compareJoin;  // Reused until either compared file changes
+    mutable LogAggregation m_aggregation;  // Reused until an aggregated file changes
 };
 
 } // namespace LogManager
@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------------------
+// LogParallel.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LOGPARALLEL_H
+#define LOGPARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace LogManager {
+
+inline std::size_t hardwareWorkerCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Run job(0) .. job(count - 1) on up to maxWorkers threads, the calling thread included.
+// Jobs are handed out one at a time, so uneven jobs still keep every worker busy.
+template <typename Job>
+void runParallel(std::size_t count, std::size_t maxWorkers, Job&& job) {
+    const std::size_t workers = std::min({count, maxWorkers, hardwareWorkerCount()});
+    if (workers <= 1) {
+        for (std::size_t index = 0; index < count; ++index) {
+            job(index);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto drain = [&next, count, &job]() {
+        for (std::size_t index = next++; index < count; index = next++) {
+            job(index);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t worker = 1; worker < workers; ++worker) {
+        threads.emplace_back(drain);
+    }
+    drain();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace LogManager
+
+#endif // LOGPARALLEL_H
@@ -10,225 +10,389 @@
 
 #include <algorithm>
 #include <cctype>
-#include <sstream>
+#include <limits>
 
 namespace LogManager {
 
 namespace {
 
-// String utility functions
-std::string toLower(std::string value) {
-    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char character) {
-        return static_cast<char>(std::tolower(character));
-    });
-    return value;
-}
-
-std::string trim(const std::string& value) {
-    const auto begin = std::find_if_not(value.begin(), value.end(), [](unsigned char character) {
-        return std::isspace(character) != 0;
-    });
-    if (begin == value.end()) {
-        return std::string();
-    }
+constexpr std::string_view kHighPriorityMarker = "this will likely crash the game";
 
-    const auto end = std::find_if_not(value.rbegin(), value.rend(), [](unsigned char character) {
-        return std::isspace(character) != 0;
-    }).base();
+bool isSpace(char character) {
+    return std::isspace(static_cast<unsigned char>(character)) != 0;
+}
 
-    return std::string(begin, end);
+char lowerChar(char character) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
 }
 
-std::string replaceAll(std::string value, const std::string& from, const std::string& to) {
-    if (from.empty()) {
-        return value;
+std::string_view trimView(std::string_view value) {
+    while (!value.empty() && isSpace(value.front())) {
+        value.remove_prefix(1);
     }
-
-    std::size_t position = 0;
-    while ((position = value.find(from, position)) != std::string::npos) {
-        value.replace(position, from.length(), to);
-        position += to.length();
+    while (!value.empty() && isSpace(value.back())) {
+        value.remove_suffix(1);
     }
     return value;
 }
 
-std::string normalizeNewlines(std::string value) {
-    value = replaceAll(std::move(value), "\r\n", "\n");
-    value = replaceAll(std::move(value), "\r", "\n");
-    return value;
+std::string_view spanView(const std::string& text, const TextSpan& span) {
+    return std::string_view(text.data() + span.offset, span.length);
 }
 
-std::string simplifyWhitespace(const std::string& value) {
-    std::string simplified;
-    simplified.reserve(value.size());
+// needle must already be lower case
+bool containsCaseInsensitive(std::string_view haystack, std::string_view needle) {
+    if (needle.empty()) {
+        return true;
+    }
+    if (haystack.size() < needle.size()) {
+        return false;
+    }
 
-    bool previousWasWhitespace = false;
-    for (unsigned char character : value) {
-        if (std::isspace(character) != 0) {
-            if (!previousWasWhitespace) {
-                simplified.push_back(' ');
-                previousWasWhitespace = true;
-            }
+    const std::size_t last = haystack.size() - needle.size();
+    for (std::size_t position = 0; position <= last; ++position) {
+        if (lowerChar(haystack[position]) != needle[0]) {
             continue;
         }
+        std::size_t matched = 1;
+        while (matched < needle.size() && lowerChar(haystack[position + matched]) == needle[matched]) {
+            ++matched;
+        }
+        if (matched == needle.size()) {
+            return true;
+        }
+    }
+    return false;
+}
 
-        simplified.push_back(static_cast<char>(character));
-        previousWasWhitespace = false;
+// Length of the line break starting at index, or 0 if there is none. A run of '\r' ended by
+// '\n' is one break, as written by tools that add a '\r' to text already ending in "\r\n";
+// otherwise a lone '\r' is a break of its own.
+std::size_t lineBreakLength(std::string_view text, std::size_t index) {
+    if (text[index] == '\n') {
+        return 1;
+    }
+    if (text[index] != '\r') {
+        return 0;
+    }
+    std::size_t end = index + 1;
+    while (end < text.size() && text[end] == '\r') {
+        ++end;
     }
+    return end < text.size() && text[end] == '\n' ? end + 1 - index : 1;
+}
 
-    return trim(simplified);
+// Append text with every line break turned into '\n'
+void appendNormalizedNewlines(std::string* out, std::string_view text) {
+    for (std::size_t index = 0; index < text.size(); ++index) {
+        const std::size_t breakLength = lineBreakLength(text, index);
+        if (breakLength == 0) {
+            out->push_back(text[index]);
+            continue;
+        }
+        out->push_back('\n');
+        index += breakLength - 1;
+    }
 }
 
-std::vector<std::string> splitLines(const std::string& value) {
-    std::vector<std::string> lines;
-    std::stringstream stream(value);
-    std::string line;
-    while (std::getline(stream, line, '\n')) {
-        lines.push_back(line);
+// Append each line of text with whitespace runs collapsed to one space and trimmed, joined
+// by '\n'. Line breaks are read as in lineBreakLength().
+void appendSimplifiedLines(std::string* out, std::string_view text, bool lowerCase) {
+    bool lineHasText = false;
+    bool pendingSpace = false;
+    for (std::size_t index = 0; index < text.size(); ++index) {
+        const char character = text[index];
+        const std::size_t breakLength = lineBreakLength(text, index);
+        if (breakLength != 0) {
+            index += breakLength - 1;
+            out->push_back('\n');
+            lineHasText = false;
+            pendingSpace = false;
+            continue;
+        }
+        if (isSpace(character)) {
+            pendingSpace = lineHasText;
+            continue;
+        }
+        if (pendingSpace) {
+            out->push_back(' ');
+            pendingSpace = false;
+        }
+        out->push_back(lowerCase ? lowerChar(character) : character);
+        lineHasText = true;
     }
-    if (!value.empty() && value.back() == '\n') {
-        lines.emplace_back();
+}
+
+// Same result as joining the lower-cased category and the message with '\n', simplifying every
+// line and trimming the whole, without building the intermediate strings.
+void buildNormalizedKey(std::string* out, std::string_view category, std::string_view message) {
+    out->clear();
+    appendSimplifiedLines(out, trimView(category), true);
+    out->push_back('\n');
+    appendSimplifiedLines(out, message, false);
+
+    // Lines are already trimmed, so only empty leading and trailing lines remain to drop.
+    while (!out->empty() && out->back() == '\n') {
+        out->pop_back();
     }
-    return lines;
+    const std::size_t firstText = out->find_first_not_of('\n');
+    out->erase(0, firstText == std::string::npos ? out->size() : firstText);
 }
 
-} // namespace
+uint64_t hashKey(std::string_view key) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char character : key) {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
 
 // PERFORMANCE OPTIMIZATION: Manual parsing instead of regex
 // Regex matching is extremely slow for large log files (2+ minutes for thousands of entries)
 // Manual parsing reduces parsing time by ~10-20x
-bool tryParseLogLine(const std::string& line,
-                     std::string* systemTime,
-                     std::string* gameTime,
-                     std::string* category,
-                     std::string* message) {
+bool tryParseLogLine(std::string_view line,
+                     std::size_t lineOffset,
+                     LogRecord* record,
+                     std::string_view* category) {
     // Expected format: [HH:MM:SS][game_time][category]: message
     // Example: [12:34:56][1936.01.01][error]: Something went wrong
-    
+
     if (line.empty() || line[0] != '[') {
         return false;
     }
-    
+
+    auto makeSpan = [lineOffset](std::size_t begin, std::size_t end) {
+        return TextSpan{static_cast<uint32_t>(lineOffset + begin), static_cast<uint32_t>(end - begin)};
+    };
+
     // Parse system time [HH:MM:SS]
     std::size_t pos = 1;
     std::size_t end = line.find(']', pos);
-    if (end == std::string::npos || end - pos < 8) {
+    if (end == std::string_view::npos || end - pos < 8) {
         return false;
     }
-    *systemTime = line.substr(pos, end - pos);
-    
+    const TextSpan systemTime = makeSpan(pos, end);
+
     // Check for second bracket [
     pos = end + 1;
     if (pos >= line.size() || line[pos] != '[') {
         return false;
     }
-    
+
     // Parse game time [...]
     pos++;
     end = line.find(']', pos);
-    if (end == std::string::npos) {
+    if (end == std::string_view::npos) {
         return false;
     }
-    *gameTime = line.substr(pos, end - pos);
-    
+    const TextSpan gameTime = makeSpan(pos, end);
+
     // Check for third bracket [
     pos = end + 1;
     if (pos >= line.size() || line[pos] != '[') {
         return false;
     }
-    
+
     // Parse category [...]
     pos++;
     end = line.find(']', pos);
-    if (end == std::string::npos) {
+    if (end == std::string_view::npos) {
         return false;
     }
-    *category = line.substr(pos, end - pos);
-    
+    const std::string_view categoryText = line.substr(pos, end - pos);
+
     // Check for colon :
     pos = end + 1;
     if (pos >= line.size() || line[pos] != ':') {
         return false;
     }
-    
+
     // Parse message (skip optional space after colon)
     pos++;
     if (pos < line.size() && line[pos] == ' ') {
         pos++;
     }
-    
-    *message = (pos < line.size()) ? line.substr(pos) : std::string();
+
+    *record = LogRecord();
+    record->systemTime = systemTime;
+    record->gameTime = gameTime;
+    record->message = makeSpan(pos, line.size());
+    *category = categoryText;
     return true;
 }
 
-std::vector<LogEntry> LogParser::parseLogContent(const std::string& content) const {
-    std::vector<LogEntry> entries;
-    entries.reserve(1000); // Pre-allocate for typical log file size
-    
-    const std::vector<std::string> lines = splitLines(content);
+} // namespace
 
-    LogEntry currentEntry;
-    bool hasCurrentEntry = false;
-    int currentIndex = 0;
+uint32_t LogCategoryTable::intern(std::string_view name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto iterator = m_ids.find(name);
+    if (iterator != m_ids.end()) {
+        return iterator->second;
+    }
 
-    auto finalizeCurrentEntry = [&]() {
-        if (!hasCurrentEntry) {
-            return;
-        }
+    const uint32_t id = static_cast<uint32_t>(m_names.size());
+    m_names.emplace_back(name);
+    m_ids.emplace(std::string_view(m_names.back()), id);
+    return id;
+}
 
-        currentEntry.message = trim(normalizeNewlines(currentEntry.message));
-        currentEntry.isHighPriority =
-            toLower(currentEntry.message).find("this will likely crash the game") != std::string::npos;
-        currentEntry.normalizedKey = normalizeLogEntryKey(currentEntry.category, currentEntry.message);
-        currentEntry.originalIndex = currentIndex++;
-        entries.push_back(std::move(currentEntry)); // Use move to avoid copy
-        
-        currentEntry = LogEntry();
-        hasCurrentEntry = false;
-    };
+const std::string& LogCategoryTable::sharedName(uint32_t id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_names[id];
+}
 
-    for (const std::string& line : lines) { // Use const reference to avoid copy
-        // Remove trailing \r if present
-        std::string cleanLine = line;
-        if (!cleanLine.empty() && cleanLine.back() == '\r') {
-            cleanLine.pop_back();
-        }
+void LogCategoryTable::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ids.clear();
+    m_names.clear();
+}
 
-        std::string systemTime, gameTime, category, message;
-        if (tryParseLogLine(cleanLine, &systemTime, &gameTime, &category, &message)) {
-            finalizeCurrentEntry();
-            currentEntry.systemTime = std::move(systemTime);
-            currentEntry.gameTime = std::move(gameTime);
-            currentEntry.category = std::move(category);
-            currentEntry.message = std::move(message);
-            hasCurrentEntry = true;
-            continue;
-        }
+bool LogParser::append(LogFileData* data, const char* bytes, std::size_t size, LogCategoryTable* categories) {
+    if (!data || !categories) {
+        return false;
+    }
+    if (data->text.size() + size > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
 
-        if (!hasCurrentEntry) {
-            continue;
-        }
+    data->text.append(bytes, size);
+    m_hasLastCategory = false;
+
+    std::size_t lineBegin = data->parsedBytes;
+    std::size_t newline = data->text.find('\n', lineBegin);
+    while (newline != std::string::npos) {
+        parseLine(data, lineBegin, newline, categories);
+        lineBegin = newline + 1;
+        newline = data->text.find('\n', lineBegin);
+    }
+    data->parsedBytes = lineBegin;
+    return true;
+}
 
-        currentEntry.message += "\n" + cleanLine;
+void LogParser::finish(LogFileData* data, LogCategoryTable* categories) {
+    if (!data || !categories) {
+        return;
     }
 
-    finalizeCurrentEntry();
-    return entries;
+    m_hasLastCategory = false;
+    data->resumePoint.recordCount = data->records.size();
+    data->resumePoint.parsedBytes = data->parsedBytes;
+    data->resumePoint.hasOpenRecord = data->hasOpenRecord;
+    data->resumePoint.openRecord = data->openRecord;
+
+    if (data->parsedBytes < data->text.size()) {
+        parseLine(data, data->parsedBytes, data->text.size(), categories);
+        data->parsedBytes = data->text.size();
+    }
+    closeRecord(data, categories);
+    data->complete = true;
 }
 
-std::string LogParser::normalizeLogEntryKey(const std::string& category, const std::string& message) const {
-    std::string normalized = toLower(trim(category)) + "\n" + normalizeNewlines(message);
-    std::vector<std::string> lines = splitLines(normalized);
+void LogParser::resume(LogFileData* data) {
+    if (!data || !data->complete) {
+        return;
+    }
 
-    std::ostringstream stream;
-    for (std::size_t index = 0; index < lines.size(); ++index) {
-        if (index > 0) {
-            stream << '\n';
-        }
-        stream << simplifyWhitespace(lines[index]);
+    // Records past the resume point came from the final partial line and the open record;
+    // both are parsed again once the appended text has arrived.
+    const LogResumePoint& point = data->resumePoint;
+    while (data->records.size() > point.recordCount) {
+        const LogRecord& record = data->records.back();
+        data->index.removeLast(static_cast<uint32_t>(data->records.size() - 1), record.category, {
+            spanView(data->text, record.systemTime),
+            spanView(data->text, record.gameTime),
+            spanView(data->text, record.message)
+        });
+        data->records.pop_back();
     }
+    data->parsedBytes = point.parsedBytes;
+    data->hasOpenRecord = point.hasOpenRecord;
+    data->openRecord = point.openRecord;
+    data->complete = false;
+}
 
-    return trim(stream.str());
+void LogParser::parseLine(LogFileData* data, std::size_t begin, std::size_t end, LogCategoryTable* categories) {
+    // Remove the '\r' run of a "\r...\r\n" break
+    while (end > begin && data->text[end - 1] == '\r') {
+        --end;
+    }
+
+    const std::string_view line(data->text.data() + begin, end - begin);
+    LogRecord record;
+    std::string_view category;
+    if (tryParseLogLine(line, begin, &record, &category)) {
+        closeRecord(data, categories);
+        record.category = categoryId(category, categories);
+        data->openRecord = record;
+        data->hasOpenRecord = true;
+        return;
+    }
+
+    // Continuation lines belong to the open record's message
+    if (data->hasOpenRecord) {
+        data->openRecord.message.length = static_cast<uint32_t>(end - data->openRecord.message.offset);
+    }
+}
+
+void LogParser::closeRecord(LogFileData* data, LogCategoryTable* categories) {
+    if (!data->hasOpenRecord) {
+        return;
+    }
+
+    LogRecord& record = data->openRecord;
+    const std::string_view message = trimView(spanView(data->text, record.message));
+    record.message.offset = static_cast<uint32_t>(message.data() - data->text.data());
+    record.message.length = static_cast<uint32_t>(message.size());
+    record.isHighPriority = containsCaseInsensitive(message, kHighPriorityMarker);
+
+    buildNormalizedKey(&m_keyBuffer, categoryName(record.category, *categories), message);
+    record.keyHash = hashKey(m_keyBuffer);
+
+    data->index.add(static_cast<uint32_t>(data->records.size()), record.category, {
+        spanView(data->text, record.systemTime),
+        spanView(data->text, record.gameTime),
+        message
+    });
+    data->records.push_back(record);
+    data->hasOpenRecord = false;
+}
+
+uint32_t LogParser::categoryId(std::string_view name, LogCategoryTable* categories) {
+    if (!m_hasLastCategory || name != m_lastCategoryName) {
+        m_lastCategoryId = categories->intern(name);
+        m_lastCategoryName.assign(name.data(), name.size());
+        m_hasLastCategory = true;
+    }
+    return m_lastCategoryId;
+}
+
+const std::string& LogParser::categoryName(uint32_t id, const LogCategoryTable& categories) {
+    if (m_hasLastCategory && id == m_lastCategoryId) {
+        return m_lastCategoryName;
+    }
+    return categories.sharedName(id);
+}
+
+LogEntry LogParser::materialize(const LogFileData& data, std::size_t index, const LogCategoryTable& categories) const {
+    const LogRecord& record = data.records[index];
+
+    LogEntry entry;
+    entry.systemTime = std::string(spanView(data.text, record.systemTime));
+    entry.gameTime = std::string(spanView(data.text, record.gameTime));
+    entry.category = categories.name(record.category);
+    entry.message.reserve(record.message.length);
+    appendNormalizedNewlines(&entry.message, spanView(data.text, record.message));
+    entry.normalizedKey = normalizeLogEntryKey(entry.category, entry.message);
+    entry.isHighPriority = record.isHighPriority;
+    entry.originalIndex = static_cast<int>(index);
+    return entry;
+}
+
+std::string LogParser::normalizeLogEntryKey(const std::string& category, const std::string& message) const {
+    std::string normalized;
+    buildNormalizedKey(&normalized, category, message);
+    return normalized;
 }
 
 } // namespace LogManager
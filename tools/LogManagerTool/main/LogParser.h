@@ -10,21 +10,73 @@
 #define LOGPARSER_H
 
 #include "LogEntry.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace LogManager {
 
+// Interned category names shared by every loaded file.
+//
+// Several parsers may intern into one table at once, and sharedName() may run alongside them.
+// name() and size() do not lock and are only for use while no parser is running.
+class LogCategoryTable {
+public:
+    uint32_t intern(std::string_view name);
+    const std::string& name(uint32_t id) const { return m_names[id]; }
+    const std::string& sharedName(uint32_t id) const;
+    std::size_t size() const noexcept { return m_names.size(); }
+    void clear();
+
+private:
+    mutable std::mutex m_mutex;
+    std::deque<std::string> m_names;  // Stable addresses for the map keys and returned names
+    std::unordered_map<std::string_view, uint32_t> m_ids;
+};
+
 // Log file parser class
+//
+// Text is fed in chunks of any size. Complete lines are parsed as they arrive; a trailing
+// partial line waits for the next chunk or for finish(). A parser keeps scratch state, so
+// files parsed in parallel each need their own.
 class LogParser {
 public:
     LogParser() = default;
 
-    // Parse log file content into structured entries
-    std::vector<LogEntry> parseLogContent(const std::string& content) const;
+    // Append a chunk to data->text and parse the lines it completes. Fails when the text
+    // would no longer be addressable by a TextSpan.
+    bool append(LogFileData* data, const char* bytes, std::size_t size, LogCategoryTable* categories);
+
+    // Parse the remaining partial line and close the last record
+    void finish(LogFileData* data, LogCategoryTable* categories);
+
+    // Undo finish() so text appended to the file continues its last line and record
+    void resume(LogFileData* data);
+
+    // Build the owning entry for data.records[index]
+    LogEntry materialize(const LogFileData& data, std::size_t index, const LogCategoryTable& categories) const;
 
     // Generate normalized key for log entry (for comparison and deduplication)
     std::string normalizeLogEntryKey(const std::string& category, const std::string& message) const;
+
+private:
+    void parseLine(LogFileData* data, std::size_t begin, std::size_t end, LogCategoryTable* categories);
+    void closeRecord(LogFileData* data, LogCategoryTable* categories);
+
+    uint32_t categoryId(std::string_view name, LogCategoryTable* categories);
+    const std::string& categoryName(uint32_t id, const LogCategoryTable& categories);
+
+    std::string m_keyBuffer;  // Scratch space for hashing normalized keys
+    // Category of the previous line, which most lines repeat; saves locking the shared table.
+    // Only valid within one append() or finish() call.
+    bool m_hasLastCategory = false;
+    uint32_t m_lastCategoryId = 0;
+    std::string m_lastCategoryName;
 };
 
 } // namespace LogManager
@@ -16,6 +16,7 @@ namespace LogManager {
 
 namespace {
 constexpr const char* kLatestLogInternalName = "__LATEST__";
+constexpr const char* kOldLogsDisplayPrefix = "old_logs/";
 
 // Convert string to lowercase
 std::string toLower(std::string value) {
@@ -41,6 +42,31 @@ std::string normalizePathSeparators(std::string value) {
     return value;
 }
 
+// Digits of the session timestamp in a crash or rotated log folder name, from the first run of
+// four digits (the year) on, so folders named by either scheme order chronologically together.
+std::string sessionTimeKey(const std::string& name) {
+    std::size_t yearStart = std::string::npos;
+    for (std::size_t index = 0; index + 4 <= name.size(); ++index) {
+        if (std::all_of(name.begin() + index, name.begin() + index + 4, [](unsigned char character) {
+                return std::isdigit(character) != 0;
+            })) {
+            yearStart = index;
+            break;
+        }
+    }
+
+    std::string key;
+    if (yearStart == std::string::npos) {
+        return key;
+    }
+    for (std::size_t index = yearStart; index < name.size(); ++index) {
+        if (std::isdigit(static_cast<unsigned char>(name[index]))) {
+            key.push_back(name[index]);
+        }
+    }
+    return key;
+}
+
 // Normalize crash log source path relative to the document root.
 std::string normalizeCrashSourcePath(const std::string& relativePath) {
     std::string normalizedPath = normalizePathSeparators(relativePath);
@@ -154,8 +180,46 @@ std::vector<LogFileRecord> LogScanner::scanLogFiles() const {
         }
     }
 
-    // Sort historical files by name
+    // Rotated sessions: the game moves each previous logs folder to logs/old_logs/<session>.
+    const DirectoryListResult oldLogsResult = m_fileSystem->listDirectory("logs/old_logs", false);
+
+    if (oldLogsResult.success) {
+        for (const DirectoryEntry& entry : oldLogsResult.entries) {
+            if (!entry.isDirectory || entry.name.empty()) {
+                continue;
+            }
+
+            const DirectoryListResult sessionResult =
+                m_fileSystem->listDirectory(normalizePathSeparators(entry.relativePath), false);
+            if (!sessionResult.success) {
+                continue;
+            }
+
+            for (const DirectoryEntry& logEntry : sessionResult.entries) {
+                if (logEntry.isDirectory || toLower(logEntry.name) != "error.log") {
+                    continue;
+                }
+
+                LogFileRecord historyRecord;
+                historyRecord.displayName = std::string(kOldLogsDisplayPrefix) + entry.name;
+                historyRecord.sourcePath = normalizePathSeparators(logEntry.relativePath);
+                historyRecord.isLatest = false;
+                historyFiles.push_back(std::move(historyRecord));
+                break;
+            }
+        }
+    }
+
+    // Oldest session first; names without a timestamp sort by name after those with one.
     std::sort(historyFiles.begin(), historyFiles.end(), [](const LogFileRecord& left, const LogFileRecord& right) {
+        const std::string leftKey = sessionTimeKey(left.displayName);
+        const std::string rightKey = sessionTimeKey(right.displayName);
+        if (leftKey.empty() != rightKey.empty()) {
+            return !leftKey.empty();
+        }
+        if (leftKey != rightKey) {
+            return leftKey < rightKey;
+        }
         return caseInsensitiveLess(left.displayName, right.displayName);
     });
 
@@ -23,7 +23,7 @@ public:
     // Set file system implementation (must be called before scanning)
     void setFileSystem(IFileSystem* fileSystem) { m_fileSystem = fileSystem; }
 
-    // Scan for available log files in the game directory
+    // Scan for the latest log, crash logs and rotated session logs in the game directory
     std::vector<LogFileRecord> scanLogFiles() const;
 
 private:
@@ -0,0 +1,305 @@
+//-------------------------------------------------------------------------------------
+// LogSearchIndex.cpp -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#include "LogSearchIndex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <iterator>
+
+namespace LogManager {
+
+namespace {
+
+// Longest gram kept per token; longer pieces intersect the token lists of their trigrams.
+constexpr std::size_t kMaximumGramLength = 3;
+
+bool isTokenChar(unsigned char character) {
+    return (character >= 'a' && character <= 'z')
+        || (character >= 'A' && character <= 'Z')
+        || (character >= '0' && character <= '9')
+        || character == '_'
+        || character >= 0x80;
+}
+
+char lowerTokenChar(unsigned char character) {
+    return (character >= 'A' && character <= 'Z')
+        ? static_cast<char>(character - 'A' + 'a')
+        : static_cast<char>(character);
+}
+
+std::size_t popCount(uint64_t word) {
+    return std::bitset<64>(word).count();
+}
+
+// Length in the top byte keeps grams of different lengths apart.
+uint32_t gramKey(const char* bytes, std::size_t length) {
+    uint32_t key = static_cast<uint32_t>(length) << 24;
+    for (std::size_t index = 0; index < length; ++index) {
+        key |= static_cast<uint32_t>(static_cast<unsigned char>(bytes[index])) << (8 * (length - 1 - index));
+    }
+    return key;
+}
+
+uint64_t nextGeneration() {
+    static std::atomic<uint64_t> counter{0};
+    return ++counter;
+}
+
+} // namespace
+
+RecordBitmap RecordBitmap::all(std::size_t count) {
+    RecordBitmap bitmap;
+    bitmap.m_words.assign(count / 64, ~uint64_t(0));
+    if (count % 64 != 0) {
+        bitmap.m_words.push_back((uint64_t(1) << (count % 64)) - 1);
+    }
+    return bitmap;
+}
+
+void RecordBitmap::set(uint32_t id) {
+    const std::size_t word = id >> 6;
+    if (word >= m_words.size()) {
+        m_words.resize(word + 1, 0);
+    }
+    m_words[word] |= uint64_t(1) << (id & 63);
+}
+
+void RecordBitmap::reset(uint32_t id) {
+    const std::size_t word = id >> 6;
+    if (word < m_words.size()) {
+        m_words[word] &= ~(uint64_t(1) << (id & 63));
+    }
+}
+
+void RecordBitmap::intersect(const RecordBitmap& other) {
+    if (m_words.size() > other.m_words.size()) {
+        m_words.resize(other.m_words.size());
+    }
+    for (std::size_t word = 0; word < m_words.size(); ++word) {
+        m_words[word] &= other.m_words[word];
+    }
+}
+
+void RecordBitmap::unite(const RecordBitmap& other) {
+    if (m_words.size() < other.m_words.size()) {
+        m_words.resize(other.m_words.size(), 0);
+    }
+    for (std::size_t word = 0; word < other.m_words.size(); ++word) {
+        m_words[word] |= other.m_words[word];
+    }
+}
+
+std::size_t RecordBitmap::count() const {
+    std::size_t total = 0;
+    for (const uint64_t word : m_words) {
+        total += popCount(word);
+    }
+    return total;
+}
+
+std::size_t RecordBitmap::countCommon(const RecordBitmap& other) const {
+    const std::size_t words = std::min(m_words.size(), other.m_words.size());
+    std::size_t total = 0;
+    for (std::size_t word = 0; word < words; ++word) {
+        total += popCount(m_words[word] & other.m_words[word]);
+    }
+    return total;
+}
+
+std::vector<uint32_t> RecordBitmap::toIndices() const {
+    std::vector<uint32_t> indices;
+    indices.reserve(count());
+    for (std::size_t word = 0; word < m_words.size(); ++word) {
+        uint64_t bits = m_words[word];
+        while (bits != 0) {
+            const uint64_t lowest = bits & (~bits + 1);
+            indices.push_back(static_cast<uint32_t>(word * 64 + popCount(lowest - 1)));
+            bits ^= lowest;
+        }
+    }
+    return indices;
+}
+
+template <typename Visitor>
+void LogSearchIndex::forEachToken(std::initializer_list<std::string_view> fields, Visitor&& visit) {
+    for (const std::string_view field : fields) {
+        std::size_t position = 0;
+        while (position < field.size()) {
+            while (position < field.size() && !isTokenChar(static_cast<unsigned char>(field[position]))) {
+                ++position;
+            }
+            m_token.clear();
+            while (position < field.size() && isTokenChar(static_cast<unsigned char>(field[position]))) {
+                m_token.push_back(lowerTokenChar(static_cast<unsigned char>(field[position])));
+                ++position;
+            }
+            if (!m_token.empty()) {
+                visit(m_token);
+            }
+        }
+    }
+}
+
+void LogSearchIndex::add(uint32_t id, uint32_t category, std::initializer_list<std::string_view> fields) {
+    forEachToken(fields, [this, id](const std::string& token) {
+        auto iterator = m_tokenIds.find(token);
+        if (iterator == m_tokenIds.end()) {
+            iterator = m_tokenIds.emplace(token, static_cast<uint32_t>(m_tokens.size())).first;
+            m_tokens.push_back(token);
+            m_postings.emplace_back();
+            indexTokenGrams(iterator->second, token);
+        }
+
+        // Ids arrive in order, so a repeated token of this record is always at the back.
+        std::vector<uint32_t>& postings = m_postings[iterator->second];
+        if (postings.empty() || postings.back() != id) {
+            postings.push_back(id);
+        }
+    });
+
+    if (category >= m_categoryRecords.size()) {
+        m_categoryRecords.resize(category + 1);
+        m_categoryCounts.resize(category + 1, 0);
+    }
+    m_categoryRecords[category].set(id);
+    ++m_categoryCounts[category];
+
+    m_recordCount = static_cast<std::size_t>(id) + 1;
+    m_generation = nextGeneration();
+}
+
+void LogSearchIndex::removeLast(uint32_t id, uint32_t category, std::initializer_list<std::string_view> fields) {
+    forEachToken(fields, [this, id](const std::string& token) {
+        const auto iterator = m_tokenIds.find(token);
+        if (iterator == m_tokenIds.end()) {
+            return;
+        }
+        std::vector<uint32_t>& postings = m_postings[iterator->second];
+        if (!postings.empty() && postings.back() == id) {
+            postings.pop_back();
+        }
+    });
+
+    if (category < m_categoryRecords.size() && m_categoryRecords[category].test(id)) {
+        m_categoryRecords[category].reset(id);
+        --m_categoryCounts[category];
+    }
+
+    m_recordCount = id;
+    m_generation = nextGeneration();
+}
+
+void LogSearchIndex::indexTokenGrams(uint32_t tokenId, const std::string& token) {
+    // Token ids only grow, so a gram repeated within this token is always at the back.
+    for (std::size_t length = 1; length <= kMaximumGramLength; ++length) {
+        for (std::size_t start = 0; start + length <= token.size(); ++start) {
+            std::vector<uint32_t>& tokens = m_gramTokens[gramKey(token.data() + start, length)];
+            if (tokens.empty() || tokens.back() != tokenId) {
+                tokens.push_back(tokenId);
+            }
+        }
+    }
+}
+
+std::vector<uint32_t> LogSearchIndex::tokensContaining(const std::string& piece) const {
+    static const std::vector<uint32_t> kNone;
+    auto gramTokens = [this](const char* bytes, std::size_t length) -> const std::vector<uint32_t>& {
+        const auto iterator = m_gramTokens.find(gramKey(bytes, length));
+        return iterator != m_gramTokens.end() ? iterator->second : kNone;
+    };
+
+    // A piece no longer than a gram is answered by its own list.
+    if (piece.size() <= kMaximumGramLength) {
+        return gramTokens(piece.data(), piece.size());
+    }
+
+    // Otherwise every trigram of the piece must occur in the token; start from the rarest.
+    std::vector<const std::vector<uint32_t>*> lists;
+    for (std::size_t start = 0; start + kMaximumGramLength <= piece.size(); ++start) {
+        lists.push_back(&gramTokens(piece.data() + start, kMaximumGramLength));
+    }
+    std::sort(lists.begin(), lists.end(), [](const std::vector<uint32_t>* left, const std::vector<uint32_t>* right) {
+        return left->size() < right->size();
+    });
+
+    std::vector<uint32_t> tokens = *lists.front();
+    std::vector<uint32_t> narrowed;
+    for (std::size_t index = 1; index < lists.size() && !tokens.empty(); ++index) {
+        narrowed.clear();
+        std::set_intersection(tokens.begin(), tokens.end(), lists[index]->begin(), lists[index]->end(),
+                              std::back_inserter(narrowed));
+        tokens.swap(narrowed);
+    }
+
+    // Trigrams can all be present without being adjacent, so confirm the survivors.
+    tokens.erase(std::remove_if(tokens.begin(), tokens.end(), [this, &piece](uint32_t token) {
+        return m_tokens[token].find(piece) == std::string::npos;
+    }), tokens.end());
+    return tokens;
+}
+
+RecordBitmap LogSearchIndex::tokenCandidates(std::string_view term, bool* exact) const {
+    // A field containing term contains every token-character run of term inside one token.
+    std::vector<std::string> pieces;
+    std::string piece;
+    bool singleRun = true;
+    for (std::size_t position = 0; position <= term.size(); ++position) {
+        if (position < term.size() && isTokenChar(static_cast<unsigned char>(term[position]))) {
+            piece.push_back(lowerTokenChar(static_cast<unsigned char>(term[position])));
+            continue;
+        }
+        if (position < term.size() || piece.size() != term.size()) {
+            singleRun = false;
+        }
+        if (!piece.empty()) {
+            pieces.push_back(piece);
+        }
+        piece.clear();
+    }
+    if (exact) {
+        *exact = singleRun && !pieces.empty();
+    }
+    if (pieces.empty()) {
+        return RecordBitmap::all(m_recordCount);
+    }
+
+    // Longer pieces match fewer tokens, so they go first and keep the intersection small.
+    std::sort(pieces.begin(), pieces.end(), [](const std::string& left, const std::string& right) {
+        return left.size() > right.size();
+    });
+
+    RecordBitmap candidates;
+    for (std::size_t index = 0; index < pieces.size(); ++index) {
+        RecordBitmap matches;
+        for (const uint32_t token : tokensContaining(pieces[index])) {
+            for (const uint32_t id : m_postings[token]) {
+                matches.set(id);
+            }
+        }
+
+        if (index == 0) {
+            candidates = std::move(matches);
+        } else {
+            candidates.intersect(matches);
+        }
+    }
+    return candidates;
+}
+
+const RecordBitmap& LogSearchIndex::categoryRecords(uint32_t category) const {
+    static const RecordBitmap kEmpty;
+    return category < m_categoryRecords.size() ? m_categoryRecords[category] : kEmpty;
+}
+
+std::size_t LogSearchIndex::categoryCount(uint32_t category) const {
+    return category < m_categoryCounts.size() ? m_categoryCounts[category] : 0;
+}
+
+} // namespace LogManager
@@ -0,0 +1,89 @@
+//-------------------------------------------------------------------------------------
+// LogSearchIndex.h -- Part of APE HOI4 Tool Studio
+//
+// Copyright (C) 2026 Team APE:RIP. All rights reserved.
+// Licensed under the Team APE:RIP Source Code License Agreement.
+//
+// https://github.com/Team-APE-RIP/APE-HOI4-Tool-Studio/
+//-------------------------------------------------------------------------------------
+#ifndef LOGSEARCHINDEX_H
+#define LOGSEARCHINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace LogManager {
+
+// Set of record ids. Bits past the stored words read as unset.
+class RecordBitmap {
+public:
+    static RecordBitmap all(std::size_t count);
+
+    bool test(uint32_t id) const {
+        const std::size_t word = id >> 6;
+        return word < m_words.size() && ((m_words[word] >> (id & 63)) & 1u) != 0;
+    }
+    void set(uint32_t id);
+    void reset(uint32_t id);
+
+    void intersect(const RecordBitmap& other);
+    void unite(const RecordBitmap& other);
+    std::size_t count() const;
+    std::size_t countCommon(const RecordBitmap& other) const;
+    std::vector<uint32_t> toIndices() const;
+
+private:
+    std::vector<uint64_t> m_words;
+};
+
+// Inverted index over the records of one log file, kept up to date by LogParser.
+//
+// Tokens are lower-cased runs of letters, digits, '_' and non-ASCII bytes taken from the time
+// fields and the message. Categories are not tokenized; each has a bitmap of its records, which
+// serves both as a search facet and to answer terms found in a category name.
+class LogSearchIndex {
+public:
+    // Ids must be added in increasing order; removeLast() undoes the most recent add.
+    void add(uint32_t id, uint32_t category, std::initializer_list<std::string_view> fields);
+    void removeLast(uint32_t id, uint32_t category, std::initializer_list<std::string_view> fields);
+
+    std::size_t recordCount() const noexcept { return m_recordCount; }
+    // Changes whenever the indexed records change
+    uint64_t generation() const noexcept { return m_generation; }
+
+    // Records that may contain term in a tokenized field: a superset of the real matches,
+    // to be verified by the caller. Terms without any token characters are not narrowed and
+    // return every record. *exact is set when term is a single run of token characters, since
+    // then the candidates are precisely the records containing it.
+    RecordBitmap tokenCandidates(std::string_view term, bool* exact = nullptr) const;
+
+    const RecordBitmap& categoryRecords(uint32_t category) const;
+    std::size_t categoryCount(uint32_t category) const;
+
+private:
+    template <typename Visitor>
+    void forEachToken(std::initializer_list<std::string_view> fields, Visitor&& visit);
+    void indexTokenGrams(uint32_t tokenId, const std::string& token);
+    std::vector<uint32_t> tokensContaining(const std::string& piece) const;
+
+    std::unordered_map<std::string, uint32_t> m_tokenIds;
+    std::vector<std::string> m_tokens;
+    // Sorted ids of the tokens containing each 1-, 2- and 3-byte gram, so a query piece finds
+    // its tokens without scanning the vocabulary.
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_gramTokens;
+    std::vector<std::vector<uint32_t>> m_postings;  // Sorted record ids per token
+    std::vector<RecordBitmap> m_categoryRecords;
+    std::vector<std::size_t> m_categoryCounts;
+    std::size_t m_recordCount = 0;
+    uint64_t m_generation = 0;  // Unique across indices, so a stale cache can never match
+    std::string m_token;  // Scratch buffer for lookups
+};
+
+} // namespace LogManager
+
+#endif // LOGSEARCHINDEX_H